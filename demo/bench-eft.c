@@ -0,0 +1,235 @@
+/* SPDX-License-Identifier: LGPL-2.1-or-later */
+/* bench-eft.c: compensated kernels and pairs timed against long double */
+/* Copyright (C) 2026 Eric Herman */
+/* https://github.com/ericherman/libefloat */
+/*
+make bench-eft && ./bench-eft [rounds]
+
+The compensated sum and dot product are timed against the plain loop,
+a loop in a wider type, and the exact superaccumulator; how far each
+lands from the exact result is printed first, in ulps. The pair
+arithmetic is timed against the same operation in the wider type.
+*/
+
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#include "efloat.h"
+#include "bench.h"
+
+/* terms of random sign over 40 binades, so that much of the sum cancels */
+static float af[Bench_len], bf[Bench_len];
+static double ad[Bench_len], bd[Bench_len];
+static long double al[Bench_len], bl[Bench_len], rl[Bench_len];
+static double rd[Bench_len];
+static struct efloat32_pair pf[Bench_len], qf[Bench_len], rpf[Bench_len];
+static struct efloat64_pair pd[Bench_len], qd[Bench_len], rpd[Bench_len];
+
+static double bench_eft_rand(uint64_t *state)
+{
+	double d;
+
+	d = ldexp(1.0 + ldexp((double)(bench_rng(state) >> 11), -53),
+		  (int)(bench_rng(state) % 41) - 20);
+	return (bench_rng(state) & 1) ? -d : d;
+}
+
+static void bench_eft_inputs(void)
+{
+	uint64_t state;
+	size_t i;
+
+	state = 0xB5026F5AA96619E9UL;
+	for (i = 0; i < Bench_len; ++i) {
+		ad[i] = bench_eft_rand(&state);
+		bd[i] = bench_eft_rand(&state);
+		af[i] = (float)ad[i];
+		bf[i] = (float)bd[i];
+		al[i] = ad[i];
+		bl[i] = bd[i];
+
+		pd[i].hi = fabs(ad[i]);
+		pd[i].lo = ldexp(bench_eft_rand(&state), ilogb(ad[i]) - 74);
+		qd[i].hi = fabs(bd[i]);
+		qd[i].lo = ldexp(bench_eft_rand(&state), ilogb(bd[i]) - 74);
+		pf[i].hi = (float)pd[i].hi;
+		pf[i].lo = (float)ldexp(pd[i].lo, -29);
+		qf[i].hi = (float)qd[i].hi;
+		qf[i].lo = (float)ldexp(qd[i].lo, -29);
+	}
+}
+
+/* the distance from "exact" to "r", in ulps of the format */
+static double bench_eft_ulps64(double r, double exact)
+{
+	return fabs(r - exact) / ldexp(1.0, ilogb(exact) - 52);
+}
+
+static double bench_eft_ulps32(float r, float exact)
+{
+	return fabs((double)r - exact) / ldexp(1.0, ilogb(exact) - 23);
+}
+
+static void bench_eft_accuracy(void)
+{
+	double sd, dd, exact, exact_dot;
+	long double sl, dl;
+	float sf, df, exactf, exactf_dot;
+	size_t i;
+
+	sd = 0.0;
+	dd = 0.0;
+	sl = 0.0;
+	dl = 0.0;
+	for (i = 0; i < Bench_len; ++i) {
+		sd += ad[i];
+		dd += ad[i] * bd[i];
+		sl += al[i];
+		dl += al[i] * bl[i];
+	}
+	exact = efloat64_array_sum_exact(ad, Bench_len);
+	exact_dot = efloat64_array_dot_exact(ad, bd, Bench_len);
+	printf("ulps from the exact efloat64 results:\n");
+	printf("%-36s %8.2f %8.2f\n", "sum, dot", bench_eft_ulps64(sd, exact),
+	       bench_eft_ulps64(dd, exact_dot));
+	printf("%-36s %8.2f %8.2f\n", "long double sum, dot",
+	       bench_eft_ulps64((double)sl, exact),
+	       bench_eft_ulps64((double)dl, exact_dot));
+	printf("%-36s %8.2f %8.2f\n", "compensated sum, dot",
+	       bench_eft_ulps64(efloat64_array_sum_compensated(ad, Bench_len),
+				exact),
+	       bench_eft_ulps64(efloat64_array_dot_compensated(ad, bd,
+							       Bench_len),
+				exact_dot));
+
+	sf = 0.0f;
+	df = 0.0f;
+	sd = 0.0;
+	dd = 0.0;
+	for (i = 0; i < Bench_len; ++i) {
+		sf += af[i];
+		df += af[i] * bf[i];
+		sd += af[i];
+		dd += (double)af[i] * bf[i];
+	}
+	exactf = efloat32_array_sum_exact(af, Bench_len);
+	exactf_dot = efloat32_array_dot_exact(af, bf, Bench_len);
+	printf("ulps from the exact efloat32 results:\n");
+	printf("%-36s %8.2f %8.2f\n", "sum, dot", bench_eft_ulps32(sf, exactf),
+	       bench_eft_ulps32(df, exactf_dot));
+	printf("%-36s %8.2f %8.2f\n", "double sum, dot",
+	       bench_eft_ulps32((float)sd, exactf),
+	       bench_eft_ulps32((float)dd, exactf_dot));
+	printf("%-36s %8.2f %8.2f\n", "compensated sum, dot",
+	       bench_eft_ulps32(efloat32_array_sum_compensated(af, Bench_len),
+				exactf),
+	       bench_eft_ulps32(efloat32_array_dot_compensated(af, bf,
+							       Bench_len),
+				exactf_dot));
+	printf("\n");
+}
+
+int main(int argc, char **argv)
+{
+	unsigned long rounds, r;
+	uint64_t check;
+	clock_t start;
+	size_t i, k;
+	double s, d;
+	long double sl;
+	float sf;
+
+	rounds = bench_rounds(argc, argv, 20000);
+	bench_eft_inputs();
+	bench_eft_accuracy();
+
+	/* the loops run on across the rounds, as one long sum */
+	s = 0.0;
+	Bench_time("double sum", s += ad[i], efloat64_to_uint64_bits(s));
+	sl = 0.0;
+	Bench_time("long double sum", sl += al[i],
+		   efloat64_to_uint64_bits((double)sl));
+	Bench_time_array("efloat64_array_sum_compensated",
+			 s = efloat64_array_sum_compensated(ad, Bench_len),
+			 efloat64_to_uint64_bits(s));
+	Bench_time_array("efloat64_array_sum_exact",
+			 s = efloat64_array_sum_exact(ad, Bench_len),
+			 efloat64_to_uint64_bits(s));
+	s = 0.0;
+	Bench_time("double dot", s += ad[i] * bd[i],
+		   efloat64_to_uint64_bits(s));
+	sl = 0.0;
+	Bench_time("long double dot", sl += al[i] * bl[i],
+		   efloat64_to_uint64_bits((double)sl));
+	Bench_time_array("efloat64_array_dot_compensated",
+			 s = efloat64_array_dot_compensated(ad, bd, Bench_len),
+			 efloat64_to_uint64_bits(s));
+	Bench_time_array("efloat64_array_dot_exact",
+			 s = efloat64_array_dot_exact(ad, bd, Bench_len),
+			 efloat64_to_uint64_bits(s));
+
+	sf = 0.0f;
+	Bench_time("float sum", sf += af[i], efloat32_to_uint32_bits(sf));
+	d = 0.0;
+	Bench_time("double sum of floats", d += af[i],
+		   efloat64_to_uint64_bits(d));
+	Bench_time_array("efloat32_array_sum_compensated",
+			 sf = efloat32_array_sum_compensated(af, Bench_len),
+			 efloat32_to_uint32_bits(sf));
+	sf = 0.0f;
+	Bench_time("float dot", sf += af[i] * bf[i],
+		   efloat32_to_uint32_bits(sf));
+	d = 0.0;
+	Bench_time("double dot of floats", d += (double)af[i] * bf[i],
+		   efloat64_to_uint64_bits(d));
+	Bench_time_array("efloat32_array_dot_compensated",
+			 sf = efloat32_array_dot_compensated(af, bf,
+							     Bench_len),
+			 efloat32_to_uint32_bits(sf));
+	printf("\n");
+
+	Bench_time("long double +", rl[i] = al[i] + bl[i],
+		   efloat64_to_uint64_bits((double)rl[k]));
+	Bench_time_array("efloat64_pair_array_add",
+			 efloat64_pair_array_add(rpd, pd, qd, Bench_len),
+			 efloat64_to_uint64_bits(rpd[k].lo));
+	Bench_time("long double *", rl[i] = al[i] * bl[i],
+		   efloat64_to_uint64_bits((double)rl[k]));
+	Bench_time_array("efloat64_pair_array_mul",
+			 efloat64_pair_array_mul(rpd, pd, qd, Bench_len),
+			 efloat64_to_uint64_bits(rpd[k].lo));
+	Bench_time("long double /", rl[i] = al[i] / bl[i],
+		   efloat64_to_uint64_bits((double)rl[k]));
+	Bench_time_array("efloat64_pair_array_div",
+			 efloat64_pair_array_div(rpd, pd, qd, Bench_len),
+			 efloat64_to_uint64_bits(rpd[k].lo));
+	Bench_time("sqrtl", rl[i] = sqrtl(fabsl(al[i])),
+		   efloat64_to_uint64_bits((double)rl[k]));
+	Bench_time_array("efloat64_pair_array_sqrt",
+			 efloat64_pair_array_sqrt(rpd, pd, Bench_len),
+			 efloat64_to_uint64_bits(rpd[k].lo));
+
+	Bench_time("double +", rd[i] = ad[i] + bd[i],
+		   efloat64_to_uint64_bits(rd[k]));
+	Bench_time_array("efloat32_pair_array_add",
+			 efloat32_pair_array_add(rpf, pf, qf, Bench_len),
+			 efloat32_to_uint32_bits(rpf[k].lo));
+	Bench_time("double *", rd[i] = ad[i] * bd[i],
+		   efloat64_to_uint64_bits(rd[k]));
+	Bench_time_array("efloat32_pair_array_mul",
+			 efloat32_pair_array_mul(rpf, pf, qf, Bench_len),
+			 efloat32_to_uint32_bits(rpf[k].lo));
+	Bench_time("double /", rd[i] = ad[i] / bd[i],
+		   efloat64_to_uint64_bits(rd[k]));
+	Bench_time_array("efloat32_pair_array_div",
+			 efloat32_pair_array_div(rpf, pf, qf, Bench_len),
+			 efloat32_to_uint32_bits(rpf[k].lo));
+	Bench_time("sqrt", rd[i] = sqrt(fabs(ad[i])),
+		   efloat64_to_uint64_bits(rd[k]));
+	Bench_time_array("efloat32_pair_array_sqrt",
+			 efloat32_pair_array_sqrt(rpf, pf, Bench_len),
+			 efloat32_to_uint32_bits(rpf[k].lo));
+
+	return 0;
+}
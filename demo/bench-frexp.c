@@ -0,0 +1,161 @@
+/* SPDX-License-Identifier: LGPL-2.1-or-later */
+/* bench-frexp.c: the exponent functions timed against libm */
+/* Copyright (C) 2026 Eric Herman */
+/* https://github.com/ericherman/libefloat */
+/*
+make bench-frexp && ./bench-frexp [rounds]
+
+Each function is timed three ways on the same inputs: libm called for
+each element, the efloat scalar form called for each element, and the
+efloat array form called once for all of them. The subnormal lines are
+where the libm versions leave their fast paths.
+*/
+
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#include "efloat.h"
+#include "bench.h"
+
+/* time one function as libm, as efloat scalar and as efloat array */
+#define Bench_frexp_three(libm_name, libm_body, ef_name, ef_body, \
+			  array_name, array_call, out) \
+	do { \
+		Bench_time(libm_name, libm_body, out); \
+		Bench_time(ef_name, ef_body, out); \
+		Bench_time_array(array_name, array_call, out); \
+	} while (0)
+
+#define Bench_out32 \
+	(efloat32_to_uint32_bits(rf[k]) ^ ((uint64_t)(uint32_t)e[k] << 32))
+#define Bench_out64 \
+	(efloat64_to_uint64_bits(rd[k]) ^ (uint64_t)(uint32_t)e[k])
+
+/* normals, subnormals, values in [1, 2) and exponents for ldexp */
+static float af[Bench_len], sf[Bench_len], bf[Bench_len], rf[Bench_len];
+static double ad[Bench_len], sd[Bench_len], bd[Bench_len], rd[Bench_len];
+static int near[Bench_len], under32[Bench_len], under64[Bench_len];
+static int e[Bench_len];
+
+static void bench_frexp_inputs(void)
+{
+	uint64_t state, u;
+	size_t i;
+
+	state = 0x2545F4914F6CDD1DUL;
+	for (i = 0; i < Bench_len; ++i) {
+		u = bench_rng(&state);
+		af[i] = uint32_bits_to_efloat32((uint32_t)
+						((((u >> 32) % 61) + 97) << 23
+						 | (u & 0x807FFFFFUL)));
+		sf[i] = uint32_bits_to_efloat32((uint32_t)(u >> 41) | 1);
+		bf[i] = uint32_bits_to_efloat32(0x3F800000UL
+						| (uint32_t)(u >> 41));
+		ad[i] = uint64_bits_to_efloat64(((((u >> 32) % 201) + 923)
+						 << 52)
+						| (u & 0x800FFFFFFFFFFFFFUL));
+		u = bench_rng(&state);
+		sd[i] = uint64_bits_to_efloat64((u >> 12) | 1);
+		bd[i] = uint64_bits_to_efloat64(0x3FF0000000000000UL
+						| (u >> 12));
+		near[i] = (int)(u % 101) - 50;
+		under32[i] = -127 - (int)((u >> 8) % 24);
+		under64[i] = -1023 - (int)((u >> 8) % 53);
+	}
+}
+
+int main(int argc, char **argv)
+{
+	unsigned long rounds, r;
+	uint64_t check;
+	clock_t start;
+	size_t i, k;
+
+	rounds = bench_rounds(argc, argv, 20000);
+	bench_frexp_inputs();
+
+	Bench_frexp_three("frexpf", rf[i] = frexpf(af[i], &e[i]),
+			  "efloat32_frexp",
+			  rf[i] = efloat32_frexp(af[i], &e[i]),
+			  "efloat32_array_frexp",
+			  efloat32_array_frexp(rf, e, af, Bench_len),
+			  Bench_out32);
+	Bench_frexp_three("frexpf, subnormal",
+			  rf[i] = frexpf(sf[i], &e[i]),
+			  "efloat32_frexp, subnormal",
+			  rf[i] = efloat32_frexp(sf[i], &e[i]),
+			  "efloat32_array_frexp, subnormal",
+			  efloat32_array_frexp(rf, e, sf, Bench_len),
+			  Bench_out32);
+	Bench_frexp_three("ldexpf", rf[i] = ldexpf(af[i], near[i]),
+			  "efloat32_ldexp",
+			  rf[i] = efloat32_ldexp(af[i], near[i]),
+			  "efloat32_array_ldexp",
+			  efloat32_array_ldexp(rf, af, near, Bench_len),
+			  Bench_out32);
+	Bench_frexp_three("ldexpf, to subnormal",
+			  rf[i] = ldexpf(bf[i], under32[i]),
+			  "efloat32_ldexp, to subnormal",
+			  rf[i] = efloat32_ldexp(bf[i], under32[i]),
+			  "efloat32_array_ldexp, to subnormal",
+			  efloat32_array_ldexp(rf, bf, under32, Bench_len),
+			  Bench_out32);
+	Bench_frexp_three("ilogbf", e[i] = ilogbf(af[i]),
+			  "efloat32_ilogb", e[i] = efloat32_ilogb(af[i]),
+			  "efloat32_array_ilogb",
+			  efloat32_array_ilogb(e, af, Bench_len), Bench_out32);
+	Bench_frexp_three("logbf", rf[i] = logbf(af[i]),
+			  "efloat32_logb", rf[i] = efloat32_logb(af[i]),
+			  "efloat32_array_logb",
+			  efloat32_array_logb(rf, af, Bench_len), Bench_out32);
+	Bench_frexp_three("copysignf", rf[i] = copysignf(bf[i], af[i]),
+			  "efloat32_copysign",
+			  rf[i] = efloat32_copysign(bf[i], af[i]),
+			  "efloat32_array_copysign",
+			  efloat32_array_copysign(rf, bf, af, Bench_len),
+			  Bench_out32);
+
+	Bench_frexp_three("frexp", rd[i] = frexp(ad[i], &e[i]),
+			  "efloat64_frexp",
+			  rd[i] = efloat64_frexp(ad[i], &e[i]),
+			  "efloat64_array_frexp",
+			  efloat64_array_frexp(rd, e, ad, Bench_len),
+			  Bench_out64);
+	Bench_frexp_three("frexp, subnormal",
+			  rd[i] = frexp(sd[i], &e[i]),
+			  "efloat64_frexp, subnormal",
+			  rd[i] = efloat64_frexp(sd[i], &e[i]),
+			  "efloat64_array_frexp, subnormal",
+			  efloat64_array_frexp(rd, e, sd, Bench_len),
+			  Bench_out64);
+	Bench_frexp_three("ldexp", rd[i] = ldexp(ad[i], near[i]),
+			  "efloat64_ldexp",
+			  rd[i] = efloat64_ldexp(ad[i], near[i]),
+			  "efloat64_array_ldexp",
+			  efloat64_array_ldexp(rd, ad, near, Bench_len),
+			  Bench_out64);
+	Bench_frexp_three("ldexp, to subnormal",
+			  rd[i] = ldexp(bd[i], under64[i]),
+			  "efloat64_ldexp, to subnormal",
+			  rd[i] = efloat64_ldexp(bd[i], under64[i]),
+			  "efloat64_array_ldexp, to subnormal",
+			  efloat64_array_ldexp(rd, bd, under64, Bench_len),
+			  Bench_out64);
+	Bench_frexp_three("ilogb", e[i] = ilogb(ad[i]),
+			  "efloat64_ilogb", e[i] = efloat64_ilogb(ad[i]),
+			  "efloat64_array_ilogb",
+			  efloat64_array_ilogb(e, ad, Bench_len), Bench_out64);
+	Bench_frexp_three("logb", rd[i] = logb(ad[i]),
+			  "efloat64_logb", rd[i] = efloat64_logb(ad[i]),
+			  "efloat64_array_logb",
+			  efloat64_array_logb(rd, ad, Bench_len), Bench_out64);
+	Bench_frexp_three("copysign", rd[i] = copysign(bd[i], ad[i]),
+			  "efloat64_copysign",
+			  rd[i] = efloat64_copysign(bd[i], ad[i]),
+			  "efloat64_array_copysign",
+			  efloat64_array_copysign(rd, bd, ad, Bench_len),
+			  Bench_out64);
+
+	return 0;
+}
@@ -0,0 +1,107 @@
+/* SPDX-License-Identifier: LGPL-2.1-or-later */
+/* bench-soft.c: the software arithmetic timed against the C operators */
+/* Copyright (C) 2026 Eric Herman */
+/* https://github.com/ericherman/libefloat */
+/*
+make bench-soft && ./bench-soft [rounds]
+
+On the host the C operators run on the FPU. Built for a target with no
+FPU (a Cortex-M0, an AVR) the same operators become calls into the
+compiler's soft-float runtime, libgcc or compiler-rt, so the one driver
+gives both comparisons.
+*/
+
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#include "efloat.h"
+#include "bench.h"
+
+static uint32_t a32[Bench_len], b32[Bench_len], c32[Bench_len];
+static uint32_t r32[Bench_len];
+static float af[Bench_len], bf[Bench_len], cf[Bench_len], rf[Bench_len];
+
+static uint64_t a64[Bench_len], b64[Bench_len], c64[Bench_len];
+static uint64_t r64[Bench_len];
+static double ad[Bench_len], bd[Bench_len], cd[Bench_len], rd[Bench_len];
+
+/* positive normal values within a few binades of 1 */
+static void bench_soft_inputs(void)
+{
+	uint64_t state;
+	size_t i;
+
+	state = 0x9E3779B97F4A7C15UL;
+	for (i = 0; i < Bench_len; ++i) {
+		a32[i] = 0x3C000000UL | (uint32_t)(bench_rng(&state) >> 37);
+		b32[i] = 0x3C000000UL | (uint32_t)(bench_rng(&state) >> 37);
+		c32[i] = 0x3C000000UL | (uint32_t)(bench_rng(&state) >> 37);
+		af[i] = uint32_bits_to_efloat32(a32[i]);
+		bf[i] = uint32_bits_to_efloat32(b32[i]);
+		cf[i] = uint32_bits_to_efloat32(c32[i]);
+
+		a64[i] = 0x3F80000000000000UL | (bench_rng(&state) >> 10);
+		b64[i] = 0x3F80000000000000UL | (bench_rng(&state) >> 10);
+		c64[i] = 0x3F80000000000000UL | (bench_rng(&state) >> 10);
+		ad[i] = uint64_bits_to_efloat64(a64[i]);
+		bd[i] = uint64_bits_to_efloat64(b64[i]);
+		cd[i] = uint64_bits_to_efloat64(c64[i]);
+	}
+}
+
+int main(int argc, char **argv)
+{
+	unsigned long rounds, r;
+	uint64_t check;
+	clock_t start;
+	size_t i, k;
+
+	rounds = bench_rounds(argc, argv, 20000);
+	bench_soft_inputs();
+	check = 0;
+
+	Bench_time("efloat32_soft_add", r32[i] =
+		   efloat32_soft_add(a32[i], b32[i]), r32[k]);
+	Bench_time("float +", rf[i] = af[i] + bf[i],
+		   efloat32_to_uint32_bits(rf[k]));
+	Bench_time("efloat32_soft_mul", r32[i] =
+		   efloat32_soft_mul(a32[i], b32[i]), r32[k]);
+	Bench_time("float *", rf[i] = af[i] * bf[i],
+		   efloat32_to_uint32_bits(rf[k]));
+	Bench_time("efloat32_soft_div", r32[i] =
+		   efloat32_soft_div(a32[i], b32[i]), r32[k]);
+	Bench_time("float /", rf[i] = af[i] / bf[i],
+		   efloat32_to_uint32_bits(rf[k]));
+	Bench_time("efloat32_soft_sqrt", r32[i] =
+		   efloat32_soft_sqrt(a32[i]), r32[k]);
+	Bench_time("sqrtf", rf[i] = sqrtf(af[i]),
+		   efloat32_to_uint32_bits(rf[k]));
+	Bench_time("efloat32_soft_fma", r32[i] =
+		   efloat32_soft_fma(a32[i], b32[i], c32[i]), r32[k]);
+	Bench_time("fmaf", rf[i] = fmaf(af[i], bf[i], cf[i]),
+		   efloat32_to_uint32_bits(rf[k]));
+
+	Bench_time("efloat64_soft_add", r64[i] =
+		   efloat64_soft_add(a64[i], b64[i]), r64[k]);
+	Bench_time("double +", rd[i] = ad[i] + bd[i],
+		   efloat64_to_uint64_bits(rd[k]));
+	Bench_time("efloat64_soft_mul", r64[i] =
+		   efloat64_soft_mul(a64[i], b64[i]), r64[k]);
+	Bench_time("double *", rd[i] = ad[i] * bd[i],
+		   efloat64_to_uint64_bits(rd[k]));
+	Bench_time("efloat64_soft_div", r64[i] =
+		   efloat64_soft_div(a64[i], b64[i]), r64[k]);
+	Bench_time("double /", rd[i] = ad[i] / bd[i],
+		   efloat64_to_uint64_bits(rd[k]));
+	Bench_time("efloat64_soft_sqrt", r64[i] =
+		   efloat64_soft_sqrt(a64[i]), r64[k]);
+	Bench_time("sqrt", rd[i] = sqrt(ad[i]),
+		   efloat64_to_uint64_bits(rd[k]));
+	Bench_time("efloat64_soft_fma", r64[i] =
+		   efloat64_soft_fma(a64[i], b64[i], c64[i]), r64[k]);
+	Bench_time("fma", rd[i] = fma(ad[i], bd[i], cd[i]),
+		   efloat64_to_uint64_bits(rd[k]));
+
+	return 0;
+}
@@ -0,0 +1,84 @@
+/* SPDX-License-Identifier: LGPL-2.1-or-later */
+/* bench.h: timing helpers shared by the demo benchmarks */
+/* Copyright (C) 2026 Eric Herman */
+/* https://github.com/ericherman/libefloat */
+
+#ifndef BENCH_H
+#define BENCH_H
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+/* the length of the input arrays, small enough to stay in the L1 cache */
+#define Bench_len 1024
+
+/* xorshift64; the state must not start at zero */
+static uint64_t bench_rng(uint64_t *state)
+{
+	*state ^= *state << 13;
+	*state ^= *state >> 7;
+	*state ^= *state << 17;
+	return *state;
+}
+
+/* the passes over the inputs: the first argument, if given, or "dflt" */
+static unsigned long bench_rounds(int argc, char **argv, unsigned long dflt)
+{
+	unsigned long rounds;
+
+	rounds = (argc > 1) ? strtoul(argv[1], NULL, 10) : 0;
+	return rounds ? rounds : dflt;
+}
+
+/*
+ Print the time since "start" for each of "rounds" times Bench_len
+ operations; "check" folds in some of the results, so that printing it
+ keeps the compiler from dropping the work, and two ways of computing
+ the same results print the same check.
+*/
+static void bench_report(const char *name, clock_t start,
+			 unsigned long rounds, uint64_t check)
+{
+	double secs;
+
+	secs = (double)(clock() - start) / CLOCKS_PER_SEC;
+	printf("%-36s %8.2f ns/op  (check %08lx)\n", name,
+	       secs * 1e9 / ((double)rounds * Bench_len),
+	       (unsigned long)(uint32_t)(check ^ (check >> 32)));
+}
+
+/*
+ Time "body", run for each "i" of the inputs, for each of the rounds;
+ "out" is a result at index "k", which changes from round to round.
+ Expects "start", "rounds", "r", "i", "k" and "check" in scope.
+*/
+#define Bench_time(name, body, out) \
+	do { \
+		check = 0; \
+		start = clock(); \
+		for (r = 0; r < rounds; ++r) { \
+			for (i = 0; i < Bench_len; ++i) { \
+				body; \
+			} \
+			k = r & (Bench_len - 1); \
+			check += (uint64_t)(out); \
+		} \
+		bench_report(name, start, rounds, check); \
+	} while (0)
+
+/* as Bench_time(), for a "call" which does all of the inputs at once */
+#define Bench_time_array(name, call, out) \
+	do { \
+		check = 0; \
+		start = clock(); \
+		for (r = 0; r < rounds; ++r) { \
+			call; \
+			k = r & (Bench_len - 1); \
+			check += (uint64_t)(out); \
+		} \
+		bench_report(name, start, rounds, check); \
+	} while (0)
+
+#endif /* BENCH_H */
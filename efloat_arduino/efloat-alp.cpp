@@ -0,0 +1 @@
+../src/efloat-alp.c
\ No newline at end of file
@@ -0,0 +1 @@
+../src/efloat-approx.c
\ No newline at end of file
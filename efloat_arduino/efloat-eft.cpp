@@ -0,0 +1 @@
+../src/efloat-eft.c
\ No newline at end of file
@@ -0,0 +1 @@
+../src/efloat-fixed.c
\ No newline at end of file
@@ -0,0 +1 @@
+../src/efloat-frexp.c
\ No newline at end of file
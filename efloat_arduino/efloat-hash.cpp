@@ -0,0 +1 @@
+../src/efloat-hash.c
\ No newline at end of file
@@ -0,0 +1 @@
+../src/efloat-histogram.c
\ No newline at end of file
@@ -0,0 +1 @@
+../src/efloat-internal.h
\ No newline at end of file
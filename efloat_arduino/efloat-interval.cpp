@@ -0,0 +1 @@
+../src/efloat-interval.c
\ No newline at end of file
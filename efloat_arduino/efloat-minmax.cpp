@@ -0,0 +1 @@
+../src/efloat-minmax.c
\ No newline at end of file
@@ -0,0 +1 @@
+../src/efloat-mx.c
\ No newline at end of file
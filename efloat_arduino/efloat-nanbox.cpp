@@ -0,0 +1 @@
+../src/efloat-nanbox.c
\ No newline at end of file
@@ -0,0 +1 @@
+../src/efloat-narrow.c
\ No newline at end of file
@@ -0,0 +1 @@
+../src/efloat-posit.c
\ No newline at end of file
@@ -0,0 +1 @@
+../src/efloat-profile.c
\ No newline at end of file
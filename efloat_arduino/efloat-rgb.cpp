@@ -0,0 +1 @@
+../src/efloat-rgb.c
\ No newline at end of file
@@ -0,0 +1 @@
+../src/efloat-round.c
\ No newline at end of file
@@ -0,0 +1 @@
+../src/efloat-sanitize.c
\ No newline at end of file
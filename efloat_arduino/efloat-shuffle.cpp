@@ -0,0 +1 @@
+../src/efloat-shuffle.c
\ No newline at end of file
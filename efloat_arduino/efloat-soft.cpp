@@ -0,0 +1 @@
+../src/efloat-soft.c
\ No newline at end of file
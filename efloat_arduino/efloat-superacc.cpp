@@ -0,0 +1 @@
+../src/efloat-superacc.c
\ No newline at end of file
@@ -0,0 +1 @@
+../src/efloat-trim.c
\ No newline at end of file
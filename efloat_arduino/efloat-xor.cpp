@@ -0,0 +1 @@
+../src/efloat-xor.c
\ No newline at end of file
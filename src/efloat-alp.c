@@ -0,0 +1,618 @@
+/* SPDX-License-Identifier: LGPL-2.1-or-later */
+/* efloat-alp.c: ALP style lossless compression of decimal-like floats */
+/* Copyright (C) 2026 Eric Herman */
+/* https://github.com/ericherman/libefloat */
+
+#include "efloat-internal.h"
+
+/*
+ stream:  magic:8 'A':8 width:8 0:8 count:32
+ vector:  count:16 e:8 f:8 bit_width:8 0:8 exceptions:16 base:64
+	  packed deltas, in whole little-endian 64 bit words
+	  exception positions, 16 bits each
+	  exception bit patterns, width bits each
+ All multi-byte fields are little-endian.
+*/
+#define Efloat_alp_header_len 8
+#define Efloat_alp_vector_header_len 16
+#define Efloat_alp_magic 0xEF
+#define Efloat_alp_kind 0x41
+#define Efloat_alp_samples 32
+#define Efloat_alp_max_e64 18
+#define Efloat_alp_max_e32 10
+
+/* the nearest values to 1e0 .. 1e10, and to 1e-0 .. 1e-10 */
+#if ((defined efloat32_exists) && (efloat32_exists))
+static const uint32_t efloat32_alp_f10[Efloat_alp_max_e32 + 1] = {
+	0x3F800000UL, 0x41200000UL, 0x42C80000UL, 0x447A0000UL,
+	0x461C4000UL, 0x47C35000UL, 0x49742400UL, 0x4B189680UL,
+	0x4CBEBC20UL, 0x4E6E6B28UL, 0x501502F9UL
+};
+
+static const uint32_t efloat32_alp_if10[Efloat_alp_max_e32 + 1] = {
+	0x3F800000UL, 0x3DCCCCCDUL, 0x3C23D70AUL, 0x3A83126FUL,
+	0x38D1B717UL, 0x3727C5ACUL, 0x358637BDUL, 0x33D6BF95UL,
+	0x322BCC77UL, 0x3089705FUL, 0x2EDBE6FFUL
+};
+#endif
+
+/* the nearest values to 1e0 .. 1e18, and to 1e-0 .. 1e-18 */
+#if ((defined efloat64_exists) && (efloat64_exists))
+static const uint64_t efloat64_alp_f10[Efloat_alp_max_e64 + 1] = {
+	0x3FF0000000000000UL, 0x4024000000000000UL, 0x4059000000000000UL,
+	0x408F400000000000UL, 0x40C3880000000000UL, 0x40F86A0000000000UL,
+	0x412E848000000000UL, 0x416312D000000000UL, 0x4197D78400000000UL,
+	0x41CDCD6500000000UL, 0x4202A05F20000000UL, 0x42374876E8000000UL,
+	0x426D1A94A2000000UL, 0x42A2309CE5400000UL, 0x42D6BCC41E900000UL,
+	0x430C6BF526340000UL, 0x4341C37937E08000UL, 0x4376345785D8A000UL,
+	0x43ABC16D674EC800UL
+};
+
+static const uint64_t efloat64_alp_if10[Efloat_alp_max_e64 + 1] = {
+	0x3FF0000000000000UL, 0x3FB999999999999AUL, 0x3F847AE147AE147BUL,
+	0x3F50624DD2F1A9FCUL, 0x3F1A36E2EB1C432DUL, 0x3EE4F8B588E368F1UL,
+	0x3EB0C6F7A0B5ED8DUL, 0x3E7AD7F29ABCAF48UL, 0x3E45798EE2308C3AUL,
+	0x3E112E0BE826D695UL, 0x3DDB7CDFD9D7BDBBUL, 0x3DA5FD7FE1796495UL,
+	0x3D719799812DEA11UL, 0x3D3C25C268497682UL, 0x3D06849B86A12B9BUL,
+	0x3CD203AF9EE75616UL, 0x3C9CD2B297D889BCUL, 0x3C670EF54646D497UL,
+	0x3C32725DD1D243ACUL
+};
+#endif
+
+static uint64_t efloat_alp_get(const uint8_t *p, unsigned bytes)
+{
+	uint64_t v;
+	unsigned i;
+
+	v = 0;
+	for (i = 0; i < bytes; ++i) {
+		v |= ((uint64_t)p[i]) << (8 * i);
+	}
+	return v;
+}
+
+static void efloat_alp_put(uint8_t *p, uint64_t v, unsigned bytes)
+{
+	unsigned i;
+
+	for (i = 0; i < bytes; ++i) {
+		p[i] = (uint8_t)(v >> (8 * i));
+	}
+}
+
+/*
+ The encoder and decoder must use exactly the same expression, the
+ encoder keeps only those values for which it reproduces the bits.
+ Values beyond max_int may not be rounded with the "magic number" trick.
+*/
+#if ((defined efloat32_exists) && (efloat32_exists))
+#define Efloat32_alp_max_int 4194304.0f	/* 2^22 */
+#define Efloat32_alp_round_magic 12582912.0f	/* 2^23 + 2^22 */
+
+static efloat32 efloat32_alp_decode_value(int64_t n, efloat32 f10,
+					  efloat32 if10)
+{
+	return ((efloat32)n) * f10 * if10;
+}
+
+/* returns 0 if "x" cannot be represented with this exponent and factor */
+static int efloat32_alp_encode_value(efloat32 x, efloat32 e10, efloat32 if10,
+				     int64_t *n)
+{
+	efloat32 scaled;
+
+	scaled = x * e10 * if10;
+	if (!(scaled > -Efloat32_alp_max_int
+	      && scaled < Efloat32_alp_max_int)) {
+		return 0;
+	}
+	*n = (int64_t)((scaled + Efloat32_alp_round_magic)
+		       - Efloat32_alp_round_magic);
+	return 1;
+}
+
+/*
+ Compute the integers and the bit patterns for a block; "ok" is set for
+ the values which round trip exactly.
+*/
+static void efloat32_alp_scale(const efloat32 *x, size_t len, unsigned e,
+			       unsigned f, int64_t *n, uint64_t *u, int *ok)
+{
+	efloat32 dd[Efloat_batch_len];
+	uint32_t u32[Efloat_batch_len], uu[Efloat_batch_len];
+	efloat32 e10, if10, f10, ie10;
+	size_t i;
+
+	e10 = uint32_bits_to_efloat32(efloat32_alp_f10[e]);
+	if10 = uint32_bits_to_efloat32(efloat32_alp_if10[f]);
+	f10 = uint32_bits_to_efloat32(efloat32_alp_f10[f]);
+	ie10 = uint32_bits_to_efloat32(efloat32_alp_if10[e]);
+
+	efloat32_array_to_uint32_bits(u32, x, len);
+	for (i = 0; i < len; ++i) {
+		ok[i] = efloat32_alp_encode_value(x[i], e10, if10, n + i);
+		if (!ok[i]) {
+			n[i] = 0;
+		}
+		dd[i] = efloat32_alp_decode_value(n[i], f10, ie10);
+	}
+	efloat32_array_to_uint32_bits(uu, dd, len);
+	for (i = 0; i < len; ++i) {
+		u[i] = u32[i];
+		ok[i] = ok[i] && (uu[i] == u32[i]);
+	}
+}
+
+static void efloat32_alp_unscale(efloat32 *out, const int64_t *n, size_t len,
+				 unsigned e, unsigned f)
+{
+	efloat32 f10, ie10;
+	size_t i;
+
+	f10 = uint32_bits_to_efloat32(efloat32_alp_f10[f]);
+	ie10 = uint32_bits_to_efloat32(efloat32_alp_if10[e]);
+	for (i = 0; i < len; ++i) {
+		out[i] = efloat32_alp_decode_value(n[i], f10, ie10);
+	}
+}
+#endif
+
+#if ((defined efloat64_exists) && (efloat64_exists))
+#define Efloat64_alp_max_int 2251799813685248.0	/* 2^51 */
+#define Efloat64_alp_round_magic 6755399441055744.0	/* 2^52 + 2^51 */
+
+static efloat64 efloat64_alp_decode_value(int64_t n, efloat64 f10,
+					  efloat64 if10)
+{
+	return ((efloat64)n) * f10 * if10;
+}
+
+/* returns 0 if "x" cannot be represented with this exponent and factor */
+static int efloat64_alp_encode_value(efloat64 x, efloat64 e10, efloat64 if10,
+				     int64_t *n)
+{
+	efloat64 scaled;
+
+	scaled = x * e10 * if10;
+	if (!(scaled > -Efloat64_alp_max_int
+	      && scaled < Efloat64_alp_max_int)) {
+		return 0;
+	}
+	*n = (int64_t)((scaled + Efloat64_alp_round_magic)
+		       - Efloat64_alp_round_magic);
+	return 1;
+}
+
+static void efloat64_alp_scale(const efloat64 *x, size_t len, unsigned e,
+			       unsigned f, int64_t *n, uint64_t *u, int *ok)
+{
+	efloat64 dd[Efloat_batch_len];
+	uint64_t uu[Efloat_batch_len];
+	efloat64 e10, if10, f10, ie10;
+	size_t i;
+
+	e10 = uint64_bits_to_efloat64(efloat64_alp_f10[e]);
+	if10 = uint64_bits_to_efloat64(efloat64_alp_if10[f]);
+	f10 = uint64_bits_to_efloat64(efloat64_alp_f10[f]);
+	ie10 = uint64_bits_to_efloat64(efloat64_alp_if10[e]);
+
+	efloat64_array_to_uint64_bits(u, x, len);
+	for (i = 0; i < len; ++i) {
+		ok[i] = efloat64_alp_encode_value(x[i], e10, if10, n + i);
+		if (!ok[i]) {
+			n[i] = 0;
+		}
+		dd[i] = efloat64_alp_decode_value(n[i], f10, ie10);
+	}
+	efloat64_array_to_uint64_bits(uu, dd, len);
+	for (i = 0; i < len; ++i) {
+		ok[i] = ok[i] && (uu[i] == u[i]);
+	}
+}
+
+static void efloat64_alp_unscale(efloat64 *out, const int64_t *n, size_t len,
+				 unsigned e, unsigned f)
+{
+	efloat64 f10, ie10;
+	size_t i;
+
+	f10 = uint64_bits_to_efloat64(efloat64_alp_f10[f]);
+	ie10 = uint64_bits_to_efloat64(efloat64_alp_if10[e]);
+	for (i = 0; i < len; ++i) {
+		out[i] = efloat64_alp_decode_value(n[i], f10, ie10);
+	}
+}
+#endif
+
+/* "len" values from "start", at most Efloat_batch_len */
+static void efloat_alp_block(const void *a, unsigned width, size_t start,
+			     size_t len, unsigned e, unsigned f, int64_t *n,
+			     uint64_t *u, int *ok)
+{
+#if ((defined efloat32_exists) && (efloat32_exists))
+	if (width == 32) {
+		efloat32_alp_scale(((const efloat32 *)a) + start, len, e, f,
+				   n, u, ok);
+		return;
+	}
+#endif
+#if ((defined efloat64_exists) && (efloat64_exists))
+	efloat64_alp_scale(((const efloat64 *)a) + start, len, e, f, n, u,
+			   ok);
+#endif
+}
+
+static void efloat_alp_unblock(void *out, unsigned width, size_t start,
+			       const int64_t *n, size_t len, unsigned e,
+			       unsigned f)
+{
+#if ((defined efloat32_exists) && (efloat32_exists))
+	if (width == 32) {
+		efloat32_alp_unscale(((efloat32 *)out) + start, n, len, e, f);
+		return;
+	}
+#endif
+#if ((defined efloat64_exists) && (efloat64_exists))
+	efloat64_alp_unscale(((efloat64 *)out) + start, n, len, e, f);
+#endif
+}
+
+static void efloat_alp_store_bits(void *out, unsigned width, size_t i,
+				  uint64_t u)
+{
+#if ((defined efloat32_exists) && (efloat32_exists))
+	if (width == 32) {
+		((efloat32 *)out)[i] = uint32_bits_to_efloat32((uint32_t)u);
+		return;
+	}
+#endif
+#if ((defined efloat64_exists) && (efloat64_exists))
+	((efloat64 *)out)[i] = uint64_bits_to_efloat64(u);
+#endif
+}
+
+static unsigned efloat_alp_bit_width(uint64_t range)
+{
+	return range ? (64 - Efloat_u64_clz(range)) : 0;
+}
+
+/* pick the exponent and factor which are cheapest for a sample */
+static void efloat_alp_choose(const void *a, unsigned width, size_t start,
+			      size_t len, unsigned *best_e, unsigned *best_f)
+{
+#if ((defined efloat32_exists) && (efloat32_exists))
+	efloat32 x32[Efloat_alp_samples];
+#endif
+#if ((defined efloat64_exists) && (efloat64_exists))
+	efloat64 x64[Efloat_alp_samples];
+#endif
+	const void *x;
+	uint64_t u[Efloat_alp_samples];
+	int64_t n[Efloat_alp_samples];
+	int ok[Efloat_alp_samples];
+	int64_t lo, hi;
+	size_t i, p, samples, exceptions, cost, best_cost;
+	unsigned e, f, max_e;
+	int have;
+
+	samples = (len < Efloat_alp_samples) ? len : Efloat_alp_samples;
+	x = a;
+#if ((defined efloat32_exists) && (efloat32_exists))
+	if (width == 32) {
+		for (i = 0; i < samples; ++i) {
+			p = start + ((i * len) / samples);
+			x32[i] = ((const efloat32 *)a)[p];
+		}
+		x = x32;
+	}
+#endif
+#if ((defined efloat64_exists) && (efloat64_exists))
+	if (width == 64) {
+		for (i = 0; i < samples; ++i) {
+			p = start + ((i * len) / samples);
+			x64[i] = ((const efloat64 *)a)[p];
+		}
+		x = x64;
+	}
+#endif
+
+	max_e = (width == 32) ? Efloat_alp_max_e32 : Efloat_alp_max_e64;
+	best_cost = (size_t)-1;
+	*best_e = 0;
+	*best_f = 0;
+	for (e = 0; e <= max_e; ++e) {
+		for (f = 0; f <= e; ++f) {
+			efloat_alp_block(x, width, 0, samples, e, f, n, u, ok);
+			exceptions = 0;
+			have = 0;
+			lo = 0;
+			hi = 0;
+			for (i = 0; i < samples; ++i) {
+				if (!ok[i]) {
+					++exceptions;
+				} else if (!have) {
+					have = 1;
+					lo = n[i];
+					hi = n[i];
+				} else {
+					lo = (n[i] < lo) ? n[i] : lo;
+					hi = (n[i] > hi) ? n[i] : hi;
+				}
+			}
+			cost = (exceptions * (16 + width))
+			    + ((samples - exceptions)
+			       * efloat_alp_bit_width((uint64_t)hi
+						      - (uint64_t)lo));
+			if (cost < best_cost) {
+				best_cost = cost;
+				*best_e = e;
+				*best_f = f;
+			}
+		}
+	}
+}
+
+/* returns the bytes written, or 0 if there is not enough room */
+static size_t efloat_alp_encode_vector(uint8_t *buf, size_t size,
+				       const void *a, unsigned width,
+				       size_t start, size_t len)
+{
+	int64_t n[Efloat_batch_len];
+	uint64_t u[Efloat_batch_len];
+	int ok[Efloat_batch_len];
+	int64_t lo, hi;
+	uint64_t v, acc;
+	size_t i, j, block, exceptions, words, need;
+	unsigned e, f, bw, acc_bits, spill, val_bytes;
+	uint8_t *w, *pos, *val;
+	int have;
+
+	efloat_alp_choose(a, width, start, len, &e, &f);
+
+	/* first pass: the frame of reference and the exception count */
+	exceptions = 0;
+	have = 0;
+	lo = 0;
+	hi = 0;
+	for (i = 0; i < len; i += block) {
+		block = (len - i < Efloat_batch_len) ? len - i
+		    : Efloat_batch_len;
+		efloat_alp_block(a, width, start + i, block, e, f, n, u,
+				 ok);
+		for (j = 0; j < block; ++j) {
+			if (!ok[j]) {
+				++exceptions;
+			} else if (!have) {
+				have = 1;
+				lo = n[j];
+				hi = n[j];
+			} else {
+				lo = (n[j] < lo) ? n[j] : lo;
+				hi = (n[j] > hi) ? n[j] : hi;
+			}
+		}
+	}
+
+	bw = efloat_alp_bit_width((uint64_t)hi - (uint64_t)lo);
+	words = ((len * bw) + 63) / 64;
+	val_bytes = width / 8;
+	need = Efloat_alp_vector_header_len + (words * 8)
+	    + (exceptions * (2 + val_bytes));
+	if (need > size) {
+		return 0;
+	}
+
+	efloat_alp_put(buf, len, 2);
+	buf[2] = (uint8_t)e;
+	buf[3] = (uint8_t)f;
+	buf[4] = (uint8_t)bw;
+	buf[5] = 0;
+	efloat_alp_put(buf + 6, exceptions, 2);
+	efloat_alp_put(buf + 8, (uint64_t)lo, 8);
+
+	/* second pass: pack the deltas, and list the exceptions */
+	w = buf + Efloat_alp_vector_header_len;
+	pos = w + (words * 8);
+	val = pos + (exceptions * 2);
+	acc = 0;
+	acc_bits = 0;
+	for (i = 0; i < len; i += block) {
+		block = (len - i < Efloat_batch_len) ? len - i
+		    : Efloat_batch_len;
+		efloat_alp_block(a, width, start + i, block, e, f, n, u,
+				 ok);
+		for (j = 0; j < block; ++j) {
+			if (!ok[j]) {
+				efloat_alp_put(pos, i + j, 2);
+				pos += 2;
+				efloat_alp_put(val, u[j], val_bytes);
+				val += val_bytes;
+				n[j] = lo;
+			}
+		}
+		if (bw == 0) {
+			continue;
+		}
+		for (j = 0; j < block; ++j) {
+			v = (uint64_t)n[j] - (uint64_t)lo;
+			acc |= v << acc_bits;
+			if (acc_bits + bw >= 64) {
+				efloat_alp_put(w, acc, 8);
+				w += 8;
+				spill = 64 - acc_bits;
+				acc = (spill < 64) ? (v >> spill) : 0;
+				acc_bits = acc_bits + bw - 64;
+			} else {
+				acc_bits += bw;
+			}
+		}
+	}
+	if (acc_bits) {
+		efloat_alp_put(w, acc, 8);
+	}
+	return need;
+}
+
+static size_t efloat_alp_encode(uint8_t *buf, size_t size, const void *a,
+				unsigned width, size_t len)
+{
+	size_t i, n, used, pos;
+
+	if (!buf || (!a && len) || (size < Efloat_alp_header_len)
+	    || (len > UINT32_MAX)) {
+		Efloat_set_err_inval();
+		return 0;
+	}
+	buf[0] = Efloat_alp_magic;
+	buf[1] = Efloat_alp_kind;
+	buf[2] = (uint8_t)width;
+	buf[3] = 0;
+	efloat_alp_put(buf + 4, len, 4);
+
+	pos = Efloat_alp_header_len;
+	for (i = 0; i < len; i += n) {
+		n = (len - i < efloat_alp_vector_len) ? len - i
+		    : efloat_alp_vector_len;
+		used = efloat_alp_encode_vector(buf + pos, size - pos, a,
+						width, i, n);
+		if (!used) {
+			Efloat_set_err_inval();
+			return 0;
+		}
+		pos += used;
+	}
+	return pos;
+}
+
+/* returns the bytes read, or 0 if the vector is damaged */
+static size_t efloat_alp_decode_vector(void *out, unsigned width,
+				       size_t start, size_t len,
+				       const uint8_t *buf, size_t size)
+{
+	int64_t n[Efloat_batch_len];
+	int64_t lo;
+	uint64_t v, mask;
+	size_t i, j, k, block, bit, exceptions, words, need, p;
+	unsigned e, f, bw, off, val_bytes, max_e;
+	const uint8_t *w, *pos, *val;
+
+	if (size < Efloat_alp_vector_header_len
+	    || efloat_alp_get(buf, 2) != len) {
+		return 0;
+	}
+	e = buf[2];
+	f = buf[3];
+	bw = buf[4];
+	exceptions = (size_t)efloat_alp_get(buf + 6, 2);
+	lo = (int64_t)efloat_alp_get(buf + 8, 8);
+	max_e = (width == 32) ? Efloat_alp_max_e32 : Efloat_alp_max_e64;
+	if (e > max_e || f > e || bw > 64 || exceptions > len) {
+		return 0;
+	}
+	words = ((len * bw) + 63) / 64;
+	val_bytes = width / 8;
+	need = Efloat_alp_vector_header_len + (words * 8)
+	    + (exceptions * (2 + val_bytes));
+	if (need > size) {
+		return 0;
+	}
+
+	mask = (bw == 64) ? UINT64_MAX : ((((uint64_t)1) << bw) - 1);
+	w = buf + Efloat_alp_vector_header_len;
+	for (i = 0; i < len; i += block) {
+		block = (len - i < Efloat_batch_len) ? len - i
+		    : Efloat_batch_len;
+		for (j = 0; j < block; ++j) {
+			v = 0;
+			if (bw) {
+				bit = (i + j) * bw;
+				k = bit / 64;
+				off = (unsigned)(bit % 64);
+				v = efloat_alp_get(w + (k * 8), 8) >> off;
+				if (off + bw > 64) {
+					v |= efloat_alp_get(w + ((k + 1) * 8),
+							    8) << (64 - off);
+				}
+			}
+			n[j] = (int64_t)((uint64_t)lo + (v & mask));
+		}
+		efloat_alp_unblock(out, width, start + i, n, block, e, f);
+	}
+
+	pos = w + (words * 8);
+	val = pos + (exceptions * 2);
+	for (i = 0; i < exceptions; ++i) {
+		p = (size_t)efloat_alp_get(pos + (i * 2), 2);
+		if (p >= len) {
+			return 0;
+		}
+		efloat_alp_store_bits(out, width, start + p,
+				      efloat_alp_get(val + (i * val_bytes),
+						     val_bytes));
+	}
+	return need;
+}
+
+size_t efloat_alp_count(const uint8_t *buf, size_t size)
+{
+	if (!buf || size < Efloat_alp_header_len
+	    || buf[0] != Efloat_alp_magic || buf[1] != Efloat_alp_kind) {
+		Efloat_set_err_inval();
+		return 0;
+	}
+	return (size_t)efloat_alp_get(buf + 4, 4);
+}
+
+static size_t efloat_alp_decode(void *out, unsigned width, size_t len,
+				const uint8_t *buf, size_t size)
+{
+	size_t count, i, n, used, pos;
+
+	count = efloat_alp_count(buf, size);
+	if (!buf || size < Efloat_alp_header_len || buf[2] != width
+	    || count > len || (!out && count)) {
+		Efloat_set_err_inval();
+		return 0;
+	}
+	pos = Efloat_alp_header_len;
+	for (i = 0; i < count; i += n) {
+		n = (count - i < efloat_alp_vector_len) ? count - i
+		    : efloat_alp_vector_len;
+		used = efloat_alp_decode_vector(out, width, i, n, buf + pos,
+						size - pos);
+		if (!used) {
+			Efloat_set_err_inval();
+			return 0;
+		}
+		pos += used;
+	}
+	return count;
+}
+
+#if ((defined efloat32_exists) && (efloat32_exists))
+size_t efloat32_alp_encode(uint8_t *buf, size_t size, const efloat32 *a,
+			   size_t len)
+{
+	return efloat_alp_encode(buf, size, a, 32, len);
+}
+
+size_t efloat32_alp_decode(efloat32 *out, size_t len, const uint8_t *buf,
+			   size_t size)
+{
+	return efloat_alp_decode(out, 32, len, buf, size);
+}
+#endif
+
+#if ((defined efloat64_exists) && (efloat64_exists))
+size_t efloat64_alp_encode(uint8_t *buf, size_t size, const efloat64 *a,
+			   size_t len)
+{
+	return efloat_alp_encode(buf, size, a, 64, len);
+}
+
+size_t efloat64_alp_decode(efloat64 *out, size_t len, const uint8_t *buf,
+			   size_t size)
+{
+	return efloat_alp_decode(out, 64, len, buf, size);
+}
+#endif
@@ -0,0 +1,488 @@
+/* SPDX-License-Identifier: LGPL-2.1-or-later */
+/* efloat-approx.c: fast approximate log2, exp2 and 1/sqrt */
+/* Copyright (C) 2026 Eric Herman */
+/* https://github.com/ericherman/libefloat */
+
+#include "efloat-internal.h"
+
+/*
+ log2(x) is the exponent field plus log2(m) of the significand m, taken
+ into [sqrt(1/2), sqrt(2)), where with t = (m - 1) / (m + 1),
+ log2(m) = 2/ln(2) * (t + t^3/3 + t^5/5 + ...); the tiers keep more
+ terms. exp2(x) is 2^n for the nearest integer n, put straight into the
+ exponent field, times the Taylor series of 2^f for |f| <= 1/2.
+ 1/sqrt(x) starts from the "magic constant" guess on the bit pattern,
+ followed by Newton steps; each roughly squares the relative error.
+*/
+static int efloat_approx_tier_ok(enum efloat_approx_tier tier)
+{
+	if ((unsigned)tier > ef_approx_fine) {
+		Efloat_set_err_inval();
+		return 0;
+	}
+	return 1;
+}
+
+#if ((defined efloat32_exists) && (efloat32_exists))
+#define Efloat32_one_bits 0x3F800000UL
+#define Efloat32_sqrt2_signif 0x003504F3UL
+#define Efloat32_rsqrt_magic 0x5F375A86UL
+
+/* the count of terms, or of Newton steps, of each tier */
+static const unsigned efloat32_log2_terms[] = { 2, 4, 5 };
+static const unsigned efloat32_exp2_terms[] = { 4, 7, 8 };
+static const unsigned efloat32_rsqrt_steps[] = { 1, 2, 3 };
+
+/* 2 / (ln(2) * (2k - 1)), and ln(2)^k / k!, enough for the fine tier */
+static const efloat32 efloat32_approx_log2_coef[] = {
+	2.88539f, 0.9617967f, 0.57707804f, 0.41219857f, 0.3205989f
+};
+
+static const efloat32 efloat32_approx_exp2_coef[] = {
+	1.0f, 0.6931472f, 0.2402265f, 0.05550411f, 0.009618129f,
+	0.0013333558f, 1.540353e-4f, 1.5252734e-5f
+};
+
+static efloat32 efloat32_approx_log2_bits(uint32_t u, unsigned terms)
+{
+	uint32_t mag, signif;
+	efloat32 m, t, t2, p;
+	unsigned shift, k;
+	long e;
+
+	mag = u & ~efloat32_r2_sign_mask;
+	if (mag > efloat32_r2_rexp_mask) {
+		return uint32_bits_to_efloat32(u | Efloat32_quiet_bit);
+	}
+	if (mag == 0) {
+		return uint32_bits_to_efloat32(efloat32_r2_sign_mask
+					       | efloat32_r2_rexp_mask);
+	}
+	if (u & efloat32_r2_sign_mask) {
+		return uint32_bits_to_efloat32(efloat32_canonical_nan_bits);
+	}
+	if (mag == efloat32_r2_rexp_mask) {
+		return uint32_bits_to_efloat32(mag);
+	}
+	signif = u & efloat32_r2_signif_mask;
+	e = (long)(u >> efloat32_r2_exp_shift) - efloat32_r2_exp_max;
+	if (e == -efloat32_r2_exp_max) {
+		shift = Efloat_u64_clz(signif) - (64 - efloat32_mant_dig);
+		signif = (signif << shift) & efloat32_r2_signif_mask;
+		e = 1 - (long)shift - efloat32_r2_exp_max;
+	}
+	if (signif > Efloat32_sqrt2_signif) {
+		/* m in [sqrt(1/2), 1) */
+		m = uint32_bits_to_efloat32((Efloat32_one_bits
+					     - (((uint32_t)1)
+						<< efloat32_r2_exp_shift))
+					    | signif);
+		++e;
+	} else {
+		m = uint32_bits_to_efloat32(Efloat32_one_bits | signif);
+	}
+	t = (m - 1.0f) / (m + 1.0f);
+	t2 = t * t;
+	p = efloat32_approx_log2_coef[terms - 1];
+	for (k = terms - 1; k > 0; --k) {
+		p = p * t2 + efloat32_approx_log2_coef[k - 1];
+	}
+	return (efloat32)e + t * p;
+}
+
+static efloat32 efloat32_approx_exp2_value(efloat32 x, unsigned terms)
+{
+	uint32_t u;
+	efloat32 f, p;
+	unsigned k;
+	long n;
+
+	u = efloat32_to_uint32_bits(x);
+	if ((u & ~efloat32_r2_sign_mask) > efloat32_r2_rexp_mask) {
+		return uint32_bits_to_efloat32(u | Efloat32_quiet_bit);
+	}
+	/* past these, the result is inf or 0 in any case */
+	x = (x > 200.0f) ? 200.0f : x;
+	x = (x < -200.0f) ? -200.0f : x;
+	n = (long)x;
+	f = x - (efloat32)n;
+	if (f > 0.5f) {
+		++n;
+		f -= 1.0f;
+	} else if (f < -0.5f) {
+		--n;
+		f += 1.0f;
+	}
+	p = efloat32_approx_exp2_coef[terms - 1];
+	for (k = terms - 1; k > 0; --k) {
+		p = p * f + efloat32_approx_exp2_coef[k - 1];
+	}
+	/* p is in [0.7, 1.42], thus its exponent is 0 or -1 */
+	if (n > -efloat32_r2_exp_max + 1 && n < efloat32_r2_exp_max) {
+		u = efloat32_to_uint32_bits(p);
+		u += (uint32_t)n << efloat32_r2_exp_shift;
+		return uint32_bits_to_efloat32(u);
+	}
+	return efloat32_ldexp(p, (int)n);
+}
+
+static efloat32 efloat32_approx_rsqrt_bits(uint32_t u, unsigned steps)
+{
+	uint32_t mag;
+	efloat32 x, half, y, scale;
+	unsigned k;
+
+	mag = u & ~efloat32_r2_sign_mask;
+	if (mag > efloat32_r2_rexp_mask) {
+		return uint32_bits_to_efloat32(u | Efloat32_quiet_bit);
+	}
+	if (mag == 0) {
+		return uint32_bits_to_efloat32(u | efloat32_r2_rexp_mask);
+	}
+	if (u & efloat32_r2_sign_mask) {
+		return uint32_bits_to_efloat32(efloat32_canonical_nan_bits);
+	}
+	if (mag == efloat32_r2_rexp_mask) {
+		return 0.0f;
+	}
+	scale = 1.0f;
+	if (mag <= efloat32_r2_signif_mask) {
+		/* a subnormal, scaled by 2^24 to be normal */
+		u = efloat32_to_uint32_bits(uint32_bits_to_efloat32(u)
+					    * 16777216.0f);
+		scale = 4096.0f;
+	}
+	x = uint32_bits_to_efloat32(u);
+	half = 0.5f * x;
+	y = uint32_bits_to_efloat32(Efloat32_rsqrt_magic - (u >> 1));
+	for (k = 0; k < steps; ++k) {
+		y = y * (1.5f - half * y * y);
+	}
+	return y * scale;
+}
+
+efloat32 efloat32_approx_log2(efloat32 f, enum efloat_approx_tier tier)
+{
+	if (!efloat_approx_tier_ok(tier)) {
+		return uint32_bits_to_efloat32(efloat32_canonical_nan_bits);
+	}
+	return efloat32_approx_log2_bits(efloat32_to_uint32_bits(f),
+					 efloat32_log2_terms[tier]);
+}
+
+efloat32 efloat32_approx_exp2(efloat32 f, enum efloat_approx_tier tier)
+{
+	if (!efloat_approx_tier_ok(tier)) {
+		return uint32_bits_to_efloat32(efloat32_canonical_nan_bits);
+	}
+	return efloat32_approx_exp2_value(f, efloat32_exp2_terms[tier]);
+}
+
+efloat32 efloat32_approx_rsqrt(efloat32 f, enum efloat_approx_tier tier)
+{
+	if (!efloat_approx_tier_ok(tier)) {
+		return uint32_bits_to_efloat32(efloat32_canonical_nan_bits);
+	}
+	return efloat32_approx_rsqrt_bits(efloat32_to_uint32_bits(f),
+					  efloat32_rsqrt_steps[tier]);
+}
+
+void efloat32_array_approx_log2(efloat32 *dst, const efloat32 *src,
+				size_t len, enum efloat_approx_tier tier)
+{
+	uint32_t bits[Efloat_batch_len];
+	unsigned terms;
+	size_t i, j, n;
+
+	if (!efloat_approx_tier_ok(tier)) {
+		return;
+	}
+	terms = efloat32_log2_terms[tier];
+	for (i = 0; i < len; i += n) {
+		n = (len - i > Efloat_batch_len) ? Efloat_batch_len : len - i;
+		efloat32_array_to_uint32_bits(bits, src + i, n);
+		for (j = 0; j < n; ++j) {
+			dst[i + j] = efloat32_approx_log2_bits(bits[j], terms);
+		}
+	}
+}
+
+void efloat32_array_approx_exp2(efloat32 *dst, const efloat32 *src,
+				size_t len, enum efloat_approx_tier tier)
+{
+	unsigned terms;
+	size_t i;
+
+	if (!efloat_approx_tier_ok(tier)) {
+		return;
+	}
+	terms = efloat32_exp2_terms[tier];
+	for (i = 0; i < len; ++i) {
+		dst[i] = efloat32_approx_exp2_value(src[i], terms);
+	}
+}
+
+void efloat32_array_approx_rsqrt(efloat32 *dst, const efloat32 *src,
+				 size_t len, enum efloat_approx_tier tier)
+{
+	uint32_t bits[Efloat_batch_len];
+	unsigned steps;
+	size_t i, j, n;
+
+	if (!efloat_approx_tier_ok(tier)) {
+		return;
+	}
+	steps = efloat32_rsqrt_steps[tier];
+	for (i = 0; i < len; i += n) {
+		n = (len - i > Efloat_batch_len) ? Efloat_batch_len : len - i;
+		efloat32_array_to_uint32_bits(bits, src + i, n);
+		for (j = 0; j < n; ++j) {
+			dst[i + j] = efloat32_approx_rsqrt_bits(bits[j], steps);
+		}
+	}
+}
+#endif
+
+#if ((defined efloat64_exists) && (efloat64_exists))
+#define Efloat64_one_bits 0x3FF0000000000000UL
+#define Efloat64_sqrt2_signif 0x0006A09E667F3BCDUL
+#define Efloat64_rsqrt_magic 0x5FE6EB50C7B537A9UL
+
+/* the count of terms, or of Newton steps, of each tier */
+static const unsigned efloat64_log2_terms[] = { 2, 4, 10 };
+static const unsigned efloat64_exp2_terms[] = { 4, 7, 14 };
+static const unsigned efloat64_rsqrt_steps[] = { 1, 2, 4 };
+
+/*
+ as for efloat32, with long double literals, so that each is exactly the
+ nearest binary64 value whichever type efloat64 is
+*/
+static const efloat64 efloat64_approx_log2_coef[] = {
+	2.88539008177792677401L,
+	0.961796693925975554329L,
+	0.577078016355585310393L,
+	0.412198583111132388357L,
+	0.320598897975325203280L,
+	0.262308189252538792591L,
+	0.221953083213686674924L,
+	0.192359338785195121968L,
+	0.169728828339878040632L,
+	0.151862635883048768815L
+};
+
+static const efloat64 efloat64_approx_exp2_coef[] = {
+	1.0L,
+	0.693147180559945286227L,
+	0.240226506959100694072L,
+	0.0555041086648215761801L,
+	0.00961812910762847687873L,
+	0.00133335581464284411157L,
+	1.54035303933816060656e-4L,
+	1.52527338040598376946e-5L,
+	1.32154867901443052734e-6L,
+	1.01780860092396959520e-7L,
+	7.05491162080112087744e-9L,
+	4.44553827187081007394e-10L,
+	2.56784359934881958182e-11L,
+	1.36914888539041240648e-12L
+};
+
+static efloat64 efloat64_approx_log2_bits(uint64_t u, unsigned terms)
+{
+	uint64_t mag, signif;
+	efloat64 m, t, t2, p;
+	unsigned shift, k;
+	long e;
+
+	mag = u & ~efloat64_r2_sign_mask;
+	if (mag > efloat64_r2_rexp_mask) {
+		return uint64_bits_to_efloat64(u | Efloat64_quiet_bit);
+	}
+	if (mag == 0) {
+		return uint64_bits_to_efloat64(efloat64_r2_sign_mask
+					       | efloat64_r2_rexp_mask);
+	}
+	if (u & efloat64_r2_sign_mask) {
+		return uint64_bits_to_efloat64(efloat64_canonical_nan_bits);
+	}
+	if (mag == efloat64_r2_rexp_mask) {
+		return uint64_bits_to_efloat64(mag);
+	}
+	signif = u & efloat64_r2_signif_mask;
+	e = (long)(u >> efloat64_r2_exp_shift) - efloat64_r2_exp_max;
+	if (e == -efloat64_r2_exp_max) {
+		shift = Efloat_u64_clz(signif) - (64 - efloat64_mant_dig);
+		signif = (signif << shift) & efloat64_r2_signif_mask;
+		e = 1 - (long)shift - efloat64_r2_exp_max;
+	}
+	if (signif > Efloat64_sqrt2_signif) {
+		/* m in [sqrt(1/2), 1) */
+		m = uint64_bits_to_efloat64((Efloat64_one_bits
+					     - (((uint64_t)1)
+						<< efloat64_r2_exp_shift))
+					    | signif);
+		++e;
+	} else {
+		m = uint64_bits_to_efloat64(Efloat64_one_bits | signif);
+	}
+	t = (m - 1.0) / (m + 1.0);
+	t2 = t * t;
+	p = efloat64_approx_log2_coef[terms - 1];
+	for (k = terms - 1; k > 0; --k) {
+		p = p * t2 + efloat64_approx_log2_coef[k - 1];
+	}
+	return (efloat64)e + t * p;
+}
+
+static efloat64 efloat64_approx_exp2_value(efloat64 x, unsigned terms)
+{
+	uint64_t u;
+	efloat64 f, p;
+	unsigned k;
+	long n;
+
+	u = efloat64_to_uint64_bits(x);
+	if ((u & ~efloat64_r2_sign_mask) > efloat64_r2_rexp_mask) {
+		return uint64_bits_to_efloat64(u | Efloat64_quiet_bit);
+	}
+	/* past these, the result is inf or 0 in any case */
+	x = (x > 1100.0) ? 1100.0 : x;
+	x = (x < -1100.0) ? -1100.0 : x;
+	n = (long)x;
+	f = x - (efloat64)n;
+	if (f > 0.5) {
+		++n;
+		f -= 1.0;
+	} else if (f < -0.5) {
+		--n;
+		f += 1.0;
+	}
+	p = efloat64_approx_exp2_coef[terms - 1];
+	for (k = terms - 1; k > 0; --k) {
+		p = p * f + efloat64_approx_exp2_coef[k - 1];
+	}
+	/* p is in [0.7, 1.42], thus its exponent is 0 or -1 */
+	if (n > -efloat64_r2_exp_max + 1 && n < efloat64_r2_exp_max) {
+		u = efloat64_to_uint64_bits(p);
+		u += (uint64_t)n << efloat64_r2_exp_shift;
+		return uint64_bits_to_efloat64(u);
+	}
+	return efloat64_ldexp(p, (int)n);
+}
+
+static efloat64 efloat64_approx_rsqrt_bits(uint64_t u, unsigned steps)
+{
+	uint64_t mag;
+	efloat64 x, half, y, scale;
+	unsigned k;
+
+	mag = u & ~efloat64_r2_sign_mask;
+	if (mag > efloat64_r2_rexp_mask) {
+		return uint64_bits_to_efloat64(u | Efloat64_quiet_bit);
+	}
+	if (mag == 0) {
+		return uint64_bits_to_efloat64(u | efloat64_r2_rexp_mask);
+	}
+	if (u & efloat64_r2_sign_mask) {
+		return uint64_bits_to_efloat64(efloat64_canonical_nan_bits);
+	}
+	if (mag == efloat64_r2_rexp_mask) {
+		return 0.0;
+	}
+	scale = 1.0;
+	if (mag <= efloat64_r2_signif_mask) {
+		/* a subnormal, scaled by 2^54 to be normal */
+		u = efloat64_to_uint64_bits(uint64_bits_to_efloat64(u)
+					    * 18014398509481984.0);
+		scale = 134217728.0;
+	}
+	x = uint64_bits_to_efloat64(u);
+	half = 0.5 * x;
+	y = uint64_bits_to_efloat64(Efloat64_rsqrt_magic - (u >> 1));
+	for (k = 0; k < steps; ++k) {
+		y = y * (1.5 - half * y * y);
+	}
+	return y * scale;
+}
+
+efloat64 efloat64_approx_log2(efloat64 d, enum efloat_approx_tier tier)
+{
+	if (!efloat_approx_tier_ok(tier)) {
+		return uint64_bits_to_efloat64(efloat64_canonical_nan_bits);
+	}
+	return efloat64_approx_log2_bits(efloat64_to_uint64_bits(d),
+					 efloat64_log2_terms[tier]);
+}
+
+efloat64 efloat64_approx_exp2(efloat64 d, enum efloat_approx_tier tier)
+{
+	if (!efloat_approx_tier_ok(tier)) {
+		return uint64_bits_to_efloat64(efloat64_canonical_nan_bits);
+	}
+	return efloat64_approx_exp2_value(d, efloat64_exp2_terms[tier]);
+}
+
+efloat64 efloat64_approx_rsqrt(efloat64 d, enum efloat_approx_tier tier)
+{
+	if (!efloat_approx_tier_ok(tier)) {
+		return uint64_bits_to_efloat64(efloat64_canonical_nan_bits);
+	}
+	return efloat64_approx_rsqrt_bits(efloat64_to_uint64_bits(d),
+					  efloat64_rsqrt_steps[tier]);
+}
+
+void efloat64_array_approx_log2(efloat64 *dst, const efloat64 *src,
+				size_t len, enum efloat_approx_tier tier)
+{
+	uint64_t bits[Efloat_batch_len];
+	unsigned terms;
+	size_t i, j, n;
+
+	if (!efloat_approx_tier_ok(tier)) {
+		return;
+	}
+	terms = efloat64_log2_terms[tier];
+	for (i = 0; i < len; i += n) {
+		n = (len - i > Efloat_batch_len) ? Efloat_batch_len : len - i;
+		efloat64_array_to_uint64_bits(bits, src + i, n);
+		for (j = 0; j < n; ++j) {
+			dst[i + j] = efloat64_approx_log2_bits(bits[j], terms);
+		}
+	}
+}
+
+void efloat64_array_approx_exp2(efloat64 *dst, const efloat64 *src,
+				size_t len, enum efloat_approx_tier tier)
+{
+	unsigned terms;
+	size_t i;
+
+	if (!efloat_approx_tier_ok(tier)) {
+		return;
+	}
+	terms = efloat64_exp2_terms[tier];
+	for (i = 0; i < len; ++i) {
+		dst[i] = efloat64_approx_exp2_value(src[i], terms);
+	}
+}
+
+void efloat64_array_approx_rsqrt(efloat64 *dst, const efloat64 *src,
+				 size_t len, enum efloat_approx_tier tier)
+{
+	uint64_t bits[Efloat_batch_len];
+	unsigned steps;
+	size_t i, j, n;
+
+	if (!efloat_approx_tier_ok(tier)) {
+		return;
+	}
+	steps = efloat64_rsqrt_steps[tier];
+	for (i = 0; i < len; i += n) {
+		n = (len - i > Efloat_batch_len) ? Efloat_batch_len : len - i;
+		efloat64_array_to_uint64_bits(bits, src + i, n);
+		for (j = 0; j < n; ++j) {
+			dst[i + j] = efloat64_approx_rsqrt_bits(bits[j], steps);
+		}
+	}
+}
+#endif
@@ -0,0 +1,496 @@
+/* SPDX-License-Identifier: LGPL-2.1-or-later */
+/* efloat-eft.c: error-free transformations and double-double arithmetic */
+/* Copyright (C) 2026 Eric Herman */
+/* https://github.com/ericherman/libefloat */
+
+#include "efloat-internal.h"
+
+/*
+ The transformations are those of Dekker, Knuth and Moller; the pair
+ arithmetic follows Joldes, Muller and Popescu, "Tight and rigorous error
+ bounds for basic building blocks of double-word arithmetic" (2017):
+ AccurateDWPlusDW, DWTimesDW1, DWDivDW2, without an fma. Each depends
+ on every operation being rounded once to the format, so a compiler
+ must neither keep wider intermediates nor contract a * b + c into an
+ fma.
+
+ Dekker's product splits each operand into halves with Veltkamp's
+ method; that overflows for the largest exponents, and the error of a
+ product is not exact if it falls below the subnormals, so the exponent
+ fields are checked first and the rare product outside the safe range
+ takes its error from the software fma instead.
+*/
+
+/* inf - inf and NaN - NaN are NaN */
+#define Efloat_eft_is_finite(x) (((x) - (x)) == 0)
+
+#if ((defined efloat32_exists) && (efloat32_exists))
+/* 2^12 + 1, splitting 24 bits into two halves of 12 */
+#define Efloat32_veltkamp 4097.0f
+#define Efloat32_eft_rexp(f) \
+	((long)((efloat32_to_uint32_bits(f) & efloat32_r2_rexp_mask) \
+		>> efloat32_r2_exp_shift))
+
+static int efloat32_eft_split_safe(efloat32 a, efloat32 b)
+{
+	long ea, eb, ep;
+
+	ea = Efloat32_eft_rexp(a);
+	eb = Efloat32_eft_rexp(b);
+	/* no subnormal, or split which overflows */
+	if (ea == 0 || eb == 0 || ea > 2 * efloat32_r2_exp_max - 14
+	    || eb > 2 * efloat32_r2_exp_max - 14) {
+		return 0;
+	}
+	/* a product well clear of overflow, with an error above subnormal */
+	ep = ea + eb - 2 * efloat32_r2_exp_max;
+	return ep > 2 * efloat32_mant_dig + 3 - efloat32_r2_exp_max
+	    && ep < efloat32_r2_exp_max - 4;
+}
+
+static void efloat32_eft_split(efloat32 a, efloat32 *hi, efloat32 *lo)
+{
+	efloat32 c;
+
+	c = Efloat32_veltkamp * a;
+	*hi = c - (c - a);
+	*lo = a - *hi;
+}
+
+efloat32 efloat32_fast_two_sum(efloat32 a, efloat32 b, efloat32 *err)
+{
+	efloat32 s;
+
+	s = a + b;
+	*err = Efloat_eft_is_finite(s) ? (b - (s - a)) : 0.0f;
+	return s;
+}
+
+efloat32 efloat32_two_sum(efloat32 a, efloat32 b, efloat32 *err)
+{
+	efloat32 s, a1, b1;
+
+	s = a + b;
+	if (!Efloat_eft_is_finite(s)) {
+		*err = 0.0f;
+		return s;
+	}
+	b1 = s - a;
+	a1 = s - b1;
+	*err = (a - a1) + (b - b1);
+	return s;
+}
+
+efloat32 efloat32_two_prod(efloat32 a, efloat32 b, efloat32 *err)
+{
+	efloat32 p, ah, al, bh, bl;
+
+	p = a * b;
+	if (!Efloat_eft_is_finite(p) || p == 0.0f) {
+		*err = 0.0f;
+		return p;
+	}
+	if (!efloat32_eft_split_safe(a, b)) {
+		*err = uint32_bits_to_efloat32(efloat32_soft_fma
+					       (efloat32_to_uint32_bits(a),
+						efloat32_to_uint32_bits(b),
+						efloat32_to_uint32_bits(-p)));
+		return p;
+	}
+	efloat32_eft_split(a, &ah, &al);
+	efloat32_eft_split(b, &bh, &bl);
+	*err = ((ah * bh - p) + ah * bl + al * bh) + al * bl;
+	return p;
+}
+
+static struct efloat32_pair efloat32_pair_make(efloat32 hi, efloat32 lo)
+{
+	struct efloat32_pair z;
+
+	z.hi = hi;
+	z.lo = lo;
+	return z;
+}
+
+struct efloat32_pair efloat32_pair_add(struct efloat32_pair x,
+				       struct efloat32_pair y)
+{
+	efloat32 sh, sl, th, tl, c, vh, vl, w, zh, zl;
+
+	sh = efloat32_two_sum(x.hi, y.hi, &sl);
+	if (!Efloat_eft_is_finite(sh)) {
+		return efloat32_pair_make(sh, 0.0f);
+	}
+	th = efloat32_two_sum(x.lo, y.lo, &tl);
+	c = sl + th;
+	vh = efloat32_fast_two_sum(sh, c, &vl);
+	w = tl + vl;
+	zh = efloat32_fast_two_sum(vh, w, &zl);
+	return efloat32_pair_make(zh, zl);
+}
+
+struct efloat32_pair efloat32_pair_mul(struct efloat32_pair x,
+				       struct efloat32_pair y)
+{
+	efloat32 ch, cl1, cl2, cl3, zh, zl;
+
+	ch = efloat32_two_prod(x.hi, y.hi, &cl1);
+	if (!Efloat_eft_is_finite(ch) || ch == 0.0f) {
+		return efloat32_pair_make(ch, 0.0f);
+	}
+	cl2 = x.hi * y.lo + x.lo * y.hi;
+	cl3 = cl1 + cl2;
+	zh = efloat32_fast_two_sum(ch, cl3, &zl);
+	return efloat32_pair_make(zh, zl);
+}
+
+struct efloat32_pair efloat32_pair_div(struct efloat32_pair x,
+				       struct efloat32_pair y)
+{
+	efloat32 th, ch, cl1, cl2, t2h, tl1, tl2, rh, rl, ph, pl, dh, dl, d;
+	efloat32 tl, zh, zl;
+
+	th = x.hi / y.hi;
+	if (!Efloat_eft_is_finite(th) || th == 0.0f) {
+		return efloat32_pair_make(th, 0.0f);
+	}
+	/* r = y * th as a pair */
+	ch = efloat32_two_prod(y.hi, th, &cl1);
+	cl2 = y.lo * th;
+	t2h = efloat32_fast_two_sum(ch, cl2, &tl1);
+	tl2 = tl1 + cl1;
+	rh = efloat32_fast_two_sum(t2h, tl2, &rl);
+	/* the remainder x - r, and its quotient */
+	ph = efloat32_two_sum(x.hi, -rh, &pl);
+	dh = pl - rl;
+	dl = dh + x.lo;
+	d = ph + dl;
+	tl = d / y.hi;
+	zh = efloat32_fast_two_sum(th, tl, &zl);
+	return efloat32_pair_make(zh, zl);
+}
+
+struct efloat32_pair efloat32_pair_sqrt(struct efloat32_pair x)
+{
+	efloat32 s, p, e, r, t, zh, zl;
+
+	s = uint32_bits_to_efloat32(efloat32_soft_sqrt
+				    (efloat32_to_uint32_bits(x.hi)));
+	if (!Efloat_eft_is_finite(s) || s == 0.0f) {
+		return efloat32_pair_make(s, 0.0f);
+	}
+	/* one Newton step on the remainder x - s^2 */
+	p = efloat32_two_prod(s, s, &e);
+	r = ((x.hi - p) - e) + x.lo;
+	t = r / (2.0f * s);
+	zh = efloat32_fast_two_sum(s, t, &zl);
+	return efloat32_pair_make(zh, zl);
+}
+
+void efloat32_pair_array_add(struct efloat32_pair *dst,
+			     const struct efloat32_pair *a,
+			     const struct efloat32_pair *b, size_t len)
+{
+	size_t i;
+
+	for (i = 0; i < len; ++i) {
+		dst[i] = efloat32_pair_add(a[i], b[i]);
+	}
+}
+
+void efloat32_pair_array_mul(struct efloat32_pair *dst,
+			     const struct efloat32_pair *a,
+			     const struct efloat32_pair *b, size_t len)
+{
+	size_t i;
+
+	for (i = 0; i < len; ++i) {
+		dst[i] = efloat32_pair_mul(a[i], b[i]);
+	}
+}
+
+void efloat32_pair_array_div(struct efloat32_pair *dst,
+			     const struct efloat32_pair *a,
+			     const struct efloat32_pair *b, size_t len)
+{
+	size_t i;
+
+	for (i = 0; i < len; ++i) {
+		dst[i] = efloat32_pair_div(a[i], b[i]);
+	}
+}
+
+void efloat32_pair_array_sqrt(struct efloat32_pair *dst,
+			      const struct efloat32_pair *src, size_t len)
+{
+	size_t i;
+
+	for (i = 0; i < len; ++i) {
+		dst[i] = efloat32_pair_sqrt(src[i]);
+	}
+}
+
+/* Ogita, Rump and Oishi's Sum2 */
+efloat32 efloat32_array_sum_compensated(const efloat32 *src, size_t len)
+{
+	efloat32 s, c, e;
+	size_t i;
+
+	s = 0.0f;
+	c = 0.0f;
+	for (i = 0; i < len; ++i) {
+		s = efloat32_two_sum(s, src[i], &e);
+		c += e;
+	}
+	return s + c;
+}
+
+/* Ogita, Rump and Oishi's Dot2 */
+efloat32 efloat32_array_dot_compensated(const efloat32 *a, const efloat32 *b,
+					size_t len)
+{
+	efloat32 p, s, h, r, q;
+	size_t i;
+
+	p = 0.0f;
+	s = 0.0f;
+	for (i = 0; i < len; ++i) {
+		h = efloat32_two_prod(a[i], b[i], &r);
+		p = efloat32_two_sum(p, h, &q);
+		s += q + r;
+	}
+	return p + s;
+}
+#endif
+
+#if ((defined efloat64_exists) && (efloat64_exists))
+/* 2^27 + 1, splitting 53 bits into two signed halves of 26 */
+#define Efloat64_veltkamp 134217729.0
+#define Efloat64_eft_rexp(d) \
+	((long)((efloat64_to_uint64_bits(d) & efloat64_r2_rexp_mask) \
+		>> efloat64_r2_exp_shift))
+
+static int efloat64_eft_split_safe(efloat64 a, efloat64 b)
+{
+	long ea, eb, ep;
+
+	ea = Efloat64_eft_rexp(a);
+	eb = Efloat64_eft_rexp(b);
+	if (ea == 0 || eb == 0 || ea > 2 * efloat64_r2_exp_max - 29
+	    || eb > 2 * efloat64_r2_exp_max - 29) {
+		return 0;
+	}
+	ep = ea + eb - 2 * efloat64_r2_exp_max;
+	return ep > 2 * efloat64_mant_dig + 3 - efloat64_r2_exp_max
+	    && ep < efloat64_r2_exp_max - 4;
+}
+
+static void efloat64_eft_split(efloat64 a, efloat64 *hi, efloat64 *lo)
+{
+	efloat64 c;
+
+	c = Efloat64_veltkamp * a;
+	*hi = c - (c - a);
+	*lo = a - *hi;
+}
+
+efloat64 efloat64_fast_two_sum(efloat64 a, efloat64 b, efloat64 *err)
+{
+	efloat64 s;
+
+	s = a + b;
+	*err = Efloat_eft_is_finite(s) ? (b - (s - a)) : 0.0;
+	return s;
+}
+
+efloat64 efloat64_two_sum(efloat64 a, efloat64 b, efloat64 *err)
+{
+	efloat64 s, a1, b1;
+
+	s = a + b;
+	if (!Efloat_eft_is_finite(s)) {
+		*err = 0.0;
+		return s;
+	}
+	b1 = s - a;
+	a1 = s - b1;
+	*err = (a - a1) + (b - b1);
+	return s;
+}
+
+efloat64 efloat64_two_prod(efloat64 a, efloat64 b, efloat64 *err)
+{
+	efloat64 p, ah, al, bh, bl;
+
+	p = a * b;
+	if (!Efloat_eft_is_finite(p) || p == 0.0) {
+		*err = 0.0;
+		return p;
+	}
+	if (!efloat64_eft_split_safe(a, b)) {
+		*err = uint64_bits_to_efloat64(efloat64_soft_fma
+					       (efloat64_to_uint64_bits(a),
+						efloat64_to_uint64_bits(b),
+						efloat64_to_uint64_bits(-p)));
+		return p;
+	}
+	efloat64_eft_split(a, &ah, &al);
+	efloat64_eft_split(b, &bh, &bl);
+	*err = ((ah * bh - p) + ah * bl + al * bh) + al * bl;
+	return p;
+}
+
+static struct efloat64_pair efloat64_pair_make(efloat64 hi, efloat64 lo)
+{
+	struct efloat64_pair z;
+
+	z.hi = hi;
+	z.lo = lo;
+	return z;
+}
+
+struct efloat64_pair efloat64_pair_add(struct efloat64_pair x,
+				       struct efloat64_pair y)
+{
+	efloat64 sh, sl, th, tl, c, vh, vl, w, zh, zl;
+
+	sh = efloat64_two_sum(x.hi, y.hi, &sl);
+	if (!Efloat_eft_is_finite(sh)) {
+		return efloat64_pair_make(sh, 0.0);
+	}
+	th = efloat64_two_sum(x.lo, y.lo, &tl);
+	c = sl + th;
+	vh = efloat64_fast_two_sum(sh, c, &vl);
+	w = tl + vl;
+	zh = efloat64_fast_two_sum(vh, w, &zl);
+	return efloat64_pair_make(zh, zl);
+}
+
+struct efloat64_pair efloat64_pair_mul(struct efloat64_pair x,
+				       struct efloat64_pair y)
+{
+	efloat64 ch, cl1, cl2, cl3, zh, zl;
+
+	ch = efloat64_two_prod(x.hi, y.hi, &cl1);
+	if (!Efloat_eft_is_finite(ch) || ch == 0.0) {
+		return efloat64_pair_make(ch, 0.0);
+	}
+	cl2 = x.hi * y.lo + x.lo * y.hi;
+	cl3 = cl1 + cl2;
+	zh = efloat64_fast_two_sum(ch, cl3, &zl);
+	return efloat64_pair_make(zh, zl);
+}
+
+struct efloat64_pair efloat64_pair_div(struct efloat64_pair x,
+				       struct efloat64_pair y)
+{
+	efloat64 th, ch, cl1, cl2, t2h, tl1, tl2, rh, rl, ph, pl, dh, dl, d;
+	efloat64 tl, zh, zl;
+
+	th = x.hi / y.hi;
+	if (!Efloat_eft_is_finite(th) || th == 0.0) {
+		return efloat64_pair_make(th, 0.0);
+	}
+	ch = efloat64_two_prod(y.hi, th, &cl1);
+	cl2 = y.lo * th;
+	t2h = efloat64_fast_two_sum(ch, cl2, &tl1);
+	tl2 = tl1 + cl1;
+	rh = efloat64_fast_two_sum(t2h, tl2, &rl);
+	ph = efloat64_two_sum(x.hi, -rh, &pl);
+	dh = pl - rl;
+	dl = dh + x.lo;
+	d = ph + dl;
+	tl = d / y.hi;
+	zh = efloat64_fast_two_sum(th, tl, &zl);
+	return efloat64_pair_make(zh, zl);
+}
+
+struct efloat64_pair efloat64_pair_sqrt(struct efloat64_pair x)
+{
+	efloat64 s, p, e, r, t, zh, zl;
+
+	s = uint64_bits_to_efloat64(efloat64_soft_sqrt
+				    (efloat64_to_uint64_bits(x.hi)));
+	if (!Efloat_eft_is_finite(s) || s == 0.0) {
+		return efloat64_pair_make(s, 0.0);
+	}
+	p = efloat64_two_prod(s, s, &e);
+	r = ((x.hi - p) - e) + x.lo;
+	t = r / (2.0 * s);
+	zh = efloat64_fast_two_sum(s, t, &zl);
+	return efloat64_pair_make(zh, zl);
+}
+
+void efloat64_pair_array_add(struct efloat64_pair *dst,
+			     const struct efloat64_pair *a,
+			     const struct efloat64_pair *b, size_t len)
+{
+	size_t i;
+
+	for (i = 0; i < len; ++i) {
+		dst[i] = efloat64_pair_add(a[i], b[i]);
+	}
+}
+
+void efloat64_pair_array_mul(struct efloat64_pair *dst,
+			     const struct efloat64_pair *a,
+			     const struct efloat64_pair *b, size_t len)
+{
+	size_t i;
+
+	for (i = 0; i < len; ++i) {
+		dst[i] = efloat64_pair_mul(a[i], b[i]);
+	}
+}
+
+void efloat64_pair_array_div(struct efloat64_pair *dst,
+			     const struct efloat64_pair *a,
+			     const struct efloat64_pair *b, size_t len)
+{
+	size_t i;
+
+	for (i = 0; i < len; ++i) {
+		dst[i] = efloat64_pair_div(a[i], b[i]);
+	}
+}
+
+void efloat64_pair_array_sqrt(struct efloat64_pair *dst,
+			      const struct efloat64_pair *src, size_t len)
+{
+	size_t i;
+
+	for (i = 0; i < len; ++i) {
+		dst[i] = efloat64_pair_sqrt(src[i]);
+	}
+}
+
+efloat64 efloat64_array_sum_compensated(const efloat64 *src, size_t len)
+{
+	efloat64 s, c, e;
+	size_t i;
+
+	s = 0.0;
+	c = 0.0;
+	for (i = 0; i < len; ++i) {
+		s = efloat64_two_sum(s, src[i], &e);
+		c += e;
+	}
+	return s + c;
+}
+
+efloat64 efloat64_array_dot_compensated(const efloat64 *a, const efloat64 *b,
+					size_t len)
+{
+	efloat64 p, s, h, r, q;
+	size_t i;
+
+	p = 0.0;
+	s = 0.0;
+	for (i = 0; i < len; ++i) {
+		h = efloat64_two_prod(a[i], b[i], &r);
+		p = efloat64_two_sum(p, h, &q);
+		s += q + r;
+	}
+	return p + s;
+}
+#endif
@@ -0,0 +1,750 @@
+/* SPDX-License-Identifier: LGPL-2.1-or-later */
+/* efloat-fixed.c: Q format fixed point and scaled int8 quantization */
+/* Copyright (C) 2026 Eric Herman */
+/* https://github.com/ericherman/libefloat */
+
+#include "efloat-internal.h"
+
+/*
+ The array conversions read the bit patterns a block at a time, and the
+ rounding of each element is a run of selects: every shift is clamped
+ into range, the rounding mode is folded in as masks, and NaN and the
+ infinities replace the rounded result, so the inner loops have no
+ branches which depend on the data.
+*/
+
+/* the bits below bit "k" of a word, for "k" of 0 to 64 */
+#define Efloat_fixed_low_mask(k) \
+	(((k) >= 64) ? UINT64_MAX : ((((uint64_t)1) << ((k) & 63)) - 1))
+
+/*
+ The magnitude of (sig + sticky) * 2^exp rounded to an integer, for a
+ value of sign "neg"; "sticky" stands for a non-zero amount below the
+ last bit of "sig". Magnitudes beyond "limit" saturate to it, with
+ efloat_flag_invalid, as IEEE 754 conversions to integers signal.
+*/
+static uint64_t efloat_fixed_round(int neg, uint64_t sig, long exp,
+				   int sticky, enum efloat_round_mode mode,
+				   uint64_t limit, unsigned *flags)
+{
+	uint64_t m;
+	unsigned left, right;
+	int guard, rest, lost, up, over;
+
+	/* one of the shifts is zero; past 64 bits the results stop changing */
+	left = (unsigned)((exp > 63) ? 63 : (exp > 0) ? exp : 0);
+	right = (unsigned)((exp < -65) ? 65 : (exp < 0) ? -exp : 0);
+	over = ((exp > 63) & (sig != 0)) | (((sig >> 1) >> (63 - left)) != 0);
+
+	m = (right < 64) ? ((sig << left) >> (right & 63)) : 0;
+	guard = (int)((right - 1 < 64) & (sig >> ((right - 1) & 63)));
+	rest = sticky | ((sig & Efloat_fixed_low_mask(right - (right != 0)))
+			 != 0);
+	lost = guard | rest;
+
+	up = (mode == ef_round_nearest_even) & guard & (rest | (int)(m & 1));
+	up |= (mode == ef_round_nearest_away) & guard;
+	up |= (mode == ef_round_up) & !neg & lost;
+	up |= (mode == ef_round_down) & neg & lost;
+
+	over |= (m > limit) | (up & (m == limit));
+	m = (m + (uint64_t)up) | (uint64_t)((mode == ef_round_odd) & lost);
+	over |= m > limit;
+
+	*flags |= over ? efloat_flag_invalid : (lost ? efloat_flag_inexact : 0);
+	return over ? limit : m;
+}
+
+/* the magnitude "mag" with the sign, without overflow for the minimum */
+static int64_t efloat_fixed_signed(int neg, uint64_t mag)
+{
+	return (neg && mag) ? -((int64_t)(mag - 1)) - 1 : (int64_t)mag;
+}
+
+/*
+ The quotient of x / scale, for a finite, positive "scale", rounded to
+ an integer magnitude. The significand of x is moved to the top of the
+ word and that of the scale shifted to be odd, so the integer quotient
+ keeps at least 10 bits, more than any int8 magnitude needs, and the
+ remainder is the sticky.
+*/
+static uint64_t efloat_fixed_divide(int neg, uint64_t sig_x, long exp_x,
+				    uint64_t sig_s, long exp_s,
+				    enum efloat_round_mode mode,
+				    uint64_t limit, unsigned *flags)
+{
+	unsigned shift;
+	uint64_t q, r;
+
+	/* a zero stays zero, the quotient and remainder both 0 */
+	shift = Efloat_u64_clz(sig_x | 1);
+	sig_x <<= shift;
+	exp_x -= (long)shift;
+	shift = Efloat_u64_ctz(sig_s);
+	sig_s >>= shift;
+	exp_s += (long)shift;
+
+	q = sig_x / sig_s;
+	r = sig_x % sig_s;
+	return efloat_fixed_round(neg, q, exp_x - exp_s, r != 0, mode, limit,
+				  flags);
+}
+
+/* store the integer of "bits" bits, signed or not, at dst[i] */
+static void efloat_fixed_store(void *dst, size_t i, unsigned bits,
+			       int is_signed, int neg, uint64_t mag)
+{
+	int64_t val;
+
+	val = efloat_fixed_signed(neg, mag);
+	switch (bits) {
+	case 8:
+		if (is_signed) {
+			((int8_t *)dst)[i] = (int8_t)val;
+		} else {
+			((uint8_t *)dst)[i] = (uint8_t)mag;
+		}
+		break;
+	case 16:
+		if (is_signed) {
+			((int16_t *)dst)[i] = (int16_t)val;
+		} else {
+			((uint16_t *)dst)[i] = (uint16_t)mag;
+		}
+		break;
+	case 32:
+		if (is_signed) {
+			((int32_t *)dst)[i] = (int32_t)val;
+		} else {
+			((uint32_t *)dst)[i] = (uint32_t)mag;
+		}
+		break;
+	default:
+		if (is_signed) {
+			((int64_t *)dst)[i] = val;
+		} else {
+			((uint64_t *)dst)[i] = mag;
+		}
+		break;
+	}
+}
+
+/* the largest magnitudes of the integer of "bits" bits, signed or not */
+static void efloat_fixed_limits(unsigned bits, int is_signed,
+				uint64_t *limit_pos, uint64_t *limit_neg)
+{
+	if (is_signed) {
+		*limit_neg = ((uint64_t)1) << (bits - 1);
+		*limit_pos = *limit_neg - 1;
+	} else {
+		*limit_neg = 0;
+		*limit_pos = (bits == 64) ? UINT64_MAX
+		    : ((((uint64_t)1) << bits) - 1);
+	}
+}
+
+#if ((defined efloat32_exists) && (efloat32_exists))
+/* the significand and exponent of finite bits, ignoring the sign */
+static void efloat32_fixed_fields(uint32_t bits, uint64_t *sig, long *exp)
+{
+	uint32_t rexp;
+
+	rexp = (bits & efloat32_r2_rexp_mask) >> efloat32_r2_exp_shift;
+	*sig = (bits & efloat32_r2_signif_mask)
+	    | ((uint64_t)(rexp != 0) << (efloat32_mant_dig - 1));
+	*exp = (long)(rexp + (rexp == 0)) - efloat32_r2_exp_max
+	    - (efloat32_mant_dig - 1);
+}
+
+/*
+ The integer magnitude of "bits" * 2^scale_exp, and its sign in "*neg",
+ saturated to "limit_pos" or "limit_neg"; NaN is 0, and infinities
+ saturate, both with efloat_flag_invalid.
+*/
+static uint64_t efloat32_fixed_magnitude(uint32_t bits, long scale_exp,
+					 enum efloat_round_mode mode,
+					 uint64_t limit_pos, uint64_t limit_neg,
+					 int *neg, unsigned *flags)
+{
+	uint64_t sig, limit, m;
+	uint32_t mag;
+	long exp;
+	unsigned f;
+	int nan, inf;
+
+	mag = bits & ~efloat32_r2_sign_mask;
+	nan = mag > efloat32_r2_rexp_mask;
+	inf = mag == efloat32_r2_rexp_mask;
+	*neg = !nan && (bits & efloat32_r2_sign_mask);
+	limit = *neg ? limit_neg : limit_pos;
+
+	f = 0;
+	efloat32_fixed_fields(bits, &sig, &exp);
+	m = efloat_fixed_round(*neg, sig, exp + scale_exp, 0, mode, limit, &f);
+	m = inf ? limit : m;
+	m = nan ? 0 : m;
+	*flags |= (nan || inf) ? (unsigned)efloat_flag_invalid : f;
+	return m;
+}
+
+int32_t efloat32_to_q(efloat32 f, unsigned bits, int frac_bits,
+		      enum efloat_round_mode mode, unsigned *flags)
+{
+	uint64_t mag, limit;
+	unsigned f_local;
+	int neg;
+
+	if (bits < 2 || bits > 32) {
+		Efloat_set_err_inval();
+		return 0;
+	}
+	f_local = 0;
+	limit = ((uint64_t)1) << (bits - 1);
+	mag = efloat32_fixed_magnitude(efloat32_to_uint32_bits(f), frac_bits,
+				       mode, limit - 1, limit, &neg, &f_local);
+	if (flags) {
+		*flags |= f_local;
+	}
+	return (int32_t)efloat_fixed_signed(neg, mag);
+}
+
+efloat32 q_to_efloat32(int32_t q, int frac_bits)
+{
+	uint64_t mag;
+
+	mag = (q < 0) ? (((uint64_t)(-(q + 1))) + 1) : (uint64_t)q;
+	return efloat32_from_wide((q < 0) ? -1 : 1, -(long)frac_bits, mag, 0,
+				  ef_round_nearest_even, NULL);
+}
+
+unsigned efloat32_array_to_q(int32_t *dst, const efloat32 *src, size_t len,
+			     unsigned bits, int frac_bits,
+			     enum efloat_round_mode mode, uint8_t *flags)
+{
+	uint32_t in[Efloat_batch_len];
+	uint64_t mag, limit;
+	unsigned all, f;
+	size_t i, j, n;
+	int neg;
+
+	if (bits < 2 || bits > 32) {
+		Efloat_set_err_inval();
+		return 0;
+	}
+	limit = ((uint64_t)1) << (bits - 1);
+	all = 0;
+	for (i = 0; i < len; i += n) {
+		n = (len - i > Efloat_batch_len) ? Efloat_batch_len : len - i;
+		efloat32_array_to_uint32_bits(in, src + i, n);
+		for (j = 0; j < n; ++j) {
+			f = 0;
+			mag = efloat32_fixed_magnitude(in[j], frac_bits, mode,
+						       limit - 1, limit, &neg,
+						       &f);
+			dst[i + j] = (int32_t)efloat_fixed_signed(neg, mag);
+			if (flags) {
+				flags[i + j] = (uint8_t)f;
+			}
+			all |= f;
+		}
+	}
+	return all;
+}
+
+void q_to_efloat32_array(efloat32 *dst, const int32_t *src, size_t len,
+			 int frac_bits)
+{
+	size_t i;
+
+	for (i = 0; i < len; ++i) {
+		dst[i] = q_to_efloat32(src[i], frac_bits);
+	}
+}
+
+/* are the scales all finite and greater than zero */
+static int efloat32_fixed_scales_valid(const efloat32 *scales,
+				       size_t channels)
+{
+	uint32_t bits;
+	size_t c;
+
+	if (!scales || channels == 0) {
+		return 0;
+	}
+	for (c = 0; c < channels; ++c) {
+		bits = efloat32_to_uint32_bits(scales[c]);
+		if (bits == 0 || bits >= efloat32_r2_rexp_mask) {
+			return 0;
+		}
+	}
+	return 1;
+}
+
+unsigned efloat32_array_to_int8_scaled(int8_t *dst, const efloat32 *src,
+				       size_t len, const efloat32 *scales,
+				       size_t channels,
+				       enum efloat_round_mode mode,
+				       uint8_t *flags)
+{
+	uint32_t in[Efloat_batch_len];
+	uint64_t sig_x, sig_s, mag, q;
+	long exp_x, exp_s;
+	unsigned all, f, g;
+	size_t i, j, n, c;
+	int neg, special;
+
+	if (!efloat32_fixed_scales_valid(scales, channels)) {
+		Efloat_set_err_inval();
+		return 0;
+	}
+	all = 0;
+	c = 0;
+	for (i = 0; i < len; i += n) {
+		n = (len - i > Efloat_batch_len) ? Efloat_batch_len : len - i;
+		efloat32_array_to_uint32_bits(in, src + i, n);
+		for (j = 0; j < n; ++j) {
+			f = 0;
+			g = 0;
+			/* NaN is 0 and infinities saturate, finite values
+			   are divided by the scale */
+			special = (in[j] & efloat32_r2_rexp_mask)
+			    == efloat32_r2_rexp_mask;
+			mag = efloat32_fixed_magnitude(in[j], 0, mode, 127, 128,
+						       &neg, &f);
+			efloat32_fixed_fields(in[j], &sig_x, &exp_x);
+			efloat32_fixed_fields(efloat32_to_uint32_bits
+					      (scales[c]), &sig_s, &exp_s);
+			q = efloat_fixed_divide(neg, sig_x, exp_x, sig_s, exp_s,
+						mode, neg ? 128 : 127, &g);
+			mag = special ? mag : q;
+			f = special ? f : g;
+			dst[i + j] = (int8_t)efloat_fixed_signed(neg, mag);
+			if (flags) {
+				flags[i + j] = (uint8_t)f;
+			}
+			all |= f;
+			if (++c == channels) {
+				c = 0;
+			}
+		}
+	}
+	return all;
+}
+
+size_t int8_scaled_to_efloat32_array(efloat32 *dst, const int8_t *src,
+				     size_t len, const efloat32 *scales,
+				     size_t channels)
+{
+	uint64_t sig_s, mag;
+	long exp_s;
+	size_t i, c;
+
+	if (!efloat32_fixed_scales_valid(scales, channels)) {
+		Efloat_set_err_inval();
+		return 0;
+	}
+	c = 0;
+	for (i = 0; i < len; ++i) {
+		/* the product of the significands is exact */
+		efloat32_fixed_fields(efloat32_to_uint32_bits(scales[c]),
+				      &sig_s, &exp_s);
+		mag = (uint64_t)((src[i] < 0) ? -src[i] : src[i]);
+		dst[i] = efloat32_from_wide((src[i] < 0) ? -1 : 1, exp_s,
+					    mag * sig_s, 0,
+					    ef_round_nearest_even, NULL);
+		if (++c == channels) {
+			c = 0;
+		}
+	}
+	return len;
+}
+
+/* the saturating conversion of an array to integers of "bits" bits */
+static unsigned efloat32_array_to_int(void *dst, unsigned bits, int is_signed,
+				      const efloat32 *src, size_t len,
+				      enum efloat_round_mode mode,
+				      uint8_t *flags)
+{
+	uint32_t in[Efloat_batch_len];
+	uint64_t mag, limit_pos, limit_neg;
+	unsigned all, f;
+	size_t i, j, n;
+	int neg;
+
+	efloat_fixed_limits(bits, is_signed, &limit_pos, &limit_neg);
+	all = 0;
+	for (i = 0; i < len; i += n) {
+		n = (len - i > Efloat_batch_len) ? Efloat_batch_len : len - i;
+		efloat32_array_to_uint32_bits(in, src + i, n);
+		for (j = 0; j < n; ++j) {
+			f = 0;
+			mag = efloat32_fixed_magnitude(in[j], 0, mode,
+						       limit_pos, limit_neg,
+						       &neg, &f);
+			efloat_fixed_store(dst, i + j, bits, is_signed, neg,
+					   mag);
+			if (flags) {
+				flags[i + j] = (uint8_t)f;
+			}
+			all |= f;
+		}
+	}
+	return all;
+}
+
+unsigned efloat32_array_to_int8_round(int8_t *dst, const efloat32 *src,
+				      size_t len, enum efloat_round_mode mode,
+				      uint8_t *flags)
+{
+	return efloat32_array_to_int(dst, 8, 1, src, len, mode, flags);
+}
+
+unsigned efloat32_array_to_uint8_round(uint8_t *dst, const efloat32 *src,
+				       size_t len, enum efloat_round_mode mode,
+				       uint8_t *flags)
+{
+	return efloat32_array_to_int(dst, 8, 0, src, len, mode, flags);
+}
+
+unsigned efloat32_array_to_int16_round(int16_t *dst, const efloat32 *src,
+				       size_t len, enum efloat_round_mode mode,
+				       uint8_t *flags)
+{
+	return efloat32_array_to_int(dst, 16, 1, src, len, mode, flags);
+}
+
+unsigned efloat32_array_to_uint16_round(uint16_t *dst, const efloat32 *src,
+					size_t len, enum efloat_round_mode mode,
+					uint8_t *flags)
+{
+	return efloat32_array_to_int(dst, 16, 0, src, len, mode, flags);
+}
+
+unsigned efloat32_array_to_int32_round(int32_t *dst, const efloat32 *src,
+				       size_t len, enum efloat_round_mode mode,
+				       uint8_t *flags)
+{
+	return efloat32_array_to_int(dst, 32, 1, src, len, mode, flags);
+}
+
+unsigned efloat32_array_to_uint32_round(uint32_t *dst, const efloat32 *src,
+					size_t len, enum efloat_round_mode mode,
+					uint8_t *flags)
+{
+	return efloat32_array_to_int(dst, 32, 0, src, len, mode, flags);
+}
+
+unsigned efloat32_array_to_int64_round(int64_t *dst, const efloat32 *src,
+				       size_t len, enum efloat_round_mode mode,
+				       uint8_t *flags)
+{
+	return efloat32_array_to_int(dst, 64, 1, src, len, mode, flags);
+}
+
+unsigned efloat32_array_to_uint64_round(uint64_t *dst, const efloat32 *src,
+					size_t len, enum efloat_round_mode mode,
+					uint8_t *flags)
+{
+	return efloat32_array_to_int(dst, 64, 0, src, len, mode, flags);
+}
+#endif
+
+#if ((defined efloat64_exists) && (efloat64_exists))
+/* the significand and exponent of finite bits, ignoring the sign */
+static void efloat64_fixed_fields(uint64_t bits, uint64_t *sig, long *exp)
+{
+	uint64_t rexp;
+
+	rexp = (bits & efloat64_r2_rexp_mask) >> efloat64_r2_exp_shift;
+	*sig = (bits & efloat64_r2_signif_mask)
+	    | ((uint64_t)(rexp != 0) << (efloat64_mant_dig - 1));
+	*exp = (long)(rexp + (rexp == 0)) - efloat64_r2_exp_max
+	    - (efloat64_mant_dig - 1);
+}
+
+/* as efloat32_fixed_magnitude() */
+static uint64_t efloat64_fixed_magnitude(uint64_t bits, long scale_exp,
+					 enum efloat_round_mode mode,
+					 uint64_t limit_pos, uint64_t limit_neg,
+					 int *neg, unsigned *flags)
+{
+	uint64_t sig, limit, m;
+	uint64_t mag;
+	long exp;
+	unsigned f;
+	int nan, inf;
+
+	mag = bits & ~efloat64_r2_sign_mask;
+	nan = mag > efloat64_r2_rexp_mask;
+	inf = mag == efloat64_r2_rexp_mask;
+	*neg = !nan && (bits & efloat64_r2_sign_mask);
+	limit = *neg ? limit_neg : limit_pos;
+
+	f = 0;
+	efloat64_fixed_fields(bits, &sig, &exp);
+	m = efloat_fixed_round(*neg, sig, exp + scale_exp, 0, mode, limit, &f);
+	m = inf ? limit : m;
+	m = nan ? 0 : m;
+	*flags |= (nan || inf) ? (unsigned)efloat_flag_invalid : f;
+	return m;
+}
+
+int64_t efloat64_to_q(efloat64 f, unsigned bits, int frac_bits,
+		      enum efloat_round_mode mode, unsigned *flags)
+{
+	uint64_t mag, limit;
+	unsigned f_local;
+	int neg;
+
+	if (bits < 2 || bits > 64) {
+		Efloat_set_err_inval();
+		return 0;
+	}
+	f_local = 0;
+	limit = ((uint64_t)1) << (bits - 1);
+	mag = efloat64_fixed_magnitude(efloat64_to_uint64_bits(f), frac_bits,
+				       mode, limit - 1, limit, &neg, &f_local);
+	if (flags) {
+		*flags |= f_local;
+	}
+	return efloat_fixed_signed(neg, mag);
+}
+
+efloat64 q_to_efloat64(int64_t q, int frac_bits)
+{
+	uint64_t mag;
+
+	mag = (q < 0) ? (((uint64_t)(-(q + 1))) + 1) : (uint64_t)q;
+	return efloat64_from_wide((q < 0) ? -1 : 1, -(long)frac_bits, mag, 0,
+				  ef_round_nearest_even, NULL);
+}
+
+unsigned efloat64_array_to_q(int64_t *dst, const efloat64 *src, size_t len,
+			     unsigned bits, int frac_bits,
+			     enum efloat_round_mode mode, uint8_t *flags)
+{
+	uint64_t in[Efloat_batch_len];
+	uint64_t mag, limit;
+	unsigned all, f;
+	size_t i, j, n;
+	int neg;
+
+	if (bits < 2 || bits > 64) {
+		Efloat_set_err_inval();
+		return 0;
+	}
+	limit = ((uint64_t)1) << (bits - 1);
+	all = 0;
+	for (i = 0; i < len; i += n) {
+		n = (len - i > Efloat_batch_len) ? Efloat_batch_len : len - i;
+		efloat64_array_to_uint64_bits(in, src + i, n);
+		for (j = 0; j < n; ++j) {
+			f = 0;
+			mag = efloat64_fixed_magnitude(in[j], frac_bits, mode,
+						       limit - 1, limit, &neg,
+						       &f);
+			dst[i + j] = efloat_fixed_signed(neg, mag);
+			if (flags) {
+				flags[i + j] = (uint8_t)f;
+			}
+			all |= f;
+		}
+	}
+	return all;
+}
+
+void q_to_efloat64_array(efloat64 *dst, const int64_t *src, size_t len,
+			 int frac_bits)
+{
+	size_t i;
+
+	for (i = 0; i < len; ++i) {
+		dst[i] = q_to_efloat64(src[i], frac_bits);
+	}
+}
+
+static int efloat64_fixed_scales_valid(const efloat64 *scales,
+				       size_t channels)
+{
+	uint64_t bits;
+	size_t c;
+
+	if (!scales || channels == 0) {
+		return 0;
+	}
+	for (c = 0; c < channels; ++c) {
+		bits = efloat64_to_uint64_bits(scales[c]);
+		if (bits == 0 || bits >= efloat64_r2_rexp_mask) {
+			return 0;
+		}
+	}
+	return 1;
+}
+
+unsigned efloat64_array_to_int8_scaled(int8_t *dst, const efloat64 *src,
+				       size_t len, const efloat64 *scales,
+				       size_t channels,
+				       enum efloat_round_mode mode,
+				       uint8_t *flags)
+{
+	uint64_t in[Efloat_batch_len];
+	uint64_t sig_x, sig_s, mag, q;
+	long exp_x, exp_s;
+	unsigned all, f, g;
+	size_t i, j, n, c;
+	int neg, special;
+
+	if (!efloat64_fixed_scales_valid(scales, channels)) {
+		Efloat_set_err_inval();
+		return 0;
+	}
+	all = 0;
+	c = 0;
+	for (i = 0; i < len; i += n) {
+		n = (len - i > Efloat_batch_len) ? Efloat_batch_len : len - i;
+		efloat64_array_to_uint64_bits(in, src + i, n);
+		for (j = 0; j < n; ++j) {
+			f = 0;
+			g = 0;
+			/* NaN is 0 and infinities saturate, finite values
+			   are divided by the scale */
+			special = (in[j] & efloat64_r2_rexp_mask)
+			    == efloat64_r2_rexp_mask;
+			mag = efloat64_fixed_magnitude(in[j], 0, mode, 127, 128,
+						       &neg, &f);
+			efloat64_fixed_fields(in[j], &sig_x, &exp_x);
+			efloat64_fixed_fields(efloat64_to_uint64_bits
+					      (scales[c]), &sig_s, &exp_s);
+			q = efloat_fixed_divide(neg, sig_x, exp_x, sig_s, exp_s,
+						mode, neg ? 128 : 127, &g);
+			mag = special ? mag : q;
+			f = special ? f : g;
+			dst[i + j] = (int8_t)efloat_fixed_signed(neg, mag);
+			if (flags) {
+				flags[i + j] = (uint8_t)f;
+			}
+			all |= f;
+			if (++c == channels) {
+				c = 0;
+			}
+		}
+	}
+	return all;
+}
+
+size_t int8_scaled_to_efloat64_array(efloat64 *dst, const int8_t *src,
+				     size_t len, const efloat64 *scales,
+				     size_t channels)
+{
+	uint64_t sig_s, mag;
+	long exp_s;
+	size_t i, c;
+
+	if (!efloat64_fixed_scales_valid(scales, channels)) {
+		Efloat_set_err_inval();
+		return 0;
+	}
+	c = 0;
+	for (i = 0; i < len; ++i) {
+		efloat64_fixed_fields(efloat64_to_uint64_bits(scales[c]),
+				      &sig_s, &exp_s);
+		mag = (uint64_t)((src[i] < 0) ? -src[i] : src[i]);
+		dst[i] = efloat64_from_wide((src[i] < 0) ? -1 : 1, exp_s,
+					    mag * sig_s, 0,
+					    ef_round_nearest_even, NULL);
+		if (++c == channels) {
+			c = 0;
+		}
+	}
+	return len;
+}
+
+/* the saturating conversion of an array to integers of "bits" bits */
+static unsigned efloat64_array_to_int(void *dst, unsigned bits, int is_signed,
+				      const efloat64 *src, size_t len,
+				      enum efloat_round_mode mode,
+				      uint8_t *flags)
+{
+	uint64_t in[Efloat_batch_len];
+	uint64_t mag, limit_pos, limit_neg;
+	unsigned all, f;
+	size_t i, j, n;
+	int neg;
+
+	efloat_fixed_limits(bits, is_signed, &limit_pos, &limit_neg);
+	all = 0;
+	for (i = 0; i < len; i += n) {
+		n = (len - i > Efloat_batch_len) ? Efloat_batch_len : len - i;
+		efloat64_array_to_uint64_bits(in, src + i, n);
+		for (j = 0; j < n; ++j) {
+			f = 0;
+			mag = efloat64_fixed_magnitude(in[j], 0, mode,
+						       limit_pos, limit_neg,
+						       &neg, &f);
+			efloat_fixed_store(dst, i + j, bits, is_signed, neg,
+					   mag);
+			if (flags) {
+				flags[i + j] = (uint8_t)f;
+			}
+			all |= f;
+		}
+	}
+	return all;
+}
+
+unsigned efloat64_array_to_int8_round(int8_t *dst, const efloat64 *src,
+				      size_t len, enum efloat_round_mode mode,
+				      uint8_t *flags)
+{
+	return efloat64_array_to_int(dst, 8, 1, src, len, mode, flags);
+}
+
+unsigned efloat64_array_to_uint8_round(uint8_t *dst, const efloat64 *src,
+				       size_t len, enum efloat_round_mode mode,
+				       uint8_t *flags)
+{
+	return efloat64_array_to_int(dst, 8, 0, src, len, mode, flags);
+}
+
+unsigned efloat64_array_to_int16_round(int16_t *dst, const efloat64 *src,
+				       size_t len, enum efloat_round_mode mode,
+				       uint8_t *flags)
+{
+	return efloat64_array_to_int(dst, 16, 1, src, len, mode, flags);
+}
+
+unsigned efloat64_array_to_uint16_round(uint16_t *dst, const efloat64 *src,
+					size_t len, enum efloat_round_mode mode,
+					uint8_t *flags)
+{
+	return efloat64_array_to_int(dst, 16, 0, src, len, mode, flags);
+}
+
+unsigned efloat64_array_to_int32_round(int32_t *dst, const efloat64 *src,
+				       size_t len, enum efloat_round_mode mode,
+				       uint8_t *flags)
+{
+	return efloat64_array_to_int(dst, 32, 1, src, len, mode, flags);
+}
+
+unsigned efloat64_array_to_uint32_round(uint32_t *dst, const efloat64 *src,
+					size_t len, enum efloat_round_mode mode,
+					uint8_t *flags)
+{
+	return efloat64_array_to_int(dst, 32, 0, src, len, mode, flags);
+}
+
+unsigned efloat64_array_to_int64_round(int64_t *dst, const efloat64 *src,
+				       size_t len, enum efloat_round_mode mode,
+				       uint8_t *flags)
+{
+	return efloat64_array_to_int(dst, 64, 1, src, len, mode, flags);
+}
+
+unsigned efloat64_array_to_uint64_round(uint64_t *dst, const efloat64 *src,
+					size_t len, enum efloat_round_mode mode,
+					uint8_t *flags)
+{
+	return efloat64_array_to_int(dst, 64, 0, src, len, mode, flags);
+}
+#endif
@@ -0,0 +1,492 @@
+/* SPDX-License-Identifier: LGPL-2.1-or-later */
+/* efloat-frexp.c: frexp, ldexp, ilogb, logb and copysign on bit patterns */
+/* Copyright (C) 2026 Eric Herman */
+/* https://github.com/ericherman/libefloat */
+
+#include "efloat-internal.h"
+
+/*
+ A scale beyond this takes any finite non-zero value of either format
+ past infinity or below half of the smallest subnormal, so larger
+ scales round the same as this.
+*/
+#define Efloat_ldexp_limit 4000L
+
+#if ((defined efloat32_exists) && (efloat32_exists))
+#define Efloat32_rexp_inf_nan \
+	(efloat32_r2_rexp_mask >> efloat32_r2_exp_shift)
+
+static uint32_t efloat32_bits_frexp(uint32_t bits, int *exp)
+{
+	uint32_t rexp, signif;
+	unsigned shift;
+
+	rexp = (bits & efloat32_r2_rexp_mask) >> efloat32_r2_exp_shift;
+	signif = bits & efloat32_r2_signif_mask;
+	*exp = 0;
+	if (rexp == Efloat32_rexp_inf_nan) {
+		return signif ? (bits | Efloat32_quiet_bit) : bits;
+	}
+	if (rexp == 0) {
+		if (signif == 0) {
+			return bits;
+		}
+		/* normalize the subnormal, moving its top bit to the hidden */
+		shift = Efloat_u64_clz(signif) - (64 - efloat32_mant_dig);
+		signif = (signif << shift) & efloat32_r2_signif_mask;
+		*exp = 1 - (int)shift - (efloat32_r2_exp_max - 1);
+	} else {
+		*exp = (int)rexp - (efloat32_r2_exp_max - 1);
+	}
+	/* a significand in [0.5, 1) */
+	return (bits & efloat32_r2_sign_mask)
+	    | (((uint32_t)(efloat32_r2_exp_max - 1)) << efloat32_r2_exp_shift)
+	    | signif;
+}
+
+static uint32_t efloat32_bits_ldexp(uint32_t bits, long n)
+{
+	uint32_t rexp, signif;
+	long e;
+
+	rexp = (bits & efloat32_r2_rexp_mask) >> efloat32_r2_exp_shift;
+	signif = bits & efloat32_r2_signif_mask;
+	if (rexp == Efloat32_rexp_inf_nan) {
+		return signif ? (bits | Efloat32_quiet_bit) : bits;
+	}
+	if (rexp == 0 && signif == 0) {
+		return bits;
+	}
+	if (n > Efloat_ldexp_limit) {
+		n = Efloat_ldexp_limit;
+	} else if (n < -Efloat_ldexp_limit) {
+		n = -Efloat_ldexp_limit;
+	}
+	if (rexp == 0) {
+		rexp = 1;
+	} else {
+		e = (long)rexp + n;
+		if (e > 0 && e < (long)Efloat32_rexp_inf_nan) {
+			/* a normal result needs only the new exponent */
+			return (bits & ~efloat32_r2_rexp_mask)
+			    | (((uint32_t)e) << efloat32_r2_exp_shift);
+		}
+		signif |= ((uint32_t)1) << efloat32_r2_exp_shift;
+	}
+	/* subnormal results round, and too large results overflow */
+	return efloat32_to_uint32_bits(efloat32_from_wide
+				       ((bits & efloat32_r2_sign_mask) ? -1 : 1,
+					(long)rexp - efloat32_r2_exp_max
+					- (efloat32_mant_dig - 1) + n, signif,
+					0, ef_round_nearest_even, NULL));
+}
+
+static int efloat32_bits_ilogb(uint32_t bits)
+{
+	uint32_t rexp, signif;
+
+	rexp = (bits & efloat32_r2_rexp_mask) >> efloat32_r2_exp_shift;
+	signif = bits & efloat32_r2_signif_mask;
+	if (rexp == Efloat32_rexp_inf_nan) {
+		return signif ? efloat_ilogbnan : INT_MAX;
+	}
+	if (rexp == 0) {
+		if (signif == 0) {
+			return efloat_ilogb0;
+		}
+		return (63 - (int)Efloat_u64_clz(signif))
+		    + 1 - efloat32_r2_exp_max - (efloat32_mant_dig - 1);
+	}
+	return (int)rexp - efloat32_r2_exp_max;
+}
+
+static uint32_t efloat32_bits_logb(uint32_t bits)
+{
+	uint32_t rexp, signif;
+
+	rexp = (bits & efloat32_r2_rexp_mask) >> efloat32_r2_exp_shift;
+	signif = bits & efloat32_r2_signif_mask;
+	if (rexp == Efloat32_rexp_inf_nan) {
+		/* the magnitude of infinity, or the NaN */
+		return signif ? (bits | Efloat32_quiet_bit)
+		    : (bits & ~efloat32_r2_sign_mask);
+	}
+	if (rexp == 0 && signif == 0) {
+		/* negative infinity */
+		return efloat32_r2_sign_mask | efloat32_r2_rexp_mask;
+	}
+	/* small integers are exact */
+	return efloat32_to_uint32_bits((efloat32)efloat32_bits_ilogb(bits));
+}
+
+static uint32_t efloat32_bits_copysign(uint32_t mag, uint32_t sgn)
+{
+	return (mag & ~efloat32_r2_sign_mask) | (sgn & efloat32_r2_sign_mask);
+}
+
+efloat32 efloat32_frexp(efloat32 f, int *exp)
+{
+	return uint32_bits_to_efloat32(efloat32_bits_frexp
+				       (efloat32_to_uint32_bits(f), exp));
+}
+
+efloat32 efloat32_ldexp(efloat32 f, int exp)
+{
+	return uint32_bits_to_efloat32(efloat32_bits_ldexp
+				       (efloat32_to_uint32_bits(f), exp));
+}
+
+efloat32 efloat32_scalbn(efloat32 f, int n)
+{
+	return efloat32_ldexp(f, n);
+}
+
+int efloat32_ilogb(efloat32 f)
+{
+	return efloat32_bits_ilogb(efloat32_to_uint32_bits(f));
+}
+
+efloat32 efloat32_logb(efloat32 f)
+{
+	return uint32_bits_to_efloat32(efloat32_bits_logb
+				       (efloat32_to_uint32_bits(f)));
+}
+
+efloat32 efloat32_copysign(efloat32 mag, efloat32 sgn)
+{
+	return uint32_bits_to_efloat32(efloat32_bits_copysign
+				       (efloat32_to_uint32_bits(mag),
+					efloat32_to_uint32_bits(sgn)));
+}
+
+void efloat32_array_frexp(efloat32 *dst, int *exps, const efloat32 *src,
+			  size_t len)
+{
+	uint32_t bits[Efloat_batch_len];
+	size_t i, j, n;
+
+	for (i = 0; i < len; i += n) {
+		n = (len - i > Efloat_batch_len) ? Efloat_batch_len : len - i;
+		efloat32_array_to_uint32_bits(bits, src + i, n);
+		for (j = 0; j < n; ++j) {
+			bits[j] = efloat32_bits_frexp(bits[j], exps + i + j);
+		}
+		uint32_bits_to_efloat32_array(dst + i, bits, n);
+	}
+}
+
+void efloat32_array_ldexp(efloat32 *dst, const efloat32 *src,
+			  const int *exps, size_t len)
+{
+	uint32_t bits[Efloat_batch_len];
+	size_t i, j, n;
+
+	for (i = 0; i < len; i += n) {
+		n = (len - i > Efloat_batch_len) ? Efloat_batch_len : len - i;
+		efloat32_array_to_uint32_bits(bits, src + i, n);
+		for (j = 0; j < n; ++j) {
+			bits[j] = efloat32_bits_ldexp(bits[j], exps[i + j]);
+		}
+		uint32_bits_to_efloat32_array(dst + i, bits, n);
+	}
+}
+
+void efloat32_array_scalbn(efloat32 *dst, const efloat32 *src, int scale,
+			   size_t len)
+{
+	uint32_t bits[Efloat_batch_len];
+	size_t i, j, n;
+
+	for (i = 0; i < len; i += n) {
+		n = (len - i > Efloat_batch_len) ? Efloat_batch_len : len - i;
+		efloat32_array_to_uint32_bits(bits, src + i, n);
+		for (j = 0; j < n; ++j) {
+			bits[j] = efloat32_bits_ldexp(bits[j], scale);
+		}
+		uint32_bits_to_efloat32_array(dst + i, bits, n);
+	}
+}
+
+void efloat32_array_ilogb(int *dst, const efloat32 *src, size_t len)
+{
+	uint32_t bits[Efloat_batch_len];
+	size_t i, j, n;
+
+	for (i = 0; i < len; i += n) {
+		n = (len - i > Efloat_batch_len) ? Efloat_batch_len : len - i;
+		efloat32_array_to_uint32_bits(bits, src + i, n);
+		for (j = 0; j < n; ++j) {
+			dst[i + j] = efloat32_bits_ilogb(bits[j]);
+		}
+	}
+}
+
+void efloat32_array_logb(efloat32 *dst, const efloat32 *src, size_t len)
+{
+	uint32_t bits[Efloat_batch_len];
+	size_t i, j, n;
+
+	for (i = 0; i < len; i += n) {
+		n = (len - i > Efloat_batch_len) ? Efloat_batch_len : len - i;
+		efloat32_array_to_uint32_bits(bits, src + i, n);
+		for (j = 0; j < n; ++j) {
+			bits[j] = efloat32_bits_logb(bits[j]);
+		}
+		uint32_bits_to_efloat32_array(dst + i, bits, n);
+	}
+}
+
+void efloat32_array_copysign(efloat32 *dst, const efloat32 *mag,
+			     const efloat32 *sgn, size_t len)
+{
+	uint32_t bits[Efloat_batch_len];
+	uint32_t sign_bits[Efloat_batch_len];
+	size_t i, j, n;
+
+	for (i = 0; i < len; i += n) {
+		n = (len - i > Efloat_batch_len) ? Efloat_batch_len : len - i;
+		efloat32_array_to_uint32_bits(bits, mag + i, n);
+		efloat32_array_to_uint32_bits(sign_bits, sgn + i, n);
+		for (j = 0; j < n; ++j) {
+			bits[j] = efloat32_bits_copysign(bits[j], sign_bits[j]);
+		}
+		uint32_bits_to_efloat32_array(dst + i, bits, n);
+	}
+}
+#endif
+
+#if ((defined efloat64_exists) && (efloat64_exists))
+#define Efloat64_rexp_inf_nan \
+	(efloat64_r2_rexp_mask >> efloat64_r2_exp_shift)
+
+static uint64_t efloat64_bits_frexp(uint64_t bits, int *exp)
+{
+	uint64_t rexp, signif;
+	unsigned shift;
+
+	rexp = (bits & efloat64_r2_rexp_mask) >> efloat64_r2_exp_shift;
+	signif = bits & efloat64_r2_signif_mask;
+	*exp = 0;
+	if (rexp == Efloat64_rexp_inf_nan) {
+		return signif ? (bits | Efloat64_quiet_bit) : bits;
+	}
+	if (rexp == 0) {
+		if (signif == 0) {
+			return bits;
+		}
+		shift = Efloat_u64_clz(signif) - (64 - efloat64_mant_dig);
+		signif = (signif << shift) & efloat64_r2_signif_mask;
+		*exp = 1 - (int)shift - (int)(efloat64_r2_exp_max - 1);
+	} else {
+		*exp = (int)rexp - (int)(efloat64_r2_exp_max - 1);
+	}
+	return (bits & efloat64_r2_sign_mask)
+	    | (((uint64_t)(efloat64_r2_exp_max - 1)) << efloat64_r2_exp_shift)
+	    | signif;
+}
+
+static uint64_t efloat64_bits_ldexp(uint64_t bits, long n)
+{
+	uint64_t rexp, signif;
+	long e;
+
+	rexp = (bits & efloat64_r2_rexp_mask) >> efloat64_r2_exp_shift;
+	signif = bits & efloat64_r2_signif_mask;
+	if (rexp == Efloat64_rexp_inf_nan) {
+		return signif ? (bits | Efloat64_quiet_bit) : bits;
+	}
+	if (rexp == 0 && signif == 0) {
+		return bits;
+	}
+	if (n > Efloat_ldexp_limit) {
+		n = Efloat_ldexp_limit;
+	} else if (n < -Efloat_ldexp_limit) {
+		n = -Efloat_ldexp_limit;
+	}
+	if (rexp == 0) {
+		rexp = 1;
+	} else {
+		e = (long)rexp + n;
+		if (e > 0 && e < (long)Efloat64_rexp_inf_nan) {
+			return (bits & ~efloat64_r2_rexp_mask)
+			    | (((uint64_t)e) << efloat64_r2_exp_shift);
+		}
+		signif |= ((uint64_t)1) << efloat64_r2_exp_shift;
+	}
+	return efloat64_to_uint64_bits(efloat64_from_wide
+				       ((bits & efloat64_r2_sign_mask) ? -1 : 1,
+					(long)rexp - efloat64_r2_exp_max
+					- (efloat64_mant_dig - 1) + n, signif,
+					0, ef_round_nearest_even, NULL));
+}
+
+static int efloat64_bits_ilogb(uint64_t bits)
+{
+	uint64_t rexp, signif;
+
+	rexp = (bits & efloat64_r2_rexp_mask) >> efloat64_r2_exp_shift;
+	signif = bits & efloat64_r2_signif_mask;
+	if (rexp == Efloat64_rexp_inf_nan) {
+		return signif ? efloat_ilogbnan : INT_MAX;
+	}
+	if (rexp == 0) {
+		if (signif == 0) {
+			return efloat_ilogb0;
+		}
+		return (63 - (int)Efloat_u64_clz(signif))
+		    + 1 - (int)efloat64_r2_exp_max - (efloat64_mant_dig - 1);
+	}
+	return (int)rexp - (int)efloat64_r2_exp_max;
+}
+
+static uint64_t efloat64_bits_logb(uint64_t bits)
+{
+	uint64_t rexp, signif;
+
+	rexp = (bits & efloat64_r2_rexp_mask) >> efloat64_r2_exp_shift;
+	signif = bits & efloat64_r2_signif_mask;
+	if (rexp == Efloat64_rexp_inf_nan) {
+		return signif ? (bits | Efloat64_quiet_bit)
+		    : (bits & ~efloat64_r2_sign_mask);
+	}
+	if (rexp == 0 && signif == 0) {
+		return efloat64_r2_sign_mask | efloat64_r2_rexp_mask;
+	}
+	return efloat64_to_uint64_bits((efloat64)efloat64_bits_ilogb(bits));
+}
+
+static uint64_t efloat64_bits_copysign(uint64_t mag, uint64_t sgn)
+{
+	return (mag & ~efloat64_r2_sign_mask) | (sgn & efloat64_r2_sign_mask);
+}
+
+efloat64 efloat64_frexp(efloat64 d, int *exp)
+{
+	return uint64_bits_to_efloat64(efloat64_bits_frexp
+				       (efloat64_to_uint64_bits(d), exp));
+}
+
+efloat64 efloat64_ldexp(efloat64 d, int exp)
+{
+	return uint64_bits_to_efloat64(efloat64_bits_ldexp
+				       (efloat64_to_uint64_bits(d), exp));
+}
+
+efloat64 efloat64_scalbn(efloat64 d, int n)
+{
+	return efloat64_ldexp(d, n);
+}
+
+int efloat64_ilogb(efloat64 d)
+{
+	return efloat64_bits_ilogb(efloat64_to_uint64_bits(d));
+}
+
+efloat64 efloat64_logb(efloat64 d)
+{
+	return uint64_bits_to_efloat64(efloat64_bits_logb
+				       (efloat64_to_uint64_bits(d)));
+}
+
+efloat64 efloat64_copysign(efloat64 mag, efloat64 sgn)
+{
+	return uint64_bits_to_efloat64(efloat64_bits_copysign
+				       (efloat64_to_uint64_bits(mag),
+					efloat64_to_uint64_bits(sgn)));
+}
+
+void efloat64_array_frexp(efloat64 *dst, int *exps, const efloat64 *src,
+			  size_t len)
+{
+	uint64_t bits[Efloat_batch_len];
+	size_t i, j, n;
+
+	for (i = 0; i < len; i += n) {
+		n = (len - i > Efloat_batch_len) ? Efloat_batch_len : len - i;
+		efloat64_array_to_uint64_bits(bits, src + i, n);
+		for (j = 0; j < n; ++j) {
+			bits[j] = efloat64_bits_frexp(bits[j], exps + i + j);
+		}
+		uint64_bits_to_efloat64_array(dst + i, bits, n);
+	}
+}
+
+void efloat64_array_ldexp(efloat64 *dst, const efloat64 *src,
+			  const int *exps, size_t len)
+{
+	uint64_t bits[Efloat_batch_len];
+	size_t i, j, n;
+
+	for (i = 0; i < len; i += n) {
+		n = (len - i > Efloat_batch_len) ? Efloat_batch_len : len - i;
+		efloat64_array_to_uint64_bits(bits, src + i, n);
+		for (j = 0; j < n; ++j) {
+			bits[j] = efloat64_bits_ldexp(bits[j], exps[i + j]);
+		}
+		uint64_bits_to_efloat64_array(dst + i, bits, n);
+	}
+}
+
+void efloat64_array_scalbn(efloat64 *dst, const efloat64 *src, int scale,
+			   size_t len)
+{
+	uint64_t bits[Efloat_batch_len];
+	size_t i, j, n;
+
+	for (i = 0; i < len; i += n) {
+		n = (len - i > Efloat_batch_len) ? Efloat_batch_len : len - i;
+		efloat64_array_to_uint64_bits(bits, src + i, n);
+		for (j = 0; j < n; ++j) {
+			bits[j] = efloat64_bits_ldexp(bits[j], scale);
+		}
+		uint64_bits_to_efloat64_array(dst + i, bits, n);
+	}
+}
+
+void efloat64_array_ilogb(int *dst, const efloat64 *src, size_t len)
+{
+	uint64_t bits[Efloat_batch_len];
+	size_t i, j, n;
+
+	for (i = 0; i < len; i += n) {
+		n = (len - i > Efloat_batch_len) ? Efloat_batch_len : len - i;
+		efloat64_array_to_uint64_bits(bits, src + i, n);
+		for (j = 0; j < n; ++j) {
+			dst[i + j] = efloat64_bits_ilogb(bits[j]);
+		}
+	}
+}
+
+void efloat64_array_logb(efloat64 *dst, const efloat64 *src, size_t len)
+{
+	uint64_t bits[Efloat_batch_len];
+	size_t i, j, n;
+
+	for (i = 0; i < len; i += n) {
+		n = (len - i > Efloat_batch_len) ? Efloat_batch_len : len - i;
+		efloat64_array_to_uint64_bits(bits, src + i, n);
+		for (j = 0; j < n; ++j) {
+			bits[j] = efloat64_bits_logb(bits[j]);
+		}
+		uint64_bits_to_efloat64_array(dst + i, bits, n);
+	}
+}
+
+void efloat64_array_copysign(efloat64 *dst, const efloat64 *mag,
+			     const efloat64 *sgn, size_t len)
+{
+	uint64_t bits[Efloat_batch_len];
+	uint64_t sign_bits[Efloat_batch_len];
+	size_t i, j, n;
+
+	for (i = 0; i < len; i += n) {
+		n = (len - i > Efloat_batch_len) ? Efloat_batch_len : len - i;
+		efloat64_array_to_uint64_bits(bits, mag + i, n);
+		efloat64_array_to_uint64_bits(sign_bits, sgn + i, n);
+		for (j = 0; j < n; ++j) {
+			bits[j] = efloat64_bits_copysign(bits[j], sign_bits[j]);
+		}
+		uint64_bits_to_efloat64_array(dst + i, bits, n);
+	}
+}
+#endif
@@ -0,0 +1,154 @@
+/* SPDX-License-Identifier: LGPL-2.1-or-later */
+/* efloat-hash.c: canonicalizing hashes of float values */
+/* Copyright (C) 2026 Eric Herman */
+/* https://github.com/ericherman/libefloat */
+
+#include "efloat-internal.h"
+
+/*
+ The 64 bit finalizer of MurmurHash3: every input bit affects every
+ output bit, and as it is a bijection, distinct canonical patterns
+ never collide before the hash is reduced to a table size.
+*/
+static uint64_t efloat_hash_mix(uint64_t k)
+{
+	k ^= k >> 33;
+	k *= 0xFF51AFD7ED558CCDUL;
+	k ^= k >> 33;
+	k *= 0xC4CEB9FE1A85EC53UL;
+	k ^= k >> 33;
+	return k;
+}
+
+#if ((defined efloat32_exists) && (efloat32_exists))
+/* -0.0 becomes 0.0, and every NaN the one quiet NaN */
+static uint32_t efloat32_bits_canonical(uint32_t u)
+{
+	uint32_t mag;
+
+	mag = u & ~efloat32_r2_sign_mask;
+	u = (mag == 0) ? 0 : u;
+	u = (mag > efloat32_r2_rexp_mask) ? efloat32_canonical_nan_bits : u;
+	return u;
+}
+
+efloat32 efloat32_canonical(efloat32 f)
+{
+	uint32_t u;
+
+	u = efloat32_bits_canonical(efloat32_to_uint32_bits(f));
+	return uint32_bits_to_efloat32(u);
+}
+
+uint64_t efloat32_hash(efloat32 f, uint64_t seed, enum efloat_hash_mode mode)
+{
+	uint32_t u;
+
+	u = efloat32_to_uint32_bits(f);
+	if (mode == ef_hash_ieee) {
+		u = efloat32_bits_canonical(u);
+	}
+	return efloat_hash_mix(u ^ seed);
+}
+
+void efloat32_array_canonical(efloat32 *dst, const efloat32 *src, size_t len)
+{
+	uint32_t bits[Efloat_batch_len];
+	size_t i, j, n;
+
+	for (i = 0; i < len; i += n) {
+		n = (len - i > Efloat_batch_len) ? Efloat_batch_len : len - i;
+		efloat32_array_to_uint32_bits(bits, src + i, n);
+		for (j = 0; j < n; ++j) {
+			bits[j] = efloat32_bits_canonical(bits[j]);
+		}
+		uint32_bits_to_efloat32_array(dst + i, bits, n);
+	}
+}
+
+void efloat32_array_hash(uint64_t *dst, const efloat32 *src, size_t len,
+			 uint64_t seed, enum efloat_hash_mode mode)
+{
+	uint32_t bits[Efloat_batch_len];
+	size_t i, j, n;
+
+	for (i = 0; i < len; i += n) {
+		n = (len - i > Efloat_batch_len) ? Efloat_batch_len : len - i;
+		efloat32_array_to_uint32_bits(bits, src + i, n);
+		if (mode == ef_hash_ieee) {
+			for (j = 0; j < n; ++j) {
+				bits[j] = efloat32_bits_canonical(bits[j]);
+			}
+		}
+		for (j = 0; j < n; ++j) {
+			dst[i + j] = efloat_hash_mix(bits[j] ^ seed);
+		}
+	}
+}
+#endif
+
+#if ((defined efloat64_exists) && (efloat64_exists))
+static uint64_t efloat64_bits_canonical(uint64_t u)
+{
+	uint64_t mag;
+
+	mag = u & ~efloat64_r2_sign_mask;
+	u = (mag == 0) ? 0 : u;
+	u = (mag > efloat64_r2_rexp_mask) ? efloat64_canonical_nan_bits : u;
+	return u;
+}
+
+efloat64 efloat64_canonical(efloat64 d)
+{
+	uint64_t u;
+
+	u = efloat64_bits_canonical(efloat64_to_uint64_bits(d));
+	return uint64_bits_to_efloat64(u);
+}
+
+uint64_t efloat64_hash(efloat64 d, uint64_t seed, enum efloat_hash_mode mode)
+{
+	uint64_t u;
+
+	u = efloat64_to_uint64_bits(d);
+	if (mode == ef_hash_ieee) {
+		u = efloat64_bits_canonical(u);
+	}
+	return efloat_hash_mix(u ^ seed);
+}
+
+void efloat64_array_canonical(efloat64 *dst, const efloat64 *src, size_t len)
+{
+	uint64_t bits[Efloat_batch_len];
+	size_t i, j, n;
+
+	for (i = 0; i < len; i += n) {
+		n = (len - i > Efloat_batch_len) ? Efloat_batch_len : len - i;
+		efloat64_array_to_uint64_bits(bits, src + i, n);
+		for (j = 0; j < n; ++j) {
+			bits[j] = efloat64_bits_canonical(bits[j]);
+		}
+		uint64_bits_to_efloat64_array(dst + i, bits, n);
+	}
+}
+
+void efloat64_array_hash(uint64_t *dst, const efloat64 *src, size_t len,
+			 uint64_t seed, enum efloat_hash_mode mode)
+{
+	uint64_t bits[Efloat_batch_len];
+	size_t i, j, n;
+
+	for (i = 0; i < len; i += n) {
+		n = (len - i > Efloat_batch_len) ? Efloat_batch_len : len - i;
+		efloat64_array_to_uint64_bits(bits, src + i, n);
+		if (mode == ef_hash_ieee) {
+			for (j = 0; j < n; ++j) {
+				bits[j] = efloat64_bits_canonical(bits[j]);
+			}
+		}
+		for (j = 0; j < n; ++j) {
+			dst[i + j] = efloat_hash_mix(bits[j] ^ seed);
+		}
+	}
+}
+#endif
@@ -0,0 +1,223 @@
+/* SPDX-License-Identifier: LGPL-2.1-or-later */
+/* efloat-histogram.c: log bucketed (HDR style) histograms */
+/* Copyright (C) 2026 Eric Herman */
+/* https://github.com/ericherman/libefloat */
+
+#include "efloat-internal.h"
+
+/*
+ Relaxed ordering is enough, as each count is independent and a reader
+ only needs every add to land once; without lock free 64 bit atomics
+ the counts are plain integers.
+*/
+#if efloat_histogram_lock_free
+#define Efloat_atomic_add(p, n) \
+	((void)__atomic_fetch_add((p), (n), __ATOMIC_RELAXED))
+#define Efloat_atomic_load(p) __atomic_load_n((p), __ATOMIC_RELAXED)
+#else
+#define Efloat_atomic_add(p, n) ((void)(*(p) += (n)))
+#define Efloat_atomic_load(p) (*(p))
+#endif
+
+#if ((defined efloat64_exists) && (efloat64_exists))
+
+/* the bit patterns of 2^exp_min and 2^(exp_max + 1) */
+#define Efloat_histogram_low(h) \
+	((uint64_t)((h)->exp_min + efloat64_r2_exp_max) \
+	 << efloat64_r2_exp_shift)
+#define Efloat_histogram_high(h) \
+	((uint64_t)((h)->exp_max + efloat64_r2_exp_max + 1) \
+	 << efloat64_r2_exp_shift)
+#define Efloat_histogram_shift(h) (efloat64_r2_exp_shift - (h)->sub_bits)
+
+struct efloat_histogram *efloat_histogram_init(struct efloat_histogram *h,
+					       uint64_t *counts, size_t len,
+					       unsigned sub_bits, int exp_min,
+					       int exp_max)
+{
+	size_t i;
+
+	if (!h || !counts || sub_bits > efloat_histogram_sub_bits_max
+	    || exp_min < 1 - efloat64_r2_exp_max
+	    || exp_max > efloat64_r2_exp_max || exp_min > exp_max
+	    || len < efloat_histogram_len(sub_bits, exp_min, exp_max)) {
+		Efloat_set_err_inval();
+		return NULL;
+	}
+	h->counts = counts;
+	h->len = efloat_histogram_len(sub_bits, exp_min, exp_max);
+	h->sub_bits = sub_bits;
+	h->exp_min = exp_min;
+	h->exp_max = exp_max;
+	h->below = 0;
+	h->above = 0;
+	h->nan = 0;
+	for (i = 0; i < h->len; ++i) {
+		h->counts[i] = 0;
+	}
+	return h;
+}
+
+static int efloat_histogram_same_shape(const struct efloat_histogram *h,
+				       const struct efloat_histogram *other)
+{
+	if (!h || !other || h->sub_bits != other->sub_bits
+	    || h->exp_min != other->exp_min || h->exp_max != other->exp_max) {
+		Efloat_set_err_inval();
+		return 0;
+	}
+	return 1;
+}
+
+void efloat_histogram_snapshot(struct efloat_histogram *dst,
+			       const struct efloat_histogram *src)
+{
+	size_t i;
+
+	if (!efloat_histogram_same_shape(dst, src)) {
+		return;
+	}
+	for (i = 0; i < dst->len; ++i) {
+		dst->counts[i] = Efloat_atomic_load(&src->counts[i]);
+	}
+	dst->below = Efloat_atomic_load(&src->below);
+	dst->above = Efloat_atomic_load(&src->above);
+	dst->nan = Efloat_atomic_load(&src->nan);
+}
+
+void efloat_histogram_merge(struct efloat_histogram *h,
+			    const struct efloat_histogram *other)
+{
+	size_t i;
+
+	if (!efloat_histogram_same_shape(h, other)) {
+		return;
+	}
+	for (i = 0; i < h->len; ++i) {
+		Efloat_atomic_add(&h->counts[i],
+				  Efloat_atomic_load(&other->counts[i]));
+	}
+	Efloat_atomic_add(&h->below, Efloat_atomic_load(&other->below));
+	Efloat_atomic_add(&h->above, Efloat_atomic_load(&other->above));
+	Efloat_atomic_add(&h->nan, Efloat_atomic_load(&other->nan));
+}
+
+uint64_t efloat_histogram_count(const struct efloat_histogram *h)
+{
+	uint64_t total;
+	size_t i;
+
+	total = Efloat_atomic_load(&h->below) + Efloat_atomic_load(&h->above);
+	for (i = 0; i < h->len; ++i) {
+		total += Efloat_atomic_load(&h->counts[i]);
+	}
+	return total;
+}
+
+efloat64 efloat_histogram_quantile(const struct efloat_histogram *h,
+				   efloat64 q)
+{
+	uint64_t total, rank, seen, u;
+	efloat64 r;
+	size_t i;
+
+	if (!h || !(q >= 0 && q <= 1)) {
+		Efloat_set_err_inval();
+		return uint64_bits_to_efloat64(efloat64_canonical_nan_bits);
+	}
+	total = efloat_histogram_count(h);
+	if (total == 0) {
+		return uint64_bits_to_efloat64(efloat64_canonical_nan_bits);
+	}
+	r = q * (efloat64)total;
+	rank = (uint64_t)r;
+	if ((efloat64)rank < r) {
+		++rank;
+	}
+	rank = (rank == 0) ? 1 : rank;
+
+	seen = Efloat_atomic_load(&h->below);
+	if (rank <= seen) {
+		return uint64_bits_to_efloat64(Efloat_histogram_low(h));
+	}
+	for (i = 0; i < h->len; ++i) {
+		seen += Efloat_atomic_load(&h->counts[i]);
+		if (rank <= seen) {
+			/* within a bucket the exponent is fixed, so the middle
+			   of the bit patterns is the middle of the values */
+			u = Efloat_histogram_low(h)
+			    + ((uint64_t)i << Efloat_histogram_shift(h))
+			    + ((uint64_t)1 << (Efloat_histogram_shift(h) - 1));
+			return uint64_bits_to_efloat64(u);
+		}
+	}
+	return uint64_bits_to_efloat64(Efloat_histogram_high(h));
+}
+
+static void efloat_histogram_record_bits(struct efloat_histogram *h,
+					 uint64_t u, uint64_t low,
+					 uint64_t high, unsigned shift)
+{
+	if ((u & ~efloat64_r2_sign_mask) > efloat64_r2_rexp_mask) {
+		Efloat_atomic_add(&h->nan, 1);
+	} else if ((u & efloat64_r2_sign_mask) || u < low) {
+		Efloat_atomic_add(&h->below, 1);
+	} else if (u >= high) {
+		Efloat_atomic_add(&h->above, 1);
+	} else {
+		Efloat_atomic_add(&h->counts[(u - low) >> shift], 1);
+	}
+}
+
+void efloat64_histogram_record(struct efloat_histogram *h, efloat64 d)
+{
+	efloat_histogram_record_bits(h, efloat64_to_uint64_bits(d),
+				     Efloat_histogram_low(h),
+				     Efloat_histogram_high(h),
+				     Efloat_histogram_shift(h));
+}
+
+void efloat64_histogram_record_array(struct efloat_histogram *h,
+				     const efloat64 *src, size_t len)
+{
+	uint64_t bits[Efloat_batch_len];
+	uint64_t low, high;
+	unsigned shift;
+	size_t i, j, n;
+
+	low = Efloat_histogram_low(h);
+	high = Efloat_histogram_high(h);
+	shift = Efloat_histogram_shift(h);
+	for (i = 0; i < len; i += n) {
+		n = (len - i > Efloat_batch_len) ? Efloat_batch_len : len - i;
+		efloat64_array_to_uint64_bits(bits, src + i, n);
+		for (j = 0; j < n; ++j) {
+			efloat_histogram_record_bits(h, bits[j], low, high,
+						     shift);
+		}
+	}
+}
+
+#if ((defined efloat32_exists) && (efloat32_exists))
+/* every efloat32 is exactly an efloat64 */
+void efloat32_histogram_record(struct efloat_histogram *h, efloat32 f)
+{
+	efloat64_histogram_record(h, (efloat64)f);
+}
+
+void efloat32_histogram_record_array(struct efloat_histogram *h,
+				     const efloat32 *src, size_t len)
+{
+	efloat64 wide[Efloat_batch_len];
+	size_t i, j, n;
+
+	for (i = 0; i < len; i += n) {
+		n = (len - i > Efloat_batch_len) ? Efloat_batch_len : len - i;
+		for (j = 0; j < n; ++j) {
+			wide[j] = (efloat64)src[i + j];
+		}
+		efloat64_histogram_record_array(h, wide, n);
+	}
+}
+#endif
+#endif
@@ -0,0 +1,97 @@
+/* SPDX-License-Identifier: LGPL-2.1-or-later */
+/* efloat-internal.h: shared, non-installed helpers for libefloat sources */
+/* Copyright (C) 2026 Eric Herman */
+/* https://github.com/ericherman/libefloat */
+
+#ifndef EFLOAT_INTERNAL_H
+#define EFLOAT_INTERNAL_H
+
+#include "efloat.h"
+#include "eembed.h"
+
+#ifndef UINT32_MAX
+#define UINT32_MAX  (0xFFFFFFFF)
+#endif
+
+#ifndef UINT64_MAX
+#define UINT64_MAX  (0xFFFFFFFFFFFFFFFF)
+#endif
+
+/*
+ The batch functions copy the input through a small stack buffer of
+ integer bit patterns, so that the inner loops are plain integer
+ arithmetic which the compiler may vectorize. The buffer is kept small
+ by default so that it also fits on small embedded stacks; hosted
+ builds may wish to raise it with -DEfloat_batch_len=256
+*/
+#ifndef Efloat_batch_len
+#define Efloat_batch_len 64
+#endif
+
+/*
+ Map a bit pattern to an unsigned key which sorts in the same order as
+ the float values (with -0.0 before 0.0 and the NaNs at the ends), and
+ back again. Negative values have every bit flipped, positive values
+ only the sign bit.
+*/
+#define Efloat32_order_key(u) \
+	((uint32_t)((u) ^ ((0 - ((u) >> 31)) | efloat32_r2_sign_mask)))
+
+#define Efloat32_order_unkey(k) \
+	((uint32_t)((k) ^ ((((k) >> 31) - 1) | efloat32_r2_sign_mask)))
+
+#define Efloat64_order_key(u) \
+	((uint64_t)((u) ^ ((0 - ((u) >> 63)) | efloat64_r2_sign_mask)))
+
+#define Efloat64_order_unkey(k) \
+	((uint64_t)((k) ^ ((((k) >> 63) - 1) | efloat64_r2_sign_mask)))
+
+/*
+ The quiet bit of a NaN, the top bit of the significand; the default
+ NaN is efloatNN_canonical_nan_bits in efloat.h
+*/
+#define Efloat32_quiet_bit 0x00400000UL
+#define Efloat64_quiet_bit 0x0008000000000000UL
+
+/*
+ count leading/trailing zero bits, undefined for zero, as with the
+ builtins; the portable versions are in efloat.c
+*/
+unsigned efloat_u64_clz(uint64_t u);
+unsigned efloat_u64_ctz(uint64_t u);
+#if (defined __GNUC__)
+#define Efloat_u64_clz(u) ((unsigned)__builtin_clzll(u))
+#define Efloat_u64_ctz(u) ((unsigned)__builtin_ctzll(u))
+#else
+#define Efloat_u64_clz(u) efloat_u64_clz(u)
+#define Efloat_u64_ctz(u) efloat_u64_ctz(u)
+#endif
+
+#define Efloat_set_err_inval() \
+	do { \
+		if (efloat_seterrinval) { \
+			efloat_seterrinval(); \
+		} \
+	} while (0)
+
+#define Efloat_debug_print_str(str) do { \
+	if (eembed_err_log) { \
+		eembed_err_log->append_s(eembed_err_log, str); \
+	} } while (0)
+
+#define Efloat_debug_print_u64(u64) do { \
+	if (eembed_err_log) { \
+		eembed_err_log->append_ul(eembed_err_log, u64); \
+	} } while (0)
+
+#define Efloat_debug_print_i32(i32) do { \
+	if (eembed_err_log) { \
+		eembed_err_log->append_l(eembed_err_log, i32); \
+	} } while (0)
+
+#define Efloat_debug_print_eol() do { \
+	if (eembed_err_log) { \
+		eembed_err_log->append_eol(eembed_err_log); \
+	} } while (0)
+
+#endif /* EFLOAT_INTERNAL_H */
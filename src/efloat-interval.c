@@ -0,0 +1,445 @@
+/* SPDX-License-Identifier: LGPL-2.1-or-later */
+/* efloat-interval.c: interval arithmetic, widened by stepping the bits */
+/* Copyright (C) 2026 Eric Herman */
+/* https://github.com/ericherman/libefloat */
+
+#include "efloat-internal.h"
+
+/*
+ Each bound is computed in the current rounding mode, normally to
+ nearest, which is within one ulp of the exact bound even with double
+ rounding through a wider format; stepping the bit pattern one place
+ outward then gives a rigorous bound, without changing the rounding
+ mode. An exact bound is widened too, as telling it from a rounded one
+ would cost more than the ulp.
+
+ A lower bound of zero steps to the smallest negative subnormal, and an
+ upper bound of zero to the smallest positive, whatever the sign of the
+ zero. An infinite bound stands for an unbounded end, so a zero bound
+ times an infinite bound is zero, and the infinite quotients of
+ infinite bounds are left out of the candidates.
+*/
+
+#if ((defined efloat32_exists) && (efloat32_exists))
+static uint32_t efloat32_bits_next_up(uint32_t u)
+{
+	if ((u & efloat32_r2_rexp_mask) == efloat32_r2_rexp_mask
+	    && ((u & efloat32_r2_signif_mask)
+		|| !(u & efloat32_r2_sign_mask))) {
+		/* NaN, or +inf */
+		return u;
+	}
+	if ((u & ~efloat32_r2_sign_mask) == 0) {
+		return 1;
+	}
+	return (u & efloat32_r2_sign_mask) ? u - 1 : u + 1;
+}
+
+efloat32 efloat32_next_up(efloat32 f)
+{
+	return uint32_bits_to_efloat32(efloat32_bits_next_up
+				       (efloat32_to_uint32_bits(f)));
+}
+
+efloat32 efloat32_next_down(efloat32 f)
+{
+	return -efloat32_next_up(-f);
+}
+
+static struct efloat32_interval efloat32_interval_make(efloat32 lo,
+						       efloat32 hi)
+{
+	struct efloat32_interval z;
+
+	z.lo = lo;
+	z.hi = hi;
+	return z;
+}
+
+static struct efloat32_interval efloat32_interval_nan(void)
+{
+	efloat32 nan;
+
+	nan = uint32_bits_to_efloat32(efloat32_canonical_nan_bits);
+	return efloat32_interval_make(nan, nan);
+}
+
+/* the outward rounding of candidate bounds, skipping any NaN */
+static struct efloat32_interval efloat32_interval_hull(const efloat32 *c,
+						       size_t len)
+{
+	efloat32 lo, hi;
+	size_t i;
+	int any;
+
+	lo = 0.0f;
+	hi = 0.0f;
+	any = 0;
+	for (i = 0; i < len; ++i) {
+		if (c[i] != c[i]) {
+			continue;
+		}
+		if (!any || c[i] < lo) {
+			lo = c[i];
+		}
+		if (!any || c[i] > hi) {
+			hi = c[i];
+		}
+		any = 1;
+	}
+	if (!any) {
+		return efloat32_interval_nan();
+	}
+	return efloat32_interval_make(efloat32_next_down(lo),
+				      efloat32_next_up(hi));
+}
+
+static int efloat32_interval_is_nan(struct efloat32_interval x)
+{
+	return x.lo != x.lo || x.hi != x.hi;
+}
+
+static efloat32 efloat32_interval_mul_bound(efloat32 a, efloat32 b)
+{
+	return (a == 0.0f || b == 0.0f) ? 0.0f : a * b;
+}
+
+struct efloat32_interval efloat32_interval_add(struct efloat32_interval x,
+					       struct efloat32_interval y)
+{
+	if (efloat32_interval_is_nan(x) || efloat32_interval_is_nan(y)) {
+		return efloat32_interval_nan();
+	}
+	return efloat32_interval_make(efloat32_next_down(x.lo + y.lo),
+				      efloat32_next_up(x.hi + y.hi));
+}
+
+struct efloat32_interval efloat32_interval_sub(struct efloat32_interval x,
+					       struct efloat32_interval y)
+{
+	if (efloat32_interval_is_nan(x) || efloat32_interval_is_nan(y)) {
+		return efloat32_interval_nan();
+	}
+	return efloat32_interval_make(efloat32_next_down(x.lo - y.hi),
+				      efloat32_next_up(x.hi - y.lo));
+}
+
+struct efloat32_interval efloat32_interval_mul(struct efloat32_interval x,
+					       struct efloat32_interval y)
+{
+	efloat32 c[4];
+
+	if (efloat32_interval_is_nan(x) || efloat32_interval_is_nan(y)) {
+		return efloat32_interval_nan();
+	}
+	c[0] = efloat32_interval_mul_bound(x.lo, y.lo);
+	c[1] = efloat32_interval_mul_bound(x.lo, y.hi);
+	c[2] = efloat32_interval_mul_bound(x.hi, y.lo);
+	c[3] = efloat32_interval_mul_bound(x.hi, y.hi);
+	return efloat32_interval_hull(c, 4);
+}
+
+/* a divisor which contains zero gives the whole line */
+struct efloat32_interval efloat32_interval_div(struct efloat32_interval x,
+					       struct efloat32_interval y)
+{
+	efloat32 c[4], inf;
+
+	if (efloat32_interval_is_nan(x) || efloat32_interval_is_nan(y)) {
+		return efloat32_interval_nan();
+	}
+	if (y.lo <= 0.0f && y.hi >= 0.0f) {
+		inf = uint32_bits_to_efloat32(efloat32_r2_rexp_mask);
+		return efloat32_interval_make(-inf, inf);
+	}
+	c[0] = x.lo / y.lo;
+	c[1] = x.lo / y.hi;
+	c[2] = x.hi / y.lo;
+	c[3] = x.hi / y.hi;
+	return efloat32_interval_hull(c, 4);
+}
+
+/* the negative part of the argument is left out, as for a domain */
+struct efloat32_interval efloat32_interval_sqrt(struct efloat32_interval x)
+{
+	efloat32 lo, hi;
+
+	if (efloat32_interval_is_nan(x) || x.hi < 0.0f) {
+		return efloat32_interval_nan();
+	}
+	lo = 0.0f;
+	if (x.lo > 0.0f) {
+		lo = uint32_bits_to_efloat32(efloat32_soft_sqrt
+					     (efloat32_to_uint32_bits(x.lo)));
+		lo = efloat32_next_down(lo);
+	}
+	hi = uint32_bits_to_efloat32(efloat32_soft_sqrt
+				     (efloat32_to_uint32_bits(x.hi)));
+	return efloat32_interval_make(lo, efloat32_next_up(hi));
+}
+
+void efloat32_interval_array_add(struct efloat32_interval *dst,
+				 const struct efloat32_interval *a,
+				 const struct efloat32_interval *b, size_t len)
+{
+	size_t i;
+
+	for (i = 0; i < len; ++i) {
+		dst[i] = efloat32_interval_add(a[i], b[i]);
+	}
+}
+
+void efloat32_interval_array_sub(struct efloat32_interval *dst,
+				 const struct efloat32_interval *a,
+				 const struct efloat32_interval *b, size_t len)
+{
+	size_t i;
+
+	for (i = 0; i < len; ++i) {
+		dst[i] = efloat32_interval_sub(a[i], b[i]);
+	}
+}
+
+void efloat32_interval_array_mul(struct efloat32_interval *dst,
+				 const struct efloat32_interval *a,
+				 const struct efloat32_interval *b, size_t len)
+{
+	size_t i;
+
+	for (i = 0; i < len; ++i) {
+		dst[i] = efloat32_interval_mul(a[i], b[i]);
+	}
+}
+
+void efloat32_interval_array_div(struct efloat32_interval *dst,
+				 const struct efloat32_interval *a,
+				 const struct efloat32_interval *b, size_t len)
+{
+	size_t i;
+
+	for (i = 0; i < len; ++i) {
+		dst[i] = efloat32_interval_div(a[i], b[i]);
+	}
+}
+
+void efloat32_interval_array_sqrt(struct efloat32_interval *dst,
+				  const struct efloat32_interval *src,
+				  size_t len)
+{
+	size_t i;
+
+	for (i = 0; i < len; ++i) {
+		dst[i] = efloat32_interval_sqrt(src[i]);
+	}
+}
+#endif
+
+#if ((defined efloat64_exists) && (efloat64_exists))
+static uint64_t efloat64_bits_next_up(uint64_t u)
+{
+	if ((u & efloat64_r2_rexp_mask) == efloat64_r2_rexp_mask
+	    && ((u & efloat64_r2_signif_mask)
+		|| !(u & efloat64_r2_sign_mask))) {
+		return u;
+	}
+	if ((u & ~efloat64_r2_sign_mask) == 0) {
+		return 1;
+	}
+	return (u & efloat64_r2_sign_mask) ? u - 1 : u + 1;
+}
+
+efloat64 efloat64_next_up(efloat64 d)
+{
+	return uint64_bits_to_efloat64(efloat64_bits_next_up
+				       (efloat64_to_uint64_bits(d)));
+}
+
+efloat64 efloat64_next_down(efloat64 d)
+{
+	return -efloat64_next_up(-d);
+}
+
+static struct efloat64_interval efloat64_interval_make(efloat64 lo,
+						       efloat64 hi)
+{
+	struct efloat64_interval z;
+
+	z.lo = lo;
+	z.hi = hi;
+	return z;
+}
+
+static struct efloat64_interval efloat64_interval_nan(void)
+{
+	efloat64 nan;
+
+	nan = uint64_bits_to_efloat64(efloat64_canonical_nan_bits);
+	return efloat64_interval_make(nan, nan);
+}
+
+static struct efloat64_interval efloat64_interval_hull(const efloat64 *c,
+						       size_t len)
+{
+	efloat64 lo, hi;
+	size_t i;
+	int any;
+
+	lo = 0.0;
+	hi = 0.0;
+	any = 0;
+	for (i = 0; i < len; ++i) {
+		if (c[i] != c[i]) {
+			continue;
+		}
+		if (!any || c[i] < lo) {
+			lo = c[i];
+		}
+		if (!any || c[i] > hi) {
+			hi = c[i];
+		}
+		any = 1;
+	}
+	if (!any) {
+		return efloat64_interval_nan();
+	}
+	return efloat64_interval_make(efloat64_next_down(lo),
+				      efloat64_next_up(hi));
+}
+
+static int efloat64_interval_is_nan(struct efloat64_interval x)
+{
+	return x.lo != x.lo || x.hi != x.hi;
+}
+
+static efloat64 efloat64_interval_mul_bound(efloat64 a, efloat64 b)
+{
+	return (a == 0.0 || b == 0.0) ? 0.0 : a * b;
+}
+
+struct efloat64_interval efloat64_interval_add(struct efloat64_interval x,
+					       struct efloat64_interval y)
+{
+	if (efloat64_interval_is_nan(x) || efloat64_interval_is_nan(y)) {
+		return efloat64_interval_nan();
+	}
+	return efloat64_interval_make(efloat64_next_down(x.lo + y.lo),
+				      efloat64_next_up(x.hi + y.hi));
+}
+
+struct efloat64_interval efloat64_interval_sub(struct efloat64_interval x,
+					       struct efloat64_interval y)
+{
+	if (efloat64_interval_is_nan(x) || efloat64_interval_is_nan(y)) {
+		return efloat64_interval_nan();
+	}
+	return efloat64_interval_make(efloat64_next_down(x.lo - y.hi),
+				      efloat64_next_up(x.hi - y.lo));
+}
+
+struct efloat64_interval efloat64_interval_mul(struct efloat64_interval x,
+					       struct efloat64_interval y)
+{
+	efloat64 c[4];
+
+	if (efloat64_interval_is_nan(x) || efloat64_interval_is_nan(y)) {
+		return efloat64_interval_nan();
+	}
+	c[0] = efloat64_interval_mul_bound(x.lo, y.lo);
+	c[1] = efloat64_interval_mul_bound(x.lo, y.hi);
+	c[2] = efloat64_interval_mul_bound(x.hi, y.lo);
+	c[3] = efloat64_interval_mul_bound(x.hi, y.hi);
+	return efloat64_interval_hull(c, 4);
+}
+
+struct efloat64_interval efloat64_interval_div(struct efloat64_interval x,
+					       struct efloat64_interval y)
+{
+	efloat64 c[4], inf;
+
+	if (efloat64_interval_is_nan(x) || efloat64_interval_is_nan(y)) {
+		return efloat64_interval_nan();
+	}
+	if (y.lo <= 0.0 && y.hi >= 0.0) {
+		inf = uint64_bits_to_efloat64(efloat64_r2_rexp_mask);
+		return efloat64_interval_make(-inf, inf);
+	}
+	c[0] = x.lo / y.lo;
+	c[1] = x.lo / y.hi;
+	c[2] = x.hi / y.lo;
+	c[3] = x.hi / y.hi;
+	return efloat64_interval_hull(c, 4);
+}
+
+struct efloat64_interval efloat64_interval_sqrt(struct efloat64_interval x)
+{
+	efloat64 lo, hi;
+
+	if (efloat64_interval_is_nan(x) || x.hi < 0.0) {
+		return efloat64_interval_nan();
+	}
+	lo = 0.0;
+	if (x.lo > 0.0) {
+		lo = uint64_bits_to_efloat64(efloat64_soft_sqrt
+					     (efloat64_to_uint64_bits(x.lo)));
+		lo = efloat64_next_down(lo);
+	}
+	hi = uint64_bits_to_efloat64(efloat64_soft_sqrt
+				     (efloat64_to_uint64_bits(x.hi)));
+	return efloat64_interval_make(lo, efloat64_next_up(hi));
+}
+
+void efloat64_interval_array_add(struct efloat64_interval *dst,
+				 const struct efloat64_interval *a,
+				 const struct efloat64_interval *b, size_t len)
+{
+	size_t i;
+
+	for (i = 0; i < len; ++i) {
+		dst[i] = efloat64_interval_add(a[i], b[i]);
+	}
+}
+
+void efloat64_interval_array_sub(struct efloat64_interval *dst,
+				 const struct efloat64_interval *a,
+				 const struct efloat64_interval *b, size_t len)
+{
+	size_t i;
+
+	for (i = 0; i < len; ++i) {
+		dst[i] = efloat64_interval_sub(a[i], b[i]);
+	}
+}
+
+void efloat64_interval_array_mul(struct efloat64_interval *dst,
+				 const struct efloat64_interval *a,
+				 const struct efloat64_interval *b, size_t len)
+{
+	size_t i;
+
+	for (i = 0; i < len; ++i) {
+		dst[i] = efloat64_interval_mul(a[i], b[i]);
+	}
+}
+
+void efloat64_interval_array_div(struct efloat64_interval *dst,
+				 const struct efloat64_interval *a,
+				 const struct efloat64_interval *b, size_t len)
+{
+	size_t i;
+
+	for (i = 0; i < len; ++i) {
+		dst[i] = efloat64_interval_div(a[i], b[i]);
+	}
+}
+
+void efloat64_interval_array_sqrt(struct efloat64_interval *dst,
+				  const struct efloat64_interval *src,
+				  size_t len)
+{
+	size_t i;
+
+	for (i = 0; i < len; ++i) {
+		dst[i] = efloat64_interval_sqrt(src[i]);
+	}
+}
+#endif
@@ -0,0 +1,432 @@
+/* SPDX-License-Identifier: LGPL-2.1-or-later */
+/* efloat-minmax.c: totalOrder, minimum and maximum on bit patterns */
+/* Copyright (C) 2026 Eric Herman */
+/* https://github.com/ericherman/libefloat */
+
+#include "efloat-internal.h"
+
+/*
+ The order keys of efloat-internal.h already sort as totalOrder does,
+ so each comparison here is one unsigned compare of the keys; the NaNs
+ are picked out by their bits before the keys are compared.
+*/
+
+#if ((defined efloat32_exists) && (efloat32_exists))
+#define Efloat32_is_nan(u) \
+	(((u) & (efloat32_r2_rexp_mask | efloat32_r2_signif_mask)) \
+	 > efloat32_r2_rexp_mask)
+
+/*
+ the smaller (or with "is_max" the larger) of "a" and "b"; with
+ "number" a NaN gives way to the other operand, otherwise a NaN wins
+*/
+static uint32_t efloat32_bits_pick(uint32_t a, uint32_t b, int is_max,
+				   int number)
+{
+	uint32_t r;
+	int a_nan, b_nan;
+
+	a_nan = Efloat32_is_nan(a);
+	b_nan = Efloat32_is_nan(b);
+	if ((Efloat32_order_key(a) < Efloat32_order_key(b)) != is_max) {
+		r = a;
+	} else {
+		r = b;
+	}
+	if (number) {
+		r = b_nan ? a : r;
+		r = a_nan ? b : r;
+		r = (a_nan && b_nan) ? (a | Efloat32_quiet_bit) : r;
+	} else {
+		r = b_nan ? (b | Efloat32_quiet_bit) : r;
+		r = a_nan ? (a | Efloat32_quiet_bit) : r;
+	}
+	return r;
+}
+
+int efloat32_total_order(efloat32 x, efloat32 y)
+{
+	uint32_t a, b;
+
+	a = efloat32_to_uint32_bits(x);
+	b = efloat32_to_uint32_bits(y);
+	return Efloat32_order_key(a) <= Efloat32_order_key(b);
+}
+
+int efloat32_total_order_mag(efloat32 x, efloat32 y)
+{
+	uint32_t a, b;
+
+	a = efloat32_to_uint32_bits(x) & ~efloat32_r2_sign_mask;
+	b = efloat32_to_uint32_bits(y) & ~efloat32_r2_sign_mask;
+	return a <= b;
+}
+
+int efloat32_total_compare(efloat32 x, efloat32 y)
+{
+	uint32_t a, b;
+
+	a = Efloat32_order_key(efloat32_to_uint32_bits(x));
+	b = Efloat32_order_key(efloat32_to_uint32_bits(y));
+	return (a > b) - (a < b);
+}
+
+static efloat32 efloat32_pick(efloat32 x, efloat32 y, int is_max, int number)
+{
+	uint32_t a, b;
+
+	a = efloat32_to_uint32_bits(x);
+	b = efloat32_to_uint32_bits(y);
+	return uint32_bits_to_efloat32(efloat32_bits_pick(a, b, is_max,
+							  number));
+}
+
+efloat32 efloat32_minimum(efloat32 x, efloat32 y)
+{
+	return efloat32_pick(x, y, 0, 0);
+}
+
+efloat32 efloat32_maximum(efloat32 x, efloat32 y)
+{
+	return efloat32_pick(x, y, 1, 0);
+}
+
+efloat32 efloat32_minimum_number(efloat32 x, efloat32 y)
+{
+	return efloat32_pick(x, y, 0, 1);
+}
+
+efloat32 efloat32_maximum_number(efloat32 x, efloat32 y)
+{
+	return efloat32_pick(x, y, 1, 1);
+}
+
+static void efloat32_array_pick(efloat32 *dst, const efloat32 *a,
+				const efloat32 *b, size_t len, int is_max,
+				int number)
+{
+	uint32_t bits[Efloat_batch_len];
+	uint32_t other[Efloat_batch_len];
+	size_t i, j, n;
+
+	for (i = 0; i < len; i += n) {
+		n = (len - i > Efloat_batch_len) ? Efloat_batch_len : len - i;
+		efloat32_array_to_uint32_bits(bits, a + i, n);
+		efloat32_array_to_uint32_bits(other, b + i, n);
+		for (j = 0; j < n; ++j) {
+			bits[j] = efloat32_bits_pick(bits[j], other[j], is_max,
+						     number);
+		}
+		uint32_bits_to_efloat32_array(dst + i, bits, n);
+	}
+}
+
+void efloat32_array_minimum(efloat32 *dst, const efloat32 *a,
+			    const efloat32 *b, size_t len)
+{
+	efloat32_array_pick(dst, a, b, len, 0, 0);
+}
+
+void efloat32_array_maximum(efloat32 *dst, const efloat32 *a,
+			    const efloat32 *b, size_t len)
+{
+	efloat32_array_pick(dst, a, b, len, 1, 0);
+}
+
+void efloat32_array_minimum_number(efloat32 *dst, const efloat32 *a,
+				   const efloat32 *b, size_t len)
+{
+	efloat32_array_pick(dst, a, b, len, 0, 1);
+}
+
+void efloat32_array_maximum_number(efloat32 *dst, const efloat32 *a,
+				   const efloat32 *b, size_t len)
+{
+	efloat32_array_pick(dst, a, b, len, 1, 1);
+}
+
+/*
+ The inner loop is only an unsigned minimum and an "or" over the keys,
+ with the maximum taken as the minimum of the complemented keys and the
+ NaNs keyed last; the first NaN is looked for only once a block is seen
+ to hold one.
+*/
+static efloat32 efloat32_array_reduce(const efloat32 *src, size_t len,
+				      int is_max, int number)
+{
+	uint32_t bits[Efloat_batch_len];
+	uint32_t flip, key, least;
+	size_t i, j, n;
+	int nan, any_nan, any_num;
+
+	flip = is_max ? UINT32_MAX : 0;
+	least = UINT32_MAX;
+	any_num = 0;
+	for (i = 0; i < len; i += n) {
+		n = (len - i > Efloat_batch_len) ? Efloat_batch_len : len - i;
+		efloat32_array_to_uint32_bits(bits, src + i, n);
+		any_nan = 0;
+		for (j = 0; j < n; ++j) {
+			nan = Efloat32_is_nan(bits[j]);
+			key = Efloat32_order_key(bits[j]) ^ flip;
+			key = nan ? UINT32_MAX : key;
+			least = (key < least) ? key : least;
+			any_nan |= nan;
+			any_num |= !nan;
+		}
+		if (any_nan && !number) {
+			for (j = 0; !Efloat32_is_nan(bits[j]); ++j) {
+				;
+			}
+			return uint32_bits_to_efloat32(bits[j]
+						       | Efloat32_quiet_bit);
+		}
+	}
+	if (!any_num) {
+		if (number && len) {
+			key = efloat32_to_uint32_bits(src[0]);
+			key |= Efloat32_quiet_bit;
+			return uint32_bits_to_efloat32(key);
+		} else if (number) {
+			return uint32_bits_to_efloat32
+			    (efloat32_canonical_nan_bits);
+		}
+		key = is_max ? efloat32_r2_sign_mask : 0;
+		return uint32_bits_to_efloat32(key | efloat32_r2_rexp_mask);
+	}
+	key = least ^ flip;
+	return uint32_bits_to_efloat32(Efloat32_order_unkey(key));
+}
+
+efloat32 efloat32_array_reduce_minimum(const efloat32 *src, size_t len)
+{
+	return efloat32_array_reduce(src, len, 0, 0);
+}
+
+efloat32 efloat32_array_reduce_maximum(const efloat32 *src, size_t len)
+{
+	return efloat32_array_reduce(src, len, 1, 0);
+}
+
+efloat32 efloat32_array_reduce_minimum_number(const efloat32 *src,
+					      size_t len)
+{
+	return efloat32_array_reduce(src, len, 0, 1);
+}
+
+efloat32 efloat32_array_reduce_maximum_number(const efloat32 *src,
+					      size_t len)
+{
+	return efloat32_array_reduce(src, len, 1, 1);
+}
+#endif
+
+#if ((defined efloat64_exists) && (efloat64_exists))
+#define Efloat64_is_nan(u) \
+	(((u) & (efloat64_r2_rexp_mask | efloat64_r2_signif_mask)) \
+	 > efloat64_r2_rexp_mask)
+
+/*
+ the smaller (or with "is_max" the larger) of "a" and "b"; with
+ "number" a NaN gives way to the other operand, otherwise a NaN wins
+*/
+static uint64_t efloat64_bits_pick(uint64_t a, uint64_t b, int is_max,
+				   int number)
+{
+	uint64_t r;
+	int a_nan, b_nan;
+
+	a_nan = Efloat64_is_nan(a);
+	b_nan = Efloat64_is_nan(b);
+	if ((Efloat64_order_key(a) < Efloat64_order_key(b)) != is_max) {
+		r = a;
+	} else {
+		r = b;
+	}
+	if (number) {
+		r = b_nan ? a : r;
+		r = a_nan ? b : r;
+		r = (a_nan && b_nan) ? (a | Efloat64_quiet_bit) : r;
+	} else {
+		r = b_nan ? (b | Efloat64_quiet_bit) : r;
+		r = a_nan ? (a | Efloat64_quiet_bit) : r;
+	}
+	return r;
+}
+
+int efloat64_total_order(efloat64 x, efloat64 y)
+{
+	uint64_t a, b;
+
+	a = efloat64_to_uint64_bits(x);
+	b = efloat64_to_uint64_bits(y);
+	return Efloat64_order_key(a) <= Efloat64_order_key(b);
+}
+
+int efloat64_total_order_mag(efloat64 x, efloat64 y)
+{
+	uint64_t a, b;
+
+	a = efloat64_to_uint64_bits(x) & ~efloat64_r2_sign_mask;
+	b = efloat64_to_uint64_bits(y) & ~efloat64_r2_sign_mask;
+	return a <= b;
+}
+
+int efloat64_total_compare(efloat64 x, efloat64 y)
+{
+	uint64_t a, b;
+
+	a = Efloat64_order_key(efloat64_to_uint64_bits(x));
+	b = Efloat64_order_key(efloat64_to_uint64_bits(y));
+	return (a > b) - (a < b);
+}
+
+static efloat64 efloat64_pick(efloat64 x, efloat64 y, int is_max, int number)
+{
+	uint64_t a, b;
+
+	a = efloat64_to_uint64_bits(x);
+	b = efloat64_to_uint64_bits(y);
+	return uint64_bits_to_efloat64(efloat64_bits_pick(a, b, is_max,
+							  number));
+}
+
+efloat64 efloat64_minimum(efloat64 x, efloat64 y)
+{
+	return efloat64_pick(x, y, 0, 0);
+}
+
+efloat64 efloat64_maximum(efloat64 x, efloat64 y)
+{
+	return efloat64_pick(x, y, 1, 0);
+}
+
+efloat64 efloat64_minimum_number(efloat64 x, efloat64 y)
+{
+	return efloat64_pick(x, y, 0, 1);
+}
+
+efloat64 efloat64_maximum_number(efloat64 x, efloat64 y)
+{
+	return efloat64_pick(x, y, 1, 1);
+}
+
+static void efloat64_array_pick(efloat64 *dst, const efloat64 *a,
+				const efloat64 *b, size_t len, int is_max,
+				int number)
+{
+	uint64_t bits[Efloat_batch_len];
+	uint64_t other[Efloat_batch_len];
+	size_t i, j, n;
+
+	for (i = 0; i < len; i += n) {
+		n = (len - i > Efloat_batch_len) ? Efloat_batch_len : len - i;
+		efloat64_array_to_uint64_bits(bits, a + i, n);
+		efloat64_array_to_uint64_bits(other, b + i, n);
+		for (j = 0; j < n; ++j) {
+			bits[j] = efloat64_bits_pick(bits[j], other[j], is_max,
+						     number);
+		}
+		uint64_bits_to_efloat64_array(dst + i, bits, n);
+	}
+}
+
+void efloat64_array_minimum(efloat64 *dst, const efloat64 *a,
+			    const efloat64 *b, size_t len)
+{
+	efloat64_array_pick(dst, a, b, len, 0, 0);
+}
+
+void efloat64_array_maximum(efloat64 *dst, const efloat64 *a,
+			    const efloat64 *b, size_t len)
+{
+	efloat64_array_pick(dst, a, b, len, 1, 0);
+}
+
+void efloat64_array_minimum_number(efloat64 *dst, const efloat64 *a,
+				   const efloat64 *b, size_t len)
+{
+	efloat64_array_pick(dst, a, b, len, 0, 1);
+}
+
+void efloat64_array_maximum_number(efloat64 *dst, const efloat64 *a,
+				   const efloat64 *b, size_t len)
+{
+	efloat64_array_pick(dst, a, b, len, 1, 1);
+}
+
+/*
+ The inner loop is only an unsigned minimum and an "or" over the keys,
+ with the maximum taken as the minimum of the complemented keys and the
+ NaNs keyed last; the first NaN is looked for only once a block is seen
+ to hold one.
+*/
+static efloat64 efloat64_array_reduce(const efloat64 *src, size_t len,
+				      int is_max, int number)
+{
+	uint64_t bits[Efloat_batch_len];
+	uint64_t flip, key, least;
+	size_t i, j, n;
+	int nan, any_nan, any_num;
+
+	flip = is_max ? UINT64_MAX : 0;
+	least = UINT64_MAX;
+	any_num = 0;
+	for (i = 0; i < len; i += n) {
+		n = (len - i > Efloat_batch_len) ? Efloat_batch_len : len - i;
+		efloat64_array_to_uint64_bits(bits, src + i, n);
+		any_nan = 0;
+		for (j = 0; j < n; ++j) {
+			nan = Efloat64_is_nan(bits[j]);
+			key = Efloat64_order_key(bits[j]) ^ flip;
+			key = nan ? UINT64_MAX : key;
+			least = (key < least) ? key : least;
+			any_nan |= nan;
+			any_num |= !nan;
+		}
+		if (any_nan && !number) {
+			for (j = 0; !Efloat64_is_nan(bits[j]); ++j) {
+				;
+			}
+			return uint64_bits_to_efloat64(bits[j]
+						       | Efloat64_quiet_bit);
+		}
+	}
+	if (!any_num) {
+		if (number && len) {
+			key = efloat64_to_uint64_bits(src[0]);
+			key |= Efloat64_quiet_bit;
+			return uint64_bits_to_efloat64(key);
+		} else if (number) {
+			return uint64_bits_to_efloat64
+			    (efloat64_canonical_nan_bits);
+		}
+		key = is_max ? efloat64_r2_sign_mask : 0;
+		return uint64_bits_to_efloat64(key | efloat64_r2_rexp_mask);
+	}
+	key = least ^ flip;
+	return uint64_bits_to_efloat64(Efloat64_order_unkey(key));
+}
+
+efloat64 efloat64_array_reduce_minimum(const efloat64 *src, size_t len)
+{
+	return efloat64_array_reduce(src, len, 0, 0);
+}
+
+efloat64 efloat64_array_reduce_maximum(const efloat64 *src, size_t len)
+{
+	return efloat64_array_reduce(src, len, 1, 0);
+}
+
+efloat64 efloat64_array_reduce_minimum_number(const efloat64 *src,
+					      size_t len)
+{
+	return efloat64_array_reduce(src, len, 0, 1);
+}
+
+efloat64 efloat64_array_reduce_maximum_number(const efloat64 *src,
+					      size_t len)
+{
+	return efloat64_array_reduce(src, len, 1, 1);
+}
+#endif
@@ -0,0 +1,343 @@
+/* SPDX-License-Identifier: LGPL-2.1-or-later */
+/* efloat-mx.c: block floating point with shared exponents, MX style */
+/* Copyright (C) 2026 Eric Herman */
+/* https://github.com/ericherman/libefloat */
+
+#include "efloat-internal.h"
+
+#define Efloat_mx_scale_bias 127
+#define Efloat_mx_scale_max 127
+#define Efloat_mx_scale_min -127
+
+static int efloat_mx_bits_valid(unsigned bits)
+{
+	return (bits == 4) || (bits == 6) || (bits == 8);
+}
+
+/* pack a block of "bits" wide two's complement elements, LSB first */
+static void efloat_mx_pack(uint8_t *p, const int32_t *q, unsigned bits)
+{
+	uint32_t acc, mask;
+	unsigned acc_bits;
+	size_t j;
+
+	mask = (((uint32_t)1) << bits) - 1;
+	acc = 0;
+	acc_bits = 0;
+	for (j = 0; j < efloat_mx_block_len; ++j) {
+		acc |= (((uint32_t)q[j]) & mask) << acc_bits;
+		acc_bits += bits;
+		while (acc_bits >= 8) {
+			*p++ = (uint8_t)acc;
+			acc >>= 8;
+			acc_bits -= 8;
+		}
+	}
+}
+
+static void efloat_mx_unpack(int32_t *q, const uint8_t *p, unsigned bits)
+{
+	uint32_t acc, mask, sign;
+	unsigned acc_bits;
+	size_t j;
+
+	mask = (((uint32_t)1) << bits) - 1;
+	sign = ((uint32_t)1) << (bits - 1);
+	acc = 0;
+	acc_bits = 0;
+	for (j = 0; j < efloat_mx_block_len; ++j) {
+		while (acc_bits < bits) {
+			acc |= ((uint32_t)*p++) << acc_bits;
+			acc_bits += 8;
+		}
+		/* sign extend */
+		q[j] = (int32_t)((acc & mask) ^ sign) - (int32_t)sign;
+		acc >>= bits;
+		acc_bits -= bits;
+	}
+}
+
+/*
+ Round m * 2^-shift to nearest, ties to even, saturating at "max"; a
+ negative shift always saturates.
+*/
+static int32_t efloat_mx_round(uint64_t m, int shift, int32_t max)
+{
+	uint64_t q;
+
+	if (shift < 0) {
+		return m ? max : 0;
+	} else if (shift == 0) {
+		q = m;
+	} else {
+		if (shift > 63) {
+			shift = 63;
+		}
+		q = (m + ((((uint64_t)1) << (shift - 1)) - 1)
+		     + ((m >> shift) & 1)) >> shift;
+	}
+	return (q > (uint64_t)max) ? max : (int32_t)q;
+}
+
+#if ((defined efloat32_exists) && (efloat32_exists))
+static efloat32 efloat32_mx_pow2(int e)
+{
+	if (e >= -126) {
+		return uint32_bits_to_efloat32(((uint32_t)(e + 127)) << 23);
+	}
+	return uint32_bits_to_efloat32(((uint32_t)1) << (e + 149));
+}
+
+static int32_t efloat32_mx_quantize(uint32_t u, int x, unsigned bits)
+{
+	uint32_t rexp, m;
+	int e;
+	int32_t q;
+
+	rexp = (u & efloat32_r2_rexp_mask) >> efloat32_r2_exp_shift;
+	m = u & efloat32_r2_signif_mask;
+	if (rexp) {
+		m |= ((uint32_t)1) << efloat32_r2_exp_shift;
+	}
+	e = rexp ? ((int)rexp - Efloat_mx_scale_bias) : -126;
+	q = efloat_mx_round(m, efloat32_r2_exp_shift + 2 + x - (int)bits - e,
+			    (int32_t)((1 << (bits - 1)) - 1));
+	return (u & efloat32_r2_sign_mask) ? -q : q;
+}
+
+size_t efloat32_mx_encode(uint8_t *buf, size_t size, const efloat32 *a,
+			  size_t len, unsigned bits, efloat32 *max_err)
+{
+	uint32_t u[efloat_mx_block_len];
+	int32_t q[efloat_mx_block_len];
+	struct efloat32_fields fields;
+	enum efloat_class cls;
+	efloat32 scale, err, max;
+	uint32_t amax;
+	size_t i, j, n, pos;
+	int x;
+
+	if (!efloat_mx_bits_valid(bits) || size < efloat_mx_bytes(len, bits)) {
+		Efloat_set_err_inval();
+		return 0;
+	}
+
+	max = 0;
+	pos = 0;
+	for (i = 0; i < len; i += n) {
+		n = len - i;
+		if (n > efloat_mx_block_len) {
+			n = efloat_mx_block_len;
+		}
+		efloat32_array_to_uint32_bits(u, a + i, n);
+		for (j = n; j < efloat_mx_block_len; ++j) {
+			u[j] = 0;
+		}
+		amax = 0;
+		for (j = 0; j < efloat_mx_block_len; ++j) {
+			amax = ((u[j] & ~efloat32_r2_sign_mask) > amax)
+			    ? (u[j] & ~efloat32_r2_sign_mask) : amax;
+		}
+
+		cls = efloat32_radix_2_to_fields(uint32_bits_to_efloat32(amax),
+						 &fields);
+		if (cls == ef_nan || cls == ef_inf) {
+			buf[pos] = efloat_mx_scale_nan;
+			for (j = 0; j < efloat_mx_block_len; ++j) {
+				q[j] = 0;
+			}
+			efloat_mx_pack(buf + pos + 1, q, bits);
+			pos += efloat_mx_block_bytes(bits);
+			continue;
+		}
+		x = (cls == ef_normal) ? fields.exponent : Efloat_mx_scale_min;
+		x = (x < Efloat_mx_scale_min) ? Efloat_mx_scale_min : x;
+		x = (x > Efloat_mx_scale_max) ? Efloat_mx_scale_max : x;
+
+		for (j = 0; j < efloat_mx_block_len; ++j) {
+			q[j] = efloat32_mx_quantize(u[j], x, bits);
+		}
+		buf[pos] = (uint8_t)(x + Efloat_mx_scale_bias);
+		efloat_mx_pack(buf + pos + 1, q, bits);
+		pos += efloat_mx_block_bytes(bits);
+
+		scale = efloat32_mx_pow2(x + 2 - (int)bits);
+		for (j = 0; j < n; ++j) {
+			err = (((efloat32)q[j]) * scale) - a[i + j];
+			err = (err < 0) ? -err : err;
+			max = (err > max) ? err : max;
+		}
+	}
+	if (max_err) {
+		*max_err = max;
+	}
+	return pos;
+}
+
+size_t efloat32_mx_decode(efloat32 *out, size_t len, const uint8_t *buf,
+			  size_t size, unsigned bits)
+{
+	int32_t q[efloat_mx_block_len];
+	efloat32 scale, nan;
+	size_t i, j, n, pos;
+
+	if (!efloat_mx_bits_valid(bits) || size < efloat_mx_bytes(len, bits)) {
+		Efloat_set_err_inval();
+		return 0;
+	}
+	nan = uint32_bits_to_efloat32(efloat32_canonical_nan_bits);
+	pos = 0;
+	for (i = 0; i < len; i += n) {
+		n = len - i;
+		if (n > efloat_mx_block_len) {
+			n = efloat_mx_block_len;
+		}
+		if (buf[pos] == efloat_mx_scale_nan) {
+			for (j = 0; j < n; ++j) {
+				out[i + j] = nan;
+			}
+		} else {
+			efloat_mx_unpack(q, buf + pos + 1, bits);
+			scale = efloat32_mx_pow2((int)buf[pos]
+						 - Efloat_mx_scale_bias + 2
+						 - (int)bits);
+			for (j = 0; j < n; ++j) {
+				out[i + j] = ((efloat32)q[j]) * scale;
+			}
+		}
+		pos += efloat_mx_block_bytes(bits);
+	}
+	return len;
+}
+#endif
+
+#if ((defined efloat64_exists) && (efloat64_exists))
+/* the scale of an element is within the normal range of a 64 bit float */
+static efloat64 efloat64_mx_pow2(int e)
+{
+	return uint64_bits_to_efloat64(((uint64_t)(e + efloat64_r2_exp_max))
+				       << efloat64_r2_exp_shift);
+}
+
+static int32_t efloat64_mx_quantize(uint64_t u, int x, unsigned bits)
+{
+	uint64_t rexp, m;
+	int e;
+	int32_t q;
+
+	rexp = (u & efloat64_r2_rexp_mask) >> efloat64_r2_exp_shift;
+	m = u & efloat64_r2_signif_mask;
+	if (rexp) {
+		m |= ((uint64_t)1) << efloat64_r2_exp_shift;
+	}
+	e = rexp ? ((int)rexp - efloat64_r2_exp_max) : -1022;
+	q = efloat_mx_round(m, efloat64_r2_exp_shift + 2 + x - (int)bits - e,
+			    (int32_t)((1 << (bits - 1)) - 1));
+	return (u & efloat64_r2_sign_mask) ? -q : q;
+}
+
+size_t efloat64_mx_encode(uint8_t *buf, size_t size, const efloat64 *a,
+			  size_t len, unsigned bits, efloat64 *max_err)
+{
+	uint64_t u[efloat_mx_block_len];
+	int32_t q[efloat_mx_block_len];
+	struct efloat64_fields fields;
+	enum efloat_class cls;
+	efloat64 scale, err, max;
+	uint64_t amax;
+	size_t i, j, n, pos;
+	int x;
+
+	if (!efloat_mx_bits_valid(bits) || size < efloat_mx_bytes(len, bits)) {
+		Efloat_set_err_inval();
+		return 0;
+	}
+
+	max = 0;
+	pos = 0;
+	for (i = 0; i < len; i += n) {
+		n = len - i;
+		if (n > efloat_mx_block_len) {
+			n = efloat_mx_block_len;
+		}
+		efloat64_array_to_uint64_bits(u, a + i, n);
+		for (j = n; j < efloat_mx_block_len; ++j) {
+			u[j] = 0;
+		}
+		amax = 0;
+		for (j = 0; j < efloat_mx_block_len; ++j) {
+			amax = ((u[j] & ~efloat64_r2_sign_mask) > amax)
+			    ? (u[j] & ~efloat64_r2_sign_mask) : amax;
+		}
+
+		cls = efloat64_radix_2_to_fields(uint64_bits_to_efloat64(amax),
+						 &fields);
+		if (cls == ef_nan || cls == ef_inf) {
+			buf[pos] = efloat_mx_scale_nan;
+			for (j = 0; j < efloat_mx_block_len; ++j) {
+				q[j] = 0;
+			}
+			efloat_mx_pack(buf + pos + 1, q, bits);
+			pos += efloat_mx_block_bytes(bits);
+			continue;
+		}
+		x = (cls == ef_normal) ? fields.exponent : Efloat_mx_scale_min;
+		x = (x < Efloat_mx_scale_min) ? Efloat_mx_scale_min : x;
+		x = (x > Efloat_mx_scale_max) ? Efloat_mx_scale_max : x;
+
+		for (j = 0; j < efloat_mx_block_len; ++j) {
+			q[j] = efloat64_mx_quantize(u[j], x, bits);
+		}
+		buf[pos] = (uint8_t)(x + Efloat_mx_scale_bias);
+		efloat_mx_pack(buf + pos + 1, q, bits);
+		pos += efloat_mx_block_bytes(bits);
+
+		scale = efloat64_mx_pow2(x + 2 - (int)bits);
+		for (j = 0; j < n; ++j) {
+			err = (((efloat64)q[j]) * scale) - a[i + j];
+			err = (err < 0) ? -err : err;
+			max = (err > max) ? err : max;
+		}
+	}
+	if (max_err) {
+		*max_err = max;
+	}
+	return pos;
+}
+
+size_t efloat64_mx_decode(efloat64 *out, size_t len, const uint8_t *buf,
+			  size_t size, unsigned bits)
+{
+	int32_t q[efloat_mx_block_len];
+	efloat64 scale, nan;
+	size_t i, j, n, pos;
+
+	if (!efloat_mx_bits_valid(bits) || size < efloat_mx_bytes(len, bits)) {
+		Efloat_set_err_inval();
+		return 0;
+	}
+	nan = uint64_bits_to_efloat64(efloat64_canonical_nan_bits);
+	pos = 0;
+	for (i = 0; i < len; i += n) {
+		n = len - i;
+		if (n > efloat_mx_block_len) {
+			n = efloat_mx_block_len;
+		}
+		if (buf[pos] == efloat_mx_scale_nan) {
+			for (j = 0; j < n; ++j) {
+				out[i + j] = nan;
+			}
+		} else {
+			efloat_mx_unpack(q, buf + pos + 1, bits);
+			scale = efloat64_mx_pow2((int)buf[pos]
+						 - Efloat_mx_scale_bias + 2
+						 - (int)bits);
+			for (j = 0; j < n; ++j) {
+				out[i + j] = ((efloat64)q[j]) * scale;
+			}
+		}
+		pos += efloat_mx_block_bytes(bits);
+	}
+	return len;
+}
+#endif
@@ -0,0 +1,128 @@
+/* SPDX-License-Identifier: LGPL-2.1-or-later */
+/* efloat-nanbox.c: tagged values carried in quiet NaN payloads */
+/* Copyright (C) 2026 Eric Herman */
+/* https://github.com/ericherman/libefloat */
+
+#include "efloat-internal.h"
+
+#if ((defined efloat32_exists) && (efloat32_exists))
+efloat32 efloat32_nanbox(unsigned tag, uint32_t payload)
+{
+	if (tag == 0 || (tag >> efloat32_nanbox_tag_bits) != 0
+	    || (payload & ~efloat32_nanbox_payload_mask) != 0) {
+		Efloat_set_err_inval();
+		return uint32_bits_to_efloat32(efloat32_canonical_nan_bits);
+	}
+	return uint32_bits_to_efloat32(efloat32_bits_nanbox(tag, payload));
+}
+
+int efloat32_is_nanbox(efloat32 f)
+{
+	uint32_t u;
+
+	u = efloat32_to_uint32_bits(f);
+	return efloat32_bits_is_nanbox(u);
+}
+
+unsigned efloat32_nanbox_tag(efloat32 f)
+{
+	uint32_t u;
+
+	u = efloat32_to_uint32_bits(f);
+	return efloat32_bits_is_nanbox(u) ? efloat32_bits_nanbox_tag(u) : 0;
+}
+
+uint32_t efloat32_nanbox_payload(efloat32 f)
+{
+	uint32_t u;
+
+	u = efloat32_to_uint32_bits(f);
+	return efloat32_bits_is_nanbox(u) ? efloat32_bits_nanbox_payload(u)
+	    : 0;
+}
+
+efloat32 efloat32_nanbox_clean(efloat32 f)
+{
+	uint32_t u;
+
+	u = efloat32_to_uint32_bits(f);
+	return uint32_bits_to_efloat32(efloat32_bits_nanbox_clean(u));
+}
+
+void efloat32_array_nanbox_clean(efloat32 *dst, const efloat32 *src,
+				 size_t len)
+{
+	uint32_t bits[Efloat_batch_len];
+	size_t i, j, n;
+
+	for (i = 0; i < len; i += n) {
+		n = (len - i > Efloat_batch_len) ? Efloat_batch_len : len - i;
+		efloat32_array_to_uint32_bits(bits, src + i, n);
+		for (j = 0; j < n; ++j) {
+			bits[j] = efloat32_bits_nanbox_clean(bits[j]);
+		}
+		uint32_bits_to_efloat32_array(dst + i, bits, n);
+	}
+}
+#endif
+
+#if ((defined efloat64_exists) && (efloat64_exists))
+efloat64 efloat64_nanbox(unsigned tag, uint64_t payload)
+{
+	if (tag == 0 || (tag >> efloat64_nanbox_tag_bits) != 0
+	    || (payload & ~efloat64_nanbox_payload_mask) != 0) {
+		Efloat_set_err_inval();
+		return uint64_bits_to_efloat64(efloat64_canonical_nan_bits);
+	}
+	return uint64_bits_to_efloat64(efloat64_bits_nanbox(tag, payload));
+}
+
+int efloat64_is_nanbox(efloat64 d)
+{
+	uint64_t u;
+
+	u = efloat64_to_uint64_bits(d);
+	return efloat64_bits_is_nanbox(u);
+}
+
+unsigned efloat64_nanbox_tag(efloat64 d)
+{
+	uint64_t u;
+
+	u = efloat64_to_uint64_bits(d);
+	return efloat64_bits_is_nanbox(u) ? efloat64_bits_nanbox_tag(u) : 0;
+}
+
+uint64_t efloat64_nanbox_payload(efloat64 d)
+{
+	uint64_t u;
+
+	u = efloat64_to_uint64_bits(d);
+	return efloat64_bits_is_nanbox(u) ? efloat64_bits_nanbox_payload(u)
+	    : 0;
+}
+
+efloat64 efloat64_nanbox_clean(efloat64 d)
+{
+	uint64_t u;
+
+	u = efloat64_to_uint64_bits(d);
+	return uint64_bits_to_efloat64(efloat64_bits_nanbox_clean(u));
+}
+
+void efloat64_array_nanbox_clean(efloat64 *dst, const efloat64 *src,
+				 size_t len)
+{
+	uint64_t bits[Efloat_batch_len];
+	size_t i, j, n;
+
+	for (i = 0; i < len; i += n) {
+		n = (len - i > Efloat_batch_len) ? Efloat_batch_len : len - i;
+		efloat64_array_to_uint64_bits(bits, src + i, n);
+		for (j = 0; j < n; ++j) {
+			bits[j] = efloat64_bits_nanbox_clean(bits[j]);
+		}
+		uint64_bits_to_efloat64_array(dst + i, bits, n);
+	}
+}
+#endif
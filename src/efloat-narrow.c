@@ -0,0 +1,437 @@
+/* SPDX-License-Identifier: LGPL-2.1-or-later */
+/* efloat-narrow.c: exact representability in narrower types */
+/* Copyright (C) 2026 Eric Herman */
+/* https://github.com/ericherman/libefloat */
+
+#include "efloat-internal.h"
+
+/*
+ A finite value is (sig * 2^(rexp' - bias - shift)) where rexp' is the
+ raw exponent (or 1 for subnormals) and sig includes the implicit bit.
+ For the value to fit a format with signif_bits and a minimum normal
+ exponent of emin, the low bits of sig must be zero:
+   at least (shift - signif_bits) of them, for precision, and
+   at least (emin - signif_bits + bias + shift - rexp') of them, for the
+   smallest subnormal quantum of the narrower format.
+ For an integer, the low (bias + shift - rexp') bits must be zero.
+ Counting the required zeros and testing with a mask, rather than
+ counting trailing zeros, keeps these free of branches.
+*/
+
+#define Efloat_fits_format 0
+#define Efloat_fits_int 1
+#define Efloat_fits_uint 2
+
+void efloat_narrowing_init(struct efloat_narrowing *narrowing)
+{
+	size_t i;
+
+	narrowing->count = 0;
+	for (i = 0; i < ef_narrow_none; ++i) {
+		narrowing->fits[i] = 0;
+	}
+}
+
+void efloat_narrowing_merge(struct efloat_narrowing *narrowing,
+			    const struct efloat_narrowing *other)
+{
+	size_t i;
+
+	narrowing->count += other->count;
+	for (i = 0; i < ef_narrow_none; ++i) {
+		narrowing->fits[i] += other->fits[i];
+	}
+}
+
+enum efloat_narrow efloat_narrowing_best(const struct efloat_narrowing
+					 *narrowing)
+{
+	size_t i;
+
+	for (i = 0; i < ef_narrow_none; ++i) {
+		if (narrowing->fits[i] == narrowing->count) {
+			return (enum efloat_narrow)i;
+		}
+	}
+	return ef_narrow_none;
+}
+
+static int efloat_fits_params_valid(int kind, unsigned p1, unsigned p2)
+{
+	if (kind == Efloat_fits_format) {
+		return (p1 >= 2) && (p1 <= 15) && (p2 <= 63);
+	}
+	return (p1 >= 1) && (p1 <= 64);
+}
+
+#if ((defined efloat32_exists) && (efloat32_exists))
+static uint32_t efloat32_fits_format_u(uint32_t u, int32_t exp_bits,
+				       int32_t signif_bits)
+{
+	uint32_t rexp, frac, sig, low_zero, in_range, nan_ok;
+	int32_t t_bias, k, k2;
+	const uint32_t rexp_all = (efloat32_r2_rexp_mask
+				   >> efloat32_r2_exp_shift);
+
+	rexp = (u & efloat32_r2_rexp_mask) >> efloat32_r2_exp_shift;
+	frac = u & efloat32_r2_signif_mask;
+	sig = frac | ((uint32_t)(rexp != 0) << efloat32_r2_exp_shift);
+
+	t_bias = ((int32_t)1 << (exp_bits - 1)) - 1;
+	k2 = efloat32_r2_exp_shift - signif_bits;
+	k2 = (k2 < 0) ? 0 : k2;
+	k = (1 - t_bias) - signif_bits
+	    + (efloat32_r2_exp_max + efloat32_r2_exp_shift)
+	    - (int32_t)(rexp + (rexp == 0));
+	k = (k < k2) ? k2 : k;
+	if (k > (efloat32_r2_exp_shift + 1)) {
+		k = (efloat32_r2_exp_shift + 1);
+	}
+
+	low_zero = (sig & (((uint32_t)1 << k) - 1)) == 0;
+	in_range = ((int32_t)rexp - efloat32_r2_exp_max) <= t_bias;
+	nan_ok = (frac & (((uint32_t)1 << k2) - 1)) == 0;
+
+	return (rexp == rexp_all) ? nan_ok : (low_zero & in_range);
+}
+
+static uint32_t efloat32_fits_int_u(uint32_t u, int32_t bits, int is_signed)
+{
+	uint32_t rexp, frac, sig, neg, integral, in_range, not_neg_zero;
+	int32_t k, e;
+	const uint32_t rexp_all = (efloat32_r2_rexp_mask
+				   >> efloat32_r2_exp_shift);
+
+	rexp = (u & efloat32_r2_rexp_mask) >> efloat32_r2_exp_shift;
+	frac = u & efloat32_r2_signif_mask;
+	sig = frac | ((uint32_t)(rexp != 0) << efloat32_r2_exp_shift);
+	neg = (u >> 31);
+
+	k = (efloat32_r2_exp_max + efloat32_r2_exp_shift)
+	    - (int32_t)(rexp + (rexp == 0));
+	k = (k < 0) ? 0 : k;
+	if (k > (efloat32_r2_exp_shift + 1)) {
+		k = (efloat32_r2_exp_shift + 1);
+	}
+	integral = (sig & (((uint32_t)1 << k) - 1)) == 0;
+
+	e = (int32_t)rexp - efloat32_r2_exp_max;
+	if (is_signed) {
+		in_range = (e < (bits - 1))
+		    | ((e == (bits - 1)) & neg & (frac == 0));
+	} else {
+		in_range = (e < bits) & (neg ^ 1);
+	}
+
+	/* -0.0 would come back as 0.0 */
+	not_neg_zero = (neg & (sig == 0)) ^ 1;
+
+	return (rexp != rexp_all) & integral & in_range & not_neg_zero;
+}
+
+static size_t efloat32_fits(const efloat32 *a, size_t len, int kind,
+			    unsigned p1, unsigned p2, uint8_t *out)
+{
+	uint32_t bits[Efloat_batch_len];
+	uint8_t ok[Efloat_batch_len];
+	size_t i, j, n, count, block_count;
+	int is_signed;
+
+	if ((len && !a) || !efloat_fits_params_valid(kind, p1, p2)) {
+		Efloat_set_err_inval();
+		return 0;
+	}
+
+	is_signed = (kind == Efloat_fits_int);
+	count = 0;
+	for (i = 0; i < len; i += n) {
+		n = len - i;
+		if (n > Efloat_batch_len) {
+			n = Efloat_batch_len;
+		}
+		efloat32_array_to_uint32_bits(bits, a + i, n);
+		/* pad with 0.0, which always fits, and take it back out */
+		for (j = n; j < Efloat_batch_len; ++j) {
+			bits[j] = 0;
+		}
+
+		block_count = 0;
+		if (kind == Efloat_fits_format) {
+			for (j = 0; j < Efloat_batch_len; ++j) {
+				ok[j] = (uint8_t)
+				    efloat32_fits_format_u(bits[j], p1, p2);
+				block_count += ok[j];
+			}
+		} else {
+			for (j = 0; j < Efloat_batch_len; ++j) {
+				ok[j] = (uint8_t)
+				    efloat32_fits_int_u(bits[j], p1, is_signed);
+				block_count += ok[j];
+			}
+		}
+		count += block_count - (Efloat_batch_len - n);
+		if (out) {
+			for (j = 0; j < n; ++j) {
+				out[i + j] = ok[j];
+			}
+		}
+	}
+	return count;
+}
+
+size_t efloat32_fits_format(const efloat32 *a, size_t len,
+			    unsigned exp_bits, unsigned signif_bits,
+			    uint8_t *out)
+{
+	return efloat32_fits(a, len, Efloat_fits_format, exp_bits,
+			     signif_bits, out);
+}
+
+size_t efloat32_fits_int(const efloat32 *a, size_t len, unsigned bits,
+			 uint8_t *out)
+{
+	return efloat32_fits(a, len, Efloat_fits_int, bits, 0, out);
+}
+
+size_t efloat32_fits_uint(const efloat32 *a, size_t len, unsigned bits,
+			  uint8_t *out)
+{
+	return efloat32_fits(a, len, Efloat_fits_uint, bits, 0, out);
+}
+
+void efloat32_narrowing_add(struct efloat_narrowing *narrowing,
+			    const efloat32 *a, size_t len)
+{
+	uint32_t bits[Efloat_batch_len];
+	uint32_t u, i8, i16, f16, bf16, i32;
+	const int32_t f16_exp = efloat_float16_exp_bits;
+	const int32_t f16_signif = efloat_float16_signif_bits;
+	const int32_t bf_exp = efloat_bfloat16_exp_bits;
+	const int32_t bf_signif = efloat_bfloat16_signif_bits;
+	size_t i, j, n, pad;
+
+	for (i = 0; i < len; i += n) {
+		n = len - i;
+		if (n > Efloat_batch_len) {
+			n = Efloat_batch_len;
+		}
+		efloat32_array_to_uint32_bits(bits, a + i, n);
+		for (j = n; j < Efloat_batch_len; ++j) {
+			bits[j] = 0;
+		}
+
+		i8 = 0;
+		i16 = 0;
+		f16 = 0;
+		bf16 = 0;
+		i32 = 0;
+		for (j = 0; j < Efloat_batch_len; ++j) {
+			u = bits[j];
+			i8 += efloat32_fits_int_u(u, 8, 1);
+			i16 += efloat32_fits_int_u(u, 16, 1);
+			f16 += efloat32_fits_format_u(u, f16_exp, f16_signif);
+			bf16 += efloat32_fits_format_u(u, bf_exp, bf_signif);
+			i32 += efloat32_fits_int_u(u, 32, 1);
+		}
+		pad = Efloat_batch_len - n;
+		narrowing->count += n;
+		narrowing->fits[ef_narrow_int8] += i8 - pad;
+		narrowing->fits[ef_narrow_int16] += i16 - pad;
+		narrowing->fits[ef_narrow_float16] += f16 - pad;
+		narrowing->fits[ef_narrow_bfloat16] += bf16 - pad;
+		narrowing->fits[ef_narrow_int32] += i32 - pad;
+		narrowing->fits[ef_narrow_float32] += n;
+	}
+}
+#endif
+
+#if ((defined efloat64_exists) && (efloat64_exists))
+static uint64_t efloat64_fits_format_u(uint64_t u, int32_t exp_bits,
+				       int32_t signif_bits)
+{
+	uint64_t rexp, frac, sig, low_zero, in_range, nan_ok;
+	int32_t t_bias, k, k2;
+	const uint64_t rexp_all = (efloat64_r2_rexp_mask
+				   >> efloat64_r2_exp_shift);
+
+	rexp = (u & efloat64_r2_rexp_mask) >> efloat64_r2_exp_shift;
+	frac = u & efloat64_r2_signif_mask;
+	sig = frac | ((uint64_t)(rexp != 0) << efloat64_r2_exp_shift);
+
+	t_bias = ((int32_t)1 << (exp_bits - 1)) - 1;
+	k2 = efloat64_r2_exp_shift - signif_bits;
+	k2 = (k2 < 0) ? 0 : k2;
+	k = (1 - t_bias) - signif_bits
+	    + (efloat64_r2_exp_max + efloat64_r2_exp_shift)
+	    - (int32_t)(rexp + (rexp == 0));
+	k = (k < k2) ? k2 : k;
+	if (k > (efloat64_r2_exp_shift + 1)) {
+		k = (efloat64_r2_exp_shift + 1);
+	}
+
+	low_zero = (sig & (((uint64_t)1 << k) - 1)) == 0;
+	in_range = ((int32_t)rexp - efloat64_r2_exp_max) <= t_bias;
+	nan_ok = (frac & (((uint64_t)1 << k2) - 1)) == 0;
+
+	return (rexp == rexp_all) ? nan_ok : (low_zero & in_range);
+}
+
+static uint64_t efloat64_fits_int_u(uint64_t u, int32_t bits, int is_signed)
+{
+	uint64_t rexp, frac, sig, neg, integral, in_range, not_neg_zero;
+	int32_t k, e;
+	const uint64_t rexp_all = (efloat64_r2_rexp_mask
+				   >> efloat64_r2_exp_shift);
+
+	rexp = (u & efloat64_r2_rexp_mask) >> efloat64_r2_exp_shift;
+	frac = u & efloat64_r2_signif_mask;
+	sig = frac | ((uint64_t)(rexp != 0) << efloat64_r2_exp_shift);
+	neg = (u >> 63);
+
+	k = (efloat64_r2_exp_max + efloat64_r2_exp_shift)
+	    - (int32_t)(rexp + (rexp == 0));
+	k = (k < 0) ? 0 : k;
+	if (k > (efloat64_r2_exp_shift + 1)) {
+		k = (efloat64_r2_exp_shift + 1);
+	}
+	integral = (sig & (((uint64_t)1 << k) - 1)) == 0;
+
+	e = (int32_t)rexp - efloat64_r2_exp_max;
+	if (is_signed) {
+		in_range = (e < (bits - 1))
+		    | ((e == (bits - 1)) & neg & (frac == 0));
+	} else {
+		in_range = (e < bits) & (neg ^ 1);
+	}
+
+	/* -0.0 would come back as 0.0 */
+	not_neg_zero = (neg & (sig == 0)) ^ 1;
+
+	return (rexp != rexp_all) & integral & in_range & not_neg_zero;
+}
+
+static size_t efloat64_fits(const efloat64 *a, size_t len, int kind,
+			    unsigned p1, unsigned p2, uint8_t *out)
+{
+	uint64_t bits[Efloat_batch_len];
+	uint8_t ok[Efloat_batch_len];
+	size_t i, j, n, count, block_count;
+	int is_signed;
+
+	if ((len && !a) || !efloat_fits_params_valid(kind, p1, p2)) {
+		Efloat_set_err_inval();
+		return 0;
+	}
+
+	is_signed = (kind == Efloat_fits_int);
+	count = 0;
+	for (i = 0; i < len; i += n) {
+		n = len - i;
+		if (n > Efloat_batch_len) {
+			n = Efloat_batch_len;
+		}
+		efloat64_array_to_uint64_bits(bits, a + i, n);
+		for (j = n; j < Efloat_batch_len; ++j) {
+			bits[j] = 0;
+		}
+
+		block_count = 0;
+		if (kind == Efloat_fits_format) {
+			for (j = 0; j < Efloat_batch_len; ++j) {
+				ok[j] = (uint8_t)
+				    efloat64_fits_format_u(bits[j], p1, p2);
+				block_count += ok[j];
+			}
+		} else {
+			for (j = 0; j < Efloat_batch_len; ++j) {
+				ok[j] = (uint8_t)
+				    efloat64_fits_int_u(bits[j], p1, is_signed);
+				block_count += ok[j];
+			}
+		}
+		count += block_count - (Efloat_batch_len - n);
+		if (out) {
+			for (j = 0; j < n; ++j) {
+				out[i + j] = ok[j];
+			}
+		}
+	}
+	return count;
+}
+
+size_t efloat64_fits_efloat32(const efloat64 *a, size_t len, uint8_t *out)
+{
+	return efloat64_fits(a, len, Efloat_fits_format,
+			     efloat_float32_exp_bits,
+			     efloat_float32_signif_bits, out);
+}
+
+size_t efloat64_fits_format(const efloat64 *a, size_t len,
+			    unsigned exp_bits, unsigned signif_bits,
+			    uint8_t *out)
+{
+	return efloat64_fits(a, len, Efloat_fits_format, exp_bits,
+			     signif_bits, out);
+}
+
+size_t efloat64_fits_int(const efloat64 *a, size_t len, unsigned bits,
+			 uint8_t *out)
+{
+	return efloat64_fits(a, len, Efloat_fits_int, bits, 0, out);
+}
+
+size_t efloat64_fits_uint(const efloat64 *a, size_t len, unsigned bits,
+			  uint8_t *out)
+{
+	return efloat64_fits(a, len, Efloat_fits_uint, bits, 0, out);
+}
+
+void efloat64_narrowing_add(struct efloat_narrowing *narrowing,
+			    const efloat64 *a, size_t len)
+{
+	uint64_t bits[Efloat_batch_len];
+	uint64_t u, i8, i16, f16, bf16, i32, f32;
+	const int32_t f32_exp = efloat_float32_exp_bits;
+	const int32_t f32_signif = efloat_float32_signif_bits;
+	const int32_t f16_exp = efloat_float16_exp_bits;
+	const int32_t f16_signif = efloat_float16_signif_bits;
+	const int32_t bf_exp = efloat_bfloat16_exp_bits;
+	const int32_t bf_signif = efloat_bfloat16_signif_bits;
+	size_t i, j, n, pad;
+
+	for (i = 0; i < len; i += n) {
+		n = len - i;
+		if (n > Efloat_batch_len) {
+			n = Efloat_batch_len;
+		}
+		efloat64_array_to_uint64_bits(bits, a + i, n);
+		for (j = n; j < Efloat_batch_len; ++j) {
+			bits[j] = 0;
+		}
+
+		i8 = 0;
+		i16 = 0;
+		f16 = 0;
+		bf16 = 0;
+		i32 = 0;
+		f32 = 0;
+		for (j = 0; j < Efloat_batch_len; ++j) {
+			u = bits[j];
+			i8 += efloat64_fits_int_u(u, 8, 1);
+			i16 += efloat64_fits_int_u(u, 16, 1);
+			f16 += efloat64_fits_format_u(u, f16_exp, f16_signif);
+			bf16 += efloat64_fits_format_u(u, bf_exp, bf_signif);
+			i32 += efloat64_fits_int_u(u, 32, 1);
+			f32 += efloat64_fits_format_u(u, f32_exp, f32_signif);
+		}
+		pad = Efloat_batch_len - n;
+		narrowing->count += n;
+		narrowing->fits[ef_narrow_int8] += i8 - pad;
+		narrowing->fits[ef_narrow_int16] += i16 - pad;
+		narrowing->fits[ef_narrow_float16] += f16 - pad;
+		narrowing->fits[ef_narrow_bfloat16] += bf16 - pad;
+		narrowing->fits[ef_narrow_int32] += i32 - pad;
+		narrowing->fits[ef_narrow_float32] += f32 - pad;
+	}
+}
+#endif
@@ -0,0 +1,642 @@
+/* SPDX-License-Identifier: LGPL-2.1-or-later */
+/* efloat-posit.c: conversion to and from posit<nbits,es> */
+/* Copyright (C) 2026 Eric Herman */
+/* https://github.com/ericherman/libefloat */
+
+#include "efloat-internal.h"
+
+#define Efloat_posit8_table_len 256
+
+static int efloat_posit_valid(unsigned nbits, unsigned es)
+{
+	if (nbits < 2 || nbits > 32 || es > efloat_posit_es_max) {
+		Efloat_set_err_inval();
+		return 0;
+	}
+	return 1;
+}
+
+static uint32_t efloat_posit_mask(unsigned nbits)
+{
+	return (nbits == 32) ? UINT32_MAX : ((((uint32_t)1) << nbits) - 1);
+}
+
+/*
+ Split a posit into its sign, scale (the power of two) and fraction,
+ left aligned without the hidden bit. Returns ef_zero, ef_nan (for NaR)
+ or ef_normal.
+*/
+static enum efloat_class efloat_posit_split(uint32_t p, unsigned nbits,
+					    unsigned es, int *neg, int *scale,
+					    uint64_t *frac)
+{
+	uint32_t mask, sign_bit;
+	uint64_t x;
+	unsigned run;
+	int k;
+
+	mask = efloat_posit_mask(nbits);
+	sign_bit = ((uint32_t)1) << (nbits - 1);
+	p &= mask;
+	if ((p & ~sign_bit) == 0) {
+		return p ? ef_nan : ef_zero;
+	}
+	*neg = (p & sign_bit) ? 1 : 0;
+	if (*neg) {
+		p = (0 - p) & mask;
+	}
+
+	/* the bits after the sign, left aligned; the low bits are zero */
+	x = ((uint64_t)p) << (65 - nbits);
+	if (x >> 63) {
+		run = Efloat_u64_clz(~x);
+		k = (int)run - 1;
+	} else {
+		run = Efloat_u64_clz(x);
+		k = -(int)run;
+	}
+	/* skip the regime and its terminating bit */
+	x = (x << run) << 1;
+	*scale = (k * (1 << es)) + (es ? (int)(x >> (64 - es)) : 0);
+	*frac = x << es;
+	return ef_normal;
+}
+
+/*
+ The posit nearest to (-1)^neg * sig * 2^(scale - 63), where "sig" has
+ its leading one in the top bit. Rounding is to nearest, ties to even,
+ on the bit string; as posits never overflow or underflow, magnitudes
+ beyond the range saturate at maxpos and minpos.
+*/
+static uint32_t efloat_posit_round(int neg, int scale, uint64_t sig,
+				   unsigned nbits, unsigned es)
+{
+	uint32_t keep, e;
+	uint64_t y, f, sticky;
+	unsigned len, drop;
+	int max_scale, k;
+
+	max_scale = ((int)nbits - 2) * (1 << es);
+	if (scale > max_scale) {
+		keep = efloat_posit_mask(nbits) >> 1;
+	} else if (scale < -max_scale) {
+		keep = 1;
+	} else {
+		/* floor division, without shifting a negative value */
+		k = (scale >= 0) ? (scale >> es)
+		    : -(int)((((unsigned)-scale) + (1U << es) - 1) >> es);
+		e = (uint32_t)(scale - (k * (1 << es)));
+		if (k >= 0) {
+			len = (unsigned)k + 2;
+			y = ~(UINT64_MAX >> (k + 1));
+		} else {
+			len = 1 - (unsigned)k;
+			y = ((uint64_t)1) << (64 - len);
+		}
+		y |= ((uint64_t)e) << (64 - len - es);
+		f = sig << 1;
+		y |= f >> (len + es);
+		sticky = f << (64 - len - es);
+
+		drop = 65 - nbits;
+		keep = (uint32_t)(y >> drop);
+		sticky |= y & ((((uint64_t)1) << (drop - 1)) - 1);
+		if (((y >> (drop - 1)) & 1) && (sticky || (keep & 1))) {
+			++keep;
+		}
+	}
+	return neg ? ((0 - keep) & efloat_posit_mask(nbits)) : keep;
+}
+
+#if ((defined efloat32_exists) && (efloat32_exists))
+static uint32_t efloat32_posit_from_bits(uint32_t u, unsigned nbits,
+					 unsigned es)
+{
+	uint32_t rexp, m;
+	uint64_t sig;
+	unsigned lz;
+	int scale;
+
+	rexp = (u & efloat32_r2_rexp_mask) >> efloat32_r2_exp_shift;
+	m = u & efloat32_r2_signif_mask;
+	if (rexp == (efloat32_r2_rexp_mask >> efloat32_r2_exp_shift)) {
+		return efloat_posit_nar(nbits);
+	} else if (rexp == 0 && m == 0) {
+		return 0;
+	} else if (rexp == 0) {
+		sig = ((uint64_t)m) << (63 - efloat32_r2_exp_shift);
+		lz = Efloat_u64_clz(sig);
+		sig <<= lz;
+		scale = 1 - efloat32_r2_exp_max - (int)lz;
+	} else {
+		sig = ((uint64_t)(m | (efloat32_r2_signif_mask + 1)))
+		    << (63 - efloat32_r2_exp_shift);
+		scale = (int)rexp - efloat32_r2_exp_max;
+	}
+	return efloat_posit_round((u & efloat32_r2_sign_mask) ? 1 : 0, scale,
+				  sig, nbits, es);
+}
+
+/* the fraction is rounded to nearest even, the scale always fits */
+static uint32_t efloat32_posit_to_bits(uint32_t p, unsigned nbits,
+				       unsigned es)
+{
+	enum efloat_class cls;
+	uint64_t frac;
+	uint32_t m, up;
+	int neg, scale;
+
+	neg = 0;
+	scale = 0;
+	frac = 0;
+	cls = efloat_posit_split(p, nbits, es, &neg, &scale, &frac);
+	if (cls == ef_zero) {
+		return 0;
+	} else if (cls == ef_nan) {
+		/* NaR converts to a quiet NaN */
+		return efloat32_canonical_nan_bits;
+	}
+	m = (uint32_t)(frac >> (64 - efloat32_r2_exp_shift));
+	up = (uint32_t)((frac >> (63 - efloat32_r2_exp_shift)) & 1);
+	if ((frac << (efloat32_r2_exp_shift + 1)) == 0) {
+		up &= m & 1;
+	}
+	return (neg ? efloat32_r2_sign_mask : 0)
+	    | ((((uint32_t)(scale + efloat32_r2_exp_max))
+		<< efloat32_r2_exp_shift) + m + up);
+}
+
+uint32_t efloat32_to_posit(efloat32 f, unsigned nbits, unsigned es)
+{
+	if (!efloat_posit_valid(nbits, es)) {
+		return efloat_posit_nar(32);
+	}
+	return efloat32_posit_from_bits(efloat32_to_uint32_bits(f), nbits, es);
+}
+
+efloat32 posit_to_efloat32(uint32_t posit, unsigned nbits, unsigned es)
+{
+	if (!efloat_posit_valid(nbits, es)) {
+		return uint32_bits_to_efloat32(efloat32_canonical_nan_bits);
+	}
+	return uint32_bits_to_efloat32(efloat32_posit_to_bits(posit, nbits,
+							      es));
+}
+
+enum efloat_class efloat32_posit_to_fields(uint32_t posit, unsigned nbits,
+					   unsigned es,
+					   struct efloat32_fields *fields)
+{
+	return efloat32_radix_2_to_fields(posit_to_efloat32(posit, nbits, es),
+					  fields);
+}
+
+uint32_t efloat32_posit_from_fields(const struct efloat32_fields fields,
+				    unsigned nbits, unsigned es)
+{
+	uint32_t raw_significand;
+
+	if (!efloat_posit_valid(nbits, es)) {
+		return efloat_posit_nar(32);
+	}
+	if (fields.exponent < efloat32_r2_exp_min
+	    || fields.exponent > efloat32_r2_exp_inf_nan) {
+		Efloat_set_err_inval();
+		return efloat_posit_nar(nbits);
+	}
+	/* as laid out by efloat32_radix_2_to_fields() */
+	raw_significand = (fields.exponent == 0)
+	    ? (fields.significand >> 1)
+	    : fields.significand;
+	return efloat32_posit_from_bits((fields.sign < 0
+					 ? efloat32_r2_sign_mask : 0)
+					| (((uint32_t)(fields.exponent
+						       + efloat32_r2_exp_max))
+					   << efloat32_r2_exp_shift)
+					| (raw_significand
+					   & efloat32_r2_signif_mask), nbits,
+					es);
+}
+
+/* converts up to Efloat_batch_len values, returns the number converted */
+static size_t efloat32_posit_block(uint32_t *p, const efloat32 *src,
+				   size_t len, unsigned nbits, unsigned es)
+{
+	uint32_t bits[Efloat_batch_len];
+	size_t j, n;
+
+	n = (len > Efloat_batch_len) ? Efloat_batch_len : len;
+	efloat32_array_to_uint32_bits(bits, src, n);
+	for (j = 0; j < n; ++j) {
+		p[j] = efloat32_posit_from_bits(bits[j], nbits, es);
+	}
+	return n;
+}
+
+static size_t efloat32_posit_unblock(efloat32 *dst, const uint32_t *p,
+				     size_t len, unsigned nbits, unsigned es)
+{
+	uint32_t bits[Efloat_batch_len];
+	size_t j, n;
+
+	n = (len > Efloat_batch_len) ? Efloat_batch_len : len;
+	for (j = 0; j < n; ++j) {
+		bits[j] = efloat32_posit_to_bits(p[j], nbits, es);
+	}
+	uint32_bits_to_efloat32_array(dst, bits, n);
+	return n;
+}
+
+efloat32 *efloat32_posit_table(efloat32 *table, unsigned nbits, unsigned es)
+{
+	uint32_t p[Efloat_batch_len];
+	size_t i, j, n, len;
+
+	if (!efloat_posit_valid(nbits, es)) {
+		return NULL;
+	} else if (nbits > 16) {
+		Efloat_set_err_inval();
+		return NULL;
+	}
+	len = ((size_t)1) << nbits;
+	for (i = 0; i < len; i += n) {
+		for (j = 0; j < Efloat_batch_len && (i + j) < len; ++j) {
+			p[j] = (uint32_t)(i + j);
+		}
+		n = efloat32_posit_unblock(table + i, p, len - i, nbits, es);
+	}
+	return table;
+}
+
+size_t efloat32_array_to_posit8(uint8_t *dst, const efloat32 *src, size_t len,
+				unsigned es)
+{
+	uint32_t p[Efloat_batch_len];
+	size_t i, j, n;
+
+	if (!efloat_posit_valid(8, es)) {
+		return 0;
+	}
+	for (i = 0; i < len; i += n) {
+		n = efloat32_posit_block(p, src + i, len - i, 8, es);
+		for (j = 0; j < n; ++j) {
+			dst[i + j] = (uint8_t)p[j];
+		}
+	}
+	return len;
+}
+
+size_t posit8_to_efloat32_array(efloat32 *dst, const uint8_t *src, size_t len,
+				unsigned es)
+{
+	efloat32 table[Efloat_posit8_table_len];
+	uint32_t p[Efloat_batch_len];
+	size_t i, j, n;
+
+	if (!efloat_posit_valid(8, es)) {
+		return 0;
+	}
+	if (len > Efloat_posit8_table_len) {
+		/* filling the table costs less than it saves */
+		efloat32_posit_table(table, 8, es);
+		for (i = 0; i < len; ++i) {
+			dst[i] = table[src[i]];
+		}
+		return len;
+	}
+	for (i = 0; i < len; i += n) {
+		for (j = 0; j < Efloat_batch_len && (i + j) < len; ++j) {
+			p[j] = src[i + j];
+		}
+		n = efloat32_posit_unblock(dst + i, p, len - i, 8, es);
+	}
+	return len;
+}
+
+size_t efloat32_array_to_posit16(uint16_t *dst, const efloat32 *src,
+				 size_t len, unsigned es)
+{
+	uint32_t p[Efloat_batch_len];
+	size_t i, j, n;
+
+	if (!efloat_posit_valid(16, es)) {
+		return 0;
+	}
+	for (i = 0; i < len; i += n) {
+		n = efloat32_posit_block(p, src + i, len - i, 16, es);
+		for (j = 0; j < n; ++j) {
+			dst[i + j] = (uint16_t)p[j];
+		}
+	}
+	return len;
+}
+
+size_t posit16_to_efloat32_array(efloat32 *dst, const uint16_t *src,
+				 size_t len, unsigned es)
+{
+	uint32_t p[Efloat_batch_len];
+	size_t i, j, n;
+
+	if (!efloat_posit_valid(16, es)) {
+		return 0;
+	}
+	for (i = 0; i < len; i += n) {
+		for (j = 0; j < Efloat_batch_len && (i + j) < len; ++j) {
+			p[j] = src[i + j];
+		}
+		n = efloat32_posit_unblock(dst + i, p, len - i, 16, es);
+	}
+	return len;
+}
+
+size_t efloat32_array_to_posit32(uint32_t *dst, const efloat32 *src,
+				 size_t len, unsigned es)
+{
+	size_t i, n;
+
+	if (!efloat_posit_valid(32, es)) {
+		return 0;
+	}
+	for (i = 0; i < len; i += n) {
+		n = efloat32_posit_block(dst + i, src + i, len - i, 32, es);
+	}
+	return len;
+}
+
+size_t posit32_to_efloat32_array(efloat32 *dst, const uint32_t *src,
+				 size_t len, unsigned es)
+{
+	size_t i, n;
+
+	if (!efloat_posit_valid(32, es)) {
+		return 0;
+	}
+	for (i = 0; i < len; i += n) {
+		n = efloat32_posit_unblock(dst + i, src + i, len - i, 32, es);
+	}
+	return len;
+}
+#endif
+
+#if ((defined efloat64_exists) && (efloat64_exists))
+static uint32_t efloat64_posit_from_bits(uint64_t u, unsigned nbits,
+					 unsigned es)
+{
+	uint64_t rexp, m, sig;
+	unsigned lz;
+	int scale;
+
+	rexp = (u & efloat64_r2_rexp_mask) >> efloat64_r2_exp_shift;
+	m = u & efloat64_r2_signif_mask;
+	if (rexp == (efloat64_r2_rexp_mask >> efloat64_r2_exp_shift)) {
+		return efloat_posit_nar(nbits);
+	} else if (rexp == 0 && m == 0) {
+		return 0;
+	} else if (rexp == 0) {
+		sig = m << (63 - efloat64_r2_exp_shift);
+		lz = Efloat_u64_clz(sig);
+		sig <<= lz;
+		scale = 1 - (int)efloat64_r2_exp_max - (int)lz;
+	} else {
+		sig = (m | (efloat64_r2_signif_mask + 1))
+		    << (63 - efloat64_r2_exp_shift);
+		scale = (int)rexp - (int)efloat64_r2_exp_max;
+	}
+	return efloat_posit_round((u & efloat64_r2_sign_mask) ? 1 : 0, scale,
+				  sig, nbits, es);
+}
+
+/* posits of up to 32 bits convert exactly */
+static uint64_t efloat64_posit_to_bits(uint32_t p, unsigned nbits,
+				       unsigned es)
+{
+	enum efloat_class cls;
+	uint64_t frac;
+	int neg, scale;
+
+	neg = 0;
+	scale = 0;
+	frac = 0;
+	cls = efloat_posit_split(p, nbits, es, &neg, &scale, &frac);
+	if (cls == ef_zero) {
+		return 0;
+	} else if (cls == ef_nan) {
+		/* NaR converts to a quiet NaN */
+		return efloat64_canonical_nan_bits;
+	}
+	return (neg ? efloat64_r2_sign_mask : 0)
+	    | (((uint64_t)(scale + efloat64_r2_exp_max))
+	       << efloat64_r2_exp_shift)
+	    | (frac >> (64 - efloat64_r2_exp_shift));
+}
+
+uint32_t efloat64_to_posit(efloat64 f, unsigned nbits, unsigned es)
+{
+	if (!efloat_posit_valid(nbits, es)) {
+		return efloat_posit_nar(32);
+	}
+	return efloat64_posit_from_bits(efloat64_to_uint64_bits(f), nbits, es);
+}
+
+efloat64 posit_to_efloat64(uint32_t posit, unsigned nbits, unsigned es)
+{
+	if (!efloat_posit_valid(nbits, es)) {
+		return uint64_bits_to_efloat64(efloat64_canonical_nan_bits);
+	}
+	return uint64_bits_to_efloat64(efloat64_posit_to_bits(posit, nbits,
+							      es));
+}
+
+enum efloat_class efloat64_posit_to_fields(uint32_t posit, unsigned nbits,
+					   unsigned es,
+					   struct efloat64_fields *fields)
+{
+	return efloat64_radix_2_to_fields(posit_to_efloat64(posit, nbits, es),
+					  fields);
+}
+
+uint32_t efloat64_posit_from_fields(const struct efloat64_fields fields,
+				    unsigned nbits, unsigned es)
+{
+	uint64_t raw_significand;
+
+	if (!efloat_posit_valid(nbits, es)) {
+		return efloat_posit_nar(32);
+	}
+	if (fields.exponent < efloat64_r2_exp_min
+	    || fields.exponent > efloat64_r2_exp_inf_nan) {
+		Efloat_set_err_inval();
+		return efloat_posit_nar(nbits);
+	}
+	/* as laid out by efloat64_radix_2_to_fields() */
+	raw_significand = (fields.exponent == 0)
+	    ? (fields.significand >> 1)
+	    : fields.significand;
+	return efloat64_posit_from_bits((fields.sign < 0
+					 ? efloat64_r2_sign_mask : 0)
+					| (((uint64_t)(fields.exponent
+						       + efloat64_r2_exp_max))
+					   << efloat64_r2_exp_shift)
+					| (raw_significand
+					   & efloat64_r2_signif_mask), nbits,
+					es);
+}
+
+static size_t efloat64_posit_block(uint32_t *p, const efloat64 *src,
+				   size_t len, unsigned nbits, unsigned es)
+{
+	uint64_t bits[Efloat_batch_len];
+	size_t j, n;
+
+	n = (len > Efloat_batch_len) ? Efloat_batch_len : len;
+	efloat64_array_to_uint64_bits(bits, src, n);
+	for (j = 0; j < n; ++j) {
+		p[j] = efloat64_posit_from_bits(bits[j], nbits, es);
+	}
+	return n;
+}
+
+static size_t efloat64_posit_unblock(efloat64 *dst, const uint32_t *p,
+				     size_t len, unsigned nbits, unsigned es)
+{
+	uint64_t bits[Efloat_batch_len];
+	size_t j, n;
+
+	n = (len > Efloat_batch_len) ? Efloat_batch_len : len;
+	for (j = 0; j < n; ++j) {
+		bits[j] = efloat64_posit_to_bits(p[j], nbits, es);
+	}
+	uint64_bits_to_efloat64_array(dst, bits, n);
+	return n;
+}
+
+efloat64 *efloat64_posit_table(efloat64 *table, unsigned nbits, unsigned es)
+{
+	uint32_t p[Efloat_batch_len];
+	size_t i, j, n, len;
+
+	if (!efloat_posit_valid(nbits, es)) {
+		return NULL;
+	} else if (nbits > 16) {
+		Efloat_set_err_inval();
+		return NULL;
+	}
+	len = ((size_t)1) << nbits;
+	for (i = 0; i < len; i += n) {
+		for (j = 0; j < Efloat_batch_len && (i + j) < len; ++j) {
+			p[j] = (uint32_t)(i + j);
+		}
+		n = efloat64_posit_unblock(table + i, p, len - i, nbits, es);
+	}
+	return table;
+}
+
+size_t efloat64_array_to_posit8(uint8_t *dst, const efloat64 *src, size_t len,
+				unsigned es)
+{
+	uint32_t p[Efloat_batch_len];
+	size_t i, j, n;
+
+	if (!efloat_posit_valid(8, es)) {
+		return 0;
+	}
+	for (i = 0; i < len; i += n) {
+		n = efloat64_posit_block(p, src + i, len - i, 8, es);
+		for (j = 0; j < n; ++j) {
+			dst[i + j] = (uint8_t)p[j];
+		}
+	}
+	return len;
+}
+
+size_t posit8_to_efloat64_array(efloat64 *dst, const uint8_t *src, size_t len,
+				unsigned es)
+{
+	efloat64 table[Efloat_posit8_table_len];
+	uint32_t p[Efloat_batch_len];
+	size_t i, j, n;
+
+	if (!efloat_posit_valid(8, es)) {
+		return 0;
+	}
+	if (len > Efloat_posit8_table_len) {
+		/* filling the table costs less than it saves */
+		efloat64_posit_table(table, 8, es);
+		for (i = 0; i < len; ++i) {
+			dst[i] = table[src[i]];
+		}
+		return len;
+	}
+	for (i = 0; i < len; i += n) {
+		for (j = 0; j < Efloat_batch_len && (i + j) < len; ++j) {
+			p[j] = src[i + j];
+		}
+		n = efloat64_posit_unblock(dst + i, p, len - i, 8, es);
+	}
+	return len;
+}
+
+size_t efloat64_array_to_posit16(uint16_t *dst, const efloat64 *src,
+				 size_t len, unsigned es)
+{
+	uint32_t p[Efloat_batch_len];
+	size_t i, j, n;
+
+	if (!efloat_posit_valid(16, es)) {
+		return 0;
+	}
+	for (i = 0; i < len; i += n) {
+		n = efloat64_posit_block(p, src + i, len - i, 16, es);
+		for (j = 0; j < n; ++j) {
+			dst[i + j] = (uint16_t)p[j];
+		}
+	}
+	return len;
+}
+
+size_t posit16_to_efloat64_array(efloat64 *dst, const uint16_t *src,
+				 size_t len, unsigned es)
+{
+	uint32_t p[Efloat_batch_len];
+	size_t i, j, n;
+
+	if (!efloat_posit_valid(16, es)) {
+		return 0;
+	}
+	for (i = 0; i < len; i += n) {
+		for (j = 0; j < Efloat_batch_len && (i + j) < len; ++j) {
+			p[j] = src[i + j];
+		}
+		n = efloat64_posit_unblock(dst + i, p, len - i, 16, es);
+	}
+	return len;
+}
+
+size_t efloat64_array_to_posit32(uint32_t *dst, const efloat64 *src,
+				 size_t len, unsigned es)
+{
+	size_t i, n;
+
+	if (!efloat_posit_valid(32, es)) {
+		return 0;
+	}
+	for (i = 0; i < len; i += n) {
+		n = efloat64_posit_block(dst + i, src + i, len - i, 32, es);
+	}
+	return len;
+}
+
+size_t posit32_to_efloat64_array(efloat64 *dst, const uint32_t *src,
+				 size_t len, unsigned es)
+{
+	size_t i, n;
+
+	if (!efloat_posit_valid(32, es)) {
+		return 0;
+	}
+	for (i = 0; i < len; i += n) {
+		n = efloat64_posit_unblock(dst + i, src + i, len - i, 32, es);
+	}
+	return len;
+}
+#endif
@@ -0,0 +1,389 @@
+/* SPDX-License-Identifier: LGPL-2.1-or-later */
+/* efloat-profile.c: single pass summary of float arrays */
+/* Copyright (C) 2026 Eric Herman */
+/* https://github.com/ericherman/libefloat */
+
+#include "efloat-internal.h"
+
+#if ((defined efloat32_exists) && (efloat32_exists))
+void efloat32_profile_init(struct efloat32_profile *profile)
+{
+	size_t i;
+
+	profile->count = 0;
+	for (i = 0; i <= ef_normal; ++i) {
+		profile->class_count[i] = 0;
+	}
+	profile->negative = 0;
+	profile->exponent_min = efloat32_r2_exp_inf_nan;
+	profile->exponent_max = efloat32_r2_exp_min;
+	profile->min = uint32_bits_to_efloat32(efloat32_r2_rexp_mask
+					       | efloat32_r2_signif_mask);
+	profile->max = profile->min;
+}
+
+static int efloat32_profile_has_min_max(const struct efloat32_profile *p)
+{
+	return p->count > p->class_count[ef_nan];
+}
+
+/*
+ The exponents and the min/max are tracked as unsigned integers: the
+ exponents as the raw biased exponent, the min/max as order keys. This
+ keeps the inner loop free of branches and of floating point compares.
+*/
+static void efloat32_profile_combine(struct efloat32_profile *profile,
+				     int had_min_max,
+				     uint32_t rexp_lo, uint32_t rexp_hi,
+				     uint32_t key_lo, uint32_t key_hi)
+{
+	uint32_t u;
+	int16_t exp_lo, exp_hi;
+
+	if (rexp_lo <= rexp_hi) {
+		exp_lo = (int16_t)((int32_t)rexp_lo - efloat32_r2_exp_max);
+		exp_hi = (int16_t)((int32_t)rexp_hi - efloat32_r2_exp_max);
+		if (exp_lo < profile->exponent_min) {
+			profile->exponent_min = exp_lo;
+		}
+		if (exp_hi > profile->exponent_max) {
+			profile->exponent_max = exp_hi;
+		}
+	}
+
+	if (key_lo <= key_hi) {
+		if (had_min_max) {
+			u = efloat32_to_uint32_bits(profile->min);
+			if (Efloat32_order_key(u) < key_lo) {
+				key_lo = Efloat32_order_key(u);
+			}
+			u = efloat32_to_uint32_bits(profile->max);
+			if (Efloat32_order_key(u) > key_hi) {
+				key_hi = Efloat32_order_key(u);
+			}
+		}
+		profile->min = uint32_bits_to_efloat32(Efloat32_order_unkey
+						       (key_lo));
+		profile->max = uint32_bits_to_efloat32(Efloat32_order_unkey
+						       (key_hi));
+	}
+}
+
+void efloat32_profile_add(struct efloat32_profile *profile,
+			  const efloat32 *a, size_t len)
+{
+	uint32_t bits[Efloat_batch_len];
+	uint32_t u, rexp, signif, is_nan, is_inf, is_zero, is_subnorm;
+	uint32_t finite_nonzero, key, lo, hi;
+	uint32_t nans, infs, zeros, subnorms, negs;
+	uint32_t rexp_lo, rexp_hi, key_lo, key_hi;
+	const uint32_t rexp_all = (efloat32_r2_rexp_mask
+				   >> efloat32_r2_exp_shift);
+	size_t i, j, n;
+	int had_min_max;
+
+	had_min_max = efloat32_profile_has_min_max(profile);
+	rexp_lo = rexp_all;
+	rexp_hi = 0;
+	key_lo = UINT32_MAX;
+	key_hi = 0;
+	for (i = 0; i < len; i += n) {
+		n = len - i;
+		if (n > Efloat_batch_len) {
+			n = Efloat_batch_len;
+		}
+		efloat32_array_to_uint32_bits(bits, a + i, n);
+		/*
+		 pad a short final block with NaN, which touches neither the
+		 exponents nor min/max, so that the inner loop is always a
+		 constant length; the padding is taken back out of the count
+		*/
+		for (j = n; j < Efloat_batch_len; ++j) {
+			bits[j] = (efloat32_r2_rexp_mask
+				   | efloat32_r2_signif_mask);
+		}
+
+		nans = 0;
+		infs = 0;
+		zeros = 0;
+		subnorms = 0;
+		negs = 0;
+		for (j = 0; j < Efloat_batch_len; ++j) {
+			u = bits[j];
+			rexp = (u & efloat32_r2_rexp_mask)
+			    >> efloat32_r2_exp_shift;
+			signif = u & efloat32_r2_signif_mask;
+
+			is_nan = (rexp == rexp_all) & (signif != 0);
+			is_inf = (rexp == rexp_all) & (signif == 0);
+			is_zero = (rexp == 0) & (signif == 0);
+			is_subnorm = (rexp == 0) & (signif != 0);
+			finite_nonzero = (rexp != rexp_all) & (is_zero ^ 1);
+
+			nans += is_nan;
+			infs += is_inf;
+			zeros += is_zero;
+			subnorms += is_subnorm;
+			negs += (u >> 31);
+
+			/* masks rather than branches, for a simple loop */
+			lo = rexp | (0 - (finite_nonzero ^ 1));
+			rexp_lo = (lo < rexp_lo) ? lo : rexp_lo;
+			hi = rexp & (0 - finite_nonzero);
+			rexp_hi = (hi > rexp_hi) ? hi : rexp_hi;
+
+			key = Efloat32_order_key(u);
+			lo = key | (0 - is_nan);
+			key_lo = (lo < key_lo) ? lo : key_lo;
+			hi = key & (0 - (is_nan ^ 1));
+			key_hi = (hi > key_hi) ? hi : key_hi;
+		}
+		nans -= (Efloat_batch_len - n);
+		profile->count += n;
+		profile->class_count[ef_nan] += nans;
+		profile->class_count[ef_inf] += infs;
+		profile->class_count[ef_zero] += zeros;
+		profile->class_count[ef_subnorm] += subnorms;
+		profile->class_count[ef_normal] +=
+		    (n - nans - infs - zeros - subnorms);
+		profile->negative += negs;
+	}
+
+	efloat32_profile_combine(profile, had_min_max, rexp_lo, rexp_hi, key_lo,
+				 key_hi);
+}
+
+void efloat32_profile_merge(struct efloat32_profile *profile,
+			    const struct efloat32_profile *other)
+{
+	uint32_t rexp_lo, rexp_hi, key_lo, key_hi;
+	size_t i;
+
+	rexp_lo = 1;
+	rexp_hi = 0;
+	if (other->exponent_min <= other->exponent_max) {
+		rexp_lo = other->exponent_min + efloat32_r2_exp_max;
+		rexp_hi = other->exponent_max + efloat32_r2_exp_max;
+	}
+
+	key_lo = 1;
+	key_hi = 0;
+	if (efloat32_profile_has_min_max(other)) {
+		key_lo = efloat32_to_uint32_bits(other->min);
+		key_lo = Efloat32_order_key(key_lo);
+		key_hi = efloat32_to_uint32_bits(other->max);
+		key_hi = Efloat32_order_key(key_hi);
+	}
+
+	efloat32_profile_combine(profile, efloat32_profile_has_min_max(profile),
+				 rexp_lo, rexp_hi, key_lo, key_hi);
+
+	profile->count += other->count;
+	for (i = 0; i <= ef_normal; ++i) {
+		profile->class_count[i] += other->class_count[i];
+	}
+	profile->negative += other->negative;
+}
+
+struct efloat32_profile *efloat32_profile_array(const efloat32 *a, size_t len,
+						struct efloat32_profile
+						*profile)
+{
+	if (!profile || (len && !a)) {
+		Efloat_set_err_inval();
+		return NULL;
+	}
+	efloat32_profile_init(profile);
+	efloat32_profile_add(profile, a, len);
+	return profile;
+}
+#endif
+
+#if ((defined efloat64_exists) && (efloat64_exists))
+void efloat64_profile_init(struct efloat64_profile *profile)
+{
+	size_t i;
+
+	profile->count = 0;
+	for (i = 0; i <= ef_normal; ++i) {
+		profile->class_count[i] = 0;
+	}
+	profile->negative = 0;
+	profile->exponent_min = efloat64_r2_exp_inf_nan;
+	profile->exponent_max = efloat64_r2_exp_min;
+	profile->min = uint64_bits_to_efloat64(efloat64_r2_rexp_mask
+					       | efloat64_r2_signif_mask);
+	profile->max = profile->min;
+}
+
+static int efloat64_profile_has_min_max(const struct efloat64_profile *p)
+{
+	return p->count > p->class_count[ef_nan];
+}
+
+static void efloat64_profile_combine(struct efloat64_profile *profile,
+				     int had_min_max,
+				     uint64_t rexp_lo, uint64_t rexp_hi,
+				     uint64_t key_lo, uint64_t key_hi)
+{
+	uint64_t u;
+	int16_t exp_lo, exp_hi;
+
+	if (rexp_lo <= rexp_hi) {
+		exp_lo = (int16_t)((int64_t)rexp_lo - efloat64_r2_exp_max);
+		exp_hi = (int16_t)((int64_t)rexp_hi - efloat64_r2_exp_max);
+		if (exp_lo < profile->exponent_min) {
+			profile->exponent_min = exp_lo;
+		}
+		if (exp_hi > profile->exponent_max) {
+			profile->exponent_max = exp_hi;
+		}
+	}
+
+	if (key_lo <= key_hi) {
+		if (had_min_max) {
+			u = efloat64_to_uint64_bits(profile->min);
+			if (Efloat64_order_key(u) < key_lo) {
+				key_lo = Efloat64_order_key(u);
+			}
+			u = efloat64_to_uint64_bits(profile->max);
+			if (Efloat64_order_key(u) > key_hi) {
+				key_hi = Efloat64_order_key(u);
+			}
+		}
+		profile->min = uint64_bits_to_efloat64(Efloat64_order_unkey
+						       (key_lo));
+		profile->max = uint64_bits_to_efloat64(Efloat64_order_unkey
+						       (key_hi));
+	}
+}
+
+void efloat64_profile_add(struct efloat64_profile *profile,
+			  const efloat64 *a, size_t len)
+{
+	uint64_t bits[Efloat_batch_len];
+	uint64_t u, rexp, signif, is_nan, is_inf, is_zero, is_subnorm;
+	uint64_t finite_nonzero, key, lo, hi;
+	uint64_t nans, infs, zeros, subnorms, negs;
+	uint64_t rexp_lo, rexp_hi, key_lo, key_hi;
+	const uint64_t rexp_all = (efloat64_r2_rexp_mask
+				   >> efloat64_r2_exp_shift);
+	size_t i, j, n;
+	int had_min_max;
+
+	had_min_max = efloat64_profile_has_min_max(profile);
+	rexp_lo = rexp_all;
+	rexp_hi = 0;
+	key_lo = UINT64_MAX;
+	key_hi = 0;
+	for (i = 0; i < len; i += n) {
+		n = len - i;
+		if (n > Efloat_batch_len) {
+			n = Efloat_batch_len;
+		}
+		efloat64_array_to_uint64_bits(bits, a + i, n);
+		/*
+		 pad a short final block with NaN, which touches neither the
+		 exponents nor min/max, so that the inner loop is always a
+		 constant length; the padding is taken back out of the count
+		*/
+		for (j = n; j < Efloat_batch_len; ++j) {
+			bits[j] = (efloat64_r2_rexp_mask
+				   | efloat64_r2_signif_mask);
+		}
+
+		nans = 0;
+		infs = 0;
+		zeros = 0;
+		subnorms = 0;
+		negs = 0;
+		for (j = 0; j < Efloat_batch_len; ++j) {
+			u = bits[j];
+			rexp = (u & efloat64_r2_rexp_mask)
+			    >> efloat64_r2_exp_shift;
+			signif = u & efloat64_r2_signif_mask;
+
+			is_nan = (rexp == rexp_all) & (signif != 0);
+			is_inf = (rexp == rexp_all) & (signif == 0);
+			is_zero = (rexp == 0) & (signif == 0);
+			is_subnorm = (rexp == 0) & (signif != 0);
+			finite_nonzero = (rexp != rexp_all) & (is_zero ^ 1);
+
+			nans += is_nan;
+			infs += is_inf;
+			zeros += is_zero;
+			subnorms += is_subnorm;
+			negs += (u >> 63);
+
+			/* masks rather than branches, for a simple loop */
+			lo = rexp | (0 - (finite_nonzero ^ 1));
+			rexp_lo = (lo < rexp_lo) ? lo : rexp_lo;
+			hi = rexp & (0 - finite_nonzero);
+			rexp_hi = (hi > rexp_hi) ? hi : rexp_hi;
+
+			key = Efloat64_order_key(u);
+			lo = key | (0 - is_nan);
+			key_lo = (lo < key_lo) ? lo : key_lo;
+			hi = key & (0 - (is_nan ^ 1));
+			key_hi = (hi > key_hi) ? hi : key_hi;
+		}
+		nans -= (Efloat_batch_len - n);
+		profile->count += n;
+		profile->class_count[ef_nan] += nans;
+		profile->class_count[ef_inf] += infs;
+		profile->class_count[ef_zero] += zeros;
+		profile->class_count[ef_subnorm] += subnorms;
+		profile->class_count[ef_normal] +=
+		    (n - nans - infs - zeros - subnorms);
+		profile->negative += negs;
+	}
+
+	efloat64_profile_combine(profile, had_min_max, rexp_lo, rexp_hi, key_lo,
+				 key_hi);
+}
+
+void efloat64_profile_merge(struct efloat64_profile *profile,
+			    const struct efloat64_profile *other)
+{
+	uint64_t rexp_lo, rexp_hi, key_lo, key_hi;
+	size_t i;
+
+	rexp_lo = 1;
+	rexp_hi = 0;
+	if (other->exponent_min <= other->exponent_max) {
+		rexp_lo = other->exponent_min + efloat64_r2_exp_max;
+		rexp_hi = other->exponent_max + efloat64_r2_exp_max;
+	}
+
+	key_lo = 1;
+	key_hi = 0;
+	if (efloat64_profile_has_min_max(other)) {
+		key_lo = efloat64_to_uint64_bits(other->min);
+		key_lo = Efloat64_order_key(key_lo);
+		key_hi = efloat64_to_uint64_bits(other->max);
+		key_hi = Efloat64_order_key(key_hi);
+	}
+
+	efloat64_profile_combine(profile, efloat64_profile_has_min_max(profile),
+				 rexp_lo, rexp_hi, key_lo, key_hi);
+
+	profile->count += other->count;
+	for (i = 0; i <= ef_normal; ++i) {
+		profile->class_count[i] += other->class_count[i];
+	}
+	profile->negative += other->negative;
+}
+
+struct efloat64_profile *efloat64_profile_array(const efloat64 *a, size_t len,
+						struct efloat64_profile
+						*profile)
+{
+	if (!profile || (len && !a)) {
+		Efloat_set_err_inval();
+		return NULL;
+	}
+	efloat64_profile_init(profile);
+	efloat64_profile_add(profile, a, len);
+	return profile;
+}
+#endif
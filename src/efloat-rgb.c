@@ -0,0 +1,222 @@
+/* SPDX-License-Identifier: LGPL-2.1-or-later */
+/* efloat-rgb.c: packed HDR color formats, RGB9E5 and R11G11B10 */
+/* Copyright (C) 2026 Eric Herman */
+/* https://github.com/ericherman/libefloat */
+
+#include "efloat-internal.h"
+
+#if ((defined efloat32_exists) && (efloat32_exists))
+
+/* the small formats all have a 5 bit exponent, with a bias of 15 */
+#define Efloat_small_exp_bias 15
+#define Efloat_small_exp_all_ones 0x1F
+#define Efloat_rgb9e5_signif_bits 9
+#define Efloat_rgb9e5_max_bits 0x477F8000UL	/* 65408.0f */
+
+/* 2^e as a 32 bit float, for e in the normal range */
+#define Efloat32_rgb_pow2_bits(e) \
+	(((uint32_t)((e) + efloat32_r2_exp_max)) << efloat32_r2_exp_shift)
+
+/* clamp to [0, max], with NaN as 0 */
+static uint32_t efloat_rgb9e5_clamp(uint32_t u)
+{
+	if ((u & efloat32_r2_sign_mask)
+	    || (u & ~efloat32_r2_sign_mask) > efloat32_r2_rexp_mask) {
+		return 0;
+	}
+	return (u > Efloat_rgb9e5_max_bits) ? Efloat_rgb9e5_max_bits : u;
+}
+
+/* x / 2^(shared - 24), rounded half up, of a clamped x */
+static uint32_t efloat_rgb9e5_signif(uint32_t u, int shared)
+{
+	uint32_t rexp, m;
+	int shift;
+
+	rexp = u >> efloat32_r2_exp_shift;
+	m = u & efloat32_r2_signif_mask;
+	if (rexp) {
+		m |= ((uint32_t)1) << efloat32_r2_exp_shift;
+	} else {
+		rexp = 1;
+	}
+	shift = shared - 1 - ((int)rexp - efloat32_r2_exp_max);
+	if (shift > 31) {
+		return 0;
+	}
+	return (uint32_t)((((uint64_t)m) + (((uint64_t)1) << (shift - 1)))
+			  >> shift);
+}
+
+static uint32_t efloat_rgb9e5_pack(uint32_t r, uint32_t g, uint32_t b)
+{
+	uint32_t max;
+	int shared;
+
+	r = efloat_rgb9e5_clamp(r);
+	g = efloat_rgb9e5_clamp(g);
+	b = efloat_rgb9e5_clamp(b);
+	max = (r > g) ? r : g;
+	max = (max > b) ? max : b;
+
+	shared = (int)(max >> efloat32_r2_exp_shift) - efloat32_r2_exp_max;
+	if (shared < -(Efloat_small_exp_bias + 1)) {
+		shared = -(Efloat_small_exp_bias + 1);
+	}
+	shared += 1 + Efloat_small_exp_bias;
+	if (efloat_rgb9e5_signif(max, shared)
+	    == (((uint32_t)1) << Efloat_rgb9e5_signif_bits)) {
+		++shared;
+	}
+	return efloat_rgb9e5_signif(r, shared)
+	    | (efloat_rgb9e5_signif(g, shared) << 9)
+	    | (efloat_rgb9e5_signif(b, shared) << 18)
+	    | (((uint32_t)shared) << 27);
+}
+
+/*
+ an unsigned float with a 5 bit exponent and "signif_bits" bits of
+ significand, rounded to nearest even
+*/
+static uint32_t efloat_to_small_float(uint32_t u, unsigned signif_bits)
+{
+	uint32_t a, t, max_finite, rexp, min_normal_rexp;
+	unsigned shift;
+
+	a = u & ~efloat32_r2_sign_mask;
+	if (a > efloat32_r2_rexp_mask) {
+		return (((uint32_t)Efloat_small_exp_all_ones) << signif_bits)
+		    | (((uint32_t)1) << (signif_bits - 1));
+	} else if (u & efloat32_r2_sign_mask) {
+		return 0;
+	} else if (a == efloat32_r2_rexp_mask) {
+		return ((uint32_t)Efloat_small_exp_all_ones) << signif_bits;
+	}
+
+	max_finite = (((uint32_t)Efloat_small_exp_all_ones) << signif_bits)
+	    - 1;
+	min_normal_rexp = efloat32_r2_exp_max + 1 - Efloat_small_exp_bias;
+	shift = efloat32_r2_exp_shift - signif_bits;
+	rexp = a >> efloat32_r2_exp_shift;
+	if (rexp < min_normal_rexp) {
+		/* subnormal in the small format, or too small for it */
+		shift += min_normal_rexp - rexp;
+		if (rexp == 0 || shift > (efloat32_r2_exp_shift + 1)) {
+			return 0;
+		}
+		t = (a & efloat32_r2_signif_mask)
+		    | (((uint32_t)1) << efloat32_r2_exp_shift);
+	} else {
+		/* re-bias the exponent, a carry rounds up into it */
+		t = a - (((uint32_t)(min_normal_rexp - 1))
+			 << efloat32_r2_exp_shift);
+	}
+	t = (t + (((uint32_t)1) << (shift - 1)) - 1 + ((t >> shift) & 1))
+	    >> shift;
+	return (t > max_finite) ? max_finite : t;
+}
+
+static efloat32 efloat_from_small_float(uint32_t v, unsigned signif_bits)
+{
+	uint32_t e, m;
+
+	e = v >> signif_bits;
+	m = v & ((((uint32_t)1) << signif_bits) - 1);
+	if (e == Efloat_small_exp_all_ones) {
+		return uint32_bits_to_efloat32(efloat32_r2_rexp_mask
+					       | (m << (efloat32_r2_exp_shift
+							- signif_bits)));
+	} else if (e == 0) {
+		return ((efloat32)m)
+		    * uint32_bits_to_efloat32(Efloat32_rgb_pow2_bits
+					      (1 - Efloat_small_exp_bias
+					       - (int)signif_bits));
+	}
+	return uint32_bits_to_efloat32((((uint32_t)(e + efloat32_r2_exp_max
+						    - Efloat_small_exp_bias))
+					<< efloat32_r2_exp_shift)
+				       | (m << (efloat32_r2_exp_shift
+						- signif_bits)));
+}
+
+void efloat32_rgb9e5_encode(uint32_t *dst, const efloat32 *rgb, size_t count)
+{
+	uint32_t bits[3 * Efloat_batch_len];
+	size_t i, j, n;
+
+	for (i = 0; i < count; i += n) {
+		n = count - i;
+		if (n > Efloat_batch_len) {
+			n = Efloat_batch_len;
+		}
+		efloat32_array_to_uint32_bits(bits, rgb + (3 * i), 3 * n);
+		for (j = 0; j < n; ++j) {
+			dst[i + j] = efloat_rgb9e5_pack(bits[3 * j],
+							bits[(3 * j) + 1],
+							bits[(3 * j) + 2]);
+		}
+	}
+}
+
+void efloat32_rgb9e5_decode(efloat32 *rgb, const uint32_t *src, size_t count)
+{
+	efloat32 scale;
+	uint32_t v;
+	size_t i;
+
+	for (i = 0; i < count; ++i) {
+		v = src[i];
+		scale = uint32_bits_to_efloat32(Efloat32_rgb_pow2_bits
+						((int)(v >> 27)
+						 - Efloat_small_exp_bias
+						 - Efloat_rgb9e5_signif_bits));
+		rgb[3 * i] = ((efloat32)(v & 0x1FF)) * scale;
+		rgb[(3 * i) + 1] = ((efloat32)((v >> 9) & 0x1FF)) * scale;
+		rgb[(3 * i) + 2] = ((efloat32)((v >> 18) & 0x1FF)) * scale;
+	}
+}
+
+static uint32_t efloat_r11g11b10_pack(uint32_t r, uint32_t g, uint32_t b)
+{
+	return efloat_to_small_float(r, efloat_float11_signif_bits)
+	    | (efloat_to_small_float(g, efloat_float11_signif_bits) << 11)
+	    | (efloat_to_small_float(b, efloat_float10_signif_bits) << 22);
+}
+
+void efloat32_r11g11b10_encode(uint32_t *dst, const efloat32 *rgb,
+			       size_t count)
+{
+	uint32_t bits[3 * Efloat_batch_len];
+	size_t i, j, n;
+
+	for (i = 0; i < count; i += n) {
+		n = count - i;
+		if (n > Efloat_batch_len) {
+			n = Efloat_batch_len;
+		}
+		efloat32_array_to_uint32_bits(bits, rgb + (3 * i), 3 * n);
+		for (j = 0; j < n; ++j) {
+			dst[i + j] = efloat_r11g11b10_pack(bits[3 * j],
+							   bits[(3 * j) + 1],
+							   bits[(3 * j) + 2]);
+		}
+	}
+}
+
+void efloat32_r11g11b10_decode(efloat32 *rgb, const uint32_t *src,
+			       size_t count)
+{
+	const unsigned f11 = efloat_float11_signif_bits;
+	const unsigned f10 = efloat_float10_signif_bits;
+	uint32_t v;
+	size_t i;
+
+	for (i = 0; i < count; ++i) {
+		v = src[i];
+		rgb[3 * i] = efloat_from_small_float(v & 0x7FF, f11);
+		rgb[(3 * i) + 1] = efloat_from_small_float((v >> 11) & 0x7FF,
+							   f11);
+		rgb[(3 * i) + 2] = efloat_from_small_float(v >> 22, f10);
+	}
+}
+#endif
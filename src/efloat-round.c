@@ -0,0 +1,606 @@
+/* SPDX-License-Identifier: LGPL-2.1-or-later */
+/* efloat-round.c: normalize and round wide significands into floats */
+/* Copyright (C) 2026 Eric Herman */
+/* https://github.com/ericherman/libefloat */
+
+#include "efloat-internal.h"
+
+/*
+ Exponents beyond this are far outside of any format, and round the
+ same as this; clamping keeps the arithmetic well inside of a long.
+*/
+#define Efloat_round_exp_limit (1L << 20)
+
+/* the parameters of a binary format */
+struct efloat_round_format {
+	unsigned precision;	/* significand bits, with the hidden bit */
+	unsigned exp_bits;
+	long exp_max;
+};
+
+/* the low 64 bits of (hi, lo) >> dist */
+static uint64_t efloat_u128_shr_lo(uint64_t hi, uint64_t lo, unsigned dist)
+{
+	if (dist == 0) {
+		return lo;
+	} else if (dist < 64) {
+		return (lo >> dist) | (hi << (64 - dist));
+	} else if (dist < 128) {
+		return hi >> (dist - 64);
+	}
+	return 0;
+}
+
+/* are any of the bits of (hi, lo) below bit "i" set */
+static int efloat_u128_any_below(uint64_t hi, uint64_t lo, unsigned i)
+{
+	if (i == 0) {
+		return 0;
+	} else if (i < 64) {
+		return (lo << (64 - i)) != 0;
+	} else if (i == 64) {
+		return lo != 0;
+	} else if (i < 128) {
+		return (lo != 0) || ((hi << (128 - i)) != 0);
+	}
+	return (hi | lo) != 0;
+}
+
+/* is the kept significand "m" to be incremented */
+static int efloat_round_up(uint64_t m, int neg, int guard, int rest,
+			   enum efloat_round_mode mode)
+{
+	switch (mode) {
+	case ef_round_nearest_even:
+		return guard && (rest || (m & 1));
+	case ef_round_nearest_away:
+		return guard;
+	case ef_round_up:
+		return !neg && (guard || rest);
+	case ef_round_down:
+		return neg && (guard || rest);
+	case ef_round_toward_zero:
+	case ef_round_odd:
+	default:
+		return 0;
+	}
+}
+
+/*
+ Round (hi, lo) + sticky to a multiple of 2^shift, returning the kept
+ significand and setting "inexact".
+*/
+static uint64_t efloat_round_at(uint64_t hi, uint64_t lo, int sticky,
+				long shift, int neg,
+				enum efloat_round_mode mode, int *inexact)
+{
+	uint64_t m;
+	int guard, rest;
+
+	if (shift <= 0) {
+		/* every bit is kept, only the sticky is lost */
+		m = lo << -shift;
+		guard = 0;
+		rest = sticky;
+	} else if (shift > 128) {
+		m = 0;
+		guard = 0;
+		rest = 1;
+	} else {
+		m = efloat_u128_shr_lo(hi, lo, (unsigned)shift);
+		guard = (int)(efloat_u128_shr_lo(hi, lo, (unsigned)(shift - 1))
+			      & 1);
+		rest = sticky
+		    || efloat_u128_any_below(hi, lo, (unsigned)(shift - 1));
+	}
+	*inexact = guard || rest;
+	if (efloat_round_up(m, neg, guard, rest, mode)) {
+		++m;
+	} else if (mode == ef_round_odd && *inexact) {
+		m |= 1;
+	}
+	return m;
+}
+
+/*
+ The bits of (-1)^neg * ((hi, lo) + sticky) * 2^exponent, rounded into
+ the format "fmt", where "sticky" stands for a non-zero amount below the
+ last bit of (hi, lo) and below the last bit the format keeps.
+*/
+static uint64_t efloat_round_wide(const struct efloat_round_format *fmt,
+				  int neg, long exponent, uint64_t hi,
+				  uint64_t lo, int sticky,
+				  enum efloat_round_mode mode, unsigned *flags)
+{
+	uint64_t sign_bit, max_finite, m, m_unbounded, bits;
+	long msb, e_msb, lsb, emin, last;
+	int inexact, tiny;
+	unsigned f;
+
+	last = (long)fmt->precision - 1;
+	emin = 1 - fmt->exp_max;
+	sign_bit = ((uint64_t)1) << (last + fmt->exp_bits);
+	max_finite = sign_bit - 1 - (((uint64_t)1) << last);
+	sticky = sticky ? 1 : 0;
+
+	if ((hi | lo) == 0) {
+		if (!sticky) {
+			return neg ? sign_bit : 0;
+		}
+		/* an amount too small to place: less than half of minsub */
+		lo = 1;
+		exponent = emin - last - 3;
+		sticky = 0;
+	}
+	if (exponent > Efloat_round_exp_limit) {
+		exponent = Efloat_round_exp_limit;
+	} else if (exponent < -Efloat_round_exp_limit) {
+		exponent = -Efloat_round_exp_limit;
+	}
+
+	msb = hi ? (127 - (long)Efloat_u64_clz(hi))
+	    : (63 - (long)Efloat_u64_clz(lo));
+	e_msb = exponent + msb;
+
+	/* the place of the last kept bit; subnormals keep fewer bits */
+	lsb = e_msb - last;
+	if (lsb < emin - last) {
+		lsb = emin - last;
+	}
+	m = efloat_round_at(hi, lo, sticky, lsb - exponent, neg, mode,
+			    &inexact);
+
+	/* tininess is after rounding, as if the exponent were unbounded */
+	tiny = (e_msb < emin);
+	if (e_msb == emin - 1 && inexact) {
+		m_unbounded = efloat_round_at(hi, lo, sticky,
+					      e_msb - last - exponent, neg,
+					      mode, &inexact);
+		tiny = !(m_unbounded >> (last + 1));
+		inexact = 1;
+	}
+
+	if (m >> (last + 1)) {
+		/* rounding carried out */
+		m >>= 1;
+		++lsb;
+	}
+	f = inexact ? efloat_flag_inexact : 0;
+	if (lsb + last > fmt->exp_max) {
+		f |= efloat_flag_overflow | efloat_flag_inexact;
+		if (mode == ef_round_nearest_even
+		    || mode == ef_round_nearest_away
+		    || (mode == ef_round_up && !neg)
+		    || (mode == ef_round_down && neg)) {
+			bits = max_finite + 1;
+		} else {
+			bits = max_finite;
+		}
+	} else {
+		/* the hidden bit of m carries into the exponent field */
+		bits = (((uint64_t)(lsb + last - 1 + fmt->exp_max)) << last)
+		    + m;
+	}
+	if (tiny && (f & efloat_flag_inexact)) {
+		f |= efloat_flag_underflow;
+	}
+	if (flags) {
+		*flags |= f;
+	}
+	return (neg ? sign_bit : 0) | bits;
+}
+
+/* the magnitude of the two's complement (hi, lo); is it negative */
+static int efloat_int128_magnitude(int64_t hi, uint64_t lo, uint64_t *mag_hi,
+				   uint64_t *mag_lo)
+{
+	if (hi >= 0) {
+		*mag_hi = (uint64_t)hi;
+		*mag_lo = lo;
+		return 0;
+	}
+	*mag_lo = 0 - lo;
+	*mag_hi = ~((uint64_t)hi) + (lo == 0 ? 1 : 0);
+	return 1;
+}
+
+#if ((defined efloat32_exists) && (efloat32_exists))
+static const struct efloat_round_format efloat32_round_format = {
+	efloat32_mant_dig, efloat32_r2_exp_bits, efloat32_r2_exp_max
+};
+
+efloat32 efloat32_from_wide(int sign, long exponent, uint64_t significand,
+			    int sticky, enum efloat_round_mode mode,
+			    unsigned *flags)
+{
+	return uint32_bits_to_efloat32((uint32_t)
+				       efloat_round_wide(&efloat32_round_format,
+							 sign < 0, exponent, 0,
+							 significand, sticky,
+							 mode, flags));
+}
+
+efloat32 efloat32_from_wide_fields(const struct efloat_wide_fields wide,
+				   enum efloat_round_mode mode,
+				   unsigned *flags)
+{
+	return uint32_bits_to_efloat32((uint32_t)
+				       efloat_round_wide(&efloat32_round_format,
+							 wide.sign < 0,
+							 wide.exponent,
+							 wide.significand_hi,
+							 wide.significand_lo,
+							 wide.sticky, mode,
+							 flags));
+}
+
+unsigned efloat32_array_from_wide_fields(efloat32 *dst,
+					 const struct efloat_wide_fields *src,
+					 size_t len,
+					 enum efloat_round_mode mode,
+					 uint8_t *flags)
+{
+	uint32_t bits[Efloat_batch_len];
+	unsigned all, f;
+	size_t i, j, n;
+
+	all = 0;
+	for (i = 0; i < len; i += n) {
+		n = (len - i > Efloat_batch_len) ? Efloat_batch_len : len - i;
+		for (j = 0; j < n; ++j) {
+			f = 0;
+			bits[j] = (uint32_t)
+			    efloat_round_wide(&efloat32_round_format,
+					      src[i + j].sign < 0,
+					      src[i + j].exponent,
+					      src[i + j].significand_hi,
+					      src[i + j].significand_lo,
+					      src[i + j].sticky, mode, &f);
+			if (flags) {
+				flags[i + j] = (uint8_t)f;
+			}
+			all |= f;
+		}
+		uint32_bits_to_efloat32_array(dst + i, bits, n);
+	}
+	return all;
+}
+
+efloat32 int64_to_efloat32_round(int64_t i, enum efloat_round_mode mode,
+				 unsigned *flags)
+{
+	uint64_t mag;
+	int neg;
+
+	neg = (i < 0);
+	mag = neg ? (0 - (uint64_t)i) : (uint64_t)i;
+	return uint32_bits_to_efloat32((uint32_t)
+				       efloat_round_wide(&efloat32_round_format,
+							 neg, 0, 0, mag, 0,
+							 mode, flags));
+}
+
+efloat32 uint64_to_efloat32_round(uint64_t u, enum efloat_round_mode mode,
+				  unsigned *flags)
+{
+	return uint32_bits_to_efloat32((uint32_t)
+				       efloat_round_wide(&efloat32_round_format,
+							 0, 0, 0, u, 0, mode,
+							 flags));
+}
+
+efloat32 int128_to_efloat32_round(int64_t hi, uint64_t lo,
+				  enum efloat_round_mode mode,
+				  unsigned *flags)
+{
+	uint64_t mag_hi, mag_lo;
+	int neg;
+
+	neg = efloat_int128_magnitude(hi, lo, &mag_hi, &mag_lo);
+	return uint32_bits_to_efloat32((uint32_t)
+				       efloat_round_wide(&efloat32_round_format,
+							 neg, 0, mag_hi,
+							 mag_lo, 0, mode,
+							 flags));
+}
+
+efloat32 uint128_to_efloat32_round(uint64_t hi, uint64_t lo,
+				   enum efloat_round_mode mode,
+				   unsigned *flags)
+{
+	return uint32_bits_to_efloat32((uint32_t)
+				       efloat_round_wide(&efloat32_round_format,
+							 0, 0, hi, lo, 0, mode,
+							 flags));
+}
+
+unsigned int64_to_efloat32_array_round(efloat32 *dst, const int64_t *src,
+				       size_t len, enum efloat_round_mode mode,
+				       uint8_t *flags)
+{
+	uint32_t bits[Efloat_batch_len];
+	uint64_t mag;
+	unsigned all, f;
+	size_t i, j, n;
+	int neg;
+
+	all = 0;
+	for (i = 0; i < len; i += n) {
+		n = (len - i > Efloat_batch_len) ? Efloat_batch_len : len - i;
+		for (j = 0; j < n; ++j) {
+			f = 0;
+			neg = (src[i + j] < 0);
+			mag = neg ? (0 - (uint64_t)src[i + j])
+			    : (uint64_t)src[i + j];
+			bits[j] = (uint32_t)
+			    efloat_round_wide(&efloat32_round_format, neg, 0, 0,
+					      mag, 0, mode, &f);
+			if (flags) {
+				flags[i + j] = (uint8_t)f;
+			}
+			all |= f;
+		}
+		uint32_bits_to_efloat32_array(dst + i, bits, n);
+	}
+	return all;
+}
+
+unsigned uint64_to_efloat32_array_round(efloat32 *dst, const uint64_t *src,
+					size_t len, enum efloat_round_mode mode,
+					uint8_t *flags)
+{
+	uint32_t bits[Efloat_batch_len];
+	unsigned all, f;
+	size_t i, j, n;
+
+	all = 0;
+	for (i = 0; i < len; i += n) {
+		n = (len - i > Efloat_batch_len) ? Efloat_batch_len : len - i;
+		for (j = 0; j < n; ++j) {
+			f = 0;
+			bits[j] = (uint32_t)
+			    efloat_round_wide(&efloat32_round_format, 0, 0, 0,
+					      src[i + j], 0, mode, &f);
+			if (flags) {
+				flags[i + j] = (uint8_t)f;
+			}
+			all |= f;
+		}
+		uint32_bits_to_efloat32_array(dst + i, bits, n);
+	}
+	return all;
+}
+#endif
+
+#if ((defined efloat64_exists) && (efloat64_exists))
+static const struct efloat_round_format efloat64_round_format = {
+	efloat64_mant_dig, efloat64_r2_exp_bits, efloat64_r2_exp_max
+};
+
+efloat64 efloat64_from_wide(int sign, long exponent, uint64_t significand,
+			    int sticky, enum efloat_round_mode mode,
+			    unsigned *flags)
+{
+	return uint64_bits_to_efloat64(efloat_round_wide(&efloat64_round_format,
+							 sign < 0, exponent, 0,
+							 significand, sticky,
+							 mode, flags));
+}
+
+efloat64 efloat64_from_wide_fields(const struct efloat_wide_fields wide,
+				   enum efloat_round_mode mode,
+				   unsigned *flags)
+{
+	return uint64_bits_to_efloat64(efloat_round_wide(&efloat64_round_format,
+							 wide.sign < 0,
+							 wide.exponent,
+							 wide.significand_hi,
+							 wide.significand_lo,
+							 wide.sticky, mode,
+							 flags));
+}
+
+unsigned efloat64_array_from_wide_fields(efloat64 *dst,
+					 const struct efloat_wide_fields *src,
+					 size_t len,
+					 enum efloat_round_mode mode,
+					 uint8_t *flags)
+{
+	uint64_t bits[Efloat_batch_len];
+	unsigned all, f;
+	size_t i, j, n;
+
+	all = 0;
+	for (i = 0; i < len; i += n) {
+		n = (len - i > Efloat_batch_len) ? Efloat_batch_len : len - i;
+		for (j = 0; j < n; ++j) {
+			f = 0;
+			bits[j] = efloat_round_wide(&efloat64_round_format,
+						    src[i + j].sign < 0,
+						    src[i + j].exponent,
+						    src[i + j].significand_hi,
+						    src[i + j].significand_lo,
+						    src[i + j].sticky, mode,
+						    &f);
+			if (flags) {
+				flags[i + j] = (uint8_t)f;
+			}
+			all |= f;
+		}
+		uint64_bits_to_efloat64_array(dst + i, bits, n);
+	}
+	return all;
+}
+
+efloat64 int64_to_efloat64_round(int64_t i, enum efloat_round_mode mode,
+				 unsigned *flags)
+{
+	uint64_t mag;
+	int neg;
+
+	neg = (i < 0);
+	mag = neg ? (0 - (uint64_t)i) : (uint64_t)i;
+	return uint64_bits_to_efloat64(efloat_round_wide(&efloat64_round_format,
+							 neg, 0, 0, mag, 0,
+							 mode, flags));
+}
+
+efloat64 uint64_to_efloat64_round(uint64_t u, enum efloat_round_mode mode,
+				  unsigned *flags)
+{
+	return uint64_bits_to_efloat64(efloat_round_wide(&efloat64_round_format,
+							 0, 0, 0, u, 0, mode,
+							 flags));
+}
+
+efloat64 int128_to_efloat64_round(int64_t hi, uint64_t lo,
+				  enum efloat_round_mode mode,
+				  unsigned *flags)
+{
+	uint64_t mag_hi, mag_lo;
+	int neg;
+
+	neg = efloat_int128_magnitude(hi, lo, &mag_hi, &mag_lo);
+	return uint64_bits_to_efloat64(efloat_round_wide(&efloat64_round_format,
+							 neg, 0, mag_hi,
+							 mag_lo, 0, mode,
+							 flags));
+}
+
+efloat64 uint128_to_efloat64_round(uint64_t hi, uint64_t lo,
+				   enum efloat_round_mode mode,
+				   unsigned *flags)
+{
+	return uint64_bits_to_efloat64(efloat_round_wide(&efloat64_round_format,
+							 0, 0, hi, lo, 0, mode,
+							 flags));
+}
+
+unsigned int64_to_efloat64_array_round(efloat64 *dst, const int64_t *src,
+				       size_t len, enum efloat_round_mode mode,
+				       uint8_t *flags)
+{
+	uint64_t bits[Efloat_batch_len];
+	uint64_t mag;
+	unsigned all, f;
+	size_t i, j, n;
+	int neg;
+
+	all = 0;
+	for (i = 0; i < len; i += n) {
+		n = (len - i > Efloat_batch_len) ? Efloat_batch_len : len - i;
+		for (j = 0; j < n; ++j) {
+			f = 0;
+			neg = (src[i + j] < 0);
+			mag = neg ? (0 - (uint64_t)src[i + j])
+			    : (uint64_t)src[i + j];
+			bits[j] = efloat_round_wide(&efloat64_round_format, neg,
+						    0, 0, mag, 0, mode, &f);
+			if (flags) {
+				flags[i + j] = (uint8_t)f;
+			}
+			all |= f;
+		}
+		uint64_bits_to_efloat64_array(dst + i, bits, n);
+	}
+	return all;
+}
+
+unsigned uint64_to_efloat64_array_round(efloat64 *dst, const uint64_t *src,
+					size_t len, enum efloat_round_mode mode,
+					uint8_t *flags)
+{
+	uint64_t bits[Efloat_batch_len];
+	unsigned all, f;
+	size_t i, j, n;
+
+	all = 0;
+	for (i = 0; i < len; i += n) {
+		n = (len - i > Efloat_batch_len) ? Efloat_batch_len : len - i;
+		for (j = 0; j < n; ++j) {
+			f = 0;
+			bits[j] = efloat_round_wide(&efloat64_round_format, 0,
+						    0, 0, src[i + j], 0, mode,
+						    &f);
+			if (flags) {
+				flags[i + j] = (uint8_t)f;
+			}
+			all |= f;
+		}
+		uint64_bits_to_efloat64_array(dst + i, bits, n);
+	}
+	return all;
+}
+#endif
+
+#if ((defined efloat32_exists) && (efloat32_exists) \
+ && (defined efloat64_exists) && (efloat64_exists))
+/* the bits of efloat64 "bits" rounded to an efloat32 */
+static uint32_t efloat64_bits_narrow(uint64_t bits,
+				     enum efloat_round_mode mode,
+				     unsigned *flags)
+{
+	uint64_t rexp, signif;
+	uint32_t sign;
+	long exponent;
+
+	sign = (uint32_t)(bits >> 32) & efloat32_r2_sign_mask;
+	rexp = (bits & efloat64_r2_rexp_mask) >> efloat64_r2_exp_shift;
+	signif = bits & efloat64_r2_signif_mask;
+
+	if (rexp == (efloat64_r2_rexp_mask >> efloat64_r2_exp_shift)) {
+		if (signif == 0) {
+			return sign | efloat32_r2_rexp_mask;
+		}
+		/* keep the top of the payload, quieted */
+		return sign | efloat32_r2_rexp_mask | Efloat32_quiet_bit
+		    | (uint32_t)(signif >> (efloat64_mant_dig
+					    - efloat32_mant_dig));
+	}
+	if (rexp == 0) {
+		exponent = 1 - efloat64_r2_exp_max - (efloat64_mant_dig - 1);
+	} else {
+		signif |= ((uint64_t)1) << (efloat64_mant_dig - 1);
+		exponent = (long)rexp - efloat64_r2_exp_max
+		    - (efloat64_mant_dig - 1);
+	}
+	return (uint32_t)efloat_round_wide(&efloat32_round_format,
+					   sign != 0, exponent, 0, signif, 0,
+					   mode, flags);
+}
+
+efloat32 efloat64_to_efloat32_round(efloat64 d, enum efloat_round_mode mode,
+				    unsigned *flags)
+{
+	return uint32_bits_to_efloat32(efloat64_bits_narrow
+				       (efloat64_to_uint64_bits(d), mode,
+					flags));
+}
+
+unsigned efloat64_array_to_efloat32_round(efloat32 *dst, const efloat64 *src,
+					  size_t len,
+					  enum efloat_round_mode mode,
+					  uint8_t *flags)
+{
+	uint64_t wide[Efloat_batch_len];
+	uint32_t narrow[Efloat_batch_len];
+	unsigned all, f;
+	size_t i, j, n;
+
+	all = 0;
+	for (i = 0; i < len; i += n) {
+		n = (len - i > Efloat_batch_len) ? Efloat_batch_len : len - i;
+		efloat64_array_to_uint64_bits(wide, src + i, n);
+		for (j = 0; j < n; ++j) {
+			f = 0;
+			narrow[j] = efloat64_bits_narrow(wide[j], mode, &f);
+			if (flags) {
+				flags[i + j] = (uint8_t)f;
+			}
+			all |= f;
+		}
+		uint32_bits_to_efloat32_array(dst + i, narrow, n);
+	}
+	return all;
+}
+#endif
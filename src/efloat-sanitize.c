@@ -0,0 +1,198 @@
+/* SPDX-License-Identifier: LGPL-2.1-or-later */
+/* efloat-sanitize.c: flush, replace and clamp float arrays in one pass */
+/* Copyright (C) 2026 Eric Herman */
+/* https://github.com/ericherman/libefloat */
+
+#include "efloat-internal.h"
+
+/*
+ Each option is folded into the inner loop as a select which is a no-op
+ when the option is off (an unset clamp is the whole range of keys), so
+ that the loop has no branches and no floating point compares.
+*/
+
+#if ((defined efloat32_exists) && (efloat32_exists))
+void efloat32_sanitize_init(struct efloat32_sanitize *options)
+{
+	options->flags = 0;
+	options->nan_value = 0.0f;
+	options->pos_inf = efloat32_max;
+	options->neg_inf = -efloat32_max;
+	options->lo = uint32_bits_to_efloat32(efloat32_r2_sign_mask
+					      | efloat32_r2_rexp_mask);
+	options->hi = uint32_bits_to_efloat32(efloat32_r2_rexp_mask);
+}
+
+size_t efloat32_array_sanitize(efloat32 *a, size_t len,
+			       const struct efloat32_sanitize *options,
+			       uint64_t *class_count)
+{
+	uint32_t bits[Efloat_batch_len];
+	uint32_t u, v, mag, key, key_lo, key_hi, inf_bits;
+	uint32_t nan_bits, pos_inf_bits, neg_inf_bits, lo_bits, hi_bits;
+	size_t i, j, n, changed;
+	uint64_t nans, infs, zeros, subs;
+	int flush, fix_nan, fix_inf, nan, inf, sub;
+
+	if (!options) {
+		Efloat_set_err_inval();
+		return 0;
+	}
+	nan_bits = efloat32_to_uint32_bits(options->nan_value);
+	pos_inf_bits = efloat32_to_uint32_bits(options->pos_inf);
+	neg_inf_bits = efloat32_to_uint32_bits(options->neg_inf);
+	lo_bits = efloat32_to_uint32_bits(options->lo);
+	hi_bits = efloat32_to_uint32_bits(options->hi);
+	key_lo = 0;
+	key_hi = UINT32_MAX;
+	if (options->flags & efloat_sanitize_clamp) {
+		key_lo = Efloat32_order_key(lo_bits);
+		key_hi = Efloat32_order_key(hi_bits);
+		if ((lo_bits & ~efloat32_r2_sign_mask) > efloat32_r2_rexp_mask
+		    || (hi_bits & ~efloat32_r2_sign_mask)
+		    > efloat32_r2_rexp_mask || key_lo > key_hi) {
+			Efloat_set_err_inval();
+			return 0;
+		}
+	}
+	flush = (options->flags & efloat_sanitize_flush) ? 1 : 0;
+	fix_nan = (options->flags & efloat_sanitize_nan) ? 1 : 0;
+	fix_inf = (options->flags & efloat_sanitize_inf) ? 1 : 0;
+
+	changed = 0;
+	nans = 0;
+	infs = 0;
+	zeros = 0;
+	subs = 0;
+	for (i = 0; i < len; i += n) {
+		n = (len - i > Efloat_batch_len) ? Efloat_batch_len : len - i;
+		efloat32_array_to_uint32_bits(bits, a + i, n);
+		for (j = 0; j < n; ++j) {
+			u = bits[j];
+			mag = u & ~efloat32_r2_sign_mask;
+			nan = mag > efloat32_r2_rexp_mask;
+			inf = mag == efloat32_r2_rexp_mask;
+			sub = mag != 0 && mag <= efloat32_r2_signif_mask;
+			nans += nan;
+			infs += inf;
+			zeros += mag == 0;
+			subs += sub;
+
+			v = (flush && sub) ? (u & efloat32_r2_sign_mask) : u;
+			inf_bits = (u & efloat32_r2_sign_mask) ? neg_inf_bits
+			    : pos_inf_bits;
+			v = (fix_inf && inf) ? inf_bits : v;
+			v = (fix_nan && nan) ? nan_bits : v;
+			mag = v & ~efloat32_r2_sign_mask;
+			key = Efloat32_order_key(v);
+			nan = mag > efloat32_r2_rexp_mask;
+			v = (!nan && key < key_lo) ? lo_bits : v;
+			v = (!nan && key > key_hi) ? hi_bits : v;
+			changed += (v != u);
+			bits[j] = v;
+		}
+		uint32_bits_to_efloat32_array(a + i, bits, n);
+	}
+	if (class_count) {
+		class_count[ef_nan] += nans;
+		class_count[ef_inf] += infs;
+		class_count[ef_zero] += zeros;
+		class_count[ef_subnorm] += subs;
+		class_count[ef_normal] += len - (nans + infs + zeros + subs);
+	}
+	return changed;
+}
+#endif
+
+#if ((defined efloat64_exists) && (efloat64_exists))
+void efloat64_sanitize_init(struct efloat64_sanitize *options)
+{
+	options->flags = 0;
+	options->nan_value = 0.0;
+	options->pos_inf = efloat64_max;
+	options->neg_inf = -efloat64_max;
+	options->lo = uint64_bits_to_efloat64(efloat64_r2_sign_mask
+					      | efloat64_r2_rexp_mask);
+	options->hi = uint64_bits_to_efloat64(efloat64_r2_rexp_mask);
+}
+
+size_t efloat64_array_sanitize(efloat64 *a, size_t len,
+			       const struct efloat64_sanitize *options,
+			       uint64_t *class_count)
+{
+	uint64_t bits[Efloat_batch_len];
+	uint64_t u, v, mag, key, key_lo, key_hi, inf_bits;
+	uint64_t nan_bits, pos_inf_bits, neg_inf_bits, lo_bits, hi_bits;
+	size_t i, j, n, changed;
+	uint64_t nans, infs, zeros, subs;
+	int flush, fix_nan, fix_inf, nan, inf, sub;
+
+	if (!options) {
+		Efloat_set_err_inval();
+		return 0;
+	}
+	nan_bits = efloat64_to_uint64_bits(options->nan_value);
+	pos_inf_bits = efloat64_to_uint64_bits(options->pos_inf);
+	neg_inf_bits = efloat64_to_uint64_bits(options->neg_inf);
+	lo_bits = efloat64_to_uint64_bits(options->lo);
+	hi_bits = efloat64_to_uint64_bits(options->hi);
+	key_lo = 0;
+	key_hi = UINT64_MAX;
+	if (options->flags & efloat_sanitize_clamp) {
+		key_lo = Efloat64_order_key(lo_bits);
+		key_hi = Efloat64_order_key(hi_bits);
+		if ((lo_bits & ~efloat64_r2_sign_mask) > efloat64_r2_rexp_mask
+		    || (hi_bits & ~efloat64_r2_sign_mask)
+		    > efloat64_r2_rexp_mask || key_lo > key_hi) {
+			Efloat_set_err_inval();
+			return 0;
+		}
+	}
+	flush = (options->flags & efloat_sanitize_flush) ? 1 : 0;
+	fix_nan = (options->flags & efloat_sanitize_nan) ? 1 : 0;
+	fix_inf = (options->flags & efloat_sanitize_inf) ? 1 : 0;
+
+	changed = 0;
+	nans = 0;
+	infs = 0;
+	zeros = 0;
+	subs = 0;
+	for (i = 0; i < len; i += n) {
+		n = (len - i > Efloat_batch_len) ? Efloat_batch_len : len - i;
+		efloat64_array_to_uint64_bits(bits, a + i, n);
+		for (j = 0; j < n; ++j) {
+			u = bits[j];
+			mag = u & ~efloat64_r2_sign_mask;
+			nan = mag > efloat64_r2_rexp_mask;
+			inf = mag == efloat64_r2_rexp_mask;
+			sub = mag != 0 && mag <= efloat64_r2_signif_mask;
+			nans += nan;
+			infs += inf;
+			zeros += mag == 0;
+			subs += sub;
+
+			v = (flush && sub) ? (u & efloat64_r2_sign_mask) : u;
+			inf_bits = (u & efloat64_r2_sign_mask) ? neg_inf_bits
+			    : pos_inf_bits;
+			v = (fix_inf && inf) ? inf_bits : v;
+			v = (fix_nan && nan) ? nan_bits : v;
+			mag = v & ~efloat64_r2_sign_mask;
+			key = Efloat64_order_key(v);
+			nan = mag > efloat64_r2_rexp_mask;
+			v = (!nan && key < key_lo) ? lo_bits : v;
+			v = (!nan && key > key_hi) ? hi_bits : v;
+			changed += (v != u);
+			bits[j] = v;
+		}
+		uint64_bits_to_efloat64_array(a + i, bits, n);
+	}
+	if (class_count) {
+		class_count[ef_nan] += nans;
+		class_count[ef_inf] += infs;
+		class_count[ef_zero] += zeros;
+		class_count[ef_subnorm] += subs;
+		class_count[ef_normal] += len - (nans + infs + zeros + subs);
+	}
+	return changed;
+}
+#endif
@@ -0,0 +1,377 @@
+/* SPDX-License-Identifier: LGPL-2.1-or-later */
+/* efloat-shuffle.c: byte, bit and field plane shuffles of float arrays */
+/* Copyright (C) 2026 Eric Herman */
+/* https://github.com/ericherman/libefloat */
+
+#include "efloat-internal.h"
+
+/* the bit planes are filled a byte (8 values) at a time */
+#define Efloat_shuffle_block (((Efloat_batch_len + 7) / 8) * 8)
+
+/*
+ transpose an 8x8 bit matrix, where byte r is row r and bit c of each
+ byte is column c, see "Hacker's Delight" (Warren) section 7-3
+*/
+static uint64_t efloat_transpose8(uint64_t x)
+{
+	uint64_t t;
+
+	t = (x ^ (x >> 7)) & 0x00AA00AA00AA00AAULL;
+	x = x ^ t ^ (t << 7);
+	t = (x ^ (x >> 14)) & 0x0000CCCC0000CCCCULL;
+	x = x ^ t ^ (t << 14);
+	t = (x ^ (x >> 28)) & 0x00000000F0F0F0F0ULL;
+	x = x ^ t ^ (t << 28);
+	return x;
+}
+
+#if ((defined efloat32_exists) && (efloat32_exists))
+void efloat32_byte_shuffle(uint8_t *dst, const efloat32 *src, size_t len)
+{
+	uint32_t bits[Efloat_shuffle_block];
+	size_t i, j, n;
+	unsigned b;
+
+	for (i = 0; i < len; i += n) {
+		n = len - i;
+		if (n > Efloat_shuffle_block) {
+			n = Efloat_shuffle_block;
+		}
+		efloat32_array_to_uint32_bits(bits, src + i, n);
+		for (b = 0; b < 4; ++b) {
+			for (j = 0; j < n; ++j) {
+				dst[(b * len) + i + j] =
+				    (uint8_t)(bits[j] >> (8 * b));
+			}
+		}
+	}
+}
+
+void efloat32_byte_unshuffle(efloat32 *dst, const uint8_t *src, size_t len)
+{
+	uint32_t bits[Efloat_shuffle_block];
+	size_t i, j, n;
+	unsigned b;
+
+	for (i = 0; i < len; i += n) {
+		n = len - i;
+		if (n > Efloat_shuffle_block) {
+			n = Efloat_shuffle_block;
+		}
+		for (j = 0; j < n; ++j) {
+			bits[j] = 0;
+		}
+		for (b = 0; b < 4; ++b) {
+			for (j = 0; j < n; ++j) {
+				bits[j] |= ((uint32_t)src[(b * len) + i + j])
+				    << (8 * b);
+			}
+		}
+		uint32_bits_to_efloat32_array(dst + i, bits, n);
+	}
+}
+
+void efloat32_bit_shuffle(uint8_t *dst, const efloat32 *src, size_t len)
+{
+	uint32_t bits[Efloat_shuffle_block];
+	size_t i, j, n, g, plane_len;
+	uint64_t x;
+	unsigned b, c;
+
+	plane_len = efloat_bit_plane_len(len);
+	for (i = 0; i < len; i += n) {
+		n = len - i;
+		if (n > Efloat_shuffle_block) {
+			n = Efloat_shuffle_block;
+		}
+		efloat32_array_to_uint32_bits(bits, src + i, n);
+		for (j = n; j % 8; ++j) {
+			bits[j] = 0;
+		}
+		for (g = 0; g < j; g += 8) {
+			for (b = 0; b < 4; ++b) {
+				x = 0;
+				for (c = 0; c < 8; ++c) {
+					x |= ((uint64_t)((bits[g + c]
+							  >> (8 * b)) & 0xFF))
+					    << (8 * c);
+				}
+				x = efloat_transpose8(x);
+				for (c = 0; c < 8; ++c) {
+					dst[((8 * b + c) * plane_len)
+					    + ((i + g) / 8)] =
+					    (uint8_t)(x >> (8 * c));
+				}
+			}
+		}
+	}
+}
+
+void efloat32_bit_unshuffle(efloat32 *dst, const uint8_t *src, size_t len)
+{
+	uint32_t bits[Efloat_shuffle_block];
+	size_t i, n, g, plane_len;
+	uint64_t x;
+	unsigned b, c;
+
+	plane_len = efloat_bit_plane_len(len);
+	for (i = 0; i < len; i += n) {
+		n = len - i;
+		if (n > Efloat_shuffle_block) {
+			n = Efloat_shuffle_block;
+		}
+		for (g = 0; g < n; g += 8) {
+			for (c = 0; c < 8; ++c) {
+				bits[g + c] = 0;
+			}
+			for (b = 0; b < 4; ++b) {
+				x = 0;
+				for (c = 0; c < 8; ++c) {
+					x |= ((uint64_t)
+					      src[((8 * b + c) * plane_len)
+						  + ((i + g) / 8)]) << (8 * c);
+				}
+				x = efloat_transpose8(x);
+				for (c = 0; c < 8; ++c) {
+					bits[g + c] |=
+					    ((uint32_t)((x >> (8 * c)) & 0xFF))
+					    << (8 * b);
+				}
+			}
+		}
+		uint32_bits_to_efloat32_array(dst + i, bits, n);
+	}
+}
+
+void efloat32_field_split(uint8_t *sign, uint8_t *rexp, uint32_t *signif,
+			  const efloat32 *src, size_t len)
+{
+	uint32_t bits[Efloat_shuffle_block];
+	size_t i, j, n, g;
+	unsigned c, s;
+
+	for (i = 0; i < len; i += n) {
+		n = len - i;
+		if (n > Efloat_shuffle_block) {
+			n = Efloat_shuffle_block;
+		}
+		efloat32_array_to_uint32_bits(bits, src + i, n);
+		for (j = 0; j < n; ++j) {
+			rexp[i + j] = (uint8_t)((bits[j]
+						 & efloat32_r2_rexp_mask)
+						>> efloat32_r2_exp_shift);
+			signif[i + j] = bits[j] & efloat32_r2_signif_mask;
+		}
+		for (j = n; j % 8; ++j) {
+			bits[j] = 0;
+		}
+		for (g = 0; g < j; g += 8) {
+			s = 0;
+			for (c = 0; c < 8; ++c) {
+				s |= ((bits[g + c] & efloat32_r2_sign_mask)
+				      >> 31) << c;
+			}
+			sign[(i + g) / 8] = (uint8_t)s;
+		}
+	}
+}
+
+void efloat32_field_join(efloat32 *dst, const uint8_t *sign,
+			 const uint8_t *rexp, const uint32_t *signif,
+			 size_t len)
+{
+	uint32_t bits[Efloat_shuffle_block];
+	size_t i, j, n;
+
+	for (i = 0; i < len; i += n) {
+		n = len - i;
+		if (n > Efloat_shuffle_block) {
+			n = Efloat_shuffle_block;
+		}
+		for (j = 0; j < n; ++j) {
+			bits[j] = (((uint32_t)((sign[(i + j) / 8]
+						>> ((i + j) % 8)) & 1)) << 31)
+			    | ((((uint32_t)rexp[i + j])
+				<< efloat32_r2_exp_shift)
+			       & efloat32_r2_rexp_mask)
+			    | (signif[i + j] & efloat32_r2_signif_mask);
+		}
+		uint32_bits_to_efloat32_array(dst + i, bits, n);
+	}
+}
+#endif
+
+#if ((defined efloat64_exists) && (efloat64_exists))
+void efloat64_byte_shuffle(uint8_t *dst, const efloat64 *src, size_t len)
+{
+	uint64_t bits[Efloat_shuffle_block];
+	size_t i, j, n;
+	unsigned b;
+
+	for (i = 0; i < len; i += n) {
+		n = len - i;
+		if (n > Efloat_shuffle_block) {
+			n = Efloat_shuffle_block;
+		}
+		efloat64_array_to_uint64_bits(bits, src + i, n);
+		for (b = 0; b < 8; ++b) {
+			for (j = 0; j < n; ++j) {
+				dst[(b * len) + i + j] =
+				    (uint8_t)(bits[j] >> (8 * b));
+			}
+		}
+	}
+}
+
+void efloat64_byte_unshuffle(efloat64 *dst, const uint8_t *src, size_t len)
+{
+	uint64_t bits[Efloat_shuffle_block];
+	size_t i, j, n;
+	unsigned b;
+
+	for (i = 0; i < len; i += n) {
+		n = len - i;
+		if (n > Efloat_shuffle_block) {
+			n = Efloat_shuffle_block;
+		}
+		for (j = 0; j < n; ++j) {
+			bits[j] = 0;
+		}
+		for (b = 0; b < 8; ++b) {
+			for (j = 0; j < n; ++j) {
+				bits[j] |= ((uint64_t)src[(b * len) + i + j])
+				    << (8 * b);
+			}
+		}
+		uint64_bits_to_efloat64_array(dst + i, bits, n);
+	}
+}
+
+void efloat64_bit_shuffle(uint8_t *dst, const efloat64 *src, size_t len)
+{
+	uint64_t bits[Efloat_shuffle_block];
+	size_t i, j, n, g, plane_len;
+	uint64_t x;
+	unsigned b, c;
+
+	plane_len = efloat_bit_plane_len(len);
+	for (i = 0; i < len; i += n) {
+		n = len - i;
+		if (n > Efloat_shuffle_block) {
+			n = Efloat_shuffle_block;
+		}
+		efloat64_array_to_uint64_bits(bits, src + i, n);
+		for (j = n; j % 8; ++j) {
+			bits[j] = 0;
+		}
+		for (g = 0; g < j; g += 8) {
+			for (b = 0; b < 8; ++b) {
+				x = 0;
+				for (c = 0; c < 8; ++c) {
+					x |= ((bits[g + c] >> (8 * b)) & 0xFF)
+					    << (8 * c);
+				}
+				x = efloat_transpose8(x);
+				for (c = 0; c < 8; ++c) {
+					dst[((8 * b + c) * plane_len)
+					    + ((i + g) / 8)] =
+					    (uint8_t)(x >> (8 * c));
+				}
+			}
+		}
+	}
+}
+
+void efloat64_bit_unshuffle(efloat64 *dst, const uint8_t *src, size_t len)
+{
+	uint64_t bits[Efloat_shuffle_block];
+	size_t i, n, g, plane_len;
+	uint64_t x;
+	unsigned b, c;
+
+	plane_len = efloat_bit_plane_len(len);
+	for (i = 0; i < len; i += n) {
+		n = len - i;
+		if (n > Efloat_shuffle_block) {
+			n = Efloat_shuffle_block;
+		}
+		for (g = 0; g < n; g += 8) {
+			for (c = 0; c < 8; ++c) {
+				bits[g + c] = 0;
+			}
+			for (b = 0; b < 8; ++b) {
+				x = 0;
+				for (c = 0; c < 8; ++c) {
+					x |= ((uint64_t)
+					      src[((8 * b + c) * plane_len)
+						  + ((i + g) / 8)]) << (8 * c);
+				}
+				x = efloat_transpose8(x);
+				for (c = 0; c < 8; ++c) {
+					bits[g + c] |= ((x >> (8 * c)) & 0xFF)
+					    << (8 * b);
+				}
+			}
+		}
+		uint64_bits_to_efloat64_array(dst + i, bits, n);
+	}
+}
+
+void efloat64_field_split(uint8_t *sign, uint16_t *rexp, uint64_t *signif,
+			  const efloat64 *src, size_t len)
+{
+	uint64_t bits[Efloat_shuffle_block];
+	size_t i, j, n, g;
+	unsigned c, s;
+
+	for (i = 0; i < len; i += n) {
+		n = len - i;
+		if (n > Efloat_shuffle_block) {
+			n = Efloat_shuffle_block;
+		}
+		efloat64_array_to_uint64_bits(bits, src + i, n);
+		for (j = 0; j < n; ++j) {
+			rexp[i + j] = (uint16_t)((bits[j]
+						  & efloat64_r2_rexp_mask)
+						 >> efloat64_r2_exp_shift);
+			signif[i + j] = bits[j] & efloat64_r2_signif_mask;
+		}
+		for (j = n; j % 8; ++j) {
+			bits[j] = 0;
+		}
+		for (g = 0; g < j; g += 8) {
+			s = 0;
+			for (c = 0; c < 8; ++c) {
+				s |= (unsigned)((bits[g + c]
+						 & efloat64_r2_sign_mask) >> 63)
+				    << c;
+			}
+			sign[(i + g) / 8] = (uint8_t)s;
+		}
+	}
+}
+
+void efloat64_field_join(efloat64 *dst, const uint8_t *sign,
+			 const uint16_t *rexp, const uint64_t *signif,
+			 size_t len)
+{
+	uint64_t bits[Efloat_shuffle_block];
+	size_t i, j, n;
+
+	for (i = 0; i < len; i += n) {
+		n = len - i;
+		if (n > Efloat_shuffle_block) {
+			n = Efloat_shuffle_block;
+		}
+		for (j = 0; j < n; ++j) {
+			bits[j] = (((uint64_t)((sign[(i + j) / 8]
+						>> ((i + j) % 8)) & 1)) << 63)
+			    | ((((uint64_t)rexp[i + j])
+				<< efloat64_r2_exp_shift)
+			       & efloat64_r2_rexp_mask)
+			    | (signif[i + j] & efloat64_r2_signif_mask);
+		}
+		uint64_bits_to_efloat64_array(dst + i, bits, n);
+	}
+}
+#endif
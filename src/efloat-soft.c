@@ -0,0 +1,995 @@
+/* SPDX-License-Identifier: LGPL-2.1-or-later */
+/* efloat-soft.c: IEEE 754 arithmetic in software, on bit patterns */
+/* Copyright (C) 2026 Eric Herman */
+/* https://github.com/ericherman/libefloat */
+
+#include "efloat-internal.h"
+
+/*
+ The working significands follow Berkeley SoftFloat: once normalized,
+ the leading one is at bit 30 (efloat32) or bit 62 (efloat64), and the
+ bits below the last place of the result are rounding bits, with any
+ lost bits "jammed" into the lowest. The working exponent is one less
+ than the biased exponent, as packing adds the leading one into the
+ exponent field; a rounding carry thus also carries into the exponent.
+
+ Only the add and compare of the width of the format are needed; the
+ wider products are built from half-width multiplies, and the divide
+ and square root produce one bit at a time.
+*/
+
+static unsigned efloat_u32_clz(uint32_t u)
+{
+	return Efloat_u64_clz((uint64_t)u) - 32;
+}
+
+static uint32_t efloat_u32_shift_right_jam(uint32_t a, unsigned dist)
+{
+	if (dist == 0) {
+		return a;
+	} else if (dist < 31) {
+		return (a >> dist) | ((a << (32 - dist)) != 0);
+	}
+	return (a != 0);
+}
+
+static uint64_t efloat_u64_shift_right_jam(uint64_t a, unsigned dist)
+{
+	if (dist == 0) {
+		return a;
+	} else if (dist < 63) {
+		return (a >> dist) | ((a << (64 - dist)) != 0);
+	}
+	return (a != 0);
+}
+
+/* the high half of a 32 x 32 bit product, from 16 x 16 bit products */
+static uint32_t efloat_u32_mul(uint32_t a, uint32_t b, uint32_t *lo)
+{
+	uint32_t ll, lh, hl, hh, mid;
+
+	ll = (a & 0xFFFF) * (b & 0xFFFF);
+	lh = (a & 0xFFFF) * (b >> 16);
+	hl = (a >> 16) * (b & 0xFFFF);
+	hh = (a >> 16) * (b >> 16);
+	mid = (ll >> 16) + (lh & 0xFFFF) + (hl & 0xFFFF);
+	*lo = (ll & 0xFFFF) | (mid << 16);
+	return hh + (lh >> 16) + (hl >> 16) + (mid >> 16);
+}
+
+#if ((defined efloat32_exists) && (efloat32_exists))
+#define Efloat32_soft_exp(u) \
+	((int)(((u) & efloat32_r2_rexp_mask) >> efloat32_r2_exp_shift))
+#define Efloat32_soft_frac(u) ((u) & efloat32_r2_signif_mask)
+#define Efloat32_soft_hidden (efloat32_r2_signif_mask + 1)
+#define Efloat32_soft_exp_all_ones 0xFF
+#define Efloat32_soft_is_nan(u) \
+	(((u) & ~efloat32_r2_sign_mask) > efloat32_r2_rexp_mask)
+#define Efloat32_soft_pack(sign, exp, sig) \
+	(((sign) ? efloat32_r2_sign_mask : 0) \
+	 + (((uint32_t)(exp)) << efloat32_r2_exp_shift) + (sig))
+#define Efloat32_soft_inf(sign) \
+	Efloat32_soft_pack(sign, Efloat32_soft_exp_all_ones, 0)
+
+/* a NaN operand is returned quieted, the first if both are NaN */
+static uint32_t efloat32_soft_nan(uint32_t a, uint32_t b)
+{
+	return (Efloat32_soft_is_nan(a) ? a : b) | Efloat32_quiet_bit;
+}
+
+/* normalize a non-zero subnormal to have its leading one hidden */
+static void efloat32_soft_normalize(int *exp, uint32_t *sig)
+{
+	unsigned shift;
+
+	shift = efloat_u32_clz(*sig) - 8;
+	*exp = 1 - (int)shift;
+	*sig <<= shift;
+}
+
+/* round to nearest, ties to even, and pack */
+static uint32_t efloat32_soft_round_pack(int sign, int exp, uint32_t sig)
+{
+	uint32_t round_bits;
+
+	round_bits = sig & 0x7F;
+	if ((unsigned)exp >= 0xFD) {
+		if (exp < 0) {
+			/* subnormal, or underflow */
+			sig = efloat_u32_shift_right_jam(sig, (unsigned)-exp);
+			exp = 0;
+			round_bits = sig & 0x7F;
+		} else if (exp > 0xFD || (sig + 0x40) >= 0x80000000UL) {
+			return Efloat32_soft_inf(sign);
+		}
+	}
+	sig = (sig + 0x40) >> 7;
+	if (round_bits == 0x40) {
+		sig &= ~((uint32_t)1);
+	}
+	return Efloat32_soft_pack(sign, sig ? exp : 0, sig);
+}
+
+static uint32_t efloat32_soft_norm_round_pack(int sign, int exp, uint32_t sig)
+{
+	unsigned shift;
+
+	shift = efloat_u32_clz(sig) - 1;
+	exp -= (int)shift;
+	if (shift >= 7 && (unsigned)exp < 0xFD) {
+		return Efloat32_soft_pack(sign, sig ? exp : 0,
+					  sig << (shift - 7));
+	}
+	return efloat32_soft_round_pack(sign, exp, sig << shift);
+}
+
+static uint32_t efloat32_soft_add_mags(uint32_t a, uint32_t b, int sign)
+{
+	uint32_t sig_a, sig_b, sig_z;
+	int exp_a, exp_b, exp_z, diff;
+
+	exp_a = Efloat32_soft_exp(a);
+	sig_a = Efloat32_soft_frac(a);
+	exp_b = Efloat32_soft_exp(b);
+	sig_b = Efloat32_soft_frac(b);
+	diff = exp_a - exp_b;
+	if (diff == 0) {
+		if (exp_a == 0) {
+			/* subnormals; a carry makes a normal */
+			return a + sig_b;
+		} else if (exp_a == Efloat32_soft_exp_all_ones) {
+			return (sig_a | sig_b) ? efloat32_soft_nan(a, b) : a;
+		}
+		exp_z = exp_a;
+		sig_z = ((2 * Efloat32_soft_hidden) + sig_a + sig_b) << 6;
+		return efloat32_soft_round_pack(sign, exp_z, sig_z);
+	}
+
+	sig_a <<= 6;
+	sig_b <<= 6;
+	if (diff < 0) {
+		if (exp_b == Efloat32_soft_exp_all_ones) {
+			return sig_b ? efloat32_soft_nan(a, b)
+			    : Efloat32_soft_inf(sign);
+		}
+		exp_z = exp_b;
+		sig_a += exp_a ? 0x20000000UL : sig_a;
+		sig_a = efloat_u32_shift_right_jam(sig_a, (unsigned)-diff);
+	} else {
+		if (exp_a == Efloat32_soft_exp_all_ones) {
+			return sig_a ? efloat32_soft_nan(a, b) : a;
+		}
+		exp_z = exp_a;
+		sig_b += exp_b ? 0x20000000UL : sig_b;
+		sig_b = efloat_u32_shift_right_jam(sig_b, (unsigned)diff);
+	}
+	sig_z = 0x20000000UL + sig_a + sig_b;
+	if (sig_z < 0x40000000UL) {
+		--exp_z;
+		sig_z <<= 1;
+	}
+	return efloat32_soft_round_pack(sign, exp_z, sig_z);
+}
+
+static uint32_t efloat32_soft_sub_mags(uint32_t a, uint32_t b, int sign)
+{
+	uint32_t sig_a, sig_b, sig_x, sig_y;
+	int exp_a, exp_b, exp_z, diff;
+	int32_t sig_diff;
+	unsigned shift;
+
+	exp_a = Efloat32_soft_exp(a);
+	sig_a = Efloat32_soft_frac(a);
+	exp_b = Efloat32_soft_exp(b);
+	sig_b = Efloat32_soft_frac(b);
+	diff = exp_a - exp_b;
+	if (diff == 0) {
+		if (exp_a == Efloat32_soft_exp_all_ones) {
+			return (sig_a | sig_b) ? efloat32_soft_nan(a, b)
+			    : efloat32_canonical_nan_bits;
+		}
+		/* exact, as the hidden bits cancel */
+		sig_diff = (int32_t)sig_a - (int32_t)sig_b;
+		if (sig_diff == 0) {
+			return 0;
+		}
+		if (exp_a) {
+			--exp_a;
+		}
+		if (sig_diff < 0) {
+			sign = !sign;
+			sig_diff = -sig_diff;
+		}
+		shift = efloat_u32_clz((uint32_t)sig_diff) - 8;
+		exp_z = exp_a - (int)shift;
+		if (exp_z < 0) {
+			shift = (unsigned)exp_a;
+			exp_z = 0;
+		}
+		return Efloat32_soft_pack(sign, exp_z,
+					  ((uint32_t)sig_diff) << shift);
+	}
+
+	sig_a <<= 7;
+	sig_b <<= 7;
+	if (diff < 0) {
+		sign = !sign;
+		if (exp_b == Efloat32_soft_exp_all_ones) {
+			return sig_b ? efloat32_soft_nan(a, b)
+			    : Efloat32_soft_inf(sign);
+		}
+		exp_z = exp_b - 1;
+		sig_x = sig_b | 0x40000000UL;
+		sig_y = sig_a + (exp_a ? 0x40000000UL : sig_a);
+		diff = -diff;
+	} else {
+		if (exp_a == Efloat32_soft_exp_all_ones) {
+			return sig_a ? efloat32_soft_nan(a, b) : a;
+		}
+		exp_z = exp_a - 1;
+		sig_x = sig_a | 0x40000000UL;
+		sig_y = sig_b + (exp_b ? 0x40000000UL : sig_b);
+	}
+	sig_y = efloat_u32_shift_right_jam(sig_y, (unsigned)diff);
+	return efloat32_soft_norm_round_pack(sign, exp_z, sig_x - sig_y);
+}
+
+uint32_t efloat32_soft_add(uint32_t a, uint32_t b)
+{
+	int sign_a, sign_b;
+
+	sign_a = (a & efloat32_r2_sign_mask) ? 1 : 0;
+	sign_b = (b & efloat32_r2_sign_mask) ? 1 : 0;
+	if (sign_a == sign_b) {
+		return efloat32_soft_add_mags(a, b, sign_a);
+	}
+	return efloat32_soft_sub_mags(a, b, sign_a);
+}
+
+uint32_t efloat32_soft_sub(uint32_t a, uint32_t b)
+{
+	int sign_a, sign_b;
+
+	sign_a = (a & efloat32_r2_sign_mask) ? 1 : 0;
+	sign_b = (b & efloat32_r2_sign_mask) ? 1 : 0;
+	if (sign_a == sign_b) {
+		return efloat32_soft_sub_mags(a, b, sign_a);
+	}
+	return efloat32_soft_add_mags(a, b, sign_a);
+}
+
+uint32_t efloat32_soft_mul(uint32_t a, uint32_t b)
+{
+	uint32_t sig_a, sig_b, sig_z, lo;
+	int sign, exp_a, exp_b, exp_z;
+
+	sign = ((a ^ b) & efloat32_r2_sign_mask) ? 1 : 0;
+	exp_a = Efloat32_soft_exp(a);
+	sig_a = Efloat32_soft_frac(a);
+	exp_b = Efloat32_soft_exp(b);
+	sig_b = Efloat32_soft_frac(b);
+	if (exp_a == Efloat32_soft_exp_all_ones) {
+		if (sig_a || Efloat32_soft_is_nan(b)) {
+			return efloat32_soft_nan(a, b);
+		}
+		return (exp_b | sig_b) ? Efloat32_soft_inf(sign)
+		    : efloat32_canonical_nan_bits;
+	}
+	if (exp_b == Efloat32_soft_exp_all_ones) {
+		if (sig_b) {
+			return efloat32_soft_nan(a, b);
+		}
+		return (exp_a | sig_a) ? Efloat32_soft_inf(sign)
+		    : efloat32_canonical_nan_bits;
+	}
+	if (exp_a == 0) {
+		if (sig_a == 0) {
+			return Efloat32_soft_pack(sign, 0, 0);
+		}
+		efloat32_soft_normalize(&exp_a, &sig_a);
+	}
+	if (exp_b == 0) {
+		if (sig_b == 0) {
+			return Efloat32_soft_pack(sign, 0, 0);
+		}
+		efloat32_soft_normalize(&exp_b, &sig_b);
+	}
+	exp_z = exp_a + exp_b - efloat32_r2_exp_max;
+	sig_a = (sig_a | Efloat32_soft_hidden) << 7;
+	sig_b = (sig_b | Efloat32_soft_hidden) << 8;
+	sig_z = efloat_u32_mul(sig_a, sig_b, &lo);
+	sig_z |= (lo != 0);
+	if (sig_z < 0x40000000UL) {
+		--exp_z;
+		sig_z <<= 1;
+	}
+	return efloat32_soft_round_pack(sign, exp_z, sig_z);
+}
+
+uint32_t efloat32_soft_div(uint32_t a, uint32_t b)
+{
+	uint32_t sig_a, sig_b, sig_z;
+	int sign, exp_a, exp_b, exp_z;
+	unsigned i;
+
+	sign = ((a ^ b) & efloat32_r2_sign_mask) ? 1 : 0;
+	exp_a = Efloat32_soft_exp(a);
+	sig_a = Efloat32_soft_frac(a);
+	exp_b = Efloat32_soft_exp(b);
+	sig_b = Efloat32_soft_frac(b);
+	if (exp_a == Efloat32_soft_exp_all_ones) {
+		if (sig_a || Efloat32_soft_is_nan(b)) {
+			return efloat32_soft_nan(a, b);
+		}
+		return (exp_b == Efloat32_soft_exp_all_ones)
+		    ? efloat32_canonical_nan_bits
+		    : Efloat32_soft_inf(sign);
+	}
+	if (exp_b == Efloat32_soft_exp_all_ones) {
+		return sig_b ? efloat32_soft_nan(a, b)
+		    : Efloat32_soft_pack(sign, 0, 0);
+	}
+	if (exp_b == 0) {
+		if (sig_b == 0) {
+			/* division by zero */
+			return (exp_a | sig_a) ? Efloat32_soft_inf(sign)
+			    : efloat32_canonical_nan_bits;
+		}
+		efloat32_soft_normalize(&exp_b, &sig_b);
+	}
+	if (exp_a == 0) {
+		if (sig_a == 0) {
+			return Efloat32_soft_pack(sign, 0, 0);
+		}
+		efloat32_soft_normalize(&exp_a, &sig_a);
+	}
+	exp_z = exp_a - exp_b + (efloat32_r2_exp_max - 1);
+	sig_a |= Efloat32_soft_hidden;
+	sig_b |= Efloat32_soft_hidden;
+	if (sig_a < sig_b) {
+		--exp_z;
+		sig_a <<= 1;
+	}
+	/* restoring division, one quotient bit at a time */
+	sig_z = 0;
+	for (i = 0; i < 31; ++i) {
+		sig_z <<= 1;
+		if (sig_a >= sig_b) {
+			sig_a -= sig_b;
+			sig_z |= 1;
+		}
+		sig_a <<= 1;
+	}
+	return efloat32_soft_round_pack(sign, exp_z, sig_z | (sig_a != 0));
+}
+
+uint32_t efloat32_soft_sqrt(uint32_t a)
+{
+	uint32_t sig_a, rem, root, trial, pair;
+	int exp_a, e, pos, shift;
+	unsigned i;
+
+	exp_a = Efloat32_soft_exp(a);
+	sig_a = Efloat32_soft_frac(a);
+	if (exp_a == Efloat32_soft_exp_all_ones) {
+		if (sig_a) {
+			return efloat32_soft_nan(a, a);
+		}
+		return (a & efloat32_r2_sign_mask) ? efloat32_canonical_nan_bits
+		    : a;
+	}
+	if (a & efloat32_r2_sign_mask) {
+		return (exp_a | sig_a) ? efloat32_canonical_nan_bits : a;
+	}
+	if (exp_a == 0) {
+		if (sig_a == 0) {
+			return a;
+		}
+		efloat32_soft_normalize(&exp_a, &sig_a);
+	}
+
+	/* a is sig_a * 2^e, shifted so that e is even */
+	sig_a |= Efloat32_soft_hidden;
+	e = exp_a - efloat32_r2_exp_max - efloat32_r2_exp_shift;
+	shift = (e & 1) ? 1 : 2;
+	sig_a <<= shift;
+	e -= shift;
+
+	/*
+	 the digit by digit square root of sig_a * 2^30, two bits of the
+	 radicand at a time, gives a 28 bit root
+	*/
+	rem = 0;
+	root = 0;
+	for (i = 0; i < 28; ++i) {
+		pos = 24 - (2 * (int)i);
+		pair = (pos >= 0) ? ((sig_a >> pos) & 3) : 0;
+		rem = (rem << 2) | pair;
+		trial = (root << 2) | 1;
+		root <<= 1;
+		if (rem >= trial) {
+			rem -= trial;
+			root |= 1;
+		}
+	}
+	return efloat32_soft_round_pack(0, ((e - 30) / 2) + 27
+					+ (efloat32_r2_exp_max - 1),
+					(root << 3) | (rem != 0));
+}
+
+uint32_t efloat32_soft_fma(uint32_t a, uint32_t b, uint32_t c)
+{
+	uint32_t sig_a, sig_b, sig_c, hi, lo;
+	int sign, sign_c, exp_a, exp_b, exp_c, e, e_c;
+	uint64_t x, y, s;
+	unsigned lz;
+
+	sign = ((a ^ b) & efloat32_r2_sign_mask) ? 1 : 0;
+	sign_c = (c & efloat32_r2_sign_mask) ? 1 : 0;
+	exp_a = Efloat32_soft_exp(a);
+	sig_a = Efloat32_soft_frac(a);
+	exp_b = Efloat32_soft_exp(b);
+	sig_b = Efloat32_soft_frac(b);
+	exp_c = Efloat32_soft_exp(c);
+	sig_c = Efloat32_soft_frac(c);
+	if (Efloat32_soft_is_nan(a) || Efloat32_soft_is_nan(b)) {
+		return efloat32_soft_nan(a, b);
+	} else if (Efloat32_soft_is_nan(c)) {
+		return c | Efloat32_quiet_bit;
+	}
+	if (exp_a == Efloat32_soft_exp_all_ones
+	    || exp_b == Efloat32_soft_exp_all_ones) {
+		if (!(exp_a | sig_a) || !(exp_b | sig_b)
+		    || (exp_c == Efloat32_soft_exp_all_ones
+			&& sign_c != sign)) {
+			return efloat32_canonical_nan_bits;
+		}
+		return Efloat32_soft_inf(sign);
+	}
+	if (exp_c == Efloat32_soft_exp_all_ones) {
+		return c;
+	}
+	if (!(exp_a | sig_a) || !(exp_b | sig_b)) {
+		/* an exact zero product */
+		if (exp_c | sig_c) {
+			return c;
+		}
+		return Efloat32_soft_pack(sign && sign_c, 0, 0);
+	}
+	if (exp_a == 0) {
+		efloat32_soft_normalize(&exp_a, &sig_a);
+	}
+	if (exp_b == 0) {
+		efloat32_soft_normalize(&exp_b, &sig_b);
+	}
+
+	/* the exact product, x * 2^e, has its leading one at bit 60 or 61 */
+	hi = efloat_u32_mul(sig_a | Efloat32_soft_hidden,
+			    sig_b | Efloat32_soft_hidden, &lo);
+	x = ((((uint64_t)hi) << 32) | lo) << 14;
+	e = exp_a + exp_b
+	    - (2 * (efloat32_r2_exp_max + efloat32_r2_exp_shift)) - 14;
+	s = x;
+	if (exp_c | sig_c) {
+		if (exp_c == 0) {
+			efloat32_soft_normalize(&exp_c, &sig_c);
+		}
+		y = ((uint64_t)(sig_c | Efloat32_soft_hidden)) << 37;
+		e_c = exp_c - efloat32_r2_exp_max - efloat32_r2_exp_shift - 37;
+		if (e >= e_c) {
+			y = efloat_u64_shift_right_jam(y, (unsigned)(e - e_c));
+		} else {
+			x = efloat_u64_shift_right_jam(x, (unsigned)(e_c - e));
+			e = e_c;
+		}
+		if (sign == sign_c) {
+			s = x + y;
+		} else if (x >= y) {
+			s = x - y;
+		} else {
+			s = y - x;
+			sign = sign_c;
+		}
+		if (s == 0) {
+			return 0;
+		}
+	}
+	lz = Efloat_u64_clz(s) - 1;
+	s <<= lz;
+	return efloat32_soft_round_pack(sign, e - (int)lz + 32 + 30
+					+ (efloat32_r2_exp_max - 1),
+					((uint32_t)(s >> 32))
+					| ((s & UINT32_MAX) != 0));
+}
+#endif
+
+#if ((defined efloat64_exists) && (efloat64_exists))
+#define Efloat64_soft_exp(u) \
+	((int)(((u) & efloat64_r2_rexp_mask) >> efloat64_r2_exp_shift))
+#define Efloat64_soft_frac(u) ((u) & efloat64_r2_signif_mask)
+#define Efloat64_soft_hidden (efloat64_r2_signif_mask + 1)
+#define Efloat64_soft_exp_all_ones 0x7FF
+#define Efloat64_soft_is_nan(u) \
+	(((u) & ~efloat64_r2_sign_mask) > efloat64_r2_rexp_mask)
+#define Efloat64_soft_pack(sign, exp, sig) \
+	(((sign) ? efloat64_r2_sign_mask : 0) \
+	 + (((uint64_t)(exp)) << efloat64_r2_exp_shift) + (sig))
+#define Efloat64_soft_inf(sign) \
+	Efloat64_soft_pack(sign, Efloat64_soft_exp_all_ones, 0)
+
+/* the high half of a 64 x 64 bit product, from 32 x 32 bit products */
+static uint64_t efloat_u64_mul(uint64_t a, uint64_t b, uint64_t *lo)
+{
+	uint64_t ll, lh, hl, hh, mid;
+
+	ll = (a & UINT32_MAX) * (b & UINT32_MAX);
+	lh = (a & UINT32_MAX) * (b >> 32);
+	hl = (a >> 32) * (b & UINT32_MAX);
+	hh = (a >> 32) * (b >> 32);
+	mid = (ll >> 32) + (lh & UINT32_MAX) + (hl & UINT32_MAX);
+	*lo = (ll & UINT32_MAX) | (mid << 32);
+	return hh + (lh >> 32) + (hl >> 32) + (mid >> 32);
+}
+
+static void efloat_u128_shift_right_jam(uint64_t *hi, uint64_t *lo,
+					unsigned dist)
+{
+	uint64_t sticky;
+
+	if (dist == 0) {
+		return;
+	} else if (dist < 64) {
+		sticky = ((*lo << (64 - dist)) != 0);
+		*lo = (*lo >> dist) | (*hi << (64 - dist)) | sticky;
+		*hi >>= dist;
+	} else if (dist < 128) {
+		sticky = (*lo != 0);
+		if (dist > 64) {
+			sticky |= ((*hi << (128 - dist)) != 0);
+		}
+		*lo = (*hi >> (dist - 64)) | sticky;
+		*hi = 0;
+	} else {
+		*lo = ((*hi | *lo) != 0);
+		*hi = 0;
+	}
+}
+
+static uint64_t efloat64_soft_nan(uint64_t a, uint64_t b)
+{
+	return (Efloat64_soft_is_nan(a) ? a : b) | Efloat64_quiet_bit;
+}
+
+static void efloat64_soft_normalize(int *exp, uint64_t *sig)
+{
+	unsigned shift;
+
+	shift = Efloat_u64_clz(*sig) - 11;
+	*exp = 1 - (int)shift;
+	*sig <<= shift;
+}
+
+static uint64_t efloat64_soft_round_pack(int sign, int exp, uint64_t sig)
+{
+	uint64_t round_bits;
+
+	round_bits = sig & 0x3FF;
+	if ((unsigned)exp >= 0x7FD) {
+		if (exp < 0) {
+			sig = efloat_u64_shift_right_jam(sig, (unsigned)-exp);
+			exp = 0;
+			round_bits = sig & 0x3FF;
+		} else if (exp > 0x7FD
+			   || (sig + 0x200) >= efloat64_r2_sign_mask) {
+			return Efloat64_soft_inf(sign);
+		}
+	}
+	sig = (sig + 0x200) >> 10;
+	if (round_bits == 0x200) {
+		sig &= ~((uint64_t)1);
+	}
+	return Efloat64_soft_pack(sign, sig ? exp : 0, sig);
+}
+
+static uint64_t efloat64_soft_norm_round_pack(int sign, int exp, uint64_t sig)
+{
+	unsigned shift;
+
+	shift = Efloat_u64_clz(sig) - 1;
+	exp -= (int)shift;
+	if (shift >= 10 && (unsigned)exp < 0x7FD) {
+		return Efloat64_soft_pack(sign, sig ? exp : 0,
+					  sig << (shift - 10));
+	}
+	return efloat64_soft_round_pack(sign, exp, sig << shift);
+}
+
+static uint64_t efloat64_soft_add_mags(uint64_t a, uint64_t b, int sign)
+{
+	uint64_t sig_a, sig_b, sig_z;
+	int exp_a, exp_b, exp_z, diff;
+
+	exp_a = Efloat64_soft_exp(a);
+	sig_a = Efloat64_soft_frac(a);
+	exp_b = Efloat64_soft_exp(b);
+	sig_b = Efloat64_soft_frac(b);
+	diff = exp_a - exp_b;
+	if (diff == 0) {
+		if (exp_a == 0) {
+			return a + sig_b;
+		} else if (exp_a == Efloat64_soft_exp_all_ones) {
+			return (sig_a | sig_b) ? efloat64_soft_nan(a, b) : a;
+		}
+		exp_z = exp_a;
+		sig_z = ((2 * Efloat64_soft_hidden) + sig_a + sig_b) << 9;
+		return efloat64_soft_round_pack(sign, exp_z, sig_z);
+	}
+
+	sig_a <<= 9;
+	sig_b <<= 9;
+	if (diff < 0) {
+		if (exp_b == Efloat64_soft_exp_all_ones) {
+			return sig_b ? efloat64_soft_nan(a, b)
+			    : Efloat64_soft_inf(sign);
+		}
+		exp_z = exp_b;
+		sig_a += exp_a ? 0x2000000000000000UL : sig_a;
+		sig_a = efloat_u64_shift_right_jam(sig_a, (unsigned)-diff);
+	} else {
+		if (exp_a == Efloat64_soft_exp_all_ones) {
+			return sig_a ? efloat64_soft_nan(a, b) : a;
+		}
+		exp_z = exp_a;
+		sig_b += exp_b ? 0x2000000000000000UL : sig_b;
+		sig_b = efloat_u64_shift_right_jam(sig_b, (unsigned)diff);
+	}
+	sig_z = 0x2000000000000000UL + sig_a + sig_b;
+	if (sig_z < 0x4000000000000000UL) {
+		--exp_z;
+		sig_z <<= 1;
+	}
+	return efloat64_soft_round_pack(sign, exp_z, sig_z);
+}
+
+static uint64_t efloat64_soft_sub_mags(uint64_t a, uint64_t b, int sign)
+{
+	uint64_t sig_a, sig_b, sig_x, sig_y, sig_diff;
+	int exp_a, exp_b, exp_z, diff;
+	unsigned shift;
+
+	exp_a = Efloat64_soft_exp(a);
+	sig_a = Efloat64_soft_frac(a);
+	exp_b = Efloat64_soft_exp(b);
+	sig_b = Efloat64_soft_frac(b);
+	diff = exp_a - exp_b;
+	if (diff == 0) {
+		if (exp_a == Efloat64_soft_exp_all_ones) {
+			return (sig_a | sig_b) ? efloat64_soft_nan(a, b)
+			    : efloat64_canonical_nan_bits;
+		}
+		if (sig_a == sig_b) {
+			return 0;
+		}
+		if (exp_a) {
+			--exp_a;
+		}
+		if (sig_a < sig_b) {
+			sign = !sign;
+			sig_diff = sig_b - sig_a;
+		} else {
+			sig_diff = sig_a - sig_b;
+		}
+		shift = Efloat_u64_clz(sig_diff) - 11;
+		exp_z = exp_a - (int)shift;
+		if (exp_z < 0) {
+			shift = (unsigned)exp_a;
+			exp_z = 0;
+		}
+		return Efloat64_soft_pack(sign, exp_z, sig_diff << shift);
+	}
+
+	sig_a <<= 10;
+	sig_b <<= 10;
+	if (diff < 0) {
+		sign = !sign;
+		if (exp_b == Efloat64_soft_exp_all_ones) {
+			return sig_b ? efloat64_soft_nan(a, b)
+			    : Efloat64_soft_inf(sign);
+		}
+		exp_z = exp_b - 1;
+		sig_x = sig_b | 0x4000000000000000UL;
+		sig_y = sig_a + (exp_a ? 0x4000000000000000UL : sig_a);
+		diff = -diff;
+	} else {
+		if (exp_a == Efloat64_soft_exp_all_ones) {
+			return sig_a ? efloat64_soft_nan(a, b) : a;
+		}
+		exp_z = exp_a - 1;
+		sig_x = sig_a | 0x4000000000000000UL;
+		sig_y = sig_b + (exp_b ? 0x4000000000000000UL : sig_b);
+	}
+	sig_y = efloat_u64_shift_right_jam(sig_y, (unsigned)diff);
+	return efloat64_soft_norm_round_pack(sign, exp_z, sig_x - sig_y);
+}
+
+uint64_t efloat64_soft_add(uint64_t a, uint64_t b)
+{
+	int sign_a, sign_b;
+
+	sign_a = (a & efloat64_r2_sign_mask) ? 1 : 0;
+	sign_b = (b & efloat64_r2_sign_mask) ? 1 : 0;
+	if (sign_a == sign_b) {
+		return efloat64_soft_add_mags(a, b, sign_a);
+	}
+	return efloat64_soft_sub_mags(a, b, sign_a);
+}
+
+uint64_t efloat64_soft_sub(uint64_t a, uint64_t b)
+{
+	int sign_a, sign_b;
+
+	sign_a = (a & efloat64_r2_sign_mask) ? 1 : 0;
+	sign_b = (b & efloat64_r2_sign_mask) ? 1 : 0;
+	if (sign_a == sign_b) {
+		return efloat64_soft_sub_mags(a, b, sign_a);
+	}
+	return efloat64_soft_add_mags(a, b, sign_a);
+}
+
+uint64_t efloat64_soft_mul(uint64_t a, uint64_t b)
+{
+	uint64_t sig_a, sig_b, sig_z, lo;
+	int sign, exp_a, exp_b, exp_z;
+
+	sign = ((a ^ b) & efloat64_r2_sign_mask) ? 1 : 0;
+	exp_a = Efloat64_soft_exp(a);
+	sig_a = Efloat64_soft_frac(a);
+	exp_b = Efloat64_soft_exp(b);
+	sig_b = Efloat64_soft_frac(b);
+	if (exp_a == Efloat64_soft_exp_all_ones) {
+		if (sig_a || Efloat64_soft_is_nan(b)) {
+			return efloat64_soft_nan(a, b);
+		}
+		return (exp_b | sig_b) ? Efloat64_soft_inf(sign)
+		    : efloat64_canonical_nan_bits;
+	}
+	if (exp_b == Efloat64_soft_exp_all_ones) {
+		if (sig_b) {
+			return efloat64_soft_nan(a, b);
+		}
+		return (exp_a | sig_a) ? Efloat64_soft_inf(sign)
+		    : efloat64_canonical_nan_bits;
+	}
+	if (exp_a == 0) {
+		if (sig_a == 0) {
+			return Efloat64_soft_pack(sign, 0, 0);
+		}
+		efloat64_soft_normalize(&exp_a, &sig_a);
+	}
+	if (exp_b == 0) {
+		if (sig_b == 0) {
+			return Efloat64_soft_pack(sign, 0, 0);
+		}
+		efloat64_soft_normalize(&exp_b, &sig_b);
+	}
+	exp_z = exp_a + exp_b - (int)efloat64_r2_exp_max;
+	sig_a = (sig_a | Efloat64_soft_hidden) << 10;
+	sig_b = (sig_b | Efloat64_soft_hidden) << 11;
+	sig_z = efloat_u64_mul(sig_a, sig_b, &lo);
+	sig_z |= (lo != 0);
+	if (sig_z < 0x4000000000000000UL) {
+		--exp_z;
+		sig_z <<= 1;
+	}
+	return efloat64_soft_round_pack(sign, exp_z, sig_z);
+}
+
+uint64_t efloat64_soft_div(uint64_t a, uint64_t b)
+{
+	uint64_t sig_a, sig_b, sig_z;
+	int sign, exp_a, exp_b, exp_z;
+	unsigned i;
+
+	sign = ((a ^ b) & efloat64_r2_sign_mask) ? 1 : 0;
+	exp_a = Efloat64_soft_exp(a);
+	sig_a = Efloat64_soft_frac(a);
+	exp_b = Efloat64_soft_exp(b);
+	sig_b = Efloat64_soft_frac(b);
+	if (exp_a == Efloat64_soft_exp_all_ones) {
+		if (sig_a || Efloat64_soft_is_nan(b)) {
+			return efloat64_soft_nan(a, b);
+		}
+		return (exp_b == Efloat64_soft_exp_all_ones)
+		    ? efloat64_canonical_nan_bits
+		    : Efloat64_soft_inf(sign);
+	}
+	if (exp_b == Efloat64_soft_exp_all_ones) {
+		return sig_b ? efloat64_soft_nan(a, b)
+		    : Efloat64_soft_pack(sign, 0, 0);
+	}
+	if (exp_b == 0) {
+		if (sig_b == 0) {
+			return (exp_a | sig_a) ? Efloat64_soft_inf(sign)
+			    : efloat64_canonical_nan_bits;
+		}
+		efloat64_soft_normalize(&exp_b, &sig_b);
+	}
+	if (exp_a == 0) {
+		if (sig_a == 0) {
+			return Efloat64_soft_pack(sign, 0, 0);
+		}
+		efloat64_soft_normalize(&exp_a, &sig_a);
+	}
+	exp_z = exp_a - exp_b + (int)(efloat64_r2_exp_max - 1);
+	sig_a |= Efloat64_soft_hidden;
+	sig_b |= Efloat64_soft_hidden;
+	if (sig_a < sig_b) {
+		--exp_z;
+		sig_a <<= 1;
+	}
+	sig_z = 0;
+	for (i = 0; i < 63; ++i) {
+		sig_z <<= 1;
+		if (sig_a >= sig_b) {
+			sig_a -= sig_b;
+			sig_z |= 1;
+		}
+		sig_a <<= 1;
+	}
+	return efloat64_soft_round_pack(sign, exp_z, sig_z | (sig_a != 0));
+}
+
+uint64_t efloat64_soft_sqrt(uint64_t a)
+{
+	uint64_t sig_a, rem, root, trial, pair;
+	int exp_a, e, pos;
+	unsigned i;
+
+	exp_a = Efloat64_soft_exp(a);
+	sig_a = Efloat64_soft_frac(a);
+	if (exp_a == Efloat64_soft_exp_all_ones) {
+		if (sig_a) {
+			return efloat64_soft_nan(a, a);
+		}
+		return (a & efloat64_r2_sign_mask) ? efloat64_canonical_nan_bits
+		    : a;
+	}
+	if (a & efloat64_r2_sign_mask) {
+		return (exp_a | sig_a) ? efloat64_canonical_nan_bits : a;
+	}
+	if (exp_a == 0) {
+		if (sig_a == 0) {
+			return a;
+		}
+		efloat64_soft_normalize(&exp_a, &sig_a);
+	}
+
+	sig_a |= Efloat64_soft_hidden;
+	e = exp_a - (int)efloat64_r2_exp_max - efloat64_r2_exp_shift;
+	if (e & 1) {
+		sig_a <<= 1;
+		--e;
+	}
+
+	/* the square root of sig_a * 2^68 is a 61 bit root */
+	rem = 0;
+	root = 0;
+	for (i = 0; i < 61; ++i) {
+		pos = 52 - (2 * (int)i);
+		pair = (pos >= 0) ? ((sig_a >> pos) & 3) : 0;
+		rem = (rem << 2) | pair;
+		trial = (root << 2) | 1;
+		root <<= 1;
+		if (rem >= trial) {
+			rem -= trial;
+			root |= 1;
+		}
+	}
+	return efloat64_soft_round_pack(0, ((e - 68) / 2) + 60
+					+ (int)(efloat64_r2_exp_max - 1),
+					(root << 2) | (rem != 0));
+}
+
+uint64_t efloat64_soft_fma(uint64_t a, uint64_t b, uint64_t c)
+{
+	uint64_t sig_a, sig_b, sig_c, x_hi, x_lo, y_hi, y_lo, s_hi, s_lo;
+	int sign, sign_c, exp_a, exp_b, exp_c, e, e_c;
+	unsigned lz;
+
+	sign = ((a ^ b) & efloat64_r2_sign_mask) ? 1 : 0;
+	sign_c = (c & efloat64_r2_sign_mask) ? 1 : 0;
+	exp_a = Efloat64_soft_exp(a);
+	sig_a = Efloat64_soft_frac(a);
+	exp_b = Efloat64_soft_exp(b);
+	sig_b = Efloat64_soft_frac(b);
+	exp_c = Efloat64_soft_exp(c);
+	sig_c = Efloat64_soft_frac(c);
+	if (Efloat64_soft_is_nan(a) || Efloat64_soft_is_nan(b)) {
+		return efloat64_soft_nan(a, b);
+	} else if (Efloat64_soft_is_nan(c)) {
+		return c | Efloat64_quiet_bit;
+	}
+	if (exp_a == Efloat64_soft_exp_all_ones
+	    || exp_b == Efloat64_soft_exp_all_ones) {
+		if (!(exp_a | sig_a) || !(exp_b | sig_b)
+		    || (exp_c == Efloat64_soft_exp_all_ones
+			&& sign_c != sign)) {
+			return efloat64_canonical_nan_bits;
+		}
+		return Efloat64_soft_inf(sign);
+	}
+	if (exp_c == Efloat64_soft_exp_all_ones) {
+		return c;
+	}
+	if (!(exp_a | sig_a) || !(exp_b | sig_b)) {
+		if (exp_c | sig_c) {
+			return c;
+		}
+		return Efloat64_soft_pack(sign && sign_c, 0, 0);
+	}
+	if (exp_a == 0) {
+		efloat64_soft_normalize(&exp_a, &sig_a);
+	}
+	if (exp_b == 0) {
+		efloat64_soft_normalize(&exp_b, &sig_b);
+	}
+
+	/* the exact product, x * 2^e, has its leading one at bit 124 or 125 */
+	x_hi = efloat_u64_mul(sig_a | Efloat64_soft_hidden,
+			      sig_b | Efloat64_soft_hidden, &x_lo);
+	x_hi = (x_hi << 20) | (x_lo >> 44);
+	x_lo <<= 20;
+	e = exp_a + exp_b
+	    - (2 * (int)(efloat64_r2_exp_max + efloat64_r2_exp_shift)) - 20;
+	s_hi = x_hi;
+	s_lo = x_lo;
+	if (exp_c | sig_c) {
+		if (exp_c == 0) {
+			efloat64_soft_normalize(&exp_c, &sig_c);
+		}
+		y_hi = (sig_c | Efloat64_soft_hidden) << 8;
+		y_lo = 0;
+		e_c = exp_c - (int)efloat64_r2_exp_max - efloat64_r2_exp_shift
+		    - 72;
+		if (e >= e_c) {
+			efloat_u128_shift_right_jam(&y_hi, &y_lo,
+						    (unsigned)(e - e_c));
+		} else {
+			efloat_u128_shift_right_jam(&x_hi, &x_lo,
+						    (unsigned)(e_c - e));
+			e = e_c;
+		}
+		if (sign == sign_c) {
+			s_lo = x_lo + y_lo;
+			s_hi = x_hi + y_hi + (s_lo < x_lo);
+		} else if (x_hi > y_hi || (x_hi == y_hi && x_lo >= y_lo)) {
+			s_lo = x_lo - y_lo;
+			s_hi = x_hi - y_hi - (x_lo < y_lo);
+		} else {
+			s_lo = y_lo - x_lo;
+			s_hi = y_hi - x_hi - (y_lo < x_lo);
+			sign = sign_c;
+		}
+		if ((s_hi | s_lo) == 0) {
+			return 0;
+		}
+	}
+
+	/* normalize to a leading one at bit 126 */
+	if (s_hi) {
+		lz = Efloat_u64_clz(s_hi) - 1;
+	} else {
+		lz = 63 + Efloat_u64_clz(s_lo);
+	}
+	if (lz >= 64) {
+		s_hi = s_lo << (lz - 64);
+		s_lo = 0;
+	} else if (lz) {
+		s_hi = (s_hi << lz) | (s_lo >> (64 - lz));
+		s_lo <<= lz;
+	}
+	return efloat64_soft_round_pack(sign, e - (int)lz + 64 + 62
+					+ (int)(efloat64_r2_exp_max - 1),
+					s_hi | (s_lo != 0));
+}
+#endif
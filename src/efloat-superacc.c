@@ -0,0 +1,551 @@
+/* SPDX-License-Identifier: LGPL-2.1-or-later */
+/* efloat-superacc.c: exact accumulation of sums and dot products */
+/* Copyright (C) 2026 Eric Herman */
+/* https://github.com/ericherman/libefloat */
+
+#include "efloat-internal.h"
+
+/*
+ The accumulator is one two's complement fixed point number of
+ efloat_superacc_words 64 bit words, least significant word first; bit 0
+ weighs 2^-Efloat_superacc_bias. That is below the least bit of a
+ product of two of the smallest efloat64 subnormals (2^-2148), and the
+ largest product (under 2^2048) leaves more than 120 bits of headroom
+ for carries, so every sum of fewer than 2^120 finite terms or
+ products is held exactly, whatever the order of the additions.
+*/
+#define Efloat_superacc_bias 2176L
+
+/* the specials remember what the words can not hold */
+#define Efloat_superacc_nan 0x01
+#define Efloat_superacc_pos_inf 0x02
+#define Efloat_superacc_neg_inf 0x04
+#define Efloat_superacc_invalid 0x08
+/* terms other than +0, and other than -0, for the sign of a zero sum */
+#define Efloat_superacc_not_pos_zero 0x10
+#define Efloat_superacc_not_neg_zero 0x20
+
+static void efloat_superacc_zero_term(struct efloat_superacc *acc, int neg)
+{
+	acc->specials |= neg ? Efloat_superacc_not_pos_zero
+	    : Efloat_superacc_not_neg_zero;
+}
+
+static void efloat_superacc_inf_term(struct efloat_superacc *acc, int neg)
+{
+	acc->specials |= neg ? Efloat_superacc_neg_inf
+	    : Efloat_superacc_pos_inf;
+}
+
+/*
+ Add or subtract (hi, lo) * 2^exponent, where the exponent is at least
+ -Efloat_superacc_bias; the carry or borrow runs only as far as needed.
+*/
+static void efloat_superacc_add_bits(struct efloat_superacc *acc, int neg,
+				     long exponent, uint64_t hi, uint64_t lo)
+{
+	uint64_t part[3], w, t, carry;
+	size_t i, k;
+	unsigned s;
+	long p;
+
+	acc->specials |= Efloat_superacc_not_pos_zero
+	    | Efloat_superacc_not_neg_zero;
+	p = exponent + Efloat_superacc_bias;
+	i = (size_t)(p / 64);
+	s = (unsigned)(p % 64);
+	part[0] = lo << s;
+	part[1] = s ? ((lo >> (64 - s)) | (hi << s)) : hi;
+	part[2] = s ? (hi >> (64 - s)) : 0;
+
+	carry = 0;
+	for (k = 0; i + k < efloat_superacc_words && (k < 3 || carry); ++k) {
+		t = ((k < 3) ? part[k] : 0) + carry;
+		carry = (t < carry);
+		w = acc->word[i + k];
+		if (neg) {
+			acc->word[i + k] = w - t;
+			carry |= (w < t);
+		} else {
+			acc->word[i + k] = w + t;
+			carry |= (w + t < t);
+		}
+	}
+}
+
+/*
+ The magnitude of the accumulator as a 64 bit significand, the exponent
+ of its last bit and the sticky of the bits below; returns 0 for zero.
+*/
+static int efloat_superacc_magnitude(const struct efloat_superacc *acc,
+				     int *neg, uint64_t *sig, long *exponent,
+				     int *sticky)
+{
+	uint64_t mag[efloat_superacc_words];
+	uint64_t carry;
+	size_t i, top, wi;
+	unsigned ws;
+	long msb, low;
+
+	*neg = (acc->word[efloat_superacc_words - 1] >> 63) ? 1 : 0;
+	carry = 1;
+	for (i = 0; i < efloat_superacc_words; ++i) {
+		mag[i] = acc->word[i];
+		if (*neg) {
+			mag[i] = ~mag[i] + carry;
+			carry = carry && (mag[i] == 0);
+		}
+	}
+	top = efloat_superacc_words;
+	while (top > 0 && mag[top - 1] == 0) {
+		--top;
+	}
+	if (top == 0) {
+		return 0;
+	}
+	msb = (long)(top - 1) * 64 + 63 - (long)Efloat_u64_clz(mag[top - 1]);
+	low = (msb > 63) ? (msb - 63) : 0;
+	wi = (size_t)(low / 64);
+	ws = (unsigned)(low % 64);
+	*sig = mag[wi] >> ws;
+	if (ws && wi + 1 < efloat_superacc_words) {
+		*sig |= mag[wi + 1] << (64 - ws);
+	}
+	*sticky = ws ? ((mag[wi] << (64 - ws)) != 0) : 0;
+	for (i = 0; i < wi && !*sticky; ++i) {
+		*sticky = (mag[i] != 0);
+	}
+	*exponent = low - Efloat_superacc_bias;
+	return 1;
+}
+
+/*
+ The sign of a zero sum, as IEEE 754 gives it for the sums in order:
+ -0 only if every term is -0, or if rounding down and not every term
+ is +0.
+*/
+static int efloat_superacc_zero_neg(const struct efloat_superacc *acc,
+				    enum efloat_round_mode mode)
+{
+	if (!(acc->specials & Efloat_superacc_not_pos_zero)) {
+		return 0;
+	}
+	if (!(acc->specials & Efloat_superacc_not_neg_zero)) {
+		return 1;
+	}
+	return mode == ef_round_down;
+}
+
+/* returns non-zero if the result is NaN, or infinity */
+static int efloat_superacc_special(const struct efloat_superacc *acc,
+				   int *neg, unsigned *flags)
+{
+	unsigned s;
+
+	s = acc->specials;
+	if ((s & Efloat_superacc_pos_inf) && (s & Efloat_superacc_neg_inf)) {
+		s |= Efloat_superacc_nan | Efloat_superacc_invalid;
+	}
+	if ((s & Efloat_superacc_invalid) && flags) {
+		*flags |= efloat_flag_invalid;
+	}
+	if (s & Efloat_superacc_nan) {
+		*neg = -1;
+		return 1;
+	}
+	if (s & (Efloat_superacc_pos_inf | Efloat_superacc_neg_inf)) {
+		*neg = (s & Efloat_superacc_neg_inf) ? 1 : 0;
+		return 1;
+	}
+	return 0;
+}
+
+void efloat_superacc_zero(struct efloat_superacc *acc)
+{
+	size_t i;
+
+	for (i = 0; i < efloat_superacc_words; ++i) {
+		acc->word[i] = 0;
+	}
+	acc->specials = 0;
+}
+
+void efloat_superacc_merge(struct efloat_superacc *acc,
+			   const struct efloat_superacc *partial)
+{
+	uint64_t t, carry;
+	size_t i;
+
+	carry = 0;
+	for (i = 0; i < efloat_superacc_words; ++i) {
+		t = partial->word[i] + carry;
+		carry = (t < carry);
+		acc->word[i] += t;
+		carry |= (acc->word[i] < t);
+	}
+	acc->specials |= partial->specials;
+}
+
+#if ((defined efloat32_exists) && (efloat32_exists))
+#define Efloat32_superacc_hidden (efloat32_r2_signif_mask + 1)
+#define Efloat32_superacc_exp_lsb \
+	(1L - efloat32_r2_exp_max - (efloat32_mant_dig - 1))
+
+/* the integer significand and exponent of a finite, non-zero float */
+static uint32_t efloat32_superacc_fields(uint32_t bits, long *exponent)
+{
+	uint32_t rexp, signif;
+
+	rexp = (bits & efloat32_r2_rexp_mask) >> efloat32_r2_exp_shift;
+	signif = bits & efloat32_r2_signif_mask;
+	if (rexp == 0) {
+		*exponent = Efloat32_superacc_exp_lsb;
+		return signif;
+	}
+	*exponent = Efloat32_superacc_exp_lsb + (long)rexp - 1;
+	return signif | Efloat32_superacc_hidden;
+}
+
+static int efloat32_superacc_is_zero(uint32_t bits)
+{
+	return (bits & ~efloat32_r2_sign_mask) == 0;
+}
+
+static int efloat32_superacc_is_inf_nan(uint32_t bits)
+{
+	return (bits & efloat32_r2_rexp_mask) == efloat32_r2_rexp_mask;
+}
+
+static int efloat32_superacc_is_nan(uint32_t bits)
+{
+	return efloat32_superacc_is_inf_nan(bits)
+	    && (bits & efloat32_r2_signif_mask);
+}
+
+static void efloat32_superacc_add_bits(struct efloat_superacc *acc,
+				       uint32_t bits)
+{
+	uint32_t sig;
+	long exponent;
+	int neg;
+
+	neg = (bits & efloat32_r2_sign_mask) ? 1 : 0;
+	if (efloat32_superacc_is_inf_nan(bits)) {
+		if (bits & efloat32_r2_signif_mask) {
+			acc->specials |= Efloat_superacc_nan;
+		} else {
+			efloat_superacc_inf_term(acc, neg);
+		}
+		return;
+	}
+	if (efloat32_superacc_is_zero(bits)) {
+		efloat_superacc_zero_term(acc, neg);
+		return;
+	}
+	sig = efloat32_superacc_fields(bits, &exponent);
+	efloat_superacc_add_bits(acc, neg, exponent, 0, sig);
+}
+
+static void efloat32_superacc_add_product(struct efloat_superacc *acc,
+					  uint32_t a, uint32_t b)
+{
+	uint64_t sig;
+	long exp_a, exp_b;
+	int neg;
+
+	neg = ((a ^ b) & efloat32_r2_sign_mask) ? 1 : 0;
+	if (efloat32_superacc_is_nan(a) || efloat32_superacc_is_nan(b)) {
+		acc->specials |= Efloat_superacc_nan;
+		return;
+	}
+	if (efloat32_superacc_is_inf_nan(a)
+	    || efloat32_superacc_is_inf_nan(b)) {
+		if (efloat32_superacc_is_zero(a)
+		    || efloat32_superacc_is_zero(b)) {
+			acc->specials |= Efloat_superacc_nan
+			    | Efloat_superacc_invalid;
+		} else {
+			efloat_superacc_inf_term(acc, neg);
+		}
+		return;
+	}
+	if (efloat32_superacc_is_zero(a) || efloat32_superacc_is_zero(b)) {
+		efloat_superacc_zero_term(acc, neg);
+		return;
+	}
+	sig = (uint64_t)efloat32_superacc_fields(a, &exp_a)
+	    * efloat32_superacc_fields(b, &exp_b);
+	efloat_superacc_add_bits(acc, neg, exp_a + exp_b, 0, sig);
+}
+
+void efloat32_superacc_add(struct efloat_superacc *acc, efloat32 f)
+{
+	efloat32_superacc_add_bits(acc, efloat32_to_uint32_bits(f));
+}
+
+void efloat32_superacc_add_array(struct efloat_superacc *acc,
+				 const efloat32 *src, size_t len)
+{
+	uint32_t bits[Efloat_batch_len];
+	size_t i, j, n;
+
+	for (i = 0; i < len; i += n) {
+		n = (len - i > Efloat_batch_len) ? Efloat_batch_len : len - i;
+		efloat32_array_to_uint32_bits(bits, src + i, n);
+		for (j = 0; j < n; ++j) {
+			efloat32_superacc_add_bits(acc, bits[j]);
+		}
+	}
+}
+
+void efloat32_superacc_add_products(struct efloat_superacc *acc,
+				    const efloat32 *a, const efloat32 *b,
+				    size_t len)
+{
+	uint32_t bits_a[Efloat_batch_len];
+	uint32_t bits_b[Efloat_batch_len];
+	size_t i, j, n;
+
+	for (i = 0; i < len; i += n) {
+		n = (len - i > Efloat_batch_len) ? Efloat_batch_len : len - i;
+		efloat32_array_to_uint32_bits(bits_a, a + i, n);
+		efloat32_array_to_uint32_bits(bits_b, b + i, n);
+		for (j = 0; j < n; ++j) {
+			efloat32_superacc_add_product(acc, bits_a[j],
+						      bits_b[j]);
+		}
+	}
+}
+
+efloat32 efloat32_superacc_round(const struct efloat_superacc *acc,
+				 enum efloat_round_mode mode, unsigned *flags)
+{
+	uint64_t sig;
+	long exponent;
+	int neg, sticky;
+
+	if (efloat_superacc_special(acc, &neg, flags)) {
+		if (neg < 0) {
+			return uint32_bits_to_efloat32
+			    (efloat32_canonical_nan_bits);
+		}
+		return uint32_bits_to_efloat32((neg ? efloat32_r2_sign_mask
+						: 0) | efloat32_r2_rexp_mask);
+	}
+	if (!efloat_superacc_magnitude(acc, &neg, &sig, &exponent, &sticky)) {
+		return uint32_bits_to_efloat32(efloat_superacc_zero_neg
+					       (acc, mode)
+					       ? efloat32_r2_sign_mask : 0);
+	}
+	return efloat32_from_wide(neg ? -1 : 1, exponent, sig, sticky, mode,
+				  flags);
+}
+
+efloat32 efloat32_array_sum_exact(const efloat32 *src, size_t len)
+{
+	struct efloat_superacc acc;
+
+	efloat_superacc_zero(&acc);
+	efloat32_superacc_add_array(&acc, src, len);
+	return efloat32_superacc_round(&acc, ef_round_nearest_even, NULL);
+}
+
+efloat32 efloat32_array_dot_exact(const efloat32 *a, const efloat32 *b,
+				  size_t len)
+{
+	struct efloat_superacc acc;
+
+	efloat_superacc_zero(&acc);
+	efloat32_superacc_add_products(&acc, a, b, len);
+	return efloat32_superacc_round(&acc, ef_round_nearest_even, NULL);
+}
+#endif
+
+#if ((defined efloat64_exists) && (efloat64_exists))
+/* the high half of a 64 x 64 bit product, from 32 x 32 bit products */
+static uint64_t efloat_u64_mul(uint64_t a, uint64_t b, uint64_t *lo)
+{
+	uint64_t ll, lh, hl, hh, mid;
+
+	ll = (a & UINT32_MAX) * (b & UINT32_MAX);
+	lh = (a & UINT32_MAX) * (b >> 32);
+	hl = (a >> 32) * (b & UINT32_MAX);
+	hh = (a >> 32) * (b >> 32);
+	mid = (ll >> 32) + (lh & UINT32_MAX) + (hl & UINT32_MAX);
+	*lo = (ll & UINT32_MAX) | (mid << 32);
+	return hh + (lh >> 32) + (hl >> 32) + (mid >> 32);
+}
+
+#define Efloat64_superacc_hidden (efloat64_r2_signif_mask + 1)
+#define Efloat64_superacc_exp_lsb \
+	(1L - efloat64_r2_exp_max - (efloat64_mant_dig - 1))
+
+static uint64_t efloat64_superacc_fields(uint64_t bits, long *exponent)
+{
+	uint64_t rexp, signif;
+
+	rexp = (bits & efloat64_r2_rexp_mask) >> efloat64_r2_exp_shift;
+	signif = bits & efloat64_r2_signif_mask;
+	if (rexp == 0) {
+		*exponent = Efloat64_superacc_exp_lsb;
+		return signif;
+	}
+	*exponent = Efloat64_superacc_exp_lsb + (long)rexp - 1;
+	return signif | Efloat64_superacc_hidden;
+}
+
+static int efloat64_superacc_is_zero(uint64_t bits)
+{
+	return (bits & ~efloat64_r2_sign_mask) == 0;
+}
+
+static int efloat64_superacc_is_inf_nan(uint64_t bits)
+{
+	return (bits & efloat64_r2_rexp_mask) == efloat64_r2_rexp_mask;
+}
+
+static int efloat64_superacc_is_nan(uint64_t bits)
+{
+	return efloat64_superacc_is_inf_nan(bits)
+	    && (bits & efloat64_r2_signif_mask);
+}
+
+static void efloat64_superacc_add_bits(struct efloat_superacc *acc,
+				       uint64_t bits)
+{
+	uint64_t sig;
+	long exponent;
+	int neg;
+
+	neg = (bits & efloat64_r2_sign_mask) ? 1 : 0;
+	if (efloat64_superacc_is_inf_nan(bits)) {
+		if (bits & efloat64_r2_signif_mask) {
+			acc->specials |= Efloat_superacc_nan;
+		} else {
+			efloat_superacc_inf_term(acc, neg);
+		}
+		return;
+	}
+	if (efloat64_superacc_is_zero(bits)) {
+		efloat_superacc_zero_term(acc, neg);
+		return;
+	}
+	sig = efloat64_superacc_fields(bits, &exponent);
+	efloat_superacc_add_bits(acc, neg, exponent, 0, sig);
+}
+
+static void efloat64_superacc_add_product(struct efloat_superacc *acc,
+					  uint64_t a, uint64_t b)
+{
+	uint64_t hi, lo, sig_a, sig_b;
+	long exp_a, exp_b;
+	int neg;
+
+	neg = ((a ^ b) & efloat64_r2_sign_mask) ? 1 : 0;
+	if (efloat64_superacc_is_nan(a) || efloat64_superacc_is_nan(b)) {
+		acc->specials |= Efloat_superacc_nan;
+		return;
+	}
+	if (efloat64_superacc_is_inf_nan(a)
+	    || efloat64_superacc_is_inf_nan(b)) {
+		if (efloat64_superacc_is_zero(a)
+		    || efloat64_superacc_is_zero(b)) {
+			acc->specials |= Efloat_superacc_nan
+			    | Efloat_superacc_invalid;
+		} else {
+			efloat_superacc_inf_term(acc, neg);
+		}
+		return;
+	}
+	if (efloat64_superacc_is_zero(a) || efloat64_superacc_is_zero(b)) {
+		efloat_superacc_zero_term(acc, neg);
+		return;
+	}
+	sig_a = efloat64_superacc_fields(a, &exp_a);
+	sig_b = efloat64_superacc_fields(b, &exp_b);
+	hi = efloat_u64_mul(sig_a, sig_b, &lo);
+	efloat_superacc_add_bits(acc, neg, exp_a + exp_b, hi, lo);
+}
+
+void efloat64_superacc_add(struct efloat_superacc *acc, efloat64 d)
+{
+	efloat64_superacc_add_bits(acc, efloat64_to_uint64_bits(d));
+}
+
+void efloat64_superacc_add_array(struct efloat_superacc *acc,
+				 const efloat64 *src, size_t len)
+{
+	uint64_t bits[Efloat_batch_len];
+	size_t i, j, n;
+
+	for (i = 0; i < len; i += n) {
+		n = (len - i > Efloat_batch_len) ? Efloat_batch_len : len - i;
+		efloat64_array_to_uint64_bits(bits, src + i, n);
+		for (j = 0; j < n; ++j) {
+			efloat64_superacc_add_bits(acc, bits[j]);
+		}
+	}
+}
+
+void efloat64_superacc_add_products(struct efloat_superacc *acc,
+				    const efloat64 *a, const efloat64 *b,
+				    size_t len)
+{
+	uint64_t bits_a[Efloat_batch_len];
+	uint64_t bits_b[Efloat_batch_len];
+	size_t i, j, n;
+
+	for (i = 0; i < len; i += n) {
+		n = (len - i > Efloat_batch_len) ? Efloat_batch_len : len - i;
+		efloat64_array_to_uint64_bits(bits_a, a + i, n);
+		efloat64_array_to_uint64_bits(bits_b, b + i, n);
+		for (j = 0; j < n; ++j) {
+			efloat64_superacc_add_product(acc, bits_a[j],
+						      bits_b[j]);
+		}
+	}
+}
+
+efloat64 efloat64_superacc_round(const struct efloat_superacc *acc,
+				 enum efloat_round_mode mode, unsigned *flags)
+{
+	uint64_t sig;
+	long exponent;
+	int neg, sticky;
+
+	if (efloat_superacc_special(acc, &neg, flags)) {
+		if (neg < 0) {
+			return uint64_bits_to_efloat64
+			    (efloat64_canonical_nan_bits);
+		}
+		return uint64_bits_to_efloat64((neg ? efloat64_r2_sign_mask
+						: 0) | efloat64_r2_rexp_mask);
+	}
+	if (!efloat_superacc_magnitude(acc, &neg, &sig, &exponent, &sticky)) {
+		return uint64_bits_to_efloat64(efloat_superacc_zero_neg
+					       (acc, mode)
+					       ? efloat64_r2_sign_mask : 0);
+	}
+	return efloat64_from_wide(neg ? -1 : 1, exponent, sig, sticky, mode,
+				  flags);
+}
+
+efloat64 efloat64_array_sum_exact(const efloat64 *src, size_t len)
+{
+	struct efloat_superacc acc;
+
+	efloat_superacc_zero(&acc);
+	efloat64_superacc_add_array(&acc, src, len);
+	return efloat64_superacc_round(&acc, ef_round_nearest_even, NULL);
+}
+
+efloat64 efloat64_array_dot_exact(const efloat64 *a, const efloat64 *b,
+				  size_t len)
+{
+	struct efloat_superacc acc;
+
+	efloat_superacc_zero(&acc);
+	efloat64_superacc_add_products(&acc, a, b, len);
+	return efloat64_superacc_round(&acc, ef_round_nearest_even, NULL);
+}
+#endif
@@ -0,0 +1,351 @@
+/* SPDX-License-Identifier: LGPL-2.1-or-later */
+/* efloat-trim.c: precision trimming of float arrays, for compression */
+/* Copyright (C) 2026 Eric Herman */
+/* https://github.com/ericherman/libefloat */
+
+#include "efloat-internal.h"
+
+enum efloat_trim_kind {
+	efloat_trim_fixed = 0,
+	efloat_trim_abs = 1,
+	efloat_trim_rel = 2
+};
+
+#if ((defined efloat32_exists) && (efloat32_exists))
+#define Efloat32_trim_bias (efloat32_r2_exp_max + efloat32_r2_exp_shift)
+
+/*
+ A tolerance of zero, or of infinity, as a power of two; beyond every
+ exponent, so that "drop" saturates, yet within a 16 bit int.
+*/
+#define Efloat32_trim_exp_all ((int)(Efloat32_trim_bias + 2))
+#define Efloat32_trim_exp_none (-Efloat32_trim_exp_all)
+
+/* floor(log2(|x|)) for a finite non-zero x */
+static int efloat32_trim_floor_log2(uint32_t u)
+{
+	uint32_t rexp;
+
+	rexp = (u & efloat32_r2_rexp_mask) >> efloat32_r2_exp_shift;
+	if (rexp) {
+		return (int)rexp - efloat32_r2_exp_max;
+	}
+	return (63 - (int)Efloat_u64_clz(u & efloat32_r2_signif_mask))
+	    - (Efloat32_trim_bias - 1);
+}
+
+/* the exponent of the lowest significand bit */
+static int efloat32_trim_ulp_exp(uint32_t u)
+{
+	uint32_t rexp;
+
+	rexp = (u & efloat32_r2_rexp_mask) >> efloat32_r2_exp_shift;
+	return (int)(rexp ? rexp : 1) - Efloat32_trim_bias;
+}
+
+/*
+ If rounding would carry a finite value up to infinity, only "fallback"
+ bits are truncated instead.
+*/
+static uint32_t efloat32_trim_u(uint32_t u, unsigned drop, unsigned fallback,
+				enum efloat_trim_mode mode)
+{
+	uint32_t mask, t;
+
+	if (drop == 0 || (u & efloat32_r2_rexp_mask) == efloat32_r2_rexp_mask) {
+		return u;
+	}
+	mask = (((uint32_t)1) << drop) - 1;
+	if (mode == ef_trim_truncate) {
+		return u & ~mask;
+	}
+	t = (u + (mask >> 1) + ((u >> drop) & 1)) & ~mask;
+	/* never round a finite value up to infinity */
+	if ((t & efloat32_r2_rexp_mask) == efloat32_r2_rexp_mask) {
+		return u & ~((((uint32_t)1) << fallback) - 1);
+	}
+	return t;
+}
+
+static efloat32 efloat32_trim(efloat32 *dst, const efloat32 *src, size_t len,
+			      enum efloat_trim_kind kind, int param,
+			      enum efloat_trim_mode mode, efloat32 *max_rel)
+{
+	uint32_t bits[Efloat_batch_len];
+	efloat32 t[Efloat_batch_len];
+	efloat32 err, rel, max_abs, max_r;
+	size_t i, j, n;
+	int drop, rnd;
+
+	rnd = (mode == ef_trim_truncate) ? 0 : 1;
+	max_abs = 0;
+	max_r = 0;
+	for (i = 0; i < len; i += n) {
+		n = len - i;
+		if (n > Efloat_batch_len) {
+			n = Efloat_batch_len;
+		}
+		efloat32_array_to_uint32_bits(bits, src + i, n);
+		if (kind == efloat_trim_fixed) {
+			for (j = 0; j < n; ++j) {
+				bits[j] = efloat32_trim_u(bits[j],
+							  (unsigned)param,
+							  (unsigned)param,
+							  mode);
+			}
+		} else {
+			for (j = 0; j < n; ++j) {
+				if ((bits[j] & ~efloat32_r2_sign_mask) == 0) {
+					continue;
+				}
+				drop = param + rnd
+				    - efloat32_trim_ulp_exp(bits[j]);
+				if (kind == efloat_trim_rel) {
+					drop += efloat32_trim_floor_log2(bits
+									 [j]);
+				}
+				drop = (drop < 0) ? 0 : drop;
+				drop = (drop > efloat32_r2_exp_shift)
+				    ? efloat32_r2_exp_shift : drop;
+				/* as truncating at a rounding "drop" could
+				   double the error, fall back one bit less */
+				bits[j] = efloat32_trim_u(bits[j],
+							  (unsigned)drop,
+							  (unsigned)(drop
+								     - rnd),
+							  mode);
+			}
+		}
+		uint32_bits_to_efloat32_array(t, bits, n);
+		for (j = 0; j < n; ++j) {
+			err = t[j] - src[i + j];
+			err = (err < 0) ? -err : err;
+			if (err > max_abs) {
+				max_abs = err;
+			}
+			if (err > 0) {
+				rel = err / ((src[i + j] < 0)
+					     ? -src[i + j] : src[i + j]);
+				if (rel > max_r) {
+					max_r = rel;
+				}
+			}
+		}
+		for (j = 0; j < n; ++j) {
+			dst[i + j] = t[j];
+		}
+	}
+	if (max_rel) {
+		*max_rel = max_r;
+	}
+	return max_abs;
+}
+
+efloat32 efloat32_trim_bits(efloat32 *dst, const efloat32 *src, size_t len,
+			    unsigned keep_bits, enum efloat_trim_mode mode,
+			    efloat32 *max_rel)
+{
+	if (keep_bits > efloat32_r2_exp_shift) {
+		keep_bits = efloat32_r2_exp_shift;
+	}
+	return efloat32_trim(dst, src, len, efloat_trim_fixed,
+			     (int)(efloat32_r2_exp_shift - keep_bits), mode,
+			     max_rel);
+}
+
+efloat32 efloat32_trim_tolerance(efloat32 *dst, const efloat32 *src,
+				 size_t len, efloat32 tolerance,
+				 enum efloat_trim_tolerance kind,
+				 enum efloat_trim_mode mode, efloat32 *max_rel)
+{
+	uint32_t u;
+	int tol_exp;
+
+	u = efloat32_to_uint32_bits(tolerance);
+	if ((u & efloat32_r2_sign_mask) && (u != efloat32_r2_sign_mask)) {
+		Efloat_set_err_inval();
+		return -1;
+	}
+	u &= ~efloat32_r2_sign_mask;
+	if (u > efloat32_r2_rexp_mask) {
+		Efloat_set_err_inval();
+		return -1;
+	} else if (u == efloat32_r2_rexp_mask) {
+		tol_exp = Efloat32_trim_exp_all;
+	} else if (u == 0) {
+		tol_exp = Efloat32_trim_exp_none;
+	} else {
+		tol_exp = efloat32_trim_floor_log2(u);
+	}
+	return efloat32_trim(dst, src, len,
+			     (kind == ef_trim_relative) ? efloat_trim_rel
+			     : efloat_trim_abs, tol_exp, mode, max_rel);
+}
+#endif
+
+#if ((defined efloat64_exists) && (efloat64_exists))
+#define Efloat64_trim_bias (efloat64_r2_exp_max + efloat64_r2_exp_shift)
+#define Efloat64_trim_exp_all ((int)(Efloat64_trim_bias + 2))
+#define Efloat64_trim_exp_none (-Efloat64_trim_exp_all)
+
+/* floor(log2(|x|)) for a finite non-zero x */
+static int efloat64_trim_floor_log2(uint64_t u)
+{
+	uint64_t rexp;
+
+	rexp = (u & efloat64_r2_rexp_mask) >> efloat64_r2_exp_shift;
+	if (rexp) {
+		return (int)rexp - efloat64_r2_exp_max;
+	}
+	return (63 - (int)Efloat_u64_clz(u & efloat64_r2_signif_mask))
+	    - (Efloat64_trim_bias - 1);
+}
+
+/* the exponent of the lowest significand bit */
+static int efloat64_trim_ulp_exp(uint64_t u)
+{
+	uint64_t rexp;
+
+	rexp = (u & efloat64_r2_rexp_mask) >> efloat64_r2_exp_shift;
+	return (int)(rexp ? rexp : 1) - Efloat64_trim_bias;
+}
+
+/*
+ If rounding would carry a finite value up to infinity, only "fallback"
+ bits are truncated instead.
+*/
+static uint64_t efloat64_trim_u(uint64_t u, unsigned drop, unsigned fallback,
+				enum efloat_trim_mode mode)
+{
+	uint64_t mask, t;
+
+	if (drop == 0 || (u & efloat64_r2_rexp_mask) == efloat64_r2_rexp_mask) {
+		return u;
+	}
+	mask = (((uint64_t)1) << drop) - 1;
+	if (mode == ef_trim_truncate) {
+		return u & ~mask;
+	}
+	t = (u + (mask >> 1) + ((u >> drop) & 1)) & ~mask;
+	/* never round a finite value up to infinity */
+	if ((t & efloat64_r2_rexp_mask) == efloat64_r2_rexp_mask) {
+		return u & ~((((uint64_t)1) << fallback) - 1);
+	}
+	return t;
+}
+
+static efloat64 efloat64_trim(efloat64 *dst, const efloat64 *src, size_t len,
+			      enum efloat_trim_kind kind, int param,
+			      enum efloat_trim_mode mode, efloat64 *max_rel)
+{
+	uint64_t bits[Efloat_batch_len];
+	efloat64 t[Efloat_batch_len];
+	efloat64 err, rel, max_abs, max_r;
+	size_t i, j, n;
+	int drop, rnd;
+
+	rnd = (mode == ef_trim_truncate) ? 0 : 1;
+	max_abs = 0;
+	max_r = 0;
+	for (i = 0; i < len; i += n) {
+		n = len - i;
+		if (n > Efloat_batch_len) {
+			n = Efloat_batch_len;
+		}
+		efloat64_array_to_uint64_bits(bits, src + i, n);
+		if (kind == efloat_trim_fixed) {
+			for (j = 0; j < n; ++j) {
+				bits[j] = efloat64_trim_u(bits[j],
+							  (unsigned)param,
+							  (unsigned)param,
+							  mode);
+			}
+		} else {
+			for (j = 0; j < n; ++j) {
+				if ((bits[j] & ~efloat64_r2_sign_mask) == 0) {
+					continue;
+				}
+				drop = param + rnd
+				    - efloat64_trim_ulp_exp(bits[j]);
+				if (kind == efloat_trim_rel) {
+					drop += efloat64_trim_floor_log2(bits
+									 [j]);
+				}
+				drop = (drop < 0) ? 0 : drop;
+				drop = (drop > efloat64_r2_exp_shift)
+				    ? efloat64_r2_exp_shift : drop;
+				/* as truncating at a rounding "drop" could
+				   double the error, fall back one bit less */
+				bits[j] = efloat64_trim_u(bits[j],
+							  (unsigned)drop,
+							  (unsigned)(drop
+								     - rnd),
+							  mode);
+			}
+		}
+		uint64_bits_to_efloat64_array(t, bits, n);
+		for (j = 0; j < n; ++j) {
+			err = t[j] - src[i + j];
+			err = (err < 0) ? -err : err;
+			if (err > max_abs) {
+				max_abs = err;
+			}
+			if (err > 0) {
+				rel = err / ((src[i + j] < 0)
+					     ? -src[i + j] : src[i + j]);
+				if (rel > max_r) {
+					max_r = rel;
+				}
+			}
+		}
+		for (j = 0; j < n; ++j) {
+			dst[i + j] = t[j];
+		}
+	}
+	if (max_rel) {
+		*max_rel = max_r;
+	}
+	return max_abs;
+}
+
+efloat64 efloat64_trim_bits(efloat64 *dst, const efloat64 *src, size_t len,
+			    unsigned keep_bits, enum efloat_trim_mode mode,
+			    efloat64 *max_rel)
+{
+	if (keep_bits > efloat64_r2_exp_shift) {
+		keep_bits = efloat64_r2_exp_shift;
+	}
+	return efloat64_trim(dst, src, len, efloat_trim_fixed,
+			     (int)(efloat64_r2_exp_shift - keep_bits), mode,
+			     max_rel);
+}
+
+efloat64 efloat64_trim_tolerance(efloat64 *dst, const efloat64 *src,
+				 size_t len, efloat64 tolerance,
+				 enum efloat_trim_tolerance kind,
+				 enum efloat_trim_mode mode, efloat64 *max_rel)
+{
+	uint64_t u;
+	int tol_exp;
+
+	u = efloat64_to_uint64_bits(tolerance);
+	if ((u & efloat64_r2_sign_mask) && (u != efloat64_r2_sign_mask)) {
+		Efloat_set_err_inval();
+		return -1;
+	}
+	u &= ~efloat64_r2_sign_mask;
+	if (u > efloat64_r2_rexp_mask) {
+		Efloat_set_err_inval();
+		return -1;
+	} else if (u == efloat64_r2_rexp_mask) {
+		tol_exp = Efloat64_trim_exp_all;
+	} else if (u == 0) {
+		tol_exp = Efloat64_trim_exp_none;
+	} else {
+		tol_exp = efloat64_trim_floor_log2(u);
+	}
+	return efloat64_trim(dst, src, len,
+			     (kind == ef_trim_relative) ? efloat_trim_rel
+			     : efloat_trim_abs, tol_exp, mode, max_rel);
+}
+#endif
@@ -0,0 +1,555 @@
+/* SPDX-License-Identifier: LGPL-2.1-or-later */
+/* efloat-xor.c: Gorilla and Chimp style XOR compression of float series */
+/* Copyright (C) 2026 Eric Herman */
+/* https://github.com/ericherman/libefloat */
+
+#include "efloat-internal.h"
+
+/*
+ Gorilla, for each value after the first:
+   '0'                          same as the previous value
+   '10' <meaningful bits>       XOR fits in the previous lead/trail window
+   '11' <lead:5> <len:5|6> <meaningful bits>    a new window
+
+ Chimp, for each value after the first:
+   '00'                                 same as the previous value
+   '01' <lead:3> <len:5|6> <center>     many trailing zeros, store the center
+   '10' <width - lead bits>             same (rounded) leading zeros as before
+   '11' <lead:3> <width - lead bits>    new (rounded) leading zeros
+
+ The stream is written most significant bit first.
+*/
+
+#define Efloat_xor_header_len 8
+#define Efloat_xor_magic 0xEF
+#define Efloat_xor_no_lead 0xFF
+#define Efloat_chimp_trail_threshold 6
+
+static const uint8_t efloat_chimp_lead[8] = { 0, 8, 12, 16, 18, 20, 22, 24 };
+
+static unsigned efloat_chimp_lead_code(unsigned lead)
+{
+	if (lead < 8) {
+		return 0;
+	} else if (lead < 12) {
+		return 1;
+	} else if (lead < 16) {
+		return 2;
+	} else if (lead < 18) {
+		return 3;
+	} else if (lead < 20) {
+		return 4;
+	} else if (lead < 22) {
+		return 5;
+	} else if (lead < 24) {
+		return 6;
+	}
+	return 7;
+}
+
+static unsigned efloat_xor_len_bits(unsigned width)
+{
+	return (width == 64) ? 6 : 5;
+}
+
+/* returns non-zero if the buffer is full */
+static int efloat_xor_put(struct efloat_xor_encoder *enc, uint64_t v,
+			  unsigned n)
+{
+	if (n == 0) {
+		return 0;
+	}
+	enc->acc = (enc->acc << n) | (v & ((((uint64_t)1) << n) - 1));
+	enc->acc_bits += n;
+	while (enc->acc_bits >= 8) {
+		if (enc->pos >= enc->size) {
+			return 1;
+		}
+		enc->acc_bits -= 8;
+		enc->buf[enc->pos++] = (uint8_t)(enc->acc >> enc->acc_bits);
+	}
+	enc->acc &= ((((uint64_t)1) << enc->acc_bits) - 1);
+	return 0;
+}
+
+static int efloat_xor_put_wide(struct efloat_xor_encoder *enc, uint64_t v,
+			       unsigned n)
+{
+	if (n > 32) {
+		if (efloat_xor_put(enc, v >> 32, n - 32)) {
+			return 1;
+		}
+		n = 32;
+	}
+	return efloat_xor_put(enc, v, n);
+}
+
+static int efloat_xor_put_gorilla(struct efloat_xor_encoder *enc,
+				  uint64_t x)
+{
+	unsigned width, lead, trail, meaningful;
+	int full;
+
+	width = enc->width;
+	if (x == 0) {
+		return efloat_xor_put(enc, 0, 1);
+	}
+
+	lead = Efloat_u64_clz(x) - (64 - width);
+	if (lead > 31) {
+		lead = 31;
+	}
+	trail = Efloat_u64_ctz(x);
+
+	if ((enc->prev_lead != Efloat_xor_no_lead)
+	    && (lead >= enc->prev_lead) && (trail >= enc->prev_trail)) {
+		meaningful = width - enc->prev_lead - enc->prev_trail;
+		full = efloat_xor_put(enc, 2, 2);
+		full = full || efloat_xor_put_wide(enc, x >> enc->prev_trail,
+						   meaningful);
+		return full;
+	}
+
+	meaningful = width - lead - trail;
+	full = efloat_xor_put(enc, 3, 2);
+	full = full || efloat_xor_put(enc, lead, 5);
+	full = full || efloat_xor_put(enc, (meaningful == width)
+				      ? 0 : meaningful,
+				      efloat_xor_len_bits(width));
+	full = full || efloat_xor_put_wide(enc, x >> trail, meaningful);
+	enc->prev_lead = (uint8_t)lead;
+	enc->prev_trail = (uint8_t)trail;
+	return full;
+}
+
+static int efloat_xor_put_chimp(struct efloat_xor_encoder *enc, uint64_t x)
+{
+	unsigned width, code, lead, trail, center;
+	int full;
+
+	width = enc->width;
+	if (x == 0) {
+		enc->prev_lead = Efloat_xor_no_lead;
+		return efloat_xor_put(enc, 0, 2);
+	}
+
+	code = efloat_chimp_lead_code(Efloat_u64_clz(x) - (64 - width));
+	lead = efloat_chimp_lead[code];
+	trail = Efloat_u64_ctz(x);
+
+	if (trail > Efloat_chimp_trail_threshold) {
+		center = width - lead - trail;
+		full = efloat_xor_put(enc, 1, 2);
+		full = full || efloat_xor_put(enc, code, 3);
+		full = full || efloat_xor_put(enc, center,
+					      efloat_xor_len_bits(width));
+		full = full || efloat_xor_put_wide(enc, x >> trail, center);
+		enc->prev_lead = Efloat_xor_no_lead;
+		return full;
+	}
+
+	if (lead == enc->prev_lead) {
+		full = efloat_xor_put(enc, 2, 2);
+		full = full || efloat_xor_put_wide(enc, x, width - lead);
+		return full;
+	}
+
+	full = efloat_xor_put(enc, 3, 2);
+	full = full || efloat_xor_put(enc, code, 3);
+	full = full || efloat_xor_put_wide(enc, x, width - lead);
+	enc->prev_lead = (uint8_t)lead;
+	return full;
+}
+
+static int efloat_xor_append_bits(struct efloat_xor_encoder *enc, uint64_t u)
+{
+	struct efloat_xor_encoder saved;
+	int full;
+
+	if (enc->count == UINT32_MAX) {
+		Efloat_set_err_inval();
+		return 1;
+	}
+
+	saved = *enc;
+	if (enc->count == 0) {
+		full = efloat_xor_put_wide(enc, u, enc->width);
+	} else if (enc->variant == ef_xor_gorilla) {
+		full = efloat_xor_put_gorilla(enc, u ^ enc->prev);
+	} else {
+		full = efloat_xor_put_chimp(enc, u ^ enc->prev);
+	}
+	/* leave room for the final partial byte */
+	if (!full && enc->acc_bits && (enc->pos >= enc->size)) {
+		full = 1;
+	}
+	if (full) {
+		*enc = saved;
+		return 1;
+	}
+	enc->prev = u;
+	++enc->count;
+	return 0;
+}
+
+static struct efloat_xor_encoder *efloat_xor_encoder_init(struct
+							  efloat_xor_encoder
+							  *enc,
+							  enum
+							  efloat_xor_variant
+							  variant,
+							  unsigned width,
+							  uint8_t *buf,
+							  size_t size)
+{
+	if (!enc || !buf || (size < Efloat_xor_header_len)
+	    || ((variant != ef_xor_gorilla) && (variant != ef_xor_chimp))) {
+		Efloat_set_err_inval();
+		return NULL;
+	}
+	enc->buf = buf;
+	enc->size = size;
+	enc->pos = Efloat_xor_header_len;
+	enc->acc = 0;
+	enc->acc_bits = 0;
+	enc->prev = 0;
+	enc->count = 0;
+	enc->variant = (uint8_t)variant;
+	enc->width = (uint8_t)width;
+	enc->prev_lead = Efloat_xor_no_lead;
+	enc->prev_trail = 0;
+	return enc;
+}
+
+size_t efloat_xor_encoder_finish(struct efloat_xor_encoder *enc)
+{
+	size_t len;
+
+	enc->buf[0] = Efloat_xor_magic;
+	enc->buf[1] = enc->variant;
+	enc->buf[2] = enc->width;
+	enc->buf[3] = 0;
+	enc->buf[4] = (uint8_t)(enc->count);
+	enc->buf[5] = (uint8_t)(enc->count >> 8);
+	enc->buf[6] = (uint8_t)(enc->count >> 16);
+	enc->buf[7] = (uint8_t)(enc->count >> 24);
+
+	len = enc->pos;
+	if (enc->acc_bits) {
+		/* pad, without consuming, so that appending may continue */
+		enc->buf[len++] = (uint8_t)(enc->acc << (8 - enc->acc_bits));
+	}
+	return len;
+}
+
+static uint64_t efloat_xor_get(struct efloat_xor_decoder *dec, unsigned n)
+{
+	uint64_t v;
+
+	if (n == 0) {
+		return 0;
+	}
+	while ((dec->window_bits <= 56) && (dec->pos < dec->size)) {
+		dec->window |= ((uint64_t)dec->buf[dec->pos++])
+		    << (56 - dec->window_bits);
+		dec->window_bits += 8;
+	}
+	if (dec->window_bits < n) {
+		dec->error = 1;
+		return 0;
+	}
+	v = dec->window >> (64 - n);
+	dec->window = (n == 64) ? 0 : (dec->window << n);
+	dec->window_bits -= n;
+	return v;
+}
+
+static uint64_t efloat_xor_get_wide(struct efloat_xor_decoder *dec,
+				    unsigned n)
+{
+	uint64_t hi;
+
+	if (n > 32) {
+		hi = efloat_xor_get(dec, n - 32);
+		return (hi << 32) | efloat_xor_get(dec, 32);
+	}
+	return efloat_xor_get(dec, n);
+}
+
+static uint64_t efloat_xor_get_gorilla(struct efloat_xor_decoder *dec)
+{
+	unsigned width, lead, trail, meaningful;
+
+	width = dec->width;
+	if (efloat_xor_get(dec, 1) == 0) {
+		return 0;
+	}
+	if (efloat_xor_get(dec, 1) == 0) {
+		if (dec->prev_lead == Efloat_xor_no_lead) {
+			dec->error = 1;
+			return 0;
+		}
+		meaningful = width - dec->prev_lead - dec->prev_trail;
+		return efloat_xor_get_wide(dec, meaningful) << dec->prev_trail;
+	}
+	lead = efloat_xor_get(dec, 5);
+	meaningful = efloat_xor_get(dec, efloat_xor_len_bits(width));
+	if (meaningful == 0) {
+		meaningful = width;
+	}
+	if (lead + meaningful > width) {
+		dec->error = 1;
+		return 0;
+	}
+	trail = width - lead - meaningful;
+	dec->prev_lead = (uint8_t)lead;
+	dec->prev_trail = (uint8_t)trail;
+	return efloat_xor_get_wide(dec, meaningful) << trail;
+}
+
+static uint64_t efloat_xor_get_chimp(struct efloat_xor_decoder *dec)
+{
+	unsigned width, lead, trail, center;
+
+	width = dec->width;
+	switch (efloat_xor_get(dec, 2)) {
+	case 0:
+		dec->prev_lead = Efloat_xor_no_lead;
+		return 0;
+	case 1:
+		lead = efloat_chimp_lead[efloat_xor_get(dec, 3)];
+		center = efloat_xor_get(dec, efloat_xor_len_bits(width));
+		if ((center == 0) || (lead + center > width)) {
+			dec->error = 1;
+			return 0;
+		}
+		trail = width - lead - center;
+		dec->prev_lead = Efloat_xor_no_lead;
+		return efloat_xor_get_wide(dec, center) << trail;
+	case 2:
+		if (dec->prev_lead == Efloat_xor_no_lead) {
+			dec->error = 1;
+			return 0;
+		}
+		return efloat_xor_get_wide(dec, width - dec->prev_lead);
+	default:
+		lead = efloat_chimp_lead[efloat_xor_get(dec, 3)];
+		dec->prev_lead = (uint8_t)lead;
+		return efloat_xor_get_wide(dec, width - lead);
+	}
+}
+
+/* returns 1 if a value was decoded, 0 at the end or on error */
+static int efloat_xor_decode_bits(struct efloat_xor_decoder *dec,
+				  uint64_t *u)
+{
+	uint64_t v;
+
+	if ((dec->remaining == 0) || dec->error) {
+		return 0;
+	}
+	if (dec->remaining == dec->count) {
+		v = efloat_xor_get_wide(dec, dec->width);
+	} else if (dec->variant == ef_xor_gorilla) {
+		v = dec->prev ^ efloat_xor_get_gorilla(dec);
+	} else {
+		v = dec->prev ^ efloat_xor_get_chimp(dec);
+	}
+	if (dec->error) {
+		Efloat_set_err_inval();
+		return 0;
+	}
+	dec->prev = v;
+	--dec->remaining;
+	*u = v;
+	return 1;
+}
+
+static struct efloat_xor_decoder *efloat_xor_decoder_init(struct
+							  efloat_xor_decoder
+							  *dec,
+							  unsigned width,
+							  const uint8_t *buf,
+							  size_t size)
+{
+	if (!dec || !buf || (size < Efloat_xor_header_len)
+	    || (buf[0] != Efloat_xor_magic)
+	    || ((buf[1] != ef_xor_gorilla) && (buf[1] != ef_xor_chimp))
+	    || (buf[2] != width)) {
+		Efloat_set_err_inval();
+		return NULL;
+	}
+	dec->buf = buf;
+	dec->size = size;
+	dec->pos = Efloat_xor_header_len;
+	dec->window = 0;
+	dec->window_bits = 0;
+	dec->prev = 0;
+	dec->count = ((uint32_t)buf[4])
+	    | (((uint32_t)buf[5]) << 8)
+	    | (((uint32_t)buf[6]) << 16)
+	    | (((uint32_t)buf[7]) << 24);
+	dec->remaining = dec->count;
+	dec->variant = buf[1];
+	dec->width = (uint8_t)width;
+	dec->prev_lead = Efloat_xor_no_lead;
+	dec->prev_trail = 0;
+	dec->error = 0;
+	return dec;
+}
+
+#if ((defined efloat32_exists) && (efloat32_exists))
+struct efloat_xor_encoder *efloat32_xor_encoder_init(struct efloat_xor_encoder
+						     *enc,
+						     enum efloat_xor_variant
+						     variant, uint8_t *buf,
+						     size_t size)
+{
+	return efloat_xor_encoder_init(enc, variant, 32, buf, size);
+}
+
+int efloat32_xor_append(struct efloat_xor_encoder *enc, efloat32 f)
+{
+	return efloat_xor_append_bits(enc, efloat32_to_uint32_bits(f));
+}
+
+size_t efloat32_xor_append_array(struct efloat_xor_encoder *enc,
+				 const efloat32 *a, size_t len)
+{
+	uint32_t bits[Efloat_batch_len];
+	size_t i, j, n;
+
+	for (i = 0; i < len; i += n) {
+		n = len - i;
+		if (n > Efloat_batch_len) {
+			n = Efloat_batch_len;
+		}
+		efloat32_array_to_uint32_bits(bits, a + i, n);
+		for (j = 0; j < n; ++j) {
+			if (efloat_xor_append_bits(enc, bits[j])) {
+				return i + j;
+			}
+		}
+	}
+	return len;
+}
+
+struct efloat_xor_decoder *efloat32_xor_decoder_init(struct efloat_xor_decoder
+						     *dec, const uint8_t *buf,
+						     size_t size)
+{
+	return efloat_xor_decoder_init(dec, 32, buf, size);
+}
+
+int efloat32_xor_decode(struct efloat_xor_decoder *dec, efloat32 *f)
+{
+	uint64_t u;
+
+	if (!efloat_xor_decode_bits(dec, &u)) {
+		return 0;
+	}
+	*f = uint32_bits_to_efloat32((uint32_t)u);
+	return 1;
+}
+
+size_t efloat32_xor_decode_array(struct efloat_xor_decoder *dec,
+				 efloat32 *out, size_t len)
+{
+	uint32_t bits[Efloat_batch_len];
+	uint64_t u;
+	size_t i, j, n;
+
+	for (i = 0; i < len; i += j) {
+		n = len - i;
+		if (n > Efloat_batch_len) {
+			n = Efloat_batch_len;
+		}
+		for (j = 0; j < n && efloat_xor_decode_bits(dec, &u); ++j) {
+			bits[j] = (uint32_t)u;
+		}
+		uint32_bits_to_efloat32_array(out + i, bits, j);
+		if (j < n) {
+			return i + j;
+		}
+	}
+	return len;
+}
+#endif
+
+#if ((defined efloat64_exists) && (efloat64_exists))
+struct efloat_xor_encoder *efloat64_xor_encoder_init(struct efloat_xor_encoder
+						     *enc,
+						     enum efloat_xor_variant
+						     variant, uint8_t *buf,
+						     size_t size)
+{
+	return efloat_xor_encoder_init(enc, variant, 64, buf, size);
+}
+
+int efloat64_xor_append(struct efloat_xor_encoder *enc, efloat64 f)
+{
+	return efloat_xor_append_bits(enc, efloat64_to_uint64_bits(f));
+}
+
+size_t efloat64_xor_append_array(struct efloat_xor_encoder *enc,
+				 const efloat64 *a, size_t len)
+{
+	uint64_t bits[Efloat_batch_len];
+	size_t i, j, n;
+
+	for (i = 0; i < len; i += n) {
+		n = len - i;
+		if (n > Efloat_batch_len) {
+			n = Efloat_batch_len;
+		}
+		efloat64_array_to_uint64_bits(bits, a + i, n);
+		for (j = 0; j < n; ++j) {
+			if (efloat_xor_append_bits(enc, bits[j])) {
+				return i + j;
+			}
+		}
+	}
+	return len;
+}
+
+struct efloat_xor_decoder *efloat64_xor_decoder_init(struct efloat_xor_decoder
+						     *dec, const uint8_t *buf,
+						     size_t size)
+{
+	return efloat_xor_decoder_init(dec, 64, buf, size);
+}
+
+int efloat64_xor_decode(struct efloat_xor_decoder *dec, efloat64 *f)
+{
+	uint64_t u;
+
+	if (!efloat_xor_decode_bits(dec, &u)) {
+		return 0;
+	}
+	*f = uint64_bits_to_efloat64(u);
+	return 1;
+}
+
+size_t efloat64_xor_decode_array(struct efloat_xor_decoder *dec,
+				 efloat64 *out, size_t len)
+{
+	uint64_t bits[Efloat_batch_len];
+	size_t i, j, n;
+
+	for (i = 0; i < len; i += j) {
+		n = len - i;
+		if (n > Efloat_batch_len) {
+			n = Efloat_batch_len;
+		}
+		for (j = 0; j < n && efloat_xor_decode_bits(dec, bits + j);
+		     ++j) {
+			;
+		}
+		uint64_bits_to_efloat64_array(out + i, bits, j);
+		if (j < n) {
+			return i + j;
+		}
+	}
+	return len;
+}
+#endif
@@ -3,16 +3,7 @@
 /* Copyright (C) 2017, 2018, 2019 Eric Herman */
 /* https://github.com/ericherman/libefloat */
 
-#include "efloat.h"
-#include "eembed.h"
-
-#ifndef UINT32_MAX
-#define UINT32_MAX  (0xFFFFFFFF)
-#endif
-
-#ifndef UINT64_MAX
-#define UINT64_MAX  (0xFFFFFFFFFFFFFFFF)
-#endif
+#include "efloat-internal.h"
 
 #if EEMBED_HOSTED
 #include <errno.h>
@@ -26,32 +17,25 @@ void (*efloat_seterrinval)(void) = efloat_set_errno_einval;
 void (*efloat_seterrinval)(void) = NULL;
 #endif
 
-#define Efloat_set_err_inval() \
-	do { \
-		if (efloat_seterrinval) { \
-			efloat_seterrinval(); \
-		} \
-	} while (0)
-
-#define Efloat_debug_print_str(str) do { \
-	if (eembed_err_log) { \
-		eembed_err_log->append_s(eembed_err_log, str); \
-	} } while (0)
-
-#define Efloat_debug_print_u64(u64) do { \
-	if (eembed_err_log) { \
-		eembed_err_log->append_ul(eembed_err_log, u64); \
-	} } while (0)
-
-#define Efloat_debug_print_i32(i32) do { \
-	if (eembed_err_log) { \
-		eembed_err_log->append_l(eembed_err_log, i32); \
-	} } while (0)
-
-#define Efloat_debug_print_eol() do { \
-	if (eembed_err_log) { \
-		eembed_err_log->append_eol(eembed_err_log); \
-	} } while (0)
+unsigned efloat_u64_clz(uint64_t u)
+{
+	unsigned n;
+
+	for (n = 0; n < 64 && !(u & (((uint64_t)1) << 63)); ++n) {
+		u = u << 1;
+	}
+	return n;
+}
+
+unsigned efloat_u64_ctz(uint64_t u)
+{
+	unsigned n;
+
+	for (n = 0; n < 64 && !(u & 1); ++n) {
+		u = u >> 1;
+	}
+	return n;
+}
 
 #if ((defined efloat32_exists) && (efloat32_exists))
 static int32_t efloat32_to_int32_bits_memcpy(efloat32 f)
@@ -158,6 +142,34 @@ efloat32 uint32_bits_to_efloat32(uint32_t u)
 	}
 }
 
+void efloat32_array_to_uint32_bits(uint32_t *dst, const efloat32 *src,
+				   size_t len)
+{
+	size_t i;
+
+	if (eembed_memcpy) {
+		eembed_memcpy(dst, src, len * sizeof(uint32_t));
+	} else {
+		for (i = 0; i < len; ++i) {
+			dst[i] = efloat32_to_uint32_bits_unionp(src[i]);
+		}
+	}
+}
+
+void uint32_bits_to_efloat32_array(efloat32 *dst, const uint32_t *src,
+				   size_t len)
+{
+	size_t i;
+
+	if (eembed_memcpy) {
+		eembed_memcpy(dst, src, len * sizeof(efloat32));
+	} else {
+		for (i = 0; i < len; ++i) {
+			dst[i] = uint32_bits_to_efloat32_unionp(src[i]);
+		}
+	}
+}
+
 enum efloat_class efloat32_classify(efloat32 f)
 {
 	struct efloat32_fields fields;
@@ -459,6 +471,34 @@ efloat64 uint64_bits_to_efloat64(uint64_t u)
 	}
 }
 
+void efloat64_array_to_uint64_bits(uint64_t *dst, const efloat64 *src,
+				   size_t len)
+{
+	size_t i;
+
+	if (eembed_memcpy) {
+		eembed_memcpy(dst, src, len * sizeof(uint64_t));
+	} else {
+		for (i = 0; i < len; ++i) {
+			dst[i] = efloat64_to_uint64_bits_unionp(src[i]);
+		}
+	}
+}
+
+void uint64_bits_to_efloat64_array(efloat64 *dst, const uint64_t *src,
+				   size_t len)
+{
+	size_t i;
+
+	if (eembed_memcpy) {
+		eembed_memcpy(dst, src, len * sizeof(efloat64));
+	} else {
+		for (i = 0; i < len; ++i) {
+			dst[i] = uint64_bits_to_efloat64_unionp(src[i]);
+		}
+	}
+}
+
 enum efloat_class efloat64_classify(efloat64 f)
 {
 	struct efloat64_fields fields;
@@ -212,6 +212,7 @@ struct efloat64_fields {
 #define efloat32_r2_signif_mask 0x007FFFFFUL
 #define efloat32_r2_exp_bits 8
 #define efloat32_r2_exp_shift 23
+#define efloat32_canonical_nan_bits 0x7FC00000UL
 #endif
 
 #if ((defined efloat64_exists) && (efloat64_exists) \
@@ -228,6 +229,7 @@ struct efloat64_fields {
 #define efloat64_r2_signif_mask 0x000FFFFFFFFFFFFFUL
 #define efloat64_r2_exp_bits 11
 #define efloat64_r2_exp_shift 52
+#define efloat64_canonical_nan_bits 0x7FF8000000000000UL
 #endif
 
 Efloat_begin_C_functions
@@ -239,6 +241,11 @@ uint32_t efloat32_to_uint32_bits(efloat32 f);
 efloat32 int32_bits_to_efloat32(int32_t i);
 efloat32 uint32_bits_to_efloat32(uint32_t i);
 
+void efloat32_array_to_uint32_bits(uint32_t *dst, const efloat32 *src,
+				   size_t len);
+void uint32_bits_to_efloat32_array(efloat32 *dst, const uint32_t *src,
+				   size_t len);
+
 enum efloat_class efloat32_classify(efloat32 f);
 enum efloat_class efloat32_radix_2_to_fields(efloat32 f,
 					     struct efloat32_fields *fields);
@@ -258,6 +265,11 @@ uint64_t efloat64_to_uint64_bits(efloat64 f);
 efloat64 int64_bits_to_efloat64(int64_t i);
 efloat64 uint64_bits_to_efloat64(uint64_t i);
 
+void efloat64_array_to_uint64_bits(uint64_t *dst, const efloat64 *src,
+				   size_t len);
+void uint64_bits_to_efloat64_array(efloat64 *dst, const uint64_t *src,
+				   size_t len);
+
 enum efloat_class efloat64_classify(efloat64 f);
 enum efloat_class efloat64_radix_2_to_fields(efloat64 f,
 					     struct efloat64_fields *fields);
@@ -268,6 +280,1450 @@ char *efloat64_fields_to_expression(const struct efloat64_fields fields,
 uint64_t efloat64_distance(efloat64 x, efloat64 y);
 #endif /* efloat64_exists */
 
+/* single pass array profiling */
+
+/*
+ A profile summarizes an array in one pass: the count of each
+ efloat_class (indexed by the enum value), the count of values with the
+ sign bit set, the range of exponents (as reported in the fields) of the
+ finite non-zero values, and the min and max of the non-NaN values
+ (where -0.0 sorts below 0.0).
+
+ If there are no finite non-zero values, then exponent_min will be
+ greater than exponent_max. If every value is NaN (or the array is
+ empty), then min and max are NaN.
+
+ Profiles of separate slices may be merged, thus large arrays may be
+ split across threads with each thread calling _profile_add() on its own
+ profile, and the results combined with _profile_merge().
+*/
+#if efloat32_exists
+struct efloat32_profile {
+	uint64_t count;
+	uint64_t class_count[ef_normal + 1];
+	uint64_t negative;
+	int16_t exponent_min;
+	int16_t exponent_max;
+	efloat32 min;
+	efloat32 max;
+};
+
+void efloat32_profile_init(struct efloat32_profile *profile);
+void efloat32_profile_add(struct efloat32_profile *profile,
+			  const efloat32 *a, size_t len);
+void efloat32_profile_merge(struct efloat32_profile *profile,
+			    const struct efloat32_profile *other);
+struct efloat32_profile *efloat32_profile_array(const efloat32 *a, size_t len,
+						struct efloat32_profile
+						*profile);
+#endif /* efloat32_exists */
+
+#if efloat64_exists
+struct efloat64_profile {
+	uint64_t count;
+	uint64_t class_count[ef_normal + 1];
+	uint64_t negative;
+	int16_t exponent_min;
+	int16_t exponent_max;
+	efloat64 min;
+	efloat64 max;
+};
+
+void efloat64_profile_init(struct efloat64_profile *profile);
+void efloat64_profile_add(struct efloat64_profile *profile,
+			  const efloat64 *a, size_t len);
+void efloat64_profile_merge(struct efloat64_profile *profile,
+			    const struct efloat64_profile *other);
+struct efloat64_profile *efloat64_profile_array(const efloat64 *a, size_t len,
+						struct efloat64_profile
+						*profile);
+#endif /* efloat64_exists */
+
+/* exact representability, for lossless narrowing */
+
+/*
+ The _fits_ functions report, for each value, whether it would survive a
+ round trip through a narrower type with every bit intact, writing 1 or
+ 0 to "out" (which may be NULL), and return the count of values which
+ fit. A float format is described by the number of exponent bits and the
+ number of (stored) significand bits, and is assumed to be IEEE 754 like,
+ with subnormals, infinities and NaNs. A NaN fits a float format if the
+ dropped low payload bits are all zero. Integers are checked against the
+ given width in bits, NaN, infinity and -0.0 never fit an integer.
+*/
+#define efloat_float16_exp_bits 5
+#define efloat_float16_signif_bits 10
+#define efloat_bfloat16_exp_bits 8
+#define efloat_bfloat16_signif_bits 7
+#define efloat_float32_exp_bits 8
+#define efloat_float32_signif_bits 23
+
+/* in order of preference, narrowest first */
+enum efloat_narrow {
+	ef_narrow_int8 = 0,
+	ef_narrow_int16 = 1,
+	ef_narrow_float16 = 2,
+	ef_narrow_bfloat16 = 3,
+	ef_narrow_int32 = 4,
+	ef_narrow_float32 = 5,
+	ef_narrow_none = 6
+};
+
+/*
+ A narrowing analysis counts, in one pass, how many values fit each of
+ the narrower types; efloat_narrowing_best() then picks the narrowest
+ type which every value fits, or ef_narrow_none. Like the profiles,
+ analyses of separate slices may be merged.
+*/
+struct efloat_narrowing {
+	uint64_t count;
+	uint64_t fits[ef_narrow_none];
+};
+
+void efloat_narrowing_init(struct efloat_narrowing *narrowing);
+void efloat_narrowing_merge(struct efloat_narrowing *narrowing,
+			    const struct efloat_narrowing *other);
+enum efloat_narrow efloat_narrowing_best(const struct efloat_narrowing
+					 *narrowing);
+
+#if efloat32_exists
+size_t efloat32_fits_format(const efloat32 *a, size_t len,
+			    unsigned exp_bits, unsigned signif_bits,
+			    uint8_t *out);
+size_t efloat32_fits_int(const efloat32 *a, size_t len, unsigned bits,
+			 uint8_t *out);
+size_t efloat32_fits_uint(const efloat32 *a, size_t len, unsigned bits,
+			  uint8_t *out);
+void efloat32_narrowing_add(struct efloat_narrowing *narrowing,
+			    const efloat32 *a, size_t len);
+#endif /* efloat32_exists */
+
+#if efloat64_exists
+size_t efloat64_fits_efloat32(const efloat64 *a, size_t len, uint8_t *out);
+size_t efloat64_fits_format(const efloat64 *a, size_t len,
+			    unsigned exp_bits, unsigned signif_bits,
+			    uint8_t *out);
+size_t efloat64_fits_int(const efloat64 *a, size_t len, unsigned bits,
+			 uint8_t *out);
+size_t efloat64_fits_uint(const efloat64 *a, size_t len, unsigned bits,
+			  uint8_t *out);
+void efloat64_narrowing_add(struct efloat_narrowing *narrowing,
+			    const efloat64 *a, size_t len);
+#endif /* efloat64_exists */
+
+/* XOR delta compression of float series */
+
+/*
+ Streaming compression of series of floats, for example metric time
+ series, by XOR-ing each bit pattern with the previous one, as described
+ in the Gorilla (Pelkonen et al., VLDB 2015) and Chimp (Liakos et al.,
+ VLDB 2022) papers. Nothing is allocated, the caller provides the
+ buffers.
+
+ A stream begins with an 8 byte header (which records the variant, the
+ width and the count of values) followed by the packed bits. The
+ encoder's _append() functions return 0 on success, or non-zero if the
+ value would not fit in the remaining buffer, in which case the stream
+ is left unchanged and remains valid. efloat_xor_encoder_finish() writes
+ the header and any partial byte, and returns the number of bytes used;
+ it may be called more than once, and appending may continue after.
+*/
+enum efloat_xor_variant {
+	ef_xor_gorilla = 1,
+	ef_xor_chimp = 2
+};
+
+struct efloat_xor_encoder {
+	uint8_t *buf;
+	size_t size;
+	size_t pos;
+	uint64_t acc;
+	unsigned acc_bits;
+	uint64_t prev;
+	uint32_t count;
+	uint8_t variant;
+	uint8_t width;
+	uint8_t prev_lead;
+	uint8_t prev_trail;
+};
+
+struct efloat_xor_decoder {
+	const uint8_t *buf;
+	size_t size;
+	size_t pos;
+	uint64_t window;
+	unsigned window_bits;
+	uint64_t prev;
+	uint32_t count;
+	uint32_t remaining;
+	uint8_t variant;
+	uint8_t width;
+	uint8_t prev_lead;
+	uint8_t prev_trail;
+	int error;
+};
+
+size_t efloat_xor_encoder_finish(struct efloat_xor_encoder *enc);
+
+#if efloat32_exists
+struct efloat_xor_encoder *efloat32_xor_encoder_init(struct efloat_xor_encoder
+						     *enc,
+						     enum efloat_xor_variant
+						     variant, uint8_t *buf,
+						     size_t size);
+int efloat32_xor_append(struct efloat_xor_encoder *enc, efloat32 f);
+size_t efloat32_xor_append_array(struct efloat_xor_encoder *enc,
+				 const efloat32 *a, size_t len);
+
+struct efloat_xor_decoder *efloat32_xor_decoder_init(struct efloat_xor_decoder
+						     *dec, const uint8_t *buf,
+						     size_t size);
+int efloat32_xor_decode(struct efloat_xor_decoder *dec, efloat32 *f);
+size_t efloat32_xor_decode_array(struct efloat_xor_decoder *dec,
+				 efloat32 *out, size_t len);
+#endif /* efloat32_exists */
+
+#if efloat64_exists
+struct efloat_xor_encoder *efloat64_xor_encoder_init(struct efloat_xor_encoder
+						     *enc,
+						     enum efloat_xor_variant
+						     variant, uint8_t *buf,
+						     size_t size);
+int efloat64_xor_append(struct efloat_xor_encoder *enc, efloat64 f);
+size_t efloat64_xor_append_array(struct efloat_xor_encoder *enc,
+				 const efloat64 *a, size_t len);
+
+struct efloat_xor_decoder *efloat64_xor_decoder_init(struct efloat_xor_decoder
+						     *dec, const uint8_t *buf,
+						     size_t size);
+int efloat64_xor_decode(struct efloat_xor_decoder *dec, efloat64 *f);
+size_t efloat64_xor_decode_array(struct efloat_xor_decoder *dec,
+				 efloat64 *out, size_t len);
+#endif /* efloat64_exists */
+
+/* byte, bit and field plane shuffles, to help general purpose compressors */
+
+/*
+ General purpose compressors do much better on arrays of floats after the
+ slowly changing sign and exponent bits are separated from the noisy low
+ significand bits. These functions reorder an array into planes, and
+ back again; they do not compress anything themselves.
+
+ The byte shuffle writes "len" bytes for each byte of the value, least
+ significant byte first, so "dst" must hold (len * sizeof(efloatNN))
+ bytes. The order does not depend upon the endianness of the platform.
+
+ The bit shuffle writes one plane for each bit of the value, least
+ significant bit first; each plane is efloat_bit_plane_len(len) bytes,
+ with the bit of value i in byte (i / 8) at bit (i % 8). "dst" must hold
+ (NN * efloat_bit_plane_len(len)) bytes.
+
+ The field split writes the sign bits as a single bit plane, and the
+ biased exponent and significand fields each to their own array.
+*/
+#define efloat_bit_plane_len(len) (((len) + 7) / 8)
+
+#if efloat32_exists
+void efloat32_byte_shuffle(uint8_t *dst, const efloat32 *src, size_t len);
+void efloat32_byte_unshuffle(efloat32 *dst, const uint8_t *src, size_t len);
+void efloat32_bit_shuffle(uint8_t *dst, const efloat32 *src, size_t len);
+void efloat32_bit_unshuffle(efloat32 *dst, const uint8_t *src, size_t len);
+void efloat32_field_split(uint8_t *sign, uint8_t *rexp, uint32_t *signif,
+			  const efloat32 *src, size_t len);
+void efloat32_field_join(efloat32 *dst, const uint8_t *sign,
+			 const uint8_t *rexp, const uint32_t *signif,
+			 size_t len);
+#endif /* efloat32_exists */
+
+#if efloat64_exists
+void efloat64_byte_shuffle(uint8_t *dst, const efloat64 *src, size_t len);
+void efloat64_byte_unshuffle(efloat64 *dst, const uint8_t *src, size_t len);
+void efloat64_bit_shuffle(uint8_t *dst, const efloat64 *src, size_t len);
+void efloat64_bit_unshuffle(efloat64 *dst, const uint8_t *src, size_t len);
+void efloat64_field_split(uint8_t *sign, uint16_t *rexp, uint64_t *signif,
+			  const efloat64 *src, size_t len);
+void efloat64_field_join(efloat64 *dst, const uint8_t *sign,
+			 const uint16_t *rexp, const uint64_t *signif,
+			 size_t len);
+#endif /* efloat64_exists */
+
+/* ALP style lossless compression of decimal-like floats */
+
+/*
+ Much real data is decimal at heart, prices or sensor readings with a
+ few digits, and compresses poorly by XOR. In the manner of ALP
+ (Afroozeh et al., SIGMOD 2024), each vector of efloat_alp_vector_len
+ values is multiplied by a power of ten, divided by another, and
+ rounded to an integer; the pair of exponents is chosen from a sample
+ of the vector. Values which do not reproduce their exact bit pattern
+ are stored as exceptions, the integers are bit-packed relative to
+ their minimum (frame of reference).
+
+ The _encode() functions return the number of bytes written, or 0 if
+ "size" is too small; efloatNN_alp_bound(len) bytes are always enough.
+ efloat_alp_count() reads the number of values from an encoded buffer,
+ and the _decode() functions return the number of values decoded, or 0
+ if the buffer is damaged or "len" is too small.
+*/
+#define efloat_alp_vector_len 1024
+#define efloat32_alp_bound(len) \
+	(8 + ((((len) + 1023) / 1024) * 24) + ((len) * 14))
+#define efloat64_alp_bound(len) \
+	(8 + ((((len) + 1023) / 1024) * 24) + ((len) * 18))
+
+size_t efloat_alp_count(const uint8_t *buf, size_t size);
+
+#if efloat32_exists
+size_t efloat32_alp_encode(uint8_t *buf, size_t size, const efloat32 *a,
+			   size_t len);
+size_t efloat32_alp_decode(efloat32 *out, size_t len, const uint8_t *buf,
+			   size_t size);
+#endif /* efloat32_exists */
+
+#if efloat64_exists
+size_t efloat64_alp_encode(uint8_t *buf, size_t size, const efloat64 *a,
+			   size_t len);
+size_t efloat64_alp_decode(efloat64 *out, size_t len, const uint8_t *buf,
+			   size_t size);
+#endif /* efloat64_exists */
+
+/* precision trimming, for lossy compression */
+
+/*
+ Zeroing the low significand bits of values which only need a few
+ significant bits makes them compress much better downstream. The
+ _trim_bits() functions keep "keep_bits" of the stored significand
+ bits of every value; the _trim_tolerance() functions keep, for each
+ value, only as many bits as are needed to stay within an absolute or
+ relative tolerance. Rounding is either to nearest, ties to even, or
+ toward zero (truncation); a value is never rounded up to infinity,
+ and NaN and infinities are left unchanged. "dst" may be the same as
+ "src".
+
+ Each returns the largest absolute error introduced, and if "max_rel"
+ is not NULL, stores the largest relative error. A negative or NaN
+ tolerance sets EINVAL and returns -1 without writing to "dst".
+*/
+enum efloat_trim_mode {
+	ef_trim_nearest_even = 0,
+	ef_trim_truncate = 1
+};
+
+enum efloat_trim_tolerance {
+	ef_trim_absolute = 0,
+	ef_trim_relative = 1
+};
+
+#if efloat32_exists
+efloat32 efloat32_trim_bits(efloat32 *dst, const efloat32 *src, size_t len,
+			    unsigned keep_bits, enum efloat_trim_mode mode,
+			    efloat32 *max_rel);
+efloat32 efloat32_trim_tolerance(efloat32 *dst, const efloat32 *src,
+				 size_t len, efloat32 tolerance,
+				 enum efloat_trim_tolerance kind,
+				 enum efloat_trim_mode mode, efloat32 *max_rel);
+#endif /* efloat32_exists */
+
+#if efloat64_exists
+efloat64 efloat64_trim_bits(efloat64 *dst, const efloat64 *src, size_t len,
+			    unsigned keep_bits, enum efloat_trim_mode mode,
+			    efloat64 *max_rel);
+efloat64 efloat64_trim_tolerance(efloat64 *dst, const efloat64 *src,
+				 size_t len, efloat64 tolerance,
+				 enum efloat_trim_tolerance kind,
+				 enum efloat_trim_mode mode, efloat64 *max_rel);
+#endif /* efloat64_exists */
+
+/* block floating point, microscaling (MX) style */
+
+/*
+ Each block of efloat_mx_block_len values shares one 8 bit exponent
+ (E8M0: the exponent plus 127, where 0xFF marks a NaN block), taken from
+ the largest magnitude in the block, and each value is stored as a
+ narrow two's complement integer of 4, 6 or 8 bits, scaled so that the
+ largest magnitude lies in [1, 2), as with MXINT8 in the OCP
+ Microscaling specification. A block is 1 byte of shared exponent
+ followed by the packed elements, least significant bit first, so a
+ block takes efloat_mx_block_bytes(bits) bytes; the last block of an
+ array is padded with zeros.
+
+ Values are rounded to nearest, ties to even, and saturate. A block
+ holding a NaN or an infinity decodes as all NaN. The _encode()
+ functions return the number of bytes written, and store the largest
+ absolute error (of the non-NaN blocks) in "max_err" if it is not NULL;
+ the _decode() functions return the number of values written. Both
+ return 0 and set EINVAL if "bits" is not 4, 6 or 8, or "size" is too
+ small.
+*/
+#define efloat_mx_block_len 32
+#define efloat_mx_scale_nan 0xFF
+#define efloat_mx_block_bytes(bits) (1 + (4 * (bits)))
+#define efloat_mx_bytes(len, bits) \
+	((((len) + efloat_mx_block_len - 1) / efloat_mx_block_len) \
+	 * efloat_mx_block_bytes(bits))
+
+#if efloat32_exists
+size_t efloat32_mx_encode(uint8_t *buf, size_t size, const efloat32 *a,
+			  size_t len, unsigned bits, efloat32 *max_err);
+size_t efloat32_mx_decode(efloat32 *out, size_t len, const uint8_t *buf,
+			  size_t size, unsigned bits);
+#endif /* efloat32_exists */
+
+#if efloat64_exists
+size_t efloat64_mx_encode(uint8_t *buf, size_t size, const efloat64 *a,
+			  size_t len, unsigned bits, efloat64 *max_err);
+size_t efloat64_mx_decode(efloat64 *out, size_t len, const uint8_t *buf,
+			  size_t size, unsigned bits);
+#endif /* efloat64_exists */
+
+/* packed HDR color formats: RGB9E5 and R11G11B10 */
+
+/*
+ RGB9E5 packs three non-negative channels into 32 bits as 9 bit
+ significands (without an implicit leading bit) sharing a 5 bit
+ exponent, as GL_EXT_texture_shared_exponent and DXGI_FORMAT_R9G9B9E5:
+ red in the low bits and the exponent in the top 5 bits. Values are
+ rounded to nearest, and clamped to [0, efloat_rgb9e5_max]; NaN becomes
+ 0.
+
+ R11G11B10 packs three unsigned floats into 32 bits, as
+ GL_EXT_packed_float and DXGI_FORMAT_R11G11B10_FLOAT: red and green
+ have 5 exponent and 6 significand bits, blue has 5 exponent and 5
+ significand bits. These have subnormals, infinity and NaN; values are
+ rounded to nearest, ties to even, negative values become 0, and finite
+ values too large become the largest finite value.
+
+ The colors are interleaved (r, g, b) triples, so "rgb" holds
+ (3 * count) values.
+*/
+#define efloat_rgb9e5_max 65408.0f
+#define efloat_float11_signif_bits 6
+#define efloat_float10_signif_bits 5
+
+#if efloat32_exists
+void efloat32_rgb9e5_encode(uint32_t *dst, const efloat32 *rgb, size_t count);
+void efloat32_rgb9e5_decode(efloat32 *rgb, const uint32_t *src, size_t count);
+void efloat32_r11g11b10_encode(uint32_t *dst, const efloat32 *rgb,
+			       size_t count);
+void efloat32_r11g11b10_decode(efloat32 *rgb, const uint32_t *src,
+			       size_t count);
+#endif /* efloat32_exists */
+
+/* posit<nbits,es> conversion */
+
+/*
+ A posit of "nbits" bits is a sign, a run-length encoded regime, up to
+ "es" exponent bits and a fraction, in two's complement; the value is
+ (-1)^sign * (2^(2^es))^regime * 2^exponent * 1.fraction. The bit
+ patterns are held in the low "nbits" bits of a uint32_t. There is one
+ zero, and one "Not a Real" (NaR), efloat_posit_nar(nbits). Here nbits
+ may be from 2 to 32, and es from 0 to efloat_posit_es_max; common
+ choices are posit8 with es of 0, posit16 with es of 1, posit32 with es
+ of 2, and the 2022 standard's es of 2 for all sizes.
+
+ Conversion to a posit rounds to nearest, ties to even; magnitudes too
+ large become maxpos and non-zero magnitudes too small become minpos.
+ NaN and infinity become NaR, and NaR converts to NaN. Posits convert
+ exactly to efloat64; a posit32 may have more fraction bits than an
+ efloat32 holds, and so is rounded to nearest, ties to even.
+
+ The _fields() functions use the layout of the _radix_2_to_fields()
+ functions. For nbits of 16 or less, the _posit_table() functions fill
+ a table of (1 << nbits) values, after which decoding is table[posit];
+ the posit8 array decode uses a table for long arrays. Invalid nbits or
+ es set EINVAL; the scalar functions return NaR or NaN, the table
+ functions return NULL, and the array functions return 0, otherwise
+ the array functions return "len".
+*/
+#define efloat_posit_es_max 2
+#define efloat_posit_nar(nbits) (((uint32_t)1) << ((nbits) - 1))
+
+#if efloat32_exists
+uint32_t efloat32_to_posit(efloat32 f, unsigned nbits, unsigned es);
+efloat32 posit_to_efloat32(uint32_t posit, unsigned nbits, unsigned es);
+enum efloat_class efloat32_posit_to_fields(uint32_t posit, unsigned nbits,
+					   unsigned es,
+					   struct efloat32_fields *fields);
+uint32_t efloat32_posit_from_fields(const struct efloat32_fields fields,
+				    unsigned nbits, unsigned es);
+efloat32 *efloat32_posit_table(efloat32 *table, unsigned nbits, unsigned es);
+size_t efloat32_array_to_posit8(uint8_t *dst, const efloat32 *src, size_t len,
+				unsigned es);
+size_t posit8_to_efloat32_array(efloat32 *dst, const uint8_t *src, size_t len,
+				unsigned es);
+size_t efloat32_array_to_posit16(uint16_t *dst, const efloat32 *src,
+				 size_t len, unsigned es);
+size_t posit16_to_efloat32_array(efloat32 *dst, const uint16_t *src,
+				 size_t len, unsigned es);
+size_t efloat32_array_to_posit32(uint32_t *dst, const efloat32 *src,
+				 size_t len, unsigned es);
+size_t posit32_to_efloat32_array(efloat32 *dst, const uint32_t *src,
+				 size_t len, unsigned es);
+#endif /* efloat32_exists */
+
+#if efloat64_exists
+uint32_t efloat64_to_posit(efloat64 f, unsigned nbits, unsigned es);
+efloat64 posit_to_efloat64(uint32_t posit, unsigned nbits, unsigned es);
+enum efloat_class efloat64_posit_to_fields(uint32_t posit, unsigned nbits,
+					   unsigned es,
+					   struct efloat64_fields *fields);
+uint32_t efloat64_posit_from_fields(const struct efloat64_fields fields,
+				    unsigned nbits, unsigned es);
+efloat64 *efloat64_posit_table(efloat64 *table, unsigned nbits, unsigned es);
+size_t efloat64_array_to_posit8(uint8_t *dst, const efloat64 *src, size_t len,
+				unsigned es);
+size_t posit8_to_efloat64_array(efloat64 *dst, const uint8_t *src, size_t len,
+				unsigned es);
+size_t efloat64_array_to_posit16(uint16_t *dst, const efloat64 *src,
+				 size_t len, unsigned es);
+size_t posit16_to_efloat64_array(efloat64 *dst, const uint16_t *src,
+				 size_t len, unsigned es);
+size_t efloat64_array_to_posit32(uint32_t *dst, const efloat64 *src,
+				 size_t len, unsigned es);
+size_t posit32_to_efloat64_array(efloat64 *dst, const uint32_t *src,
+				 size_t len, unsigned es);
+#endif /* efloat64_exists */
+
+/* IEEE 754 arithmetic in software */
+
+/*
+ For targets without a floating point unit, the basic operations are
+ provided on the bit patterns of binary32 and binary64 values, using
+ only integer arithmetic. Results are those of IEEE 754 when rounding to
+ nearest, ties to even, including subnormals, signed zeros and
+ infinities; a NaN operand is returned quieted (the first, if more than
+ one is a NaN), and an invalid operation returns the default quiet NaN.
+ No exception flags are kept. Other than the fma, the efloat32
+ operations need no integers wider than 32 bits.
+*/
+#if efloat32_exists
+uint32_t efloat32_soft_add(uint32_t a, uint32_t b);
+uint32_t efloat32_soft_sub(uint32_t a, uint32_t b);
+uint32_t efloat32_soft_mul(uint32_t a, uint32_t b);
+uint32_t efloat32_soft_div(uint32_t a, uint32_t b);
+uint32_t efloat32_soft_sqrt(uint32_t a);
+uint32_t efloat32_soft_fma(uint32_t a, uint32_t b, uint32_t c);
+#endif /* efloat32_exists */
+
+#if efloat64_exists
+uint64_t efloat64_soft_add(uint64_t a, uint64_t b);
+uint64_t efloat64_soft_sub(uint64_t a, uint64_t b);
+uint64_t efloat64_soft_mul(uint64_t a, uint64_t b);
+uint64_t efloat64_soft_div(uint64_t a, uint64_t b);
+uint64_t efloat64_soft_sqrt(uint64_t a);
+uint64_t efloat64_soft_fma(uint64_t a, uint64_t b, uint64_t c);
+#endif /* efloat64_exists */
+
+/* normalize and round wide significands */
+
+/*
+ The from_wide() functions round a value given as an unnormalized
+ integer significand and a power of two into the nearest float of the
+ mode: the value is sign * (significand + sticky) * 2^exponent, where a
+ "sticky" which is non-zero stands for a non-zero amount below the last
+ bit of the significand and too small for the format to keep, as from
+ bits already shifted out; a sign less than zero is negative, as with
+ the _radix_2_to_fields() functions. The
+ efloat_wide_fields hold a 128 bit significand as a (hi, lo) pair.
+
+ The modes are the IEEE 754 directed modes, ties to even and ties away,
+ and round to odd, which rounds toward zero and then sets the last bit
+ if inexact; rounding a wide value to odd with at least two bits more
+ than a narrower format and then rounding that to the narrower format
+ has no double rounding error. Overflow becomes infinity or the largest
+ finite value, as IEEE 754 specifies for the mode; tininess is detected
+ after rounding. The efloat_flag_ bits of each rounding are OR'ed into
+ "*flags", if "flags" is not NULL; the array functions return the OR of
+ all of the flags, and store the flags of each element if "flags" is
+ not NULL. Nothing here reads or changes the floating point environment.
+*/
+enum efloat_round_mode {
+	ef_round_nearest_even = 0,
+	ef_round_toward_zero,
+	ef_round_up,
+	ef_round_down,
+	ef_round_nearest_away,
+	ef_round_odd
+};
+
+#define efloat_flag_inexact 0x01
+#define efloat_flag_underflow 0x02
+#define efloat_flag_overflow 0x04
+#define efloat_flag_invalid 0x08
+
+struct efloat_wide_fields {
+	int8_t sign;
+	uint8_t sticky;
+	int32_t exponent;
+	uint64_t significand_hi;
+	uint64_t significand_lo;
+};
+
+#if efloat32_exists
+efloat32 efloat32_from_wide(int sign, long exponent, uint64_t significand,
+			    int sticky, enum efloat_round_mode mode,
+			    unsigned *flags);
+efloat32 efloat32_from_wide_fields(const struct efloat_wide_fields wide,
+				   enum efloat_round_mode mode,
+				   unsigned *flags);
+unsigned efloat32_array_from_wide_fields(efloat32 *dst,
+					 const struct efloat_wide_fields *src,
+					 size_t len,
+					 enum efloat_round_mode mode,
+					 uint8_t *flags);
+#endif /* efloat32_exists */
+
+#if efloat64_exists
+efloat64 efloat64_from_wide(int sign, long exponent, uint64_t significand,
+			    int sticky, enum efloat_round_mode mode,
+			    unsigned *flags);
+efloat64 efloat64_from_wide_fields(const struct efloat_wide_fields wide,
+				   enum efloat_round_mode mode,
+				   unsigned *flags);
+unsigned efloat64_array_from_wide_fields(efloat64 *dst,
+					 const struct efloat_wide_fields *src,
+					 size_t len,
+					 enum efloat_round_mode mode,
+					 uint8_t *flags);
+#endif /* efloat64_exists */
+
+/*
+ The _to_efloat32_round() functions narrow efloat64 values with the
+ rounding mode given, rather than that of the floating point
+ environment, and report the flags as the from_wide() functions do.
+ Infinities and zeros keep their sign, and NaN keeps its sign and the
+ top of its payload, quieted.
+*/
+#if (efloat32_exists && efloat64_exists)
+efloat32 efloat64_to_efloat32_round(efloat64 d, enum efloat_round_mode mode,
+				    unsigned *flags);
+unsigned efloat64_array_to_efloat32_round(efloat32 *dst, const efloat64 *src,
+					  size_t len,
+					  enum efloat_round_mode mode,
+					  uint8_t *flags);
+#endif /* (efloat32_exists && efloat64_exists) */
+
+/*
+ The integer conversions round 64 bit and 128 bit integers into floats
+ with the rounding mode given and report the flags as the from_wide()
+ functions do, so efloat_flag_inexact is set when an integer is too
+ large to be held exactly. A 128 bit integer is a (hi, lo) pair, two's
+ complement for the signed, as C89 has no 128 bit integer type; for a
+ __int128 x, hi is (int64_t)(x >> 64) and lo is (uint64_t)x.
+*/
+#if efloat32_exists
+efloat32 int64_to_efloat32_round(int64_t i, enum efloat_round_mode mode,
+				 unsigned *flags);
+efloat32 uint64_to_efloat32_round(uint64_t u, enum efloat_round_mode mode,
+				  unsigned *flags);
+efloat32 int128_to_efloat32_round(int64_t hi, uint64_t lo,
+				  enum efloat_round_mode mode, unsigned *flags);
+efloat32 uint128_to_efloat32_round(uint64_t hi, uint64_t lo,
+				   enum efloat_round_mode mode,
+				   unsigned *flags);
+unsigned int64_to_efloat32_array_round(efloat32 *dst, const int64_t *src,
+				       size_t len, enum efloat_round_mode mode,
+				       uint8_t *flags);
+unsigned uint64_to_efloat32_array_round(efloat32 *dst, const uint64_t *src,
+					size_t len, enum efloat_round_mode mode,
+					uint8_t *flags);
+#endif /* efloat32_exists */
+
+#if efloat64_exists
+efloat64 int64_to_efloat64_round(int64_t i, enum efloat_round_mode mode,
+				 unsigned *flags);
+efloat64 uint64_to_efloat64_round(uint64_t u, enum efloat_round_mode mode,
+				  unsigned *flags);
+efloat64 int128_to_efloat64_round(int64_t hi, uint64_t lo,
+				  enum efloat_round_mode mode, unsigned *flags);
+efloat64 uint128_to_efloat64_round(uint64_t hi, uint64_t lo,
+				   enum efloat_round_mode mode,
+				   unsigned *flags);
+unsigned int64_to_efloat64_array_round(efloat64 *dst, const int64_t *src,
+				       size_t len, enum efloat_round_mode mode,
+				       uint8_t *flags);
+unsigned uint64_to_efloat64_array_round(efloat64 *dst, const uint64_t *src,
+					size_t len, enum efloat_round_mode mode,
+					uint8_t *flags);
+#endif /* efloat64_exists */
+
+/* Q format fixed point and scaled int8 quantization */
+
+/*
+ A Qm.n fixed point value of "bits" bits (m + n, with the sign) is an
+ integer scaled by 2^-n, "frac_bits"; here bits may be from 2 to 32 for
+ efloat32 and to 64 for efloat64, and frac_bits may be negative. The
+ scaled int8 values are round(x / scale), where element i uses
+ scales[i % channels], so one channel is a per-tensor scale and the
+ channels of interleaved data each have their own. Scales must be
+ finite and greater than zero.
+
+ Conversions to integers round in the mode given, and saturate to the
+ range of the integer, flagging efloat_flag_invalid, as IEEE 754 does
+ for an integer out of range; NaN becomes 0, also flagged invalid. The
+ quotient by the scale is rounded once, exactly, using the integer
+ significands rather than a float divide or multiply by the reciprocal.
+ The flags are reported as with the from_wide() functions. Conversions
+ to floats round to nearest, ties to even. Invalid bits, scales or
+ channels set EINVAL and return 0.
+*/
+#if efloat32_exists
+int32_t efloat32_to_q(efloat32 f, unsigned bits, int frac_bits,
+		      enum efloat_round_mode mode, unsigned *flags);
+efloat32 q_to_efloat32(int32_t q, int frac_bits);
+unsigned efloat32_array_to_q(int32_t *dst, const efloat32 *src, size_t len,
+			     unsigned bits, int frac_bits,
+			     enum efloat_round_mode mode, uint8_t *flags);
+void q_to_efloat32_array(efloat32 *dst, const int32_t *src, size_t len,
+			 int frac_bits);
+unsigned efloat32_array_to_int8_scaled(int8_t *dst, const efloat32 *src,
+				       size_t len, const efloat32 *scales,
+				       size_t channels,
+				       enum efloat_round_mode mode,
+				       uint8_t *flags);
+size_t int8_scaled_to_efloat32_array(efloat32 *dst, const int8_t *src,
+				     size_t len, const efloat32 *scales,
+				     size_t channels);
+#endif /* efloat32_exists */
+
+#if efloat64_exists
+int64_t efloat64_to_q(efloat64 f, unsigned bits, int frac_bits,
+		      enum efloat_round_mode mode, unsigned *flags);
+efloat64 q_to_efloat64(int64_t q, int frac_bits);
+unsigned efloat64_array_to_q(int64_t *dst, const efloat64 *src, size_t len,
+			     unsigned bits, int frac_bits,
+			     enum efloat_round_mode mode, uint8_t *flags);
+void q_to_efloat64_array(efloat64 *dst, const int64_t *src, size_t len,
+			 int frac_bits);
+unsigned efloat64_array_to_int8_scaled(int8_t *dst, const efloat64 *src,
+				       size_t len, const efloat64 *scales,
+				       size_t channels,
+				       enum efloat_round_mode mode,
+				       uint8_t *flags);
+size_t int8_scaled_to_efloat64_array(efloat64 *dst, const int8_t *src,
+				     size_t len, const efloat64 *scales,
+				     size_t channels);
+#endif /* efloat64_exists */
+
+/* saturating conversions to integers */
+
+/*
+ The saturating conversions to integers are defined for every input,
+ unlike a C cast: each value is rounded in the mode given, values out of
+ range become the nearest of the integer's minimum and maximum, NaN
+ becomes 0, and those are flagged efloat_flag_invalid; negative values
+ which round to zero are 0 for the unsigned types. The flags are
+ reported as with the from_wide() functions.
+*/
+#if efloat32_exists
+unsigned efloat32_array_to_int8_round(int8_t *dst, const efloat32 *src,
+				      size_t len, enum efloat_round_mode mode,
+				      uint8_t *flags);
+unsigned efloat32_array_to_uint8_round(uint8_t *dst, const efloat32 *src,
+				       size_t len, enum efloat_round_mode mode,
+				       uint8_t *flags);
+unsigned efloat32_array_to_int16_round(int16_t *dst, const efloat32 *src,
+				       size_t len, enum efloat_round_mode mode,
+				       uint8_t *flags);
+unsigned efloat32_array_to_uint16_round(uint16_t *dst, const efloat32 *src,
+					size_t len, enum efloat_round_mode mode,
+					uint8_t *flags);
+unsigned efloat32_array_to_int32_round(int32_t *dst, const efloat32 *src,
+				       size_t len, enum efloat_round_mode mode,
+				       uint8_t *flags);
+unsigned efloat32_array_to_uint32_round(uint32_t *dst, const efloat32 *src,
+					size_t len, enum efloat_round_mode mode,
+					uint8_t *flags);
+unsigned efloat32_array_to_int64_round(int64_t *dst, const efloat32 *src,
+				       size_t len, enum efloat_round_mode mode,
+				       uint8_t *flags);
+unsigned efloat32_array_to_uint64_round(uint64_t *dst, const efloat32 *src,
+					size_t len, enum efloat_round_mode mode,
+					uint8_t *flags);
+#endif /* efloat32_exists */
+
+#if efloat64_exists
+unsigned efloat64_array_to_int8_round(int8_t *dst, const efloat64 *src,
+				      size_t len, enum efloat_round_mode mode,
+				      uint8_t *flags);
+unsigned efloat64_array_to_uint8_round(uint8_t *dst, const efloat64 *src,
+				       size_t len, enum efloat_round_mode mode,
+				       uint8_t *flags);
+unsigned efloat64_array_to_int16_round(int16_t *dst, const efloat64 *src,
+				       size_t len, enum efloat_round_mode mode,
+				       uint8_t *flags);
+unsigned efloat64_array_to_uint16_round(uint16_t *dst, const efloat64 *src,
+					size_t len, enum efloat_round_mode mode,
+					uint8_t *flags);
+unsigned efloat64_array_to_int32_round(int32_t *dst, const efloat64 *src,
+				       size_t len, enum efloat_round_mode mode,
+				       uint8_t *flags);
+unsigned efloat64_array_to_uint32_round(uint32_t *dst, const efloat64 *src,
+					size_t len, enum efloat_round_mode mode,
+					uint8_t *flags);
+unsigned efloat64_array_to_int64_round(int64_t *dst, const efloat64 *src,
+				       size_t len, enum efloat_round_mode mode,
+				       uint8_t *flags);
+unsigned efloat64_array_to_uint64_round(uint64_t *dst, const efloat64 *src,
+					size_t len, enum efloat_round_mode mode,
+					uint8_t *flags);
+#endif /* efloat64_exists */
+
+/* exponent manipulation: frexp, ldexp, ilogb, logb and copysign */
+
+/*
+ These work on the bit patterns, as the C99 <math.h> functions of the
+ same names do on the values, and need neither libm nor C99. frexp()
+ returns a significand in [0.5, 1), or the zero, infinity or NaN given
+ with an "*exp" of 0. ldexp() and scalbn() scale by a power of two,
+ rounding a subnormal result to nearest, ties to even, whatever the
+ current rounding mode; results too large overflow to infinity. ilogb()
+ returns efloat_ilogb0 for zero, efloat_ilogbnan for NaN and INT_MAX for
+ infinity; logb() returns negative infinity for zero. A NaN in is a
+ quiet NaN out, and copysign() changes only the sign bit.
+*/
+#define efloat_ilogb0 INT_MIN
+#define efloat_ilogbnan INT_MAX
+
+#if efloat32_exists
+efloat32 efloat32_frexp(efloat32 f, int *exp);
+efloat32 efloat32_ldexp(efloat32 f, int exp);
+efloat32 efloat32_scalbn(efloat32 f, int n);
+int efloat32_ilogb(efloat32 f);
+efloat32 efloat32_logb(efloat32 f);
+efloat32 efloat32_copysign(efloat32 mag, efloat32 sgn);
+void efloat32_array_frexp(efloat32 *dst, int *exps, const efloat32 *src,
+			  size_t len);
+void efloat32_array_ldexp(efloat32 *dst, const efloat32 *src,
+			  const int *exps, size_t len);
+void efloat32_array_scalbn(efloat32 *dst, const efloat32 *src, int scale,
+			   size_t len);
+void efloat32_array_ilogb(int *dst, const efloat32 *src, size_t len);
+void efloat32_array_logb(efloat32 *dst, const efloat32 *src, size_t len);
+void efloat32_array_copysign(efloat32 *dst, const efloat32 *mag,
+			     const efloat32 *sgn, size_t len);
+#endif /* efloat32_exists */
+
+#if efloat64_exists
+efloat64 efloat64_frexp(efloat64 d, int *exp);
+efloat64 efloat64_ldexp(efloat64 d, int exp);
+efloat64 efloat64_scalbn(efloat64 d, int n);
+int efloat64_ilogb(efloat64 d);
+efloat64 efloat64_logb(efloat64 d);
+efloat64 efloat64_copysign(efloat64 mag, efloat64 sgn);
+void efloat64_array_frexp(efloat64 *dst, int *exps, const efloat64 *src,
+			  size_t len);
+void efloat64_array_ldexp(efloat64 *dst, const efloat64 *src,
+			  const int *exps, size_t len);
+void efloat64_array_scalbn(efloat64 *dst, const efloat64 *src, int scale,
+			   size_t len);
+void efloat64_array_ilogb(int *dst, const efloat64 *src, size_t len);
+void efloat64_array_logb(efloat64 *dst, const efloat64 *src, size_t len);
+void efloat64_array_copysign(efloat64 *dst, const efloat64 *mag,
+			     const efloat64 *sgn, size_t len);
+#endif /* efloat64_exists */
+
+/* exact sums and dot products */
+
+/*
+ A struct efloat_superacc holds a sum of floats, or of their products,
+ exactly, as one wide fixed point integer covering every efloat32 and
+ efloat64 value and product; adding in any order, or adding to separate
+ accumulators and then merging them, leaves the same bits, so a rounded
+ result does not depend on the order or on how work was split between
+ threads. An accumulator must be zeroed before use; it is a little over
+ half a kilobyte, and is not locked. Rounding reports the flags as the
+ from_wide() functions do, and a NaN, or infinities of both signs, or an
+ infinity times zero, round to a quiet NaN. The _exact() functions
+ round the exact sum or dot product to nearest, ties to even.
+*/
+#define efloat_superacc_words 68
+
+struct efloat_superacc {
+	uint64_t word[efloat_superacc_words];
+	uint8_t specials;
+};
+
+void efloat_superacc_zero(struct efloat_superacc *acc);
+void efloat_superacc_merge(struct efloat_superacc *acc,
+			   const struct efloat_superacc *partial);
+
+#if efloat32_exists
+void efloat32_superacc_add(struct efloat_superacc *acc, efloat32 f);
+void efloat32_superacc_add_array(struct efloat_superacc *acc,
+				 const efloat32 *src, size_t len);
+void efloat32_superacc_add_products(struct efloat_superacc *acc,
+				    const efloat32 *a, const efloat32 *b,
+				    size_t len);
+efloat32 efloat32_superacc_round(const struct efloat_superacc *acc,
+				 enum efloat_round_mode mode, unsigned *flags);
+efloat32 efloat32_array_sum_exact(const efloat32 *src, size_t len);
+efloat32 efloat32_array_dot_exact(const efloat32 *a, const efloat32 *b,
+				  size_t len);
+#endif /* efloat32_exists */
+
+#if efloat64_exists
+void efloat64_superacc_add(struct efloat_superacc *acc, efloat64 d);
+void efloat64_superacc_add_array(struct efloat_superacc *acc,
+				 const efloat64 *src, size_t len);
+void efloat64_superacc_add_products(struct efloat_superacc *acc,
+				    const efloat64 *a, const efloat64 *b,
+				    size_t len);
+efloat64 efloat64_superacc_round(const struct efloat_superacc *acc,
+				 enum efloat_round_mode mode, unsigned *flags);
+efloat64 efloat64_array_sum_exact(const efloat64 *src, size_t len);
+efloat64 efloat64_array_dot_exact(const efloat64 *a, const efloat64 *b,
+				  size_t len);
+#endif /* efloat64_exists */
+
+/* error-free transformations and double-double arithmetic */
+
+/*
+ The two_sum() and two_prod() functions return the rounded sum or
+ product, and store in "*err" its rounding error, so that the result
+ plus the error is exactly the sum or product; fast_two_sum() is the
+ same where |a| >= |b|, or a is 0. The error of a product is exact
+ unless it is below the smallest subnormal; an infinite or NaN result
+ has an error of 0.
+
+ A struct efloat64_pair is a double-double (and an efloat32_pair a
+ float-float): an unevaluated sum hi + lo, with |lo| at most half an
+ ulp of hi, carrying about twice the precision of the format. The pair
+ add, mul and div have relative errors below 3, 7 and 15 times u^2,
+ where u is 2^-53 (or 2^-24), when nothing overflows or underflows; an
+ infinite, NaN or zero result is returned with a lo of 0.
+
+ The _compensated() sum and dot product are as accurate as if computed
+ in twice the precision and then rounded. All of these need the
+ arithmetic of the format to be rounded to nearest, without wider
+ intermediates (FLT_EVAL_METHOD 0) and without contraction into fused
+ multiply-adds.
+*/
+#if efloat32_exists
+struct efloat32_pair {
+	efloat32 hi;
+	efloat32 lo;
+};
+
+efloat32 efloat32_fast_two_sum(efloat32 a, efloat32 b, efloat32 *err);
+efloat32 efloat32_two_sum(efloat32 a, efloat32 b, efloat32 *err);
+efloat32 efloat32_two_prod(efloat32 a, efloat32 b, efloat32 *err);
+struct efloat32_pair efloat32_pair_add(struct efloat32_pair x,
+				       struct efloat32_pair y);
+struct efloat32_pair efloat32_pair_mul(struct efloat32_pair x,
+				       struct efloat32_pair y);
+struct efloat32_pair efloat32_pair_div(struct efloat32_pair x,
+				       struct efloat32_pair y);
+struct efloat32_pair efloat32_pair_sqrt(struct efloat32_pair x);
+void efloat32_pair_array_add(struct efloat32_pair *dst,
+			     const struct efloat32_pair *a,
+			     const struct efloat32_pair *b, size_t len);
+void efloat32_pair_array_mul(struct efloat32_pair *dst,
+			     const struct efloat32_pair *a,
+			     const struct efloat32_pair *b, size_t len);
+void efloat32_pair_array_div(struct efloat32_pair *dst,
+			     const struct efloat32_pair *a,
+			     const struct efloat32_pair *b, size_t len);
+void efloat32_pair_array_sqrt(struct efloat32_pair *dst,
+			      const struct efloat32_pair *src, size_t len);
+efloat32 efloat32_array_sum_compensated(const efloat32 *src, size_t len);
+efloat32 efloat32_array_dot_compensated(const efloat32 *a, const efloat32 *b,
+					size_t len);
+#endif /* efloat32_exists */
+
+#if efloat64_exists
+struct efloat64_pair {
+	efloat64 hi;
+	efloat64 lo;
+};
+
+efloat64 efloat64_fast_two_sum(efloat64 a, efloat64 b, efloat64 *err);
+efloat64 efloat64_two_sum(efloat64 a, efloat64 b, efloat64 *err);
+efloat64 efloat64_two_prod(efloat64 a, efloat64 b, efloat64 *err);
+struct efloat64_pair efloat64_pair_add(struct efloat64_pair x,
+				       struct efloat64_pair y);
+struct efloat64_pair efloat64_pair_mul(struct efloat64_pair x,
+				       struct efloat64_pair y);
+struct efloat64_pair efloat64_pair_div(struct efloat64_pair x,
+				       struct efloat64_pair y);
+struct efloat64_pair efloat64_pair_sqrt(struct efloat64_pair x);
+void efloat64_pair_array_add(struct efloat64_pair *dst,
+			     const struct efloat64_pair *a,
+			     const struct efloat64_pair *b, size_t len);
+void efloat64_pair_array_mul(struct efloat64_pair *dst,
+			     const struct efloat64_pair *a,
+			     const struct efloat64_pair *b, size_t len);
+void efloat64_pair_array_div(struct efloat64_pair *dst,
+			     const struct efloat64_pair *a,
+			     const struct efloat64_pair *b, size_t len);
+void efloat64_pair_array_sqrt(struct efloat64_pair *dst,
+			      const struct efloat64_pair *src, size_t len);
+efloat64 efloat64_array_sum_compensated(const efloat64 *src, size_t len);
+efloat64 efloat64_array_dot_compensated(const efloat64 *a, const efloat64 *b,
+					size_t len);
+#endif /* efloat64_exists */
+
+/* interval arithmetic with outward rounding */
+
+/*
+ An interval holds the reals from lo to hi, with lo <= hi; an infinite
+ bound is an unbounded end. The bounds of each result are computed in
+ the current rounding mode and then stepped one ulp outward on their bit
+ patterns, so the exact result of any operands within the intervals is
+ within the result without changing the rounding mode; results are thus
+ up to two ulps wider than the tightest bounds. Dividing by an interval
+ which contains zero gives the whole line; the square root of an
+ interval leaves out its negative part. An operand with a NaN bound, or
+ the square root of an interval below zero, gives NaN bounds. The
+ next_up() and next_down() functions step a value by one ulp, from either
+ zero to the smallest subnormal of the direction.
+*/
+#if efloat32_exists
+struct efloat32_interval {
+	efloat32 lo;
+	efloat32 hi;
+};
+
+efloat32 efloat32_next_up(efloat32 f);
+efloat32 efloat32_next_down(efloat32 f);
+struct efloat32_interval efloat32_interval_add(struct efloat32_interval x,
+					       struct efloat32_interval y);
+struct efloat32_interval efloat32_interval_sub(struct efloat32_interval x,
+					       struct efloat32_interval y);
+struct efloat32_interval efloat32_interval_mul(struct efloat32_interval x,
+					       struct efloat32_interval y);
+struct efloat32_interval efloat32_interval_div(struct efloat32_interval x,
+					       struct efloat32_interval y);
+struct efloat32_interval efloat32_interval_sqrt(struct efloat32_interval x);
+void efloat32_interval_array_add(struct efloat32_interval *dst,
+				 const struct efloat32_interval *a,
+				 const struct efloat32_interval *b, size_t len);
+void efloat32_interval_array_sub(struct efloat32_interval *dst,
+				 const struct efloat32_interval *a,
+				 const struct efloat32_interval *b, size_t len);
+void efloat32_interval_array_mul(struct efloat32_interval *dst,
+				 const struct efloat32_interval *a,
+				 const struct efloat32_interval *b, size_t len);
+void efloat32_interval_array_div(struct efloat32_interval *dst,
+				 const struct efloat32_interval *a,
+				 const struct efloat32_interval *b, size_t len);
+void efloat32_interval_array_sqrt(struct efloat32_interval *dst,
+				  const struct efloat32_interval *src,
+				  size_t len);
+#endif /* efloat32_exists */
+
+#if efloat64_exists
+struct efloat64_interval {
+	efloat64 lo;
+	efloat64 hi;
+};
+
+efloat64 efloat64_next_up(efloat64 d);
+efloat64 efloat64_next_down(efloat64 d);
+struct efloat64_interval efloat64_interval_add(struct efloat64_interval x,
+					       struct efloat64_interval y);
+struct efloat64_interval efloat64_interval_sub(struct efloat64_interval x,
+					       struct efloat64_interval y);
+struct efloat64_interval efloat64_interval_mul(struct efloat64_interval x,
+					       struct efloat64_interval y);
+struct efloat64_interval efloat64_interval_div(struct efloat64_interval x,
+					       struct efloat64_interval y);
+struct efloat64_interval efloat64_interval_sqrt(struct efloat64_interval x);
+void efloat64_interval_array_add(struct efloat64_interval *dst,
+				 const struct efloat64_interval *a,
+				 const struct efloat64_interval *b, size_t len);
+void efloat64_interval_array_sub(struct efloat64_interval *dst,
+				 const struct efloat64_interval *a,
+				 const struct efloat64_interval *b, size_t len);
+void efloat64_interval_array_mul(struct efloat64_interval *dst,
+				 const struct efloat64_interval *a,
+				 const struct efloat64_interval *b, size_t len);
+void efloat64_interval_array_div(struct efloat64_interval *dst,
+				 const struct efloat64_interval *a,
+				 const struct efloat64_interval *b, size_t len);
+void efloat64_interval_array_sqrt(struct efloat64_interval *dst,
+				  const struct efloat64_interval *src,
+				  size_t len);
+#endif /* efloat64_exists */
+
+/* totalOrder, minimum and maximum */
+
+/*
+ These follow IEEE 754-2019, comparing the bit patterns as integers.
+ total_order() is nonzero if "x" is ordered before or equal to "y", with
+ -NaN < -inf < ... < -0.0 < 0.0 < ... < inf < NaN, and total_order_mag()
+ is the same of the magnitudes; total_compare() returns a negative,
+ zero or positive result as for qsort(). minimum() and maximum() order
+ -0.0 below 0.0 and return a quiet NaN if either operand is a NaN; the
+ _number() forms instead return the other operand, and a quiet NaN only
+ if both are NaN. The _array_reduce_ functions return the same over a
+ whole array: the first NaN quieted, by the _number() forms only if
+ there is no number. An empty array gives inf for minimum, -inf for
+ maximum and the default quiet NaN for the _number() forms.
+*/
+#if efloat32_exists
+int efloat32_total_order(efloat32 x, efloat32 y);
+int efloat32_total_order_mag(efloat32 x, efloat32 y);
+int efloat32_total_compare(efloat32 x, efloat32 y);
+efloat32 efloat32_minimum(efloat32 x, efloat32 y);
+efloat32 efloat32_maximum(efloat32 x, efloat32 y);
+efloat32 efloat32_minimum_number(efloat32 x, efloat32 y);
+efloat32 efloat32_maximum_number(efloat32 x, efloat32 y);
+void efloat32_array_minimum(efloat32 *dst, const efloat32 *a,
+			    const efloat32 *b, size_t len);
+void efloat32_array_maximum(efloat32 *dst, const efloat32 *a,
+			    const efloat32 *b, size_t len);
+void efloat32_array_minimum_number(efloat32 *dst, const efloat32 *a,
+				   const efloat32 *b, size_t len);
+void efloat32_array_maximum_number(efloat32 *dst, const efloat32 *a,
+				   const efloat32 *b, size_t len);
+efloat32 efloat32_array_reduce_minimum(const efloat32 *src, size_t len);
+efloat32 efloat32_array_reduce_maximum(const efloat32 *src, size_t len);
+efloat32 efloat32_array_reduce_minimum_number(const efloat32 *src,
+					      size_t len);
+efloat32 efloat32_array_reduce_maximum_number(const efloat32 *src,
+					      size_t len);
+#endif /* efloat32_exists */
+
+#if efloat64_exists
+int efloat64_total_order(efloat64 x, efloat64 y);
+int efloat64_total_order_mag(efloat64 x, efloat64 y);
+int efloat64_total_compare(efloat64 x, efloat64 y);
+efloat64 efloat64_minimum(efloat64 x, efloat64 y);
+efloat64 efloat64_maximum(efloat64 x, efloat64 y);
+efloat64 efloat64_minimum_number(efloat64 x, efloat64 y);
+efloat64 efloat64_maximum_number(efloat64 x, efloat64 y);
+void efloat64_array_minimum(efloat64 *dst, const efloat64 *a,
+			    const efloat64 *b, size_t len);
+void efloat64_array_maximum(efloat64 *dst, const efloat64 *a,
+			    const efloat64 *b, size_t len);
+void efloat64_array_minimum_number(efloat64 *dst, const efloat64 *a,
+				   const efloat64 *b, size_t len);
+void efloat64_array_maximum_number(efloat64 *dst, const efloat64 *a,
+				   const efloat64 *b, size_t len);
+efloat64 efloat64_array_reduce_minimum(const efloat64 *src, size_t len);
+efloat64 efloat64_array_reduce_maximum(const efloat64 *src, size_t len);
+efloat64 efloat64_array_reduce_minimum_number(const efloat64 *src,
+					      size_t len);
+efloat64 efloat64_array_reduce_maximum_number(const efloat64 *src,
+					      size_t len);
+#endif /* efloat64_exists */
+
+/* canonicalizing hashes */
+
+/*
+ With ef_hash_ieee, values which compare equal hash equal: -0.0 is taken
+ as 0.0, and every NaN as the one quiet NaN, so that all NaNs fall in
+ one group for joins and de-duplication. With ef_hash_bitwise the bit
+ pattern is hashed as it is. The hash is a bijection of the (canonical)
+ bit pattern xor the "seed", so distinct values never share the full
+ 64 bits. canonical() makes the same substitutions on the values.
+*/
+enum efloat_hash_mode {
+	ef_hash_ieee = 0,
+	ef_hash_bitwise
+};
+
+#if efloat32_exists
+efloat32 efloat32_canonical(efloat32 f);
+uint64_t efloat32_hash(efloat32 f, uint64_t seed, enum efloat_hash_mode mode);
+void efloat32_array_canonical(efloat32 *dst, const efloat32 *src, size_t len);
+void efloat32_array_hash(uint64_t *dst, const efloat32 *src, size_t len,
+			 uint64_t seed, enum efloat_hash_mode mode);
+#endif /* efloat32_exists */
+
+#if efloat64_exists
+efloat64 efloat64_canonical(efloat64 d);
+uint64_t efloat64_hash(efloat64 d, uint64_t seed, enum efloat_hash_mode mode);
+void efloat64_array_canonical(efloat64 *dst, const efloat64 *src, size_t len);
+void efloat64_array_hash(uint64_t *dst, const efloat64 *src, size_t len,
+			 uint64_t seed, enum efloat_hash_mode mode);
+#endif /* efloat64_exists */
+
+/* NaN-boxing: tagged values carried in quiet NaN payloads */
+
+/*
+ A box is a quiet NaN with the sign bit clear and a non-zero tag in the
+ top bits of its payload, leaving 48 bits of payload for an efloat64
+ (enough for a pointer on the common 64 bit targets) and 20 bits for an
+ efloat32. The real NaNs which arithmetic produces have a tag of zero on
+ the usual targets, but any NaN may have any payload, so values from
+ outside should pass through _nanbox_clean(), which replaces every NaN
+ with the one canonical quiet NaN (which is not a box) and leaves every
+ other value alone.
+
+ The macros work on the bit patterns, for the fast paths of a runtime;
+ the functions work on the values. _nanbox() sets efloat_seterrinval
+ and returns the canonical NaN if the tag is zero or too large, or the
+ payload too wide. _nanbox_tag() and _nanbox_payload() return 0 for a
+ value which is not a box.
+*/
+#if efloat32_exists
+#define efloat32_nanbox_tag_bits 2
+#define efloat32_nanbox_tag_shift 20
+#define efloat32_nanbox_tag_mask 0x00300000UL
+#define efloat32_nanbox_payload_mask 0x000FFFFFUL
+
+#define efloat32_bits_nanbox(tag, payload) \
+	((uint32_t)(efloat32_canonical_nan_bits \
+		    | (((uint32_t)(tag) << efloat32_nanbox_tag_shift) \
+		       & efloat32_nanbox_tag_mask) \
+		    | ((uint32_t)(payload) & efloat32_nanbox_payload_mask)))
+
+#define efloat32_bits_is_nanbox(u) \
+	((((u) & (efloat32_r2_sign_mask | efloat32_canonical_nan_bits)) \
+	  == efloat32_canonical_nan_bits) \
+	 && (((u) & efloat32_nanbox_tag_mask) != 0))
+
+#define efloat32_bits_nanbox_tag(u) \
+	((unsigned)(((u) & efloat32_nanbox_tag_mask) \
+		    >> efloat32_nanbox_tag_shift))
+
+#define efloat32_bits_nanbox_payload(u) \
+	((uint32_t)((u) & efloat32_nanbox_payload_mask))
+
+#define efloat32_bits_nanbox_clean(u) \
+	((((u) & ~efloat32_r2_sign_mask) > efloat32_r2_rexp_mask) \
+	 ? (uint32_t)efloat32_canonical_nan_bits : (uint32_t)(u))
+
+efloat32 efloat32_nanbox(unsigned tag, uint32_t payload);
+int efloat32_is_nanbox(efloat32 f);
+unsigned efloat32_nanbox_tag(efloat32 f);
+uint32_t efloat32_nanbox_payload(efloat32 f);
+efloat32 efloat32_nanbox_clean(efloat32 f);
+void efloat32_array_nanbox_clean(efloat32 *dst, const efloat32 *src,
+				 size_t len);
+#endif /* efloat32_exists */
+
+#if efloat64_exists
+#define efloat64_nanbox_tag_bits 3
+#define efloat64_nanbox_tag_shift 48
+#define efloat64_nanbox_tag_mask 0x0007000000000000UL
+#define efloat64_nanbox_payload_mask 0x0000FFFFFFFFFFFFUL
+
+#define efloat64_bits_nanbox(tag, payload) \
+	((uint64_t)(efloat64_canonical_nan_bits \
+		    | (((uint64_t)(tag) << efloat64_nanbox_tag_shift) \
+		       & efloat64_nanbox_tag_mask) \
+		    | ((uint64_t)(payload) & efloat64_nanbox_payload_mask)))
+
+#define efloat64_bits_is_nanbox(u) \
+	((((u) & (efloat64_r2_sign_mask | efloat64_canonical_nan_bits)) \
+	  == efloat64_canonical_nan_bits) \
+	 && (((u) & efloat64_nanbox_tag_mask) != 0))
+
+#define efloat64_bits_nanbox_tag(u) \
+	((unsigned)(((u) & efloat64_nanbox_tag_mask) \
+		    >> efloat64_nanbox_tag_shift))
+
+#define efloat64_bits_nanbox_payload(u) \
+	((uint64_t)((u) & efloat64_nanbox_payload_mask))
+
+#define efloat64_bits_nanbox_clean(u) \
+	((((u) & ~efloat64_r2_sign_mask) > efloat64_r2_rexp_mask) \
+	 ? (uint64_t)efloat64_canonical_nan_bits : (uint64_t)(u))
+
+efloat64 efloat64_nanbox(unsigned tag, uint64_t payload);
+int efloat64_is_nanbox(efloat64 d);
+unsigned efloat64_nanbox_tag(efloat64 d);
+uint64_t efloat64_nanbox_payload(efloat64 d);
+efloat64 efloat64_nanbox_clean(efloat64 d);
+void efloat64_array_nanbox_clean(efloat64 *dst, const efloat64 *src,
+				 size_t len);
+#endif /* efloat64_exists */
+
+/* sanitizing arrays: flushing subnormals, replacing NaN and inf, clamping */
+
+/*
+ _array_sanitize() rewrites an array in place, in one pass, as chosen by
+ the "flags" of the options: with efloat_sanitize_flush a subnormal
+ becomes a zero of the same sign; with efloat_sanitize_nan a NaN becomes
+ "nan_value"; with efloat_sanitize_inf an infinity becomes "pos_inf" or
+ "neg_inf"; and then with efloat_sanitize_clamp every value which is not
+ a NaN is clamped to ["lo", "hi"], in total order, so that -0.0 is below
+ 0.0. This works on the bit patterns and does not depend on, nor change,
+ the flush-to-zero or denormals-are-zero modes of the FPU.
+
+ If "class_count" is not NULL, the counts of each efloat_class of the
+ values (as they were) are added to it, indexed by the enum value. The
+ count of values changed is returned. If the options are NULL, or a
+ clamp bound is NaN or "lo" is above "hi", efloat_seterrinval is called
+ and the array is left alone. _sanitize_init() clears the flags, sets
+ the replacements to 0.0 and the largest finite values, and the bounds
+ to the infinities.
+*/
+#define efloat_sanitize_flush 0x01
+#define efloat_sanitize_nan 0x02
+#define efloat_sanitize_inf 0x04
+#define efloat_sanitize_clamp 0x08
+
+#if efloat32_exists
+struct efloat32_sanitize {
+	unsigned flags;
+	efloat32 nan_value;
+	efloat32 pos_inf;
+	efloat32 neg_inf;
+	efloat32 lo;
+	efloat32 hi;
+};
+
+void efloat32_sanitize_init(struct efloat32_sanitize *options);
+size_t efloat32_array_sanitize(efloat32 *a, size_t len,
+			       const struct efloat32_sanitize *options,
+			       uint64_t *class_count);
+#endif /* efloat32_exists */
+
+#if efloat64_exists
+struct efloat64_sanitize {
+	unsigned flags;
+	efloat64 nan_value;
+	efloat64 pos_inf;
+	efloat64 neg_inf;
+	efloat64 lo;
+	efloat64 hi;
+};
+
+void efloat64_sanitize_init(struct efloat64_sanitize *options);
+size_t efloat64_array_sanitize(efloat64 *a, size_t len,
+			       const struct efloat64_sanitize *options,
+			       uint64_t *class_count);
+#endif /* efloat64_exists */
+
+/* fast approximate log2, exp2 and 1/sqrt */
+
+/*
+ These start from the exponent and significand fields and refine with a
+ short series or a few Newton steps, chosen by the tier. The worst error
+ of each tier, in ulps from the correctly rounded result as counted by
+ _distance(), measured over every efloat32 argument and over 2 million
+ random efloat64 arguments, is:
+
+	         coarse    medium    fine
+	log2 32  2943      4         3
+	log2 64  1.6e12    7.6e8     3
+	exp2 32  9426      3         1
+	exp2 64  5.1e12    1.1e9     1
+	rsqrt 32 28385     74        3
+	rsqrt 64 1.53e13   3.9e10    2
+
+ that is, a relative error of at most about 3e-4 (log2), 1e-3 (exp2)
+ and 2e-3 (rsqrt) for the coarse tier, and 2e-7, 2e-7 and 5e-6 for the
+ medium tier.
+
+ The special values are exact: log2() gives -inf for zero and NaN below
+ zero, exp2() gives inf and zero past the range, and rsqrt() gives the
+ signed infinity for a zero and NaN below zero. The argument of exp2()
+ may give a subnormal result, which is rounded from the approximation.
+ An unknown tier calls efloat_seterrinval and gives NaN.
+*/
+enum efloat_approx_tier {
+	ef_approx_coarse = 0,
+	ef_approx_medium,
+	ef_approx_fine
+};
+
+#if efloat32_exists
+efloat32 efloat32_approx_log2(efloat32 f, enum efloat_approx_tier tier);
+efloat32 efloat32_approx_exp2(efloat32 f, enum efloat_approx_tier tier);
+efloat32 efloat32_approx_rsqrt(efloat32 f, enum efloat_approx_tier tier);
+void efloat32_array_approx_log2(efloat32 *dst, const efloat32 *src,
+				size_t len, enum efloat_approx_tier tier);
+void efloat32_array_approx_exp2(efloat32 *dst, const efloat32 *src,
+				size_t len, enum efloat_approx_tier tier);
+void efloat32_array_approx_rsqrt(efloat32 *dst, const efloat32 *src,
+				 size_t len, enum efloat_approx_tier tier);
+#endif /* efloat32_exists */
+
+#if efloat64_exists
+efloat64 efloat64_approx_log2(efloat64 d, enum efloat_approx_tier tier);
+efloat64 efloat64_approx_exp2(efloat64 d, enum efloat_approx_tier tier);
+efloat64 efloat64_approx_rsqrt(efloat64 d, enum efloat_approx_tier tier);
+void efloat64_array_approx_log2(efloat64 *dst, const efloat64 *src,
+				size_t len, enum efloat_approx_tier tier);
+void efloat64_array_approx_exp2(efloat64 *dst, const efloat64 *src,
+				size_t len, enum efloat_approx_tier tier);
+void efloat64_array_approx_rsqrt(efloat64 *dst, const efloat64 *src,
+				 size_t len, enum efloat_approx_tier tier);
+#endif /* efloat64_exists */
+
+/* log bucketed (HDR style) histograms */
+
+/*
+ A histogram counts values in buckets keyed by the unbiased exponent and
+ the top "sub_bits" bits of the significand, which is simply the high
+ bits of the efloat64 bit pattern, so every bucket spans a relative
+ width of at most 2^-sub_bits. Values from 2^exp_min up to (but not
+ including) 2^(exp_max + 1) are bucketed; smaller values (including
+ zero and the negative values) are counted in "below", larger values
+ (including inf) in "above", and NaNs in "nan".
+
+ The caller provides the storage for the counts, which must hold at
+ least efloat_histogram_len() entries. Where the compiler offers lock
+ free 64 bit atomics, efloat_histogram_lock_free is 1, and recording and
+ merging use relaxed atomic adds, and so may be done from many threads
+ at once; otherwise it is 0, and a histogram must not be shared.
+ _snapshot() copies the counts of a histogram into another of the same
+ shape, and _merge() adds them; histograms of different shapes call
+ efloat_seterrinval and are left alone.
+
+ _quantile() returns the middle of the bucket holding the value of rank
+ ceil(q * count) among the values counted (not the NaNs), which is
+ within a relative error of 2^-(sub_bits + 1) of that value, if it is
+ within the range; otherwise 2^exp_min or 2^(exp_max + 1) is returned.
+ An empty histogram gives NaN, as does a "q" outside [0, 1], which also
+ calls efloat_seterrinval.
+
+ _init() zeroes the counts and returns "h", or calls efloat_seterrinval
+ and returns NULL if sub_bits is above efloat_histogram_sub_bits_max, if
+ exp_min and exp_max are not an ordered pair within the normal exponents
+ from -1022 to 1023, or if "len" is too short. _count() does not include
+ the NaNs.
+*/
+#define efloat_histogram_len(sub_bits, exp_min, exp_max) \
+	((size_t)((exp_max) - (exp_min) + 1) << (sub_bits))
+
+#define efloat_histogram_sub_bits_max 20
+
+#if (defined __GCC_ATOMIC_LLONG_LOCK_FREE) \
+	&& (__GCC_ATOMIC_LLONG_LOCK_FREE == 2)
+#define efloat_histogram_lock_free 1
+#else
+#define efloat_histogram_lock_free 0
+#endif
+
+#if efloat64_exists
+struct efloat_histogram {
+	uint64_t *counts;
+	size_t len;
+	unsigned sub_bits;
+	int exp_min;
+	int exp_max;
+	uint64_t below;
+	uint64_t above;
+	uint64_t nan;
+};
+
+struct efloat_histogram *efloat_histogram_init(struct efloat_histogram *h,
+					       uint64_t *counts, size_t len,
+					       unsigned sub_bits, int exp_min,
+					       int exp_max);
+void efloat_histogram_snapshot(struct efloat_histogram *dst,
+			       const struct efloat_histogram *src);
+void efloat_histogram_merge(struct efloat_histogram *h,
+			    const struct efloat_histogram *other);
+uint64_t efloat_histogram_count(const struct efloat_histogram *h);
+efloat64 efloat_histogram_quantile(const struct efloat_histogram *h,
+				   efloat64 q);
+void efloat64_histogram_record(struct efloat_histogram *h, efloat64 d);
+void efloat64_histogram_record_array(struct efloat_histogram *h,
+				     const efloat64 *src, size_t len);
+#if efloat32_exists
+void efloat32_histogram_record(struct efloat_histogram *h, efloat32 f);
+void efloat32_histogram_record_array(struct efloat_histogram *h,
+				     const efloat32 *src, size_t len);
+#endif /* efloat32_exists */
+#endif /* efloat64_exists */
+
 /* last the function aliases */
 
 #if (efloat_float == 32)
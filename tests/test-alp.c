@@ -0,0 +1,205 @@
+/* SPDX-License-Identifier: LGPL-2.1-or-later */
+/* test-alp.c: test of the ALP style decimal float compression */
+/* Copyright (C) 2026 Eric Herman */
+/* https://github.com/ericherman/libefloat */
+
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "efloat.h"
+
+#define Test_array_len 3000
+
+static efloat64 a[Test_array_len];
+static efloat64 out[Test_array_len];
+static uint8_t buf[efloat64_alp_bound(Test_array_len)];
+
+void fill_series(size_t len, int kind)
+{
+	uint64_t state;
+	int64_t cents;
+	size_t i;
+
+	state = 11;
+	cents = 10000;
+	for (i = 0; i < len; ++i) {
+		state = (state * 6364136223846793005ULL)
+		    + 1442695040888963407ULL;
+		cents += (int64_t)((state >> 40) % 201) - 100;
+		switch (kind) {
+		case 0:
+			/* prices with two decimal places */
+			a[i] = (double)cents / 100.0;
+			break;
+		case 1:
+			/* sensor readings with four decimal places */
+			a[i] = (double)(cents - 5000) / 10000.0;
+			break;
+		case 2:
+			/* decimals, with exceptions sprinkled in */
+			a[i] = (double)cents / 1000.0;
+			if ((i % 37) == 0) {
+				a[i] = uint64_bits_to_efloat64(state);
+			} else if ((i % 41) == 0) {
+				a[i] = -0.0;
+			} else if ((i % 43) == 0) {
+				a[i] = (i & 1) ? INFINITY : NAN;
+			} else if ((i % 47) == 0) {
+				a[i] = 1.0 / 3.0;
+			}
+			break;
+		default:
+			/* nothing but exceptions */
+			a[i] = uint64_bits_to_efloat64(state);
+			break;
+		}
+	}
+}
+
+int check_efloat64_round_trip(size_t len, size_t *used)
+{
+	size_t i, n;
+	int err;
+
+	err = 0;
+	*used = efloat64_alp_encode(buf, sizeof(buf), a, len);
+	if (*used == 0 || *used > efloat64_alp_bound(len)) {
+		fprintf(stderr, "encoded %lu values in %lu bytes\n",
+			(unsigned long)len, (unsigned long)*used);
+		return 1;
+	}
+	if (efloat_alp_count(buf, *used) != len) {
+		++err;
+	}
+	n = efloat64_alp_decode(out, Test_array_len, buf, *used);
+	if (n != len) {
+		fprintf(stderr, "decoded %lu of %lu\n", (unsigned long)n,
+			(unsigned long)len);
+		return 1;
+	}
+	for (i = 0; i < len; ++i) {
+		if (efloat64_to_uint64_bits(out[i])
+		    != efloat64_to_uint64_bits(a[i])) {
+			++err;
+			fprintf(stderr, "[%lu] %g != %g\n", (unsigned long)i,
+				out[i], a[i]);
+		}
+	}
+	return err;
+}
+
+int test_efloat64_round_trips(void)
+{
+	size_t lens[] = { 0, 1, 2, 1023, 1024, 1025, Test_array_len };
+	size_t i, used;
+	int kind, err;
+
+	err = 0;
+	for (kind = 0; kind < 4; ++kind) {
+		fill_series(Test_array_len, kind);
+		for (i = 0; i < sizeof(lens) / sizeof(lens[0]); ++i) {
+			err += check_efloat64_round_trip(lens[i], &used);
+		}
+	}
+	return err;
+}
+
+int test_efloat64_size(void)
+{
+	uint8_t xbuf[Test_array_len * 9];
+	struct efloat_xor_encoder enc;
+	size_t used, xor_used;
+	int err;
+
+	err = 0;
+	fill_series(Test_array_len, 0);
+	err += check_efloat64_round_trip(Test_array_len, &used);
+
+	efloat64_xor_encoder_init(&enc, ef_xor_chimp, xbuf, sizeof(xbuf));
+	efloat64_xor_append_array(&enc, a, Test_array_len);
+	xor_used = efloat_xor_encoder_finish(&enc);
+
+	/* the deltas span about 200000 cents, so about 18 bits each */
+	if (used > (Test_array_len * 3) || used >= xor_used) {
+		++err;
+		fprintf(stderr, "alp %lu bytes, chimp %lu bytes\n",
+			(unsigned long)used, (unsigned long)xor_used);
+	}
+	return err;
+}
+
+int test_errors(void)
+{
+	size_t used;
+	int err;
+
+	err = 0;
+	fill_series(Test_array_len, 0);
+	used = efloat64_alp_encode(buf, sizeof(buf), a, Test_array_len);
+
+	/* too small to encode */
+	err += (efloat64_alp_encode(buf, used - 1, a, Test_array_len) != 0);
+	used = efloat64_alp_encode(buf, sizeof(buf), a, Test_array_len);
+
+	/* truncated, too small an output, or the wrong width */
+	err += (efloat64_alp_decode(out, Test_array_len, buf, used - 1) != 0);
+	err += (efloat64_alp_decode(out, Test_array_len - 1, buf, used) != 0);
+	err += (efloat32_alp_decode((efloat32 *)out, Test_array_len, buf,
+				    used) != 0);
+	if (err) {
+		fprintf(stderr, "errors: %d\n", err);
+	}
+	return err;
+}
+
+int test_efloat32_round_trip(void)
+{
+	efloat32 f[Test_array_len], g[Test_array_len];
+	size_t i, n, used;
+	int kind, err;
+
+	err = 0;
+	for (kind = 0; kind < 4; ++kind) {
+		fill_series(Test_array_len, kind);
+		for (i = 0; i < Test_array_len; ++i) {
+			f[i] = (efloat32)a[i];
+		}
+		used = efloat32_alp_encode(buf, sizeof(buf), f,
+					   Test_array_len);
+		n = efloat32_alp_decode(g, Test_array_len, buf, used);
+		err += (used == 0) || (n != Test_array_len);
+		for (i = 0; i < n; ++i) {
+			if (efloat32_to_uint32_bits(f[i])
+			    != efloat32_to_uint32_bits(g[i])) {
+				++err;
+				fprintf(stderr, "[%lu] %g != %g\n",
+					(unsigned long)i, (double)g[i],
+					(double)f[i]);
+			}
+		}
+		if (kind == 0 && used > (Test_array_len * 3)) {
+			++err;
+			fprintf(stderr, "efloat32 %lu bytes\n",
+				(unsigned long)used);
+		}
+	}
+	return err;
+}
+
+int main(void)
+{
+	int err;
+
+	err = 0;
+	err += test_efloat64_round_trips();
+	err += test_efloat64_size();
+	err += test_errors();
+	err += test_efloat32_round_trip();
+
+	if (err) {
+		fprintf(stderr, "%d errors\n", err);
+	}
+	return (err == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,248 @@
+/* SPDX-License-Identifier: LGPL-2.1-or-later */
+/* test-approx.c: test of fast approximate log2, exp2 and 1/sqrt */
+/* Copyright (C) 2026 Eric Herman */
+/* https://github.com/ericherman/libefloat */
+
+#include <float.h>
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "efloat.h"
+#include "test-rng.h"
+
+#define Test_all32_stride 509
+#define Test_random_len 100000
+#define Test_array_len 200
+
+/* the documented worst ulps, of log2, exp2 and rsqrt for each tier */
+static const uint32_t max_ulps32[3][3] = {
+	{ 2943, 4, 3 },
+	{ 9426, 3, 1 },
+	{ 28385, 74, 3 }
+};
+
+static const uint64_t max_ulps64[3][3] = {
+	{ 1600000000000UL, 760000000UL, 3 },
+	{ 5100000000000UL, 1100000000UL, 1 },
+	{ 15300000000000UL, 39000000000UL, 2 }
+};
+
+enum efloat_approx_tier tiers[3] = {
+	ef_approx_coarse, ef_approx_medium, ef_approx_fine
+};
+
+int test_all32(void)
+{
+	uint32_t worst[3][3], u, d;
+	float x, y, r;
+	size_t i, t;
+	int err;
+
+	err = 0;
+	for (i = 0; i < 3; ++i) {
+		for (t = 0; t < 3; ++t) {
+			worst[i][t] = 0;
+		}
+	}
+	for (u = 1; u < 0x7F800000UL; u += Test_all32_stride) {
+		x = uint32_bits_to_efloat32(u);
+		for (t = 0; t < 3; ++t) {
+			y = efloat32_approx_log2(x, tiers[t]);
+			r = (float)log2((double)x);
+			d = efloat32_distance(y, r);
+			worst[0][t] = (d > worst[0][t]) ? d : worst[0][t];
+
+			y = efloat32_approx_rsqrt(x, tiers[t]);
+			r = (float)(1.0 / sqrt((double)x));
+			d = efloat32_distance(y, r);
+			worst[2][t] = (d > worst[2][t]) ? d : worst[2][t];
+
+			/* both signs, within the range of exp2 */
+			x = (float)fmod((double)x, 150.0);
+			x = (u & 0x100) ? -x : x;
+			x = (x >= 128.0f) ? x - 128.0f : x;
+			y = efloat32_approx_exp2(x, tiers[t]);
+			r = (float)exp2((double)x);
+			d = efloat32_distance(y, r);
+			worst[1][t] = (d > worst[1][t]) ? d : worst[1][t];
+			x = uint32_bits_to_efloat32(u);
+		}
+	}
+	for (i = 0; i < 3; ++i) {
+		for (t = 0; t < 3; ++t) {
+			if (worst[i][t] > max_ulps32[i][t]) {
+				fprintf(stderr, "32: function %lu tier %lu:"
+					" %lu ulps\n", (unsigned long)i,
+					(unsigned long)t,
+					(unsigned long)worst[i][t]);
+				++err;
+			}
+		}
+	}
+	return err;
+}
+
+int test_random64(void)
+{
+	uint64_t worst[3][3], u, d;
+	double x, y, r;
+	size_t i, t, j;
+	int err;
+
+	err = 0;
+	for (i = 0; i < 3; ++i) {
+		for (t = 0; t < 3; ++t) {
+			worst[i][t] = 0;
+		}
+	}
+	for (j = 0; j < Test_random_len; ++j) {
+		u = rng() >> 1;
+		if (u >= 0x7FF0000000000000UL || u == 0) {
+			continue;
+		}
+		x = uint64_bits_to_efloat64(u);
+		for (t = 0; t < 3; ++t) {
+			y = efloat64_approx_log2(x, tiers[t]);
+			r = (double)log2l((long double)x);
+			d = efloat64_distance(y, r);
+			worst[0][t] = (d > worst[0][t]) ? d : worst[0][t];
+
+			y = efloat64_approx_rsqrt(x, tiers[t]);
+			r = (double)(1.0L / sqrtl((long double)x));
+			d = efloat64_distance(y, r);
+			worst[2][t] = (d > worst[2][t]) ? d : worst[2][t];
+		}
+		x = ldexp((double)(rng() >> 11), -53) * 2099.0 - 1075.0;
+		for (t = 0; t < 3; ++t) {
+			y = efloat64_approx_exp2(x, tiers[t]);
+			r = (double)exp2l((long double)x);
+			d = efloat64_distance(y, r);
+			worst[1][t] = (d > worst[1][t]) ? d : worst[1][t];
+		}
+	}
+	for (i = 0; i < 3; ++i) {
+		for (t = 0; t < 3; ++t) {
+			if (worst[i][t] > max_ulps64[i][t]) {
+				fprintf(stderr, "64: function %lu tier %lu:"
+					" %lu ulps\n", (unsigned long)i,
+					(unsigned long)t,
+					(unsigned long)worst[i][t]);
+				++err;
+			}
+		}
+	}
+	return err;
+}
+
+/* as the NaNs differ from themselves, compare the bits */
+int diff64(double x, double y)
+{
+	return efloat64_to_uint64_bits(x) != efloat64_to_uint64_bits(y);
+}
+
+int diff32(float x, float y)
+{
+	return efloat32_to_uint32_bits(x) != efloat32_to_uint32_bits(y);
+}
+
+int test_arrays(void)
+{
+	static double d[Test_array_len], dr[Test_array_len];
+	static float f[Test_array_len], fr[Test_array_len];
+	enum efloat_approx_tier tier;
+	size_t i, t;
+	int err;
+
+	err = 0;
+	for (i = 0; i < Test_array_len; ++i) {
+		/* finite values, and some within the range of exp2 */
+		d[i] = uint64_bits_to_efloat64(rng() >> 2);
+		d[i] = (i % 2) ? d[i] : (double)(i % 50) - 25.5;
+		f[i] = (float)d[i];
+	}
+	for (t = 0; t < 3; ++t) {
+		tier = tiers[t];
+		efloat64_array_approx_log2(dr, d, Test_array_len, tier);
+		efloat32_array_approx_exp2(fr, f, Test_array_len, tier);
+		for (i = 0; i < Test_array_len; ++i) {
+			err += diff64(dr[i], efloat64_approx_log2(d[i], tier));
+			err += diff32(fr[i], efloat32_approx_exp2(f[i], tier));
+		}
+		efloat64_array_approx_exp2(dr, d, Test_array_len, tier);
+		efloat32_array_approx_rsqrt(fr, f, Test_array_len, tier);
+		for (i = 0; i < Test_array_len; ++i) {
+			err += diff64(dr[i], efloat64_approx_exp2(d[i], tier));
+			err += diff32(fr[i], efloat32_approx_rsqrt(f[i], tier));
+		}
+		efloat64_array_approx_rsqrt(dr, d, Test_array_len, tier);
+		efloat32_array_approx_log2(fr, f, Test_array_len, tier);
+		for (i = 0; i < Test_array_len; ++i) {
+			err += diff64(dr[i], efloat64_approx_rsqrt(d[i], tier));
+			err += diff32(fr[i], efloat32_approx_log2(f[i], tier));
+		}
+	}
+	if (err) {
+		fprintf(stderr, "arrays: %d errors\n", err);
+	}
+	return err;
+}
+
+int test_specials(void)
+{
+	enum efloat_approx_tier t;
+	int err;
+
+	err = 0;
+	t = ef_approx_coarse;
+	err += efloat64_approx_log2(0.0, t) != -HUGE_VAL;
+	err += efloat64_approx_log2(-0.0, t) != -HUGE_VAL;
+	err += !isnan(efloat64_approx_log2(-1.0, t));
+	err += efloat64_approx_log2(HUGE_VAL, t) != HUGE_VAL;
+	err += efloat64_approx_log2(1.0, t) != 0.0;
+	err += efloat64_approx_log2(0.25, t) != -2.0;
+	err += efloat32_approx_log2(FLT_MIN / 8, t) != -129.0f;
+	err += !isnan(efloat32_approx_log2(nanf(""), t));
+
+	err += efloat64_approx_exp2(HUGE_VAL, t) != HUGE_VAL;
+	err += efloat64_approx_exp2(-HUGE_VAL, t) != 0.0;
+	err += efloat64_approx_exp2(1024.0, t) != HUGE_VAL;
+	err += efloat64_approx_exp2(-1076.0, t) != 0.0;
+	err += efloat64_approx_exp2(-1074.0, t) != DBL_MIN * DBL_EPSILON;
+	err += efloat32_approx_exp2(10.0f, t) != 1024.0f;
+	err += !isnan(efloat64_approx_exp2(nan(""), t));
+
+	err += efloat64_approx_rsqrt(0.0, t) != HUGE_VAL;
+	err += efloat64_approx_rsqrt(-0.0, t) != -HUGE_VAL;
+	err += !isnan(efloat64_approx_rsqrt(-4.0, t));
+	err += efloat64_approx_rsqrt(HUGE_VAL, t) != 0.0;
+	err += efloat32_approx_rsqrt(-0.0f, t) != -HUGE_VALF;
+	err += efloat64_distance(efloat64_approx_rsqrt(DBL_MIN / 64,
+						       ef_approx_fine),
+				 8.0 / sqrt(DBL_MIN)) > 3;
+
+	err += !isnan(efloat64_approx_log2(2.0, (enum efloat_approx_tier)7));
+	err += !isnan(efloat32_approx_rsqrt(2.0f, (enum efloat_approx_tier)3));
+	if (err) {
+		fprintf(stderr, "specials: %d errors\n", err);
+	}
+	return err;
+}
+
+int main(void)
+{
+	int err;
+
+	rng_seed(0xBB67AE8584CAA73BUL);
+	err = 0;
+	err += test_all32();
+	err += test_random64();
+	err += test_arrays();
+	err += test_specials();
+
+	if (err) {
+		fprintf(stderr, "%d errors\n", err);
+	}
+	return (err == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,469 @@
+/* SPDX-License-Identifier: LGPL-2.1-or-later */
+/* test-eft.c: test of error-free transformations and pair arithmetic */
+/* Copyright (C) 2026 Eric Herman */
+/* https://github.com/ericherman/libefloat */
+
+#include <float.h>
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "efloat.h"
+#include "test-rng.h"
+
+#define Test_random_len 20000
+#define Test_array_len 100
+#define Test_sum_len 1000
+
+/* a random double, of magnitude 2^exp_min to 2^(exp_min + exp_span) */
+double rand_double(int exp_min, int exp_span)
+{
+	double d;
+
+	d = ldexp((double)(rng() >> 11), -53);
+	d = ldexp(1.0 + d, exp_min + (int)(rng() % (unsigned)exp_span));
+	return (rng() & 1) ? -d : d;
+}
+
+/* a random pair, the lo at most half an ulp of the hi */
+struct efloat64_pair rand_pair64(int exp_min, int exp_span)
+{
+	struct efloat64_pair x;
+
+	x.hi = rand_double(exp_min, exp_span);
+	x.lo = ldexp(rand_double(-1, 1), ilogb(x.hi) - 53);
+	return x;
+}
+
+struct efloat32_pair rand_pair32(int exp_min, int exp_span)
+{
+	struct efloat32_pair x;
+
+	x.hi = (float)rand_double(exp_min, exp_span);
+	x.lo = (float)ldexp(rand_double(-1, 1), ilogb(x.hi) - 24);
+	return x;
+}
+
+/* the exact residual of the terms and products, rounded to a double */
+double residual64(const double *a, const double *b, size_t len)
+{
+	struct efloat_superacc acc;
+
+	efloat_superacc_zero(&acc);
+	efloat64_superacc_add_products(&acc, a, b, len);
+	return efloat64_superacc_round(&acc, ef_round_nearest_even, NULL);
+}
+
+float residual32(const float *a, const float *b, size_t len)
+{
+	struct efloat_superacc acc;
+
+	efloat_superacc_zero(&acc);
+	efloat32_superacc_add_products(&acc, a, b, len);
+	return efloat32_superacc_round(&acc, ef_round_nearest_even, NULL);
+}
+
+int test_two64(void)
+{
+	double a[4], b[4], s, e;
+	size_t i;
+	int err;
+
+	err = 0;
+	b[0] = 1.0;
+	b[1] = 1.0;
+	b[2] = -1.0;
+	b[3] = -1.0;
+	for (i = 0; i < Test_random_len; ++i) {
+		a[0] = rand_double(-1000, 2000);
+		a[1] = rand_double(-1000, 2000);
+		a[2] = efloat64_two_sum(a[0], a[1], &a[3]);
+		err += residual64(a, b, 4) != 0.0;
+
+		if (fabs(a[0]) < fabs(a[1])) {
+			s = a[0];
+			a[0] = a[1];
+			a[1] = s;
+		}
+		a[2] = efloat64_fast_two_sum(a[0], a[1], &a[3]);
+		err += residual64(a, b, 4) != 0.0;
+	}
+
+	b[1] = -1.0;
+	for (i = 0; i < Test_random_len; ++i) {
+		/* products from both the split and the fma */
+		a[0] = rand_double(-1020, 2040);
+		b[0] = rand_double(-900 - ilogb(a[0]), 1900);
+		if ((i % 8) == 0) {
+			a[0] = ldexp(a[0], -1074 - ilogb(a[0]) + (i % 52));
+			b[0] = rand_double(960, 60);
+		}
+		if (ilogb(a[0]) + ilogb(b[0]) > 1020) {
+			continue;
+		}
+		a[1] = efloat64_two_prod(a[0], b[0], &a[2]);
+		if (residual64(a, b, 3) != 0.0) {
+			++err;
+			fprintf(stderr, "two_prod(%g, %g) = %g + %g\n",
+				a[0], b[0], a[1], a[2]);
+		}
+	}
+
+	s = efloat64_two_sum(HUGE_VAL, 1.0, &e);
+	err += s != HUGE_VAL || e != 0.0;
+	s = efloat64_two_sum(DBL_MAX, DBL_MAX, &e);
+	err += s != HUGE_VAL || e != 0.0;
+	s = efloat64_two_prod(DBL_MAX, 2.0, &e);
+	err += s != HUGE_VAL || e != 0.0;
+	s = efloat64_two_prod(0.0, 2.0, &e);
+	err += s != 0.0 || e != 0.0;
+	if (err) {
+		fprintf(stderr, "two64: %d errors\n", err);
+	}
+	return err;
+}
+
+int test_two32(void)
+{
+	float a[4], b[4];
+	size_t i;
+	int err;
+
+	err = 0;
+	for (i = 0; i < Test_random_len; ++i) {
+		b[0] = 1.0f;
+		b[1] = 1.0f;
+		b[2] = -1.0f;
+		b[3] = -1.0f;
+		a[0] = (float)rand_double(-120, 240);
+		a[1] = (float)rand_double(-120, 240);
+		a[2] = efloat32_two_sum(a[0], a[1], &a[3]);
+		err += residual32(a, b, 4) != 0.0f;
+
+		b[1] = -1.0f;
+		a[0] = (float)rand_double(-125, 250);
+		b[0] = (float)rand_double(-95 - ilogb(a[0]), 200);
+		if (ilogb(a[0]) + ilogb(b[0]) > 125) {
+			continue;
+		}
+		a[1] = efloat32_two_prod(a[0], b[0], &a[2]);
+		err += residual32(a, b, 3) != 0.0f;
+	}
+	if (err) {
+		fprintf(stderr, "two32: %d errors\n", err);
+	}
+	return err;
+}
+
+/* |residual| <= 2^scale * |ref|, and lo is at most half an ulp of hi */
+int check_bound64(const char *name, double r, double ref, int scale,
+		  struct efloat64_pair z)
+{
+	if (fabs(r) > ldexp(fabs(ref), scale)
+	    || fabs(z.lo) > ldexp(fabs(z.hi), -53)) {
+		fprintf(stderr, "%s: %g + %g residual %g\n", name, z.hi, z.lo,
+			r);
+		return 1;
+	}
+	return 0;
+}
+
+int check_bound32(const char *name, float r, float ref, int scale,
+		  struct efloat32_pair z)
+{
+	if (fabs(r) > ldexp(fabs(ref), scale)
+	    || fabs(z.lo) > ldexp(fabs(z.hi), -24)) {
+		fprintf(stderr, "%s: %g + %g residual %g\n", name, z.hi, z.lo,
+			r);
+		return 1;
+	}
+	return 0;
+}
+
+int test_pair64(void)
+{
+	struct efloat64_pair x[Test_array_len], y[Test_array_len];
+	struct efloat64_pair z[Test_array_len], w;
+	double a[6], b[6];
+	size_t i, j;
+	int err;
+
+	err = 0;
+	for (j = 0; j < Test_random_len / Test_array_len; ++j) {
+		for (i = 0; i < Test_array_len; ++i) {
+			x[i] = rand_pair64(-300, 600);
+			y[i] = rand_pair64(-300, 600);
+			if (i % 4 == 0) {
+				/* cancellation in the add */
+				y[i].hi = -x[i].hi;
+				y[i].lo = ldexp(rand_double(-1, 1),
+						ilogb(y[i].hi) - 53);
+			}
+		}
+
+		efloat64_pair_array_add(z, x, y, Test_array_len);
+		for (i = 0; i < 6; ++i) {
+			b[i] = 1.0;
+		}
+		for (i = 0; i < Test_array_len; ++i) {
+			a[0] = x[i].hi;
+			a[1] = x[i].lo;
+			a[2] = y[i].hi;
+			a[3] = y[i].lo;
+			a[4] = -z[i].hi;
+			a[5] = -z[i].lo;
+			err += check_bound64("add", residual64(a, b, 6),
+					     residual64(a, b, 4), -103, z[i]);
+		}
+
+		efloat64_pair_array_mul(z, x, y, Test_array_len);
+		for (i = 0; i < Test_array_len; ++i) {
+			a[0] = x[i].hi;
+			b[0] = y[i].hi;
+			a[1] = x[i].hi;
+			b[1] = y[i].lo;
+			a[2] = x[i].lo;
+			b[2] = y[i].hi;
+			a[3] = x[i].lo;
+			b[3] = y[i].lo;
+			a[4] = -z[i].hi;
+			b[4] = 1.0;
+			a[5] = -z[i].lo;
+			b[5] = 1.0;
+			err += check_bound64("mul", residual64(a, b, 6),
+					     z[i].hi, -102, z[i]);
+		}
+
+		efloat64_pair_array_div(z, x, y, Test_array_len);
+		for (i = 0; i < Test_array_len; ++i) {
+			a[0] = x[i].hi;
+			b[0] = 1.0;
+			a[1] = x[i].lo;
+			b[1] = 1.0;
+			a[2] = -z[i].hi;
+			b[2] = y[i].hi;
+			a[3] = -z[i].hi;
+			b[3] = y[i].lo;
+			a[4] = -z[i].lo;
+			b[4] = y[i].hi;
+			a[5] = -z[i].lo;
+			b[5] = y[i].lo;
+			err += check_bound64("div", residual64(a, b, 6),
+					     x[i].hi, -101, z[i]);
+		}
+
+		for (i = 0; i < Test_array_len; ++i) {
+			x[i].hi = fabs(x[i].hi);
+			x[i].lo = (x[i].lo < 0) ? -x[i].lo : x[i].lo;
+		}
+		efloat64_pair_array_sqrt(z, x, Test_array_len);
+		for (i = 0; i < Test_array_len; ++i) {
+			a[0] = x[i].hi;
+			b[0] = 1.0;
+			a[1] = x[i].lo;
+			b[1] = 1.0;
+			a[2] = -z[i].hi;
+			b[2] = z[i].hi;
+			a[3] = -z[i].hi;
+			b[3] = z[i].lo;
+			a[4] = -z[i].lo;
+			b[4] = z[i].hi;
+			a[5] = -z[i].lo;
+			b[5] = z[i].lo;
+			err += check_bound64("sqrt", residual64(a, b, 6),
+					     x[i].hi, -100, z[i]);
+		}
+	}
+
+	x[0].hi = 1.0;
+	x[0].lo = 0.0;
+	y[0].hi = 0.0;
+	y[0].lo = 0.0;
+	w = efloat64_pair_div(x[0], y[0]);
+	err += w.hi != HUGE_VAL || w.lo != 0.0;
+	x[0].hi = -1.0;
+	w = efloat64_pair_sqrt(x[0]);
+	err += !isnan(w.hi) || w.lo != 0.0;
+	w = efloat64_pair_sqrt(y[0]);
+	err += w.hi != 0.0 || w.lo != 0.0;
+	x[0].hi = DBL_MAX;
+	w = efloat64_pair_add(x[0], x[0]);
+	err += w.hi != HUGE_VAL || w.lo != 0.0;
+	if (err) {
+		fprintf(stderr, "pair64: %d errors\n", err);
+	}
+	return err;
+}
+
+int test_pair32(void)
+{
+	struct efloat32_pair x[Test_array_len], y[Test_array_len];
+	struct efloat32_pair z[Test_array_len];
+	float a[6], b[6];
+	size_t i, j;
+	int err;
+
+	err = 0;
+	for (j = 0; j < Test_random_len / Test_array_len; ++j) {
+		for (i = 0; i < Test_array_len; ++i) {
+			x[i] = rand_pair32(-30, 60);
+			y[i] = rand_pair32(-30, 60);
+		}
+		efloat32_pair_array_add(z, x, y, Test_array_len);
+		for (i = 0; i < 6; ++i) {
+			b[i] = 1.0f;
+		}
+		for (i = 0; i < Test_array_len; ++i) {
+			a[0] = x[i].hi;
+			a[1] = x[i].lo;
+			a[2] = y[i].hi;
+			a[3] = y[i].lo;
+			a[4] = -z[i].hi;
+			a[5] = -z[i].lo;
+			err += check_bound32("add", residual32(a, b, 6),
+					     residual32(a, b, 4), -45, z[i]);
+		}
+
+		efloat32_pair_array_mul(z, x, y, Test_array_len);
+		for (i = 0; i < Test_array_len; ++i) {
+			a[0] = x[i].hi;
+			b[0] = y[i].hi;
+			a[1] = x[i].hi;
+			b[1] = y[i].lo;
+			a[2] = x[i].lo;
+			b[2] = y[i].hi;
+			a[3] = x[i].lo;
+			b[3] = y[i].lo;
+			a[4] = -z[i].hi;
+			b[4] = 1.0f;
+			a[5] = -z[i].lo;
+			b[5] = 1.0f;
+			err += check_bound32("mul", residual32(a, b, 6),
+					     z[i].hi, -44, z[i]);
+		}
+
+		efloat32_pair_array_div(z, x, y, Test_array_len);
+		for (i = 0; i < Test_array_len; ++i) {
+			a[0] = x[i].hi;
+			b[0] = 1.0f;
+			a[1] = x[i].lo;
+			b[1] = 1.0f;
+			a[2] = -z[i].hi;
+			b[2] = y[i].hi;
+			a[3] = -z[i].hi;
+			b[3] = y[i].lo;
+			a[4] = -z[i].lo;
+			b[4] = y[i].hi;
+			a[5] = -z[i].lo;
+			b[5] = y[i].lo;
+			err += check_bound32("div", residual32(a, b, 6),
+					     x[i].hi, -43, z[i]);
+		}
+
+		for (i = 0; i < Test_array_len; ++i) {
+			x[i].hi = (float)fabs(x[i].hi);
+			x[i].lo = (float)fabs(x[i].lo);
+		}
+		efloat32_pair_array_sqrt(z, x, Test_array_len);
+		for (i = 0; i < Test_array_len; ++i) {
+			a[0] = x[i].hi;
+			b[0] = 1.0f;
+			a[1] = x[i].lo;
+			b[1] = 1.0f;
+			a[2] = -z[i].hi;
+			b[2] = z[i].hi;
+			a[3] = -z[i].hi;
+			b[3] = z[i].lo;
+			a[4] = -z[i].lo;
+			b[4] = z[i].hi;
+			a[5] = -z[i].lo;
+			b[5] = z[i].lo;
+			err += check_bound32("sqrt", residual32(a, b, 6),
+					     x[i].hi, -42, z[i]);
+		}
+	}
+	if (err) {
+		fprintf(stderr, "pair32: %d errors\n", err);
+	}
+	return err;
+}
+
+/*
+ Terms and their negations, shuffled, and one term more: the exact sum
+ is that term, which the naive sum loses and the compensated sum keeps.
+*/
+int test_compensated(void)
+{
+	double a[2 * Test_sum_len + 1], b[2 * Test_sum_len + 1], t, c;
+	float f[2 * Test_sum_len + 1], g[2 * Test_sum_len + 1], fc;
+	size_t i, j, k, n;
+	int err;
+
+	err = 0;
+	n = 2 * Test_sum_len + 1;
+	for (j = 0; j < 20; ++j) {
+		for (i = 0; i < Test_sum_len; ++i) {
+			a[2 * i] = rand_double(-10, 20);
+			a[2 * i + 1] = -a[2 * i];
+			b[2 * i] = rand_double(-5, 10);
+			b[2 * i + 1] = b[2 * i];
+			f[2 * i] = (float)rand_double(-5, 10);
+			f[2 * i + 1] = -f[2 * i];
+			g[2 * i] = (float)rand_double(-3, 6);
+			g[2 * i + 1] = g[2 * i];
+		}
+		c = rand_double(0, 1);
+		fc = (float)c;
+		a[n - 1] = c;
+		b[n - 1] = 1.0;
+		f[n - 1] = fc;
+		g[n - 1] = 1.0f;
+		for (i = n - 1; i > 0; --i) {
+			k = rng() % (i + 1);
+			t = a[i];
+			a[i] = a[k];
+			a[k] = t;
+			t = b[i];
+			b[i] = b[k];
+			b[k] = t;
+			t = f[i];
+			f[i] = f[k];
+			f[k] = (float)t;
+			t = g[i];
+			g[i] = g[k];
+			g[k] = (float)t;
+		}
+		err += efloat64_array_dot_compensated(a, b, n) != c;
+		err += efloat32_array_dot_compensated(f, g, n) != fc;
+		for (i = 0; i < n; ++i) {
+			b[i] = 1.0;
+			g[i] = 1.0f;
+		}
+		err += efloat64_array_sum_compensated(a, n) != c;
+		err += efloat32_array_sum_compensated(f, n) != fc;
+		err += efloat64_array_dot_compensated(a, b, n) != c;
+	}
+	if (err) {
+		fprintf(stderr, "compensated: %d errors\n", err);
+	}
+	return err;
+}
+
+int main(void)
+{
+	int err;
+
+	rng_seed(0x9E3779B97F4A7C15UL);
+	err = 0;
+	err += test_two64();
+	err += test_two32();
+	err += test_pair64();
+	err += test_pair32();
+	err += test_compensated();
+
+	if (err) {
+		fprintf(stderr, "%d errors\n", err);
+	}
+	return (err == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,545 @@
+/* SPDX-License-Identifier: LGPL-2.1-or-later */
+/* test-fixed.c: test of the Q format and scaled int8 conversions */
+/* Copyright (C) 2026 Eric Herman */
+/* https://github.com/ericherman/libefloat */
+
+#include <fenv.h>
+#include <float.h>
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "efloat.h"
+#include "test-rng.h"
+
+#define Test_random_len 100000
+#define Test_array_len 150
+#define Test_channels 3
+#define Test_block_len 4096
+
+#ifndef Test_all32_stride
+#define Test_all32_stride 61
+#endif
+
+static const enum efloat_round_mode modes[] = {
+	ef_round_nearest_even, ef_round_toward_zero, ef_round_up,
+	ef_round_down, ef_round_nearest_away, ef_round_odd
+};
+
+#define Modes_len (sizeof(modes) / sizeof(modes[0]))
+
+/* a float of any bits, or of a magnitude near that of a small integer */
+uint32_t rand32(void)
+{
+	uint64_t r;
+
+	r = rng();
+	if (r & 1) {
+		return (uint32_t)(r >> 32);
+	}
+	return ((uint32_t)(r >> 32) & 0x807FFFFFUL)
+	    | ((uint32_t)(127 - 30 + ((r >> 8) % 70)) << 23);
+}
+
+uint64_t rand64(void)
+{
+	uint64_t r;
+
+	r = rng();
+	if (r & 1) {
+		return rng();
+	}
+	return (rng() & 0x800FFFFFFFFFFFFFUL)
+	    | ((uint64_t)(1023 - 30 + ((r >> 8) % 100)) << 52);
+}
+
+#if LDBL_MANT_DIG >= 64
+/*
+ The reference: the exact value (or the nearly exact quotient) rounded
+ by the long double functions, then range checked.
+*/
+long double ref_round(long double v, enum efloat_round_mode mode)
+{
+	long double r;
+
+	switch (mode) {
+	case ef_round_toward_zero:
+		return truncl(v);
+	case ef_round_up:
+		return ceill(v);
+	case ef_round_down:
+		return floorl(v);
+	case ef_round_nearest_away:
+		return roundl(v);
+	case ef_round_odd:
+		r = truncl(v);
+		if (r != v && fmodl(r, 2.0L) == 0.0L) {
+			r += (v < 0) ? -1.0L : 1.0L;
+		}
+		return r;
+	case ef_round_nearest_even:
+	default:
+		return nearbyintl(v);
+	}
+}
+
+long double ref_value(long double v, enum efloat_round_mode mode,
+		      long double min, long double max, unsigned *flags)
+{
+	long double r;
+
+	if (isnan(v)) {
+		*flags = efloat_flag_invalid;
+		return 0;
+	}
+	r = ref_round(v, mode);
+	if (r > max) {
+		*flags = efloat_flag_invalid;
+		r = max;
+	} else if (r < min) {
+		*flags = efloat_flag_invalid;
+		r = min;
+	} else {
+		*flags = (r != v) ? efloat_flag_inexact : 0;
+	}
+	return r;
+}
+
+int64_t ref_int(long double v, enum efloat_round_mode mode, long double min,
+		long double max, unsigned *flags)
+{
+	return (int64_t)ref_value(v, mode, min, max, flags);
+}
+
+int test_q(void)
+{
+	efloat32 f;
+	efloat64 d;
+	int64_t expect;
+	long double max;
+	unsigned got_flags, expect_flags;
+	size_t i, m;
+	int err, frac;
+	unsigned bits;
+
+	err = 0;
+	for (i = 0; i < Test_random_len && err < 10; ++i) {
+		m = i % Modes_len;
+		bits = 2 + (unsigned)(rng() % 31);
+		frac = (int)(rng() % 40) - 8;
+		max = ldexpl(1.0L, (int)bits - 1);
+		f = uint32_bits_to_efloat32(rand32());
+		expect = ref_int(ldexpl(f, frac), modes[m], -max, max - 1,
+				 &expect_flags);
+		got_flags = 0;
+		if (efloat32_to_q(f, bits, frac, modes[m], &got_flags) != expect
+		    || got_flags != expect_flags) {
+			++err;
+			fprintf(stderr, "Q%u.%d %g mode %u: %ld (%x) != %ld"
+				" (%x)\n", bits - 1 - frac, frac, (double)f,
+				(unsigned)m,
+				(long)efloat32_to_q(f, bits, frac, modes[m],
+						    NULL), got_flags,
+				(long)expect, expect_flags);
+		}
+
+		bits = 2 + (unsigned)(rng() % 63);
+		frac = (int)(rng() % 80) - 8;
+		max = ldexpl(1.0L, (int)bits - 1);
+		d = uint64_bits_to_efloat64(rand64());
+		expect = ref_int(ldexpl(d, frac), modes[m], -max, max - 1,
+				 &expect_flags);
+		got_flags = 0;
+		if (efloat64_to_q(d, bits, frac, modes[m], &got_flags) != expect
+		    || got_flags != expect_flags) {
+			++err;
+			fprintf(stderr, "Q%u.%d %g mode %u: %lld (%x) != %lld"
+				" (%x)\n", bits - 1 - frac, frac, d,
+				(unsigned)m,
+				(long long)efloat64_to_q(d, bits, frac,
+							 modes[m], NULL),
+				got_flags, (long long)expect, expect_flags);
+		}
+	}
+	return err;
+}
+
+int test_q_to_float(void)
+{
+	int32_t q32;
+	int64_t q64;
+	size_t i;
+	int err, frac;
+
+	err = 0;
+	for (i = 0; i < Test_random_len && err < 10; ++i) {
+		q32 = (int32_t)(rng() >> (32 + (rng() % 32)));
+		q32 = (rng() & 1) ? q32 : -q32;
+		q64 = (int64_t)(rng() >> (1 + (rng() % 63)));
+		q64 = (rng() & 1) ? q64 : -q64;
+		frac = (int)(rng() % 300) - 100;
+		err += q_to_efloat32(q32, frac) != (float)ldexpl(q32, -frac);
+		err += q_to_efloat64(q64, frac) != (double)ldexpl(q64, -frac);
+	}
+	err += q_to_efloat32(INT32_MIN, 31) != -1.0f;
+	err += q_to_efloat64(INT64_MIN, 63) != -1.0;
+	err += q_to_efloat32(0x7FFFFFFF, 0) != 2147483648.0f;
+	if (err) {
+		fprintf(stderr, "q to float: %d errors\n", err);
+	}
+	return err;
+}
+
+int test_scaled(void)
+{
+	efloat32 scales32[Test_channels] = { 0.05f, 1.0f / 3.0f, 7e-3f };
+	efloat64 scales64[Test_channels] = { 0.05, 1.0 / 3.0, 7e-40 };
+	efloat32 src32[Test_array_len], back32[Test_array_len];
+	efloat64 src64[Test_array_len], back64[Test_array_len];
+	int8_t q[Test_array_len];
+	uint8_t flags[Test_array_len];
+	unsigned expect_flags, all, expect_all;
+	size_t i, m, c;
+	int err;
+
+	err = 0;
+	for (m = 0; m < Modes_len; ++m) {
+		for (i = 0; i < Test_array_len; ++i) {
+			c = i % Test_channels;
+			src32[i] = scales32[c] * (float)((int)(rng() % 400)
+							 - 200) * 0.01f
+			    * (float)(rng() % 101);
+			src64[i] = scales64[c] * (double)((int)(rng() % 300)
+							  - 150)
+			    / (double)(1 + rng() % 7);
+		}
+		src32[0] = (float)HUGE_VAL;
+		src32[1] = -src32[0];
+		src32[2] = src32[0] - src32[0];
+		src64[3] = -0.0;
+
+		all = efloat32_array_to_int8_scaled(q, src32, Test_array_len,
+						    scales32, Test_channels,
+						    modes[m], flags);
+		expect_all = 0;
+		for (i = 0; i < Test_array_len; ++i) {
+			c = i % Test_channels;
+			err += q[i] != ref_int((long double)src32[i]
+					       / scales32[c], modes[m], -128,
+					       127, &expect_flags);
+			err += flags[i] != expect_flags;
+			expect_all |= expect_flags;
+		}
+		err += (all != expect_all);
+		int8_scaled_to_efloat32_array(back32, q, Test_array_len,
+					      scales32, Test_channels);
+		for (i = 0; i < Test_array_len; ++i) {
+			c = i % Test_channels;
+			err += back32[i] != (float)((long double)q[i]
+						    * scales32[c]);
+		}
+
+		all = efloat64_array_to_int8_scaled(q, src64, Test_array_len,
+						    scales64, Test_channels,
+						    modes[m], NULL);
+		expect_all = 0;
+		for (i = 0; i < Test_array_len; ++i) {
+			c = i % Test_channels;
+			err += q[i] != ref_int((long double)src64[i]
+					       / scales64[c], modes[m], -128,
+					       127, &expect_flags);
+			expect_all |= expect_flags;
+		}
+		err += (all != expect_all);
+		int8_scaled_to_efloat64_array(back64, q, Test_array_len,
+					      scales64, Test_channels);
+		for (i = 0; i < Test_array_len; ++i) {
+			c = i % Test_channels;
+			err += back64[i] != (double)((long double)q[i]
+						     * scales64[c]);
+		}
+	}
+	if (err) {
+		fprintf(stderr, "scaled int8: %d errors\n", err);
+	}
+	return err;
+}
+/* the integer types, signed and unsigned, of 8, 16, 32 and 64 bits */
+#define Int_types_len 8
+
+static int8_t out_i8[Test_block_len];
+static uint8_t out_u8[Test_block_len];
+static int16_t out_i16[Test_block_len];
+static uint16_t out_u16[Test_block_len];
+static int32_t out_i32[Test_block_len];
+static uint32_t out_u32[Test_block_len];
+static int64_t out_i64[Test_block_len];
+static uint64_t out_u64[Test_block_len];
+
+unsigned convert_block(size_t type, const efloat32 *src, size_t len,
+		       enum efloat_round_mode mode, uint8_t *flags)
+{
+	switch (type) {
+	case 0:
+		return efloat32_array_to_int8_round(out_i8, src, len, mode,
+						    flags);
+	case 1:
+		return efloat32_array_to_uint8_round(out_u8, src, len, mode,
+						     flags);
+	case 2:
+		return efloat32_array_to_int16_round(out_i16, src, len, mode,
+						     flags);
+	case 3:
+		return efloat32_array_to_uint16_round(out_u16, src, len, mode,
+						      flags);
+	case 4:
+		return efloat32_array_to_int32_round(out_i32, src, len, mode,
+						     flags);
+	case 5:
+		return efloat32_array_to_uint32_round(out_u32, src, len, mode,
+						      flags);
+	case 6:
+		return efloat32_array_to_int64_round(out_i64, src, len, mode,
+						     flags);
+	default:
+		return efloat32_array_to_uint64_round(out_u64, src, len, mode,
+						      flags);
+	}
+}
+
+long double converted(size_t type, size_t i)
+{
+	switch (type) {
+	case 0:
+		return out_i8[i];
+	case 1:
+		return out_u8[i];
+	case 2:
+		return out_i16[i];
+	case 3:
+		return out_u16[i];
+	case 4:
+		return out_i32[i];
+	case 5:
+		return out_u32[i];
+	case 6:
+		return out_i64[i];
+	default:
+		return out_u64[i];
+	}
+}
+
+/*
+ Every Test_all32_stride-th float32 bit pattern is converted, each block
+ to another of the integer types and with another of the rounding
+ modes; build with -DTest_all32_stride=1 to convert every float32.
+*/
+int test_saturate_all32(void)
+{
+	efloat32 src[Test_block_len];
+	uint8_t flags[Test_block_len];
+	uint64_t u, block;
+	uint32_t pattern[Test_block_len];
+	long double min, max, expect;
+	unsigned expect_flags;
+	size_t i, n, type, m;
+	unsigned bits;
+	int err;
+
+	err = 0;
+	block = 0;
+	for (u = 0; u <= 0xFFFFFFFFUL && err < 10; block++) {
+		for (n = 0; n < Test_block_len && u <= 0xFFFFFFFFUL; ++n) {
+			pattern[n] = (uint32_t)u;
+			src[n] = uint32_bits_to_efloat32(pattern[n]);
+			u += Test_all32_stride;
+		}
+		type = block % Int_types_len;
+		m = (block / Int_types_len) % Modes_len;
+		convert_block(type, src, n, modes[m], flags);
+
+		bits = 8U << (type / 2);
+		if (type & 1) {
+			min = 0;
+			max = ldexpl(1.0L, (int)bits) - 1;
+		} else {
+			min = -ldexpl(1.0L, (int)bits - 1);
+			max = -min - 1;
+		}
+		for (i = 0; i < n; ++i) {
+			expect = ref_value(src[i], modes[m], min, max,
+					   &expect_flags);
+			if (converted(type, i) != expect
+			    || flags[i] != expect_flags) {
+				++err;
+				fprintf(stderr, "0x%08lx to type %u mode %u:"
+					" %Lg (%x) != %Lg (%x)\n",
+					(unsigned long)pattern[i],
+					(unsigned)type,
+					(unsigned)m, converted(type, i),
+					(unsigned)flags[i], expect,
+					expect_flags);
+			}
+		}
+	}
+	return err;
+}
+
+int test_saturate64(void)
+{
+	efloat64 src[Test_block_len];
+	int8_t i8[Test_block_len];
+	uint16_t u16[Test_block_len];
+	int32_t i32[Test_block_len];
+	uint64_t u64[Test_block_len];
+	uint8_t flags[Test_block_len];
+	unsigned f;
+	size_t i, m;
+	int err;
+
+	err = 0;
+	for (m = 0; m < Modes_len; ++m) {
+		for (i = 0; i < Test_block_len; ++i) {
+			src[i] = uint64_bits_to_efloat64(rand64());
+		}
+		efloat64_array_to_int8_round(i8, src, Test_block_len, modes[m],
+					     flags);
+		for (i = 0; i < Test_block_len; ++i) {
+			err += i8[i] != ref_value(src[i], modes[m], -128, 127,
+						  &f);
+			err += flags[i] != f;
+		}
+		efloat64_array_to_uint16_round(u16, src, Test_block_len,
+					       modes[m], flags);
+		for (i = 0; i < Test_block_len; ++i) {
+			err += u16[i] != ref_value(src[i], modes[m], 0, 65535,
+						   &f);
+			err += flags[i] != f;
+		}
+		efloat64_array_to_int32_round(i32, src, Test_block_len,
+					      modes[m], NULL);
+		for (i = 0; i < Test_block_len; ++i) {
+			err += i32[i] != ref_value(src[i], modes[m],
+						   -2147483648.0L,
+						   2147483647.0L, &f);
+		}
+		efloat64_array_to_uint64_round(u64, src, Test_block_len,
+					       modes[m], flags);
+		for (i = 0; i < Test_block_len; ++i) {
+			err += u64[i] != ref_value(src[i], modes[m], 0,
+						   18446744073709551615.0L,
+						   &f);
+			err += flags[i] != f;
+		}
+	}
+	if (err) {
+		fprintf(stderr, "saturate64: %d errors\n", err);
+	}
+	return err;
+}
+#else
+int test_saturate_all32(void)
+{
+	return 0;
+}
+
+int test_saturate64(void)
+{
+	return 0;
+}
+
+int test_q(void)
+{
+	return 0;
+}
+
+int test_q_to_float(void)
+{
+	return 0;
+}
+
+int test_scaled(void)
+{
+	return 0;
+}
+#endif
+
+int test_arrays(void)
+{
+	efloat32 src32[Test_array_len], back32[Test_array_len];
+	efloat64 src64[Test_array_len], back64[Test_array_len];
+	int32_t q32[Test_array_len];
+	int64_t q64[Test_array_len];
+	uint8_t flags[Test_array_len];
+	unsigned all, f, expect_all;
+	size_t i;
+	int err;
+
+	err = 0;
+	for (i = 0; i < Test_array_len; ++i) {
+		src32[i] = uint32_bits_to_efloat32(rand32());
+		src64[i] = uint64_bits_to_efloat64(rand64());
+	}
+	all = efloat32_array_to_q(q32, src32, Test_array_len, 16, 8,
+				  ef_round_up, flags);
+	expect_all = 0;
+	for (i = 0; i < Test_array_len; ++i) {
+		f = 0;
+		err += q32[i] != efloat32_to_q(src32[i], 16, 8, ef_round_up,
+					       &f);
+		err += flags[i] != f;
+		expect_all |= f;
+	}
+	err += (all != expect_all);
+	q_to_efloat32_array(back32, q32, Test_array_len, 8);
+	for (i = 0; i < Test_array_len; ++i) {
+		err += back32[i] != q_to_efloat32(q32[i], 8);
+	}
+
+	all = efloat64_array_to_q(q64, src64, Test_array_len, 64, 32,
+				  ef_round_odd, NULL);
+	expect_all = 0;
+	for (i = 0; i < Test_array_len; ++i) {
+		err += q64[i] != efloat64_to_q(src64[i], 64, 32, ef_round_odd,
+					       &expect_all);
+	}
+	err += (all != expect_all);
+	q_to_efloat64_array(back64, q64, Test_array_len, 32);
+	for (i = 0; i < Test_array_len; ++i) {
+		err += back64[i] != q_to_efloat64(q64[i], 32);
+	}
+
+	/* invalid arguments */
+	err += efloat32_array_to_q(q32, src32, 1, 33, 0, ef_round_up, NULL)
+	    != 0;
+	err += efloat64_to_q(1.0, 1, 0, ef_round_up, NULL) != 0;
+	err += int8_scaled_to_efloat32_array(back32, (int8_t *)q32, 1, src32,
+					     0) != 0;
+	back64[0] = -1.0;
+	err += efloat64_array_to_int8_scaled((int8_t *)q64, src64, 1, back64,
+					     1, ef_round_up, NULL) != 0;
+	if (err) {
+		fprintf(stderr, "arrays: %d errors\n", err);
+	}
+	return err;
+}
+
+int main(void)
+{
+	int err;
+
+	rng_seed(0x9E3779B97F4A7C15UL);
+	err = 0;
+	err += test_q();
+	err += test_q_to_float();
+	err += test_scaled();
+	err += test_arrays();
+	err += test_saturate_all32();
+	err += test_saturate64();
+
+	if (err) {
+		fprintf(stderr, "%d errors\n", err);
+	}
+	return (err == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,345 @@
+/* SPDX-License-Identifier: LGPL-2.1-or-later */
+/* test-frexp.c: test of frexp, ldexp, ilogb, logb and copysign */
+/* Copyright (C) 2026 Eric Herman */
+/* https://github.com/ericherman/libefloat */
+
+#include <fenv.h>
+#include <float.h>
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "efloat.h"
+#include "test-rng.h"
+
+#define Test_random_len 100000
+#define Test_block_len 1000
+
+#ifndef Test_all32_stride
+#define Test_all32_stride 61
+#endif
+
+/* a scale which often lands near the subnormals or past infinity */
+int rand_scale(void)
+{
+	uint64_t r;
+
+	r = rng();
+	switch (r % 4) {
+	case 0:
+		return (int)((r >> 8) % 64) - 32;
+	case 1:
+		return (int)((r >> 8) % 700) - 350;
+	case 2:
+		return (int)((r >> 8) % 4400) - 2200;
+	default:
+		return (int)((r >> 8) % 0x7FFFFFFFUL) * ((r & 0x100) ? -1 : 1);
+	}
+}
+
+/* FP_ILOGB0 and FP_ILOGBNAN may be the same, so check the value */
+int ref_ilogb(double d)
+{
+	if (isnan(d)) {
+		return efloat_ilogbnan;
+	}
+	if (isinf(d)) {
+		return INT_MAX;
+	}
+	if (d == 0.0) {
+		return efloat_ilogb0;
+	}
+	return ilogb(d);
+}
+
+#if efloat32_exists
+/* NaN is expected to be quieted, keeping its sign and payload */
+int check32(uint32_t in, float expect, efloat32 got, const char *name,
+	    long arg)
+{
+	uint32_t e, g;
+
+	e = efloat32_to_uint32_bits(expect);
+	g = efloat32_to_uint32_bits(got);
+	if (isnan(expect)) {
+		e = in | 0x00400000UL;
+	}
+	if (e != g) {
+		fprintf(stderr, "%s(0x%08lx, %ld): 0x%08lx != 0x%08lx\n",
+			name, (unsigned long)in, arg, (unsigned long)g,
+			(unsigned long)e);
+		return 1;
+	}
+	return 0;
+}
+
+int check_block32(const uint32_t *pattern, size_t len)
+{
+	static efloat32 src[Test_block_len], sgn[Test_block_len];
+	static efloat32 out[Test_block_len];
+	static int exps[Test_block_len], scales[Test_block_len];
+	size_t i;
+	int err, e, scale;
+	float f;
+
+	err = 0;
+	for (i = 0; i < len; ++i) {
+		src[i] = uint32_bits_to_efloat32(pattern[i]);
+		sgn[i] = uint32_bits_to_efloat32((uint32_t)rng());
+		scales[i] = rand_scale();
+	}
+
+	efloat32_array_frexp(out, exps, src, len);
+	for (i = 0; i < len; ++i) {
+		f = frexpf(src[i], &e);
+		if (isnan(f) || isinf(f)) {
+			e = 0;
+		}
+		err += check32(pattern[i], f, out[i], "frexp", 0);
+		err += (exps[i] != e);
+		err += check32(pattern[i], f, efloat32_frexp(src[i], &e),
+			       "frexp", 0);
+		err += (exps[i] != e);
+	}
+
+	efloat32_array_ldexp(out, src, scales, len);
+	for (i = 0; i < len; ++i) {
+		f = ldexpf(src[i], scales[i]);
+		err += check32(pattern[i], f, out[i], "ldexp", scales[i]);
+		err += check32(pattern[i], f,
+			       efloat32_ldexp(src[i], scales[i]), "ldexp",
+			       scales[i]);
+	}
+
+	scale = rand_scale();
+	efloat32_array_scalbn(out, src, scale, len);
+	for (i = 0; i < len; ++i) {
+		f = scalbnf(src[i], scale);
+		err += check32(pattern[i], f, out[i], "scalbn", scale);
+	}
+
+	efloat32_array_ilogb(exps, src, len);
+	for (i = 0; i < len; ++i) {
+		e = ref_ilogb(src[i]);
+		if (exps[i] != e || efloat32_ilogb(src[i]) != e) {
+			++err;
+			fprintf(stderr, "ilogb(0x%08lx): %d != %d\n",
+				(unsigned long)pattern[i], exps[i], e);
+		}
+	}
+
+	efloat32_array_logb(out, src, len);
+	for (i = 0; i < len; ++i) {
+		f = logbf(src[i]);
+		err += check32(pattern[i], f, out[i], "logb", 0);
+		err += check32(pattern[i], f, efloat32_logb(src[i]), "logb", 0);
+	}
+
+	efloat32_array_copysign(out, src, sgn, len);
+	for (i = 0; i < len; ++i) {
+		f = copysignf(src[i], sgn[i]);
+		err += (efloat32_to_uint32_bits(f)
+			!= efloat32_to_uint32_bits(out[i]));
+		err += (efloat32_to_uint32_bits(f)
+			!= efloat32_to_uint32_bits(efloat32_copysign(src[i],
+								     sgn[i])));
+	}
+	return err;
+}
+
+/*
+ Every Test_all32_stride-th float32 bit pattern is checked, and the
+ patterns nearest the zeros, the subnormals and the infinities; build
+ with -DTest_all32_stride=1 to check every float32.
+*/
+int test_all32(void)
+{
+	uint32_t pattern[Test_block_len];
+	uint64_t u;
+	size_t n, k;
+	int err;
+
+	err = 0;
+	for (u = 0; u <= 0xFFFFFFFFUL && err < 10;) {
+		for (n = 0; n < Test_block_len && u <= 0xFFFFFFFFUL; ++n) {
+			pattern[n] = (uint32_t)u;
+			u += Test_all32_stride;
+		}
+		err += check_block32(pattern, n);
+	}
+	for (k = 0; k < 2; ++k) {
+		for (n = 0; n < Test_block_len / 4; ++n) {
+			pattern[4 * n] = (k ? 0x80000000UL : 0) + n;
+			pattern[4 * n + 1] = (k ? 0x80800000UL : 0x00800000UL)
+			    - 1 - n;
+			pattern[4 * n + 2] = (k ? 0xFF800000UL : 0x7F800000UL)
+			    - n;
+			pattern[4 * n + 3] = (k ? 0xFF800000UL : 0x7F800000UL)
+			    + n;
+		}
+		err += check_block32(pattern, Test_block_len);
+	}
+	if (err) {
+		fprintf(stderr, "all32: %d errors\n", err);
+	}
+	return err;
+}
+#else
+int test_all32(void)
+{
+	return 0;
+}
+#endif
+
+#if efloat64_exists
+int check64(uint64_t in, double expect, efloat64 got, const char *name,
+	    long arg)
+{
+	uint64_t e, g;
+
+	e = efloat64_to_uint64_bits(expect);
+	g = efloat64_to_uint64_bits(got);
+	if (isnan(expect)) {
+		e = in | 0x0008000000000000UL;
+	}
+	if (e != g) {
+		fprintf(stderr, "%s(0x%016llx, %ld): 0x%016llx != 0x%016llx\n",
+			name, (unsigned long long)in, arg,
+			(unsigned long long)g, (unsigned long long)e);
+		return 1;
+	}
+	return 0;
+}
+
+/* random bits, or a subnormal, or a value near the largest exponents */
+uint64_t rand64(void)
+{
+	uint64_t r;
+
+	r = rng();
+	switch (r % 4) {
+	case 0:
+		return (rng() & 0x800FFFFFFFFFFFFFUL) >> ((r >> 8) % 52);
+	case 1:
+		return (rng() & 0x800FFFFFFFFFFFFFUL)
+		    | ((uint64_t)(2047 - ((r >> 8) % 4)) << 52);
+	default:
+		return rng();
+	}
+}
+
+int test_random64(void)
+{
+	efloat64 src[Test_block_len], sgn[Test_block_len];
+	efloat64 out[Test_block_len], out2[Test_block_len];
+	int exps[Test_block_len], scales[Test_block_len];
+	uint64_t pattern[Test_block_len];
+	size_t i, j;
+	int err, e, scale;
+	double d;
+
+	err = 0;
+	for (j = 0; j < Test_random_len / Test_block_len && err < 10; ++j) {
+		for (i = 0; i < Test_block_len; ++i) {
+			pattern[i] = rand64();
+			src[i] = uint64_bits_to_efloat64(pattern[i]);
+			sgn[i] = uint64_bits_to_efloat64(rng());
+			scales[i] = rand_scale();
+		}
+		efloat64_array_frexp(out, exps, src, Test_block_len);
+		efloat64_array_ldexp(out2, src, scales, Test_block_len);
+		for (i = 0; i < Test_block_len; ++i) {
+			d = frexp(src[i], &e);
+			if (isnan(d) || isinf(d)) {
+				e = 0;
+			}
+			err += check64(pattern[i], d, out[i], "frexp", 0);
+			err += (exps[i] != e);
+			d = ldexp(src[i], scales[i]);
+			err += check64(pattern[i], d, out2[i], "ldexp",
+				       scales[i]);
+		}
+		scale = rand_scale();
+		efloat64_array_scalbn(out, src, scale, Test_block_len);
+		efloat64_array_logb(out2, src, Test_block_len);
+		for (i = 0; i < Test_block_len; ++i) {
+			d = scalbn(src[i], scale);
+			err += check64(pattern[i], d, out[i], "scalbn", scale);
+			d = logb(src[i]);
+			err += check64(pattern[i], d, out2[i], "logb", 0);
+			err += check64(pattern[i], d, efloat64_logb(src[i]),
+				       "logb", 0);
+		}
+		efloat64_array_ilogb(exps, src, Test_block_len);
+		efloat64_array_copysign(out, src, sgn, Test_block_len);
+		for (i = 0; i < Test_block_len; ++i) {
+			e = ref_ilogb(src[i]);
+			err += (exps[i] != e);
+			err += (efloat64_ilogb(src[i]) != e);
+			d = copysign(src[i], sgn[i]);
+			err += (efloat64_to_uint64_bits(d)
+				!= efloat64_to_uint64_bits(out[i]));
+		}
+	}
+	if (err) {
+		fprintf(stderr, "random64: %d errors\n", err);
+	}
+	return err;
+}
+
+int test_specials64(void)
+{
+	int err, e;
+
+	err = 0;
+	err += efloat64_ilogb(0.0) != efloat_ilogb0;
+	err += efloat64_ilogb(-DBL_MIN) != DBL_MIN_EXP - 1;
+	err += efloat64_ilogb(DBL_MAX) != DBL_MAX_EXP - 1;
+	err += efloat64_frexp(-DBL_MIN / 4, &e) != -0.5;
+	err += e != DBL_MIN_EXP - 2;
+	/* half of the smallest subnormal, then one and a half, are ties */
+	err += efloat64_ldexp(0.5, DBL_MIN_EXP - DBL_MANT_DIG) != 0.0;
+	err += efloat64_ldexp(0.75, DBL_MIN_EXP - DBL_MANT_DIG + 1)
+	    != 2 * DBL_MIN * DBL_EPSILON;
+	err += efloat64_ldexp(DBL_MIN * DBL_EPSILON, INT_MAX) != HUGE_VAL;
+	err += efloat64_ldexp(-DBL_MAX, INT_MIN) != 0.0;
+	err += efloat64_scalbn(1.0, DBL_MAX_EXP) != HUGE_VAL;
+	err += efloat64_logb(-0.0) != -HUGE_VAL;
+	err += efloat64_logb(-HUGE_VAL) != HUGE_VAL;
+	err += efloat64_copysign(HUGE_VAL, -0.0) != -HUGE_VAL;
+	if (err) {
+		fprintf(stderr, "specials64: %d errors\n", err);
+	}
+	return err;
+}
+#else
+int test_random64(void)
+{
+	return 0;
+}
+
+int test_specials64(void)
+{
+	return 0;
+}
+#endif
+
+int main(void)
+{
+	int err;
+
+	/* ldexp() rounds ties to even, whatever the mode */
+	fesetround(FE_TONEAREST);
+
+	rng_seed(0x9E3779B97F4A7C15UL);
+	err = 0;
+	err += test_all32();
+	err += test_random64();
+	err += test_specials64();
+
+	if (err) {
+		fprintf(stderr, "%d errors\n", err);
+	}
+	return (err == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,200 @@
+/* SPDX-License-Identifier: LGPL-2.1-or-later */
+/* test-hash.c: test of canonicalizing hashes */
+/* Copyright (C) 2026 Eric Herman */
+/* https://github.com/ericherman/libefloat */
+
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "efloat.h"
+#include "test-rng.h"
+
+#define Test_random_len 20000
+#define Test_array_len 200
+#define Test_buckets 256
+
+/* often a zero or a NaN with a random sign and payload */
+uint64_t rand_bits64(void)
+{
+	uint64_t u;
+
+	u = rng();
+	switch (u % 4) {
+	case 0:
+		u &= 0x8000000000000000UL;
+		break;
+	case 1:
+		u |= 0x7FF0000000000001UL;
+		break;
+	default:
+		break;
+	}
+	return u;
+}
+
+int test_scalar64(void)
+{
+	uint64_t u, v, seed;
+	double x, y;
+	size_t i;
+	int err, same;
+
+	err = 0;
+	for (i = 0; i < Test_random_len; ++i) {
+		u = rand_bits64();
+		v = (i % 2) ? rand_bits64() : (u ^ 0x8000000000000000UL);
+		x = uint64_bits_to_efloat64(u);
+		y = uint64_bits_to_efloat64(v);
+		seed = rng();
+
+		same = (x == y) || (isnan(x) && isnan(y));
+		err += same != (efloat64_hash(x, seed, ef_hash_ieee)
+				== efloat64_hash(y, seed, ef_hash_ieee));
+		err += (u == v) != (efloat64_hash(x, seed, ef_hash_bitwise)
+				    == efloat64_hash(y, seed, ef_hash_bitwise));
+		err += efloat64_hash(x, seed, ef_hash_ieee)
+		    == efloat64_hash(x, seed + 1, ef_hash_ieee);
+
+		/* the canonical value is equal, and hashes the same bitwise */
+		y = efloat64_canonical(x);
+		err += !(x == y || (isnan(x) && isnan(y)));
+		err += signbit(y) && (y == 0.0 || isnan(y));
+		err += efloat64_hash(x, seed, ef_hash_ieee)
+		    != efloat64_hash(y, seed, ef_hash_bitwise);
+	}
+	if (err) {
+		fprintf(stderr, "scalar64: %d errors\n", err);
+	}
+	return err;
+}
+
+int test_scalar32(void)
+{
+	uint32_t u, v;
+	float x, y;
+	size_t i;
+	int err, same;
+
+	err = 0;
+	for (i = 0; i < Test_random_len; ++i) {
+		u = (uint32_t)(rand_bits64() >> 32);
+		v = (i % 2) ? (uint32_t)(rand_bits64() >> 32)
+		    : (u ^ 0x80000000UL);
+		x = uint32_bits_to_efloat32(u);
+		y = uint32_bits_to_efloat32(v);
+
+		same = (x == y) || (isnan(x) && isnan(y));
+		err += same != (efloat32_hash(x, 0, ef_hash_ieee)
+				== efloat32_hash(y, 0, ef_hash_ieee));
+		err += (u == v) != (efloat32_hash(x, 0, ef_hash_bitwise)
+				    == efloat32_hash(y, 0, ef_hash_bitwise));
+
+		y = efloat32_canonical(x);
+		err += !(x == y || (isnan(x) && isnan(y)));
+		err += signbit(y) && (y == 0.0f || isnan(y));
+		err += efloat32_hash(x, 0, ef_hash_ieee)
+		    != efloat32_hash(y, 0, ef_hash_bitwise);
+	}
+	if (err) {
+		fprintf(stderr, "scalar32: %d errors\n", err);
+	}
+	return err;
+}
+
+int test_arrays(void)
+{
+	static double d[Test_array_len], dc[Test_array_len];
+	static float f[Test_array_len], fc[Test_array_len];
+	static uint64_t h[Test_array_len];
+	enum efloat_hash_mode mode;
+	uint64_t seed;
+	size_t i, j, len;
+	int err;
+
+	err = 0;
+	for (j = 0; j < 20; ++j) {
+		len = 1 + (rng() % Test_array_len);
+		seed = rng();
+		mode = (j % 2) ? ef_hash_bitwise : ef_hash_ieee;
+		for (i = 0; i < len; ++i) {
+			d[i] = uint64_bits_to_efloat64(rand_bits64());
+			f[i] = uint32_bits_to_efloat32((uint32_t)
+						       (rand_bits64() >> 32));
+		}
+		efloat64_array_hash(h, d, len, seed, mode);
+		for (i = 0; i < len; ++i) {
+			err += h[i] != efloat64_hash(d[i], seed, mode);
+		}
+		efloat32_array_hash(h, f, len, seed, mode);
+		for (i = 0; i < len; ++i) {
+			err += h[i] != efloat32_hash(f[i], seed, mode);
+		}
+		efloat64_array_canonical(dc, d, len);
+		efloat32_array_canonical(fc, f, len);
+		for (i = 0; i < len; ++i) {
+			err += efloat64_to_uint64_bits(dc[i])
+			    != efloat64_to_uint64_bits(efloat64_canonical
+						       (d[i]));
+			err += efloat32_to_uint32_bits(fc[i])
+			    != efloat32_to_uint32_bits(efloat32_canonical
+						       (f[i]));
+		}
+	}
+	if (err) {
+		fprintf(stderr, "arrays: %d errors\n", err);
+	}
+	return err;
+}
+
+/* the low bits of the hashes of consecutive integers are spread evenly */
+int test_spread(void)
+{
+	static double d[Test_random_len];
+	static uint64_t h[Test_random_len];
+	unsigned count[Test_buckets];
+	double expect, chi2;
+	size_t i;
+	int err;
+
+	err = 0;
+	for (i = 0; i < Test_buckets; ++i) {
+		count[i] = 0;
+	}
+	for (i = 0; i < Test_random_len; ++i) {
+		d[i] = (double)i;
+	}
+	efloat64_array_hash(h, d, Test_random_len, 0, ef_hash_ieee);
+	for (i = 0; i < Test_random_len; ++i) {
+		++count[h[i] % Test_buckets];
+	}
+	expect = (double)Test_random_len / Test_buckets;
+	chi2 = 0.0;
+	for (i = 0; i < Test_buckets; ++i) {
+		chi2 += (count[i] - expect) * (count[i] - expect) / expect;
+	}
+	/* well beyond the 0.1% tail of 255 degrees of freedom, about 330 */
+	if (chi2 > 400.0) {
+		fprintf(stderr, "spread: chi squared %g\n", chi2);
+		++err;
+	}
+	return err;
+}
+
+int main(void)
+{
+	int err;
+
+	rng_seed(0x853C49E6748FEA9BUL);
+	err = 0;
+	err += test_scalar64();
+	err += test_scalar32();
+	err += test_arrays();
+	err += test_spread();
+
+	if (err) {
+		fprintf(stderr, "%d errors\n", err);
+	}
+	return (err == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
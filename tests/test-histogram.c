@@ -0,0 +1,261 @@
+/* SPDX-License-Identifier: LGPL-2.1-or-later */
+/* test-histogram.c: test of log bucketed histograms */
+/* Copyright (C) 2026 Eric Herman */
+/* https://github.com/ericherman/libefloat */
+
+#include <float.h>
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "efloat.h"
+#include "test-rng.h"
+
+#define Test_values_len 5000
+#define Test_exp_min -20
+#define Test_exp_max 20
+#define Test_counts_len (41 << 12)
+
+/* spread evenly over the exponents, a few of them out of range */
+double rand_log(void)
+{
+	double frac;
+
+	frac = ldexp((double)(rng() >> 11), -53);
+	return exp2(frac * 46.0 - 23.0);
+}
+
+int compare_doubles(const void *a, const void *b)
+{
+	double x, y;
+
+	x = *(const double *)a;
+	y = *(const double *)b;
+	return (x < y) ? -1 : (x > y) ? 1 : 0;
+}
+
+static uint64_t counts[Test_counts_len];
+static uint64_t counts2[Test_counts_len];
+static double values[Test_values_len];
+static double sorted[Test_values_len];
+
+int test_quantiles(unsigned sub_bits)
+{
+	struct efloat_histogram h;
+	const double qs[] = {
+		0.0, 0.001, 0.1, 0.25, 0.5, 0.75, 0.9, 0.99, 1.0
+	};
+	double q, got, want, lo, hi, rel;
+	size_t i, rank, len;
+	int err;
+
+	err = 0;
+	len = efloat_histogram_len(sub_bits, Test_exp_min, Test_exp_max);
+	if (!efloat_histogram_init(&h, counts, len, sub_bits, Test_exp_min,
+				   Test_exp_max)) {
+		fprintf(stderr, "sub_bits %u: init failed\n", sub_bits);
+		return 1;
+	}
+	for (i = 0; i < Test_values_len; ++i) {
+		values[i] = rand_log();
+		sorted[i] = values[i];
+	}
+	/* half one at a time, half as an array */
+	for (i = 0; i < Test_values_len / 2; ++i) {
+		efloat64_histogram_record(&h, values[i]);
+	}
+	efloat64_histogram_record_array(&h, values + Test_values_len / 2,
+					Test_values_len - Test_values_len / 2);
+	qsort(sorted, Test_values_len, sizeof(double), compare_doubles);
+
+	err += efloat_histogram_count(&h) != Test_values_len;
+	lo = ldexp(1.0, Test_exp_min);
+	hi = ldexp(1.0, Test_exp_max + 1);
+	for (i = 0; i < sizeof(qs) / sizeof(qs[0]); ++i) {
+		q = qs[i];
+		rank = (size_t)ceil(q * Test_values_len);
+		rank = (rank == 0) ? 1 : rank;
+		want = sorted[rank - 1];
+		got = efloat_histogram_quantile(&h, q);
+		if (want < lo) {
+			err += got != lo;
+		} else if (want >= hi) {
+			err += got != hi;
+		} else {
+			rel = fabs(got - want) / want;
+			if (rel > ldexp(1.0, -(int)(sub_bits + 1))) {
+				fprintf(stderr, "sub_bits %u, q %g: got %g,"
+					" want %g\n", sub_bits, q, got, want);
+				++err;
+			}
+		}
+	}
+	if (err) {
+		fprintf(stderr, "quantiles %u: %d errors\n", sub_bits, err);
+	}
+	return err;
+}
+
+int test_merge(void)
+{
+	struct efloat_histogram whole, part, snap;
+	static uint64_t counts3[Test_counts_len];
+	size_t i, len;
+	int err;
+
+	err = 0;
+	len = efloat_histogram_len(7, Test_exp_min, Test_exp_max);
+	efloat_histogram_init(&whole, counts, len, 7, Test_exp_min,
+			      Test_exp_max);
+	efloat_histogram_init(&part, counts2, len, 7, Test_exp_min,
+			      Test_exp_max);
+	efloat_histogram_init(&snap, counts3, len, 7, Test_exp_min,
+			      Test_exp_max);
+	for (i = 0; i < Test_values_len; ++i) {
+		values[i] = (i % 100) ? rand_log() : nan("");
+	}
+	efloat64_histogram_record_array(&whole, values, Test_values_len);
+	efloat64_histogram_record_array(&snap, values, Test_values_len / 3);
+	efloat64_histogram_record_array(&part, values + Test_values_len / 3,
+					Test_values_len - Test_values_len / 3);
+	efloat_histogram_merge(&snap, &part);
+	for (i = 0; i < len; ++i) {
+		err += snap.counts[i] != whole.counts[i];
+	}
+	err += snap.below != whole.below || snap.above != whole.above;
+	err += snap.nan != whole.nan || whole.nan != Test_values_len / 100;
+
+	efloat_histogram_init(&snap, counts3, len, 7, Test_exp_min,
+			      Test_exp_max);
+	efloat_histogram_snapshot(&snap, &whole);
+	for (i = 0; i < len; ++i) {
+		err += snap.counts[i] != whole.counts[i];
+	}
+	err += snap.below != whole.below || snap.above != whole.above;
+	err += snap.nan != whole.nan;
+	err += efloat_histogram_quantile(&snap, 0.5)
+	    != efloat_histogram_quantile(&whole, 0.5);
+
+	/* different shapes are left alone */
+	efloat_histogram_init(&part, counts2, len, 6, Test_exp_min,
+			      Test_exp_max);
+	efloat_histogram_merge(&part, &whole);
+	err += efloat_histogram_count(&part) != 0;
+	efloat_histogram_snapshot(&part, &whole);
+	err += efloat_histogram_count(&part) != 0;
+	if (err) {
+		fprintf(stderr, "merge: %d errors\n", err);
+	}
+	return err;
+}
+
+int test_edges(void)
+{
+	struct efloat_histogram h;
+	float f[4];
+	size_t len;
+	int err;
+
+	err = 0;
+	len = efloat_histogram_len(3, -1, 1);
+	err += len != 24;
+	err += efloat_histogram_init(&h, counts, len, 3, -1, 1) != &h;
+	err += !isnan(efloat_histogram_quantile(&h, 0.5));
+
+	efloat64_histogram_record(&h, 0.0);
+	efloat64_histogram_record(&h, -0.0);
+	efloat64_histogram_record(&h, -3.0);
+	efloat64_histogram_record(&h, 0.4999);
+	efloat64_histogram_record(&h, DBL_MIN / 2);
+	efloat64_histogram_record(&h, -HUGE_VAL);
+	err += h.below != 6;
+	efloat64_histogram_record(&h, 4.0);
+	efloat64_histogram_record(&h, HUGE_VAL);
+	err += h.above != 2;
+	efloat64_histogram_record(&h, nan(""));
+	efloat64_histogram_record(&h, -nan(""));
+	err += h.nan != 2;
+	err += efloat_histogram_count(&h) != 8;
+	err += efloat_histogram_quantile(&h, 0.0) != 0.5;
+	err += efloat_histogram_quantile(&h, 1.0) != 4.0;
+
+	/* the first and last buckets, from both widths */
+	f[0] = 0.5f;
+	f[1] = 3.9999f;
+	f[2] = 1.0f;
+	f[3] = 1.1f;
+	efloat32_histogram_record_array(&h, f, 3);
+	efloat32_histogram_record(&h, f[3]);
+	err += h.counts[0] != 1 || h.counts[23] != 1;
+	err += h.counts[8] != 2;
+	err += efloat_histogram_count(&h) != 12;
+	/* rank 7 is 0.5, in the bucket [0.5, 0.5625) */
+	err += efloat_histogram_quantile(&h, 6.5 / 12) != 0.53125;
+	err += efloat_histogram_quantile(&h, 8.5 / 12) != 1.0625;
+	err += efloat_histogram_quantile(&h, 9.5 / 12) != 3.875;
+
+	err += !isnan(efloat_histogram_quantile(&h, -0.1));
+	err += !isnan(efloat_histogram_quantile(&h, 1.5));
+	err += !isnan(efloat_histogram_quantile(&h, nan("")));
+
+	/* sub_bits of zero is one bucket per binade */
+	efloat_histogram_init(&h, counts, 3, 0, 0, 2);
+	efloat64_histogram_record(&h, 5.0);
+	err += efloat_histogram_quantile(&h, 0.5) != 6.0;
+
+	/* the whole range, where the top is inf */
+	len = efloat_histogram_len(0, -1022, 1023);
+	err += efloat_histogram_init(&h, counts, len, 0, -1022, 1023) != &h;
+	efloat64_histogram_record(&h, DBL_MAX);
+	efloat64_histogram_record(&h, HUGE_VAL);
+	err += h.counts[len - 1] != 1 || h.above != 1;
+	err += efloat_histogram_quantile(&h, 0.0) != 1.5 * ldexp(1.0, 1023);
+	err += efloat_histogram_quantile(&h, 1.0) != HUGE_VAL;
+	if (err) {
+		fprintf(stderr, "edges: %d errors\n", err);
+	}
+	return err;
+}
+
+int test_invalid(void)
+{
+	struct efloat_histogram h;
+	size_t len;
+	int err;
+
+	err = 0;
+	len = Test_counts_len;
+	err += efloat_histogram_init(&h, NULL, len, 3, -1, 1) != NULL;
+	err += efloat_histogram_init(&h, counts, 23, 3, -1, 1) != NULL;
+	err += efloat_histogram_init(&h, counts, len, 21, -1, 1) != NULL;
+	err += efloat_histogram_init(&h, counts, len, 3, 1, -1) != NULL;
+	err += efloat_histogram_init(&h, counts, len, 3, -1023, 1) != NULL;
+	err += efloat_histogram_init(&h, counts, len, 3, -1, 1024) != NULL;
+	err += efloat_histogram_init(&h, counts, len, 17, 0, 0) != &h;
+	err += h.len != ((size_t)1 << 17);
+	if (err) {
+		fprintf(stderr, "invalid: %d errors\n", err);
+	}
+	return err;
+}
+
+int main(void)
+{
+	int err;
+
+	rng_seed(0x3C6EF372FE94F82BUL);
+	err = 0;
+	err += test_quantiles(0);
+	err += test_quantiles(3);
+	err += test_quantiles(7);
+	err += test_quantiles(12);
+	err += test_merge();
+	err += test_edges();
+	err += test_invalid();
+
+	if (err) {
+		fprintf(stderr, "%d errors\n", err);
+	}
+	return (err == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
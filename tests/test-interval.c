@@ -0,0 +1,450 @@
+/* SPDX-License-Identifier: LGPL-2.1-or-later */
+/* test-interval.c: test of interval arithmetic with outward rounding */
+/* Copyright (C) 2026 Eric Herman */
+/* https://github.com/ericherman/libefloat */
+
+#include <float.h>
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "efloat.h"
+#include "test-rng.h"
+
+#define Test_random_len 20000
+#define Test_array_len 100
+
+double rand_double(int exp_min, int exp_span)
+{
+	double d;
+
+	d = ldexp((double)(rng() >> 11), -53);
+	d = ldexp(1.0 + d, exp_min + (int)(rng() % (unsigned)exp_span));
+	return (rng() & 1) ? -d : d;
+}
+
+/* a point, a narrow interval, a wide one, or one around zero */
+struct efloat64_interval rand_interval64(int exp_min, int exp_span)
+{
+	struct efloat64_interval x;
+	double t;
+
+	x.lo = rand_double(exp_min, exp_span);
+	switch (rng() % 4) {
+	case 0:
+		x.hi = x.lo;
+		break;
+	case 1:
+		x.hi = x.lo + ldexp(fabs(x.lo), -(int)(rng() % 50));
+		break;
+	case 2:
+		x.hi = rand_double(exp_min, exp_span);
+		break;
+	default:
+		x.hi = ldexp(fabs(x.lo), -(int)(rng() % 5));
+		x.lo = -fabs(x.lo);
+		break;
+	}
+	if (x.hi < x.lo) {
+		t = x.lo;
+		x.lo = x.hi;
+		x.hi = t;
+	}
+	return x;
+}
+
+struct efloat32_interval rand_interval32(void)
+{
+	struct efloat64_interval d;
+	struct efloat32_interval f;
+
+	d = rand_interval64(-60, 120);
+	f.lo = (float)d.lo;
+	f.hi = (float)d.hi;
+	return f;
+}
+
+/* the sign of the exact sum of the products */
+int sign64(const double *a, const double *b, size_t len)
+{
+	struct efloat_superacc acc;
+	double r;
+
+	efloat_superacc_zero(&acc);
+	efloat64_superacc_add_products(&acc, a, b, len);
+	r = efloat64_superacc_round(&acc, ef_round_nearest_even, NULL);
+	return (r > 0) - (r < 0);
+}
+
+int sign32(const float *a, const float *b, size_t len)
+{
+	struct efloat_superacc acc;
+	float r;
+
+	efloat_superacc_zero(&acc);
+	efloat32_superacc_add_products(&acc, a, b, len);
+	r = efloat32_superacc_round(&acc, ef_round_nearest_even, NULL);
+	return (r > 0) - (r < 0);
+}
+
+/* whether p + sp * q is within z, for sp of 1 or -1 */
+int sum_within64(double p, double q, double sp, struct efloat64_interval z)
+{
+	double a[3], b[3];
+
+	a[0] = p;
+	b[0] = 1.0;
+	a[1] = q;
+	b[1] = sp;
+	a[2] = z.lo;
+	b[2] = -1.0;
+	if (sign64(a, b, 3) < 0) {
+		return 0;
+	}
+	a[2] = z.hi;
+	return sign64(a, b, 3) <= 0;
+}
+
+int prod_within64(double p, double q, struct efloat64_interval z)
+{
+	double a[2], b[2];
+
+	a[0] = p;
+	b[0] = q;
+	a[1] = z.lo;
+	b[1] = -1.0;
+	if (sign64(a, b, 2) < 0) {
+		return 0;
+	}
+	a[1] = z.hi;
+	return sign64(a, b, 2) <= 0;
+}
+
+/* lo <= p / q <= hi, as lo * q <= p <= hi * q for q > 0 */
+int quot_within64(double p, double q, struct efloat64_interval z)
+{
+	double a[2], b[2];
+	int s;
+
+	s = (q > 0) ? 1 : -1;
+	a[0] = p;
+	b[0] = 1.0;
+	a[1] = z.lo;
+	b[1] = -q;
+	if (s * sign64(a, b, 2) < 0) {
+		return 0;
+	}
+	a[1] = z.hi;
+	return s * sign64(a, b, 2) <= 0;
+}
+
+/* lo * lo <= p <= hi * hi */
+int sqrt_within64(double p, struct efloat64_interval z)
+{
+	double a[2], b[2];
+
+	a[0] = p;
+	b[0] = 1.0;
+	a[1] = -z.lo;
+	b[1] = z.lo;
+	if (sign64(a, b, 2) < 0) {
+		return 0;
+	}
+	a[1] = -z.hi;
+	b[1] = z.hi;
+	return sign64(a, b, 2) <= 0;
+}
+
+/* the bounds, and a point between them */
+void points64(struct efloat64_interval x, double *p)
+{
+	p[0] = x.lo;
+	p[1] = x.hi;
+	p[2] = x.lo / 2 + x.hi / 2;
+	if (p[2] < x.lo || p[2] > x.hi) {
+		p[2] = x.lo;
+	}
+}
+
+int test_interval64(void)
+{
+	struct efloat64_interval x[Test_array_len], y[Test_array_len];
+	struct efloat64_interval s[Test_array_len], d[Test_array_len];
+	struct efloat64_interval m[Test_array_len], q[Test_array_len];
+	struct efloat64_interval r[Test_array_len];
+	double p[3], v[3];
+	size_t i, j, k, l;
+	int err;
+
+	err = 0;
+	for (j = 0; j < Test_random_len / Test_array_len; ++j) {
+		for (i = 0; i < Test_array_len; ++i) {
+			x[i] = rand_interval64(-300, 600);
+			y[i] = rand_interval64(-300, 600);
+			if (i % 8 == 0) {
+				/* bounds near the subnormals */
+				x[i].lo = ldexp(x[i].lo, -720);
+				x[i].hi = ldexp(x[i].hi, -720);
+			}
+		}
+		efloat64_interval_array_add(s, x, y, Test_array_len);
+		efloat64_interval_array_sub(d, x, y, Test_array_len);
+		efloat64_interval_array_mul(m, x, y, Test_array_len);
+		efloat64_interval_array_div(q, x, y, Test_array_len);
+		for (i = 0; i < Test_array_len; ++i) {
+			points64(x[i], p);
+			points64(y[i], v);
+			for (k = 0; k < 3; ++k) {
+				for (l = 0; l < 3; ++l) {
+					err += !sum_within64(p[k], v[l], 1.0,
+							     s[i]);
+					err += !sum_within64(p[k], v[l], -1.0,
+							     d[i]);
+					err += !prod_within64(p[k], v[l], m[i]);
+					if (y[i].lo > 0 || y[i].hi < 0) {
+						err += !quot_within64(p[k],
+								      v[l],
+								      q[i]);
+					}
+				}
+			}
+			if (x[i].lo == x[i].hi && y[i].lo == y[i].hi) {
+				/* one ulp each way of a point */
+				err += s[i].hi
+				    > efloat64_next_up(efloat64_next_up
+						       (s[i].lo));
+				err += m[i].hi
+				    > efloat64_next_up(efloat64_next_up
+						       (m[i].lo));
+			}
+		}
+
+		for (i = 0; i < Test_array_len; ++i) {
+			x[i].hi = fabs(x[i].hi);
+			x[i].lo = (x[i].lo < 0) ? 0.0 : x[i].lo;
+		}
+		efloat64_interval_array_sqrt(r, x, Test_array_len);
+		for (i = 0; i < Test_array_len; ++i) {
+			points64(x[i], p);
+			for (k = 0; k < 3; ++k) {
+				err += !sqrt_within64(p[k], r[i]);
+			}
+			err += r[i].lo < 0;
+		}
+	}
+	if (err) {
+		fprintf(stderr, "interval64: %d errors\n", err);
+	}
+	return err;
+}
+
+int sum_within32(float p, float q, float sp, struct efloat32_interval z)
+{
+	float a[3], b[3];
+
+	a[0] = p;
+	b[0] = 1.0f;
+	a[1] = q;
+	b[1] = sp;
+	a[2] = z.lo;
+	b[2] = -1.0f;
+	if (sign32(a, b, 3) < 0) {
+		return 0;
+	}
+	a[2] = z.hi;
+	return sign32(a, b, 3) <= 0;
+}
+
+int prod_within32(float p, float q, struct efloat32_interval z)
+{
+	float a[2], b[2];
+
+	a[0] = p;
+	b[0] = q;
+	a[1] = z.lo;
+	b[1] = -1.0f;
+	if (sign32(a, b, 2) < 0) {
+		return 0;
+	}
+	a[1] = z.hi;
+	return sign32(a, b, 2) <= 0;
+}
+
+int quot_within32(float p, float q, struct efloat32_interval z)
+{
+	float a[2], b[2];
+	int s;
+
+	s = (q > 0) ? 1 : -1;
+	a[0] = p;
+	b[0] = 1.0f;
+	a[1] = z.lo;
+	b[1] = -q;
+	if (s * sign32(a, b, 2) < 0) {
+		return 0;
+	}
+	a[1] = z.hi;
+	return s * sign32(a, b, 2) <= 0;
+}
+
+int sqrt_within32(float p, struct efloat32_interval z)
+{
+	float a[2], b[2];
+
+	a[0] = p;
+	b[0] = 1.0f;
+	a[1] = -z.lo;
+	b[1] = z.lo;
+	if (sign32(a, b, 2) < 0) {
+		return 0;
+	}
+	a[1] = -z.hi;
+	b[1] = z.hi;
+	return sign32(a, b, 2) <= 0;
+}
+
+int test_interval32(void)
+{
+	struct efloat32_interval x, y, z;
+	float p[2], v[2];
+	size_t i, k, l;
+	int err;
+
+	err = 0;
+	for (i = 0; i < Test_random_len; ++i) {
+		x = rand_interval32();
+		y = rand_interval32();
+		p[0] = x.lo;
+		p[1] = x.hi;
+		v[0] = y.lo;
+		v[1] = y.hi;
+		for (k = 0; k < 2; ++k) {
+			for (l = 0; l < 2; ++l) {
+				z = efloat32_interval_add(x, y);
+				err += !sum_within32(p[k], v[l], 1.0f, z);
+				z = efloat32_interval_sub(x, y);
+				err += !sum_within32(p[k], v[l], -1.0f, z);
+				z = efloat32_interval_mul(x, y);
+				err += !prod_within32(p[k], v[l], z);
+				if (y.lo > 0 || y.hi < 0) {
+					z = efloat32_interval_div(x, y);
+					err += !quot_within32(p[k], v[l], z);
+				}
+			}
+		}
+		x.lo = (float)fabs(x.lo);
+		x.hi = (float)fabs(x.hi);
+		if (x.lo > x.hi) {
+			x.lo = x.hi;
+		}
+		z = efloat32_interval_sqrt(x);
+		err += !sqrt_within32(x.lo, z);
+		err += !sqrt_within32(x.hi, z);
+	}
+	if (err) {
+		fprintf(stderr, "interval32: %d errors\n", err);
+	}
+	return err;
+}
+
+int test_next(void)
+{
+	uint64_t u;
+	uint32_t w;
+	double d;
+	float f;
+	size_t i;
+	int err;
+
+	err = 0;
+	for (i = 0; i < Test_random_len; ++i) {
+		u = rng();
+		if (i % 4 == 0) {
+			u &= 0x800000000000000FUL;
+		}
+		d = uint64_bits_to_efloat64(u);
+		if (isnan(d)) {
+			continue;
+		}
+		err += efloat64_next_up(d) != nextafter(d, HUGE_VAL);
+		err += efloat64_next_down(d) != nextafter(d, -HUGE_VAL);
+		w = (uint32_t)(u >> 32);
+		f = uint32_bits_to_efloat32(w);
+		if (isnan(f)) {
+			continue;
+		}
+		err += efloat32_next_up(f) != nextafterf(f, (float)HUGE_VAL);
+		err += efloat32_next_down(f)
+		    != nextafterf(f, (float)-HUGE_VAL);
+	}
+	err += efloat64_next_up(DBL_MAX) != HUGE_VAL;
+	err += efloat64_next_up(HUGE_VAL) != HUGE_VAL;
+	err += efloat64_next_down(-HUGE_VAL) != -HUGE_VAL;
+	err += efloat64_next_up(-HUGE_VAL) != -DBL_MAX;
+	err += efloat64_next_up(-0.0) != DBL_MIN * DBL_EPSILON;
+	err += efloat64_next_down(0.0) != -DBL_MIN * DBL_EPSILON;
+	err += !isnan(efloat64_next_up(nan("")));
+	err += !isnan(efloat32_next_down(nanf("")));
+	if (err) {
+		fprintf(stderr, "next: %d errors\n", err);
+	}
+	return err;
+}
+
+int test_specials(void)
+{
+	struct efloat64_interval x, y, z;
+	int err;
+
+	err = 0;
+	x.lo = 1.0;
+	x.hi = 2.0;
+	y.lo = -1.0;
+	y.hi = 1.0;
+	z = efloat64_interval_div(x, y);
+	err += z.lo != -HUGE_VAL || z.hi != HUGE_VAL;
+
+	x.lo = 0.0;
+	x.hi = 1.0;
+	y.lo = 1.0;
+	y.hi = HUGE_VAL;
+	z = efloat64_interval_mul(x, y);
+	err += z.lo > 0.0 || z.hi != HUGE_VAL;
+	z = efloat64_interval_div(y, y);
+	err += z.lo > 0.0 || z.hi != HUGE_VAL;
+
+	x.lo = -1.0;
+	x.hi = 4.0;
+	z = efloat64_interval_sqrt(x);
+	err += z.lo != 0.0 || z.hi != efloat64_next_up(2.0);
+	x.hi = -0.5;
+	z = efloat64_interval_sqrt(x);
+	err += !isnan(z.lo) || !isnan(z.hi);
+
+	x.lo = DBL_MAX;
+	x.hi = DBL_MAX;
+	z = efloat64_interval_add(x, x);
+	err += z.lo != DBL_MAX || z.hi != HUGE_VAL;
+	if (err) {
+		fprintf(stderr, "specials: %d errors\n", err);
+	}
+	return err;
+}
+
+int main(void)
+{
+	int err;
+
+	rng_seed(0x9E3779B97F4A7C15UL);
+	err = 0;
+	err += test_interval64();
+	err += test_interval32();
+	err += test_next();
+	err += test_specials();
+
+	if (err) {
+		fprintf(stderr, "%d errors\n", err);
+	}
+	return (err == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,420 @@
+/* SPDX-License-Identifier: LGPL-2.1-or-later */
+/* test-minmax.c: test of totalOrder, minimum and maximum */
+/* Copyright (C) 2026 Eric Herman */
+/* https://github.com/ericherman/libefloat */
+
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "efloat.h"
+#include "test-rng.h"
+
+#define Test_random_len 20000
+#define Test_array_len 300
+
+static const uint64_t specials64[] = {
+	0x0000000000000000UL, 0x8000000000000000UL,
+	0x7FF0000000000000UL, 0xFFF0000000000000UL,
+	0x7FF8000000000000UL, 0xFFF8000000000000UL,
+	0x7FF0000000000001UL, 0xFFF0000000000001UL,
+	0x7FFFFFFFFFFFFFFFUL, 0xFFFFFFFFFFFFFFFFUL,
+	0x0000000000000001UL, 0x8000000000000001UL,
+	0x7FEFFFFFFFFFFFFFUL, 0xFFEFFFFFFFFFFFFFUL,
+	0x3FF0000000000000UL, 0xBFF0000000000000UL
+};
+
+#define Specials64_len (sizeof(specials64) / sizeof(specials64[0]))
+
+/* a special value, a random pattern, or one of a few values to tie */
+double rand_double(void)
+{
+	uint64_t u;
+
+	switch (rng() % 4) {
+	case 0:
+		u = specials64[rng() % Specials64_len];
+		break;
+	case 1:
+		u = 0x3FF0000000000000UL + (rng() % 4);
+		u |= (rng() & 1) ? 0x8000000000000000UL : 0;
+		break;
+	default:
+		u = rng();
+		break;
+	}
+	return uint64_bits_to_efloat64(u);
+}
+
+float rand_float(void)
+{
+	double d;
+	uint32_t w;
+
+	d = rand_double();
+	if (isnan(d)) {
+		/* keep the payload, including whether it is signaling */
+		w = (uint32_t)(efloat64_to_uint64_bits(d) >> 32);
+		w |= (efloat64_to_uint64_bits(d) & 1) ? 1 : 0;
+		return uint32_bits_to_efloat32(w);
+	}
+	if (rng() % 2) {
+		return uint32_bits_to_efloat32((uint32_t)rng());
+	}
+	return (float)d;
+}
+
+/* totalOrder from the values, then the payloads of the NaNs */
+int ref_total_order64(double x, double y)
+{
+	uint64_t a, b;
+
+	if (!isnan(x) && !isnan(y)) {
+		if (x != y) {
+			return x < y;
+		}
+		return !(signbit(y) && !signbit(x));
+	}
+	if (!isnan(y)) {
+		return signbit(x) != 0;
+	}
+	if (!isnan(x)) {
+		return !signbit(y);
+	}
+	if (signbit(x) != signbit(y)) {
+		return signbit(x) != 0;
+	}
+	a = efloat64_to_uint64_bits(x);
+	b = efloat64_to_uint64_bits(y);
+	return signbit(x) ? (a >= b) : (a <= b);
+}
+
+int ref_total_order32(float x, float y)
+{
+	uint32_t a, b;
+
+	if (!isnan(x) && !isnan(y)) {
+		if (x != y) {
+			return x < y;
+		}
+		return !(signbit(y) && !signbit(x));
+	}
+	if (!isnan(y)) {
+		return signbit(x) != 0;
+	}
+	if (!isnan(x)) {
+		return !signbit(y);
+	}
+	if (signbit(x) != signbit(y)) {
+		return signbit(x) != 0;
+	}
+	a = efloat32_to_uint32_bits(x);
+	b = efloat32_to_uint32_bits(y);
+	return signbit(x) ? (a >= b) : (a <= b);
+}
+
+/* the expected bits of minimum() or maximum(), or of a _number() form */
+uint64_t ref_pick64(double x, double y, int is_max, int number)
+{
+	uint64_t quiet;
+	double r;
+
+	quiet = 0x0008000000000000UL;
+	if (isnan(x) || isnan(y)) {
+		if (number && !isnan(x)) {
+			return efloat64_to_uint64_bits(x);
+		}
+		if (number && !isnan(y)) {
+			return efloat64_to_uint64_bits(y);
+		}
+		r = isnan(x) ? x : y;
+		return efloat64_to_uint64_bits(r) | quiet;
+	}
+	if (x == y) {
+		/* the zeros, else the same value */
+		r = ((signbit(x) != 0) == !is_max) ? x : y;
+	} else {
+		r = ((x < y) == !is_max) ? x : y;
+	}
+	return efloat64_to_uint64_bits(r);
+}
+
+uint32_t ref_pick32(float x, float y, int is_max, int number)
+{
+	uint32_t quiet;
+	float r;
+
+	quiet = 0x00400000UL;
+	if (isnan(x) || isnan(y)) {
+		if (number && !isnan(x)) {
+			return efloat32_to_uint32_bits(x);
+		}
+		if (number && !isnan(y)) {
+			return efloat32_to_uint32_bits(y);
+		}
+		r = isnan(x) ? x : y;
+		return efloat32_to_uint32_bits(r) | quiet;
+	}
+	if (x == y) {
+		r = ((signbit(x) != 0) == !is_max) ? x : y;
+	} else {
+		r = ((x < y) == !is_max) ? x : y;
+	}
+	return efloat32_to_uint32_bits(r);
+}
+
+int test_scalar64(void)
+{
+	double x, y;
+	size_t i;
+	int err, t, c;
+
+	err = 0;
+	for (i = 0; i < Test_random_len; ++i) {
+		x = rand_double();
+		y = rand_double();
+		t = efloat64_total_order(x, y);
+		err += t != ref_total_order64(x, y);
+		c = efloat64_total_compare(x, y);
+		err += (c <= 0) != t;
+		err += (c >= 0) != efloat64_total_order(y, x);
+		err += efloat64_total_order_mag(x, y)
+		    != ref_total_order64(fabs(x), fabs(y));
+
+		err += efloat64_to_uint64_bits(efloat64_minimum(x, y))
+		    != ref_pick64(x, y, 0, 0);
+		err += efloat64_to_uint64_bits(efloat64_maximum(x, y))
+		    != ref_pick64(x, y, 1, 0);
+		err += efloat64_to_uint64_bits(efloat64_minimum_number(x, y))
+		    != ref_pick64(x, y, 0, 1);
+		err += efloat64_to_uint64_bits(efloat64_maximum_number(x, y))
+		    != ref_pick64(x, y, 1, 1);
+	}
+	if (err) {
+		fprintf(stderr, "scalar64: %d errors\n", err);
+	}
+	return err;
+}
+
+int test_scalar32(void)
+{
+	float x, y;
+	size_t i;
+	int err, t, c;
+
+	err = 0;
+	for (i = 0; i < Test_random_len; ++i) {
+		x = rand_float();
+		y = rand_float();
+		t = efloat32_total_order(x, y);
+		err += t != ref_total_order32(x, y);
+		c = efloat32_total_compare(x, y);
+		err += (c <= 0) != t;
+		err += (c >= 0) != efloat32_total_order(y, x);
+		err += efloat32_total_order_mag(x, y)
+		    != ref_total_order32(fabsf(x), fabsf(y));
+
+		err += efloat32_to_uint32_bits(efloat32_minimum(x, y))
+		    != ref_pick32(x, y, 0, 0);
+		err += efloat32_to_uint32_bits(efloat32_maximum(x, y))
+		    != ref_pick32(x, y, 1, 0);
+		err += efloat32_to_uint32_bits(efloat32_minimum_number(x, y))
+		    != ref_pick32(x, y, 0, 1);
+		err += efloat32_to_uint32_bits(efloat32_maximum_number(x, y))
+		    != ref_pick32(x, y, 1, 1);
+	}
+	if (err) {
+		fprintf(stderr, "scalar32: %d errors\n", err);
+	}
+	return err;
+}
+
+/* the reductions, as a left fold of the scalar forms */
+uint64_t fold64(const double *src, size_t len, int is_max, int number)
+{
+	uint64_t r;
+	size_t i;
+
+	if (len == 0) {
+		return is_max ? 0xFFF0000000000000UL : 0x7FF0000000000000UL;
+	}
+	r = efloat64_to_uint64_bits(src[0]);
+	if (isnan(src[0])) {
+		r |= 0x0008000000000000UL;
+	}
+	for (i = 1; i < len; ++i) {
+		r = ref_pick64(uint64_bits_to_efloat64(r), src[i], is_max,
+			       number);
+	}
+	return r;
+}
+
+int test_arrays64(void)
+{
+	static double a[Test_array_len], b[Test_array_len];
+	static double dst[Test_array_len];
+	size_t i, j, len, k;
+	int err, op, is_max, number;
+	uint64_t r;
+
+	err = 0;
+	for (j = 0; j < 40; ++j) {
+		len = 1 + (rng() % Test_array_len);
+		for (i = 0; i < len; ++i) {
+			a[i] = rand_double();
+			b[i] = rand_double();
+			if (j % 2 && isnan(a[i])) {
+				/* half of the reductions see no NaN */
+				a[i] = (double)i;
+			}
+		}
+		for (op = 0; op < 4; ++op) {
+			is_max = op & 1;
+			number = op >> 1;
+			switch (op) {
+			case 0:
+				efloat64_array_minimum(dst, a, b, len);
+				r = efloat64_to_uint64_bits
+				    (efloat64_array_reduce_minimum(a, len));
+				break;
+			case 1:
+				efloat64_array_maximum(dst, a, b, len);
+				r = efloat64_to_uint64_bits
+				    (efloat64_array_reduce_maximum(a, len));
+				break;
+			case 2:
+				efloat64_array_minimum_number(dst, a, b, len);
+				r = efloat64_to_uint64_bits
+				    (efloat64_array_reduce_minimum_number
+				     (a, len));
+				break;
+			default:
+				efloat64_array_maximum_number(dst, a, b, len);
+				r = efloat64_to_uint64_bits
+				    (efloat64_array_reduce_maximum_number
+				     (a, len));
+				break;
+			}
+			for (k = 0; k < len; ++k) {
+				err += efloat64_to_uint64_bits(dst[k])
+				    != ref_pick64(a[k], b[k], is_max, number);
+			}
+			err += r != fold64(a, len, is_max, number);
+		}
+	}
+	if (err) {
+		fprintf(stderr, "arrays64: %d errors\n", err);
+	}
+	return err;
+}
+
+int test_arrays32(void)
+{
+	static float a[Test_array_len], b[Test_array_len];
+	static float dst[Test_array_len];
+	size_t i, j, len, k;
+	int err;
+	float lo, hi;
+
+	err = 0;
+	for (j = 0; j < 40; ++j) {
+		len = 1 + (rng() % Test_array_len);
+		for (i = 0; i < len; ++i) {
+			a[i] = rand_float();
+			b[i] = rand_float();
+			if (isnan(a[i])) {
+				a[i] = -(float)i;
+			}
+		}
+		efloat32_array_minimum(dst, a, b, len);
+		for (k = 0; k < len; ++k) {
+			err += efloat32_to_uint32_bits(dst[k])
+			    != ref_pick32(a[k], b[k], 0, 0);
+		}
+		efloat32_array_maximum_number(dst, a, b, len);
+		for (k = 0; k < len; ++k) {
+			err += efloat32_to_uint32_bits(dst[k])
+			    != ref_pick32(a[k], b[k], 1, 1);
+		}
+		lo = a[0];
+		hi = a[0];
+		for (k = 1; k < len; ++k) {
+			lo = efloat32_minimum(lo, a[k]);
+			hi = efloat32_maximum(hi, a[k]);
+		}
+		err += efloat32_to_uint32_bits(lo)
+		    != efloat32_to_uint32_bits(efloat32_array_reduce_minimum
+					       (a, len));
+		err += efloat32_to_uint32_bits(hi)
+		    != efloat32_to_uint32_bits(efloat32_array_reduce_maximum
+					       (a, len));
+		err += efloat32_to_uint32_bits(lo)
+		    != efloat32_to_uint32_bits
+		    (efloat32_array_reduce_minimum_number(a, len));
+	}
+	if (err) {
+		fprintf(stderr, "arrays32: %d errors\n", err);
+	}
+	return err;
+}
+
+int test_specials(void)
+{
+	double d[3];
+	float f[2];
+	int err;
+
+	err = 0;
+	d[0] = 0.0;
+	f[0] = 0.0f;
+	err += efloat64_array_reduce_minimum(d, 0) != HUGE_VAL;
+	err += efloat64_array_reduce_maximum(d, 0) != -HUGE_VAL;
+	err += !isnan(efloat64_array_reduce_minimum_number(d, 0));
+	err += efloat32_array_reduce_maximum(f, 0) != -HUGE_VALF;
+
+	d[0] = nan("");
+	d[1] = -nan("");
+	d[2] = 1.0;
+	err += efloat64_array_reduce_maximum_number(d, 3) != 1.0;
+	err += efloat64_array_reduce_minimum_number(d, 3) != 1.0;
+	err += !isnan(efloat64_array_reduce_minimum_number(d, 2));
+	err += !isnan(efloat64_array_reduce_maximum(d + 1, 2));
+	err += !signbit(efloat64_array_reduce_maximum(d + 1, 2));
+
+	err += !signbit(efloat64_minimum(0.0, -0.0));
+	err += !signbit(efloat64_minimum(-0.0, 0.0));
+	err += signbit(efloat64_maximum(-0.0, 0.0));
+	err += signbit(efloat64_maximum_number(-0.0, 0.0));
+
+	f[0] = -0.0f;
+	f[1] = 0.0f;
+	err += !signbit(efloat32_array_reduce_minimum(f, 2));
+	err += signbit(efloat32_array_reduce_maximum(f, 2));
+	err += !efloat32_total_order(-0.0f, 0.0f);
+	err += efloat32_total_order(0.0f, -0.0f);
+	err += !efloat32_total_order(-nanf(""), -HUGE_VALF);
+	err += !efloat32_total_order(HUGE_VALF, nanf(""));
+	if (err) {
+		fprintf(stderr, "specials: %d errors\n", err);
+	}
+	return err;
+}
+
+int main(void)
+{
+	int err;
+
+	rng_seed(0x2545F4914F6CDD1DUL);
+	err = 0;
+	err += test_scalar64();
+	err += test_scalar32();
+	err += test_arrays64();
+	err += test_arrays32();
+	err += test_specials();
+
+	if (err) {
+		fprintf(stderr, "%d errors\n", err);
+	}
+	return (err == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
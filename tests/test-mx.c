@@ -0,0 +1,170 @@
+/* SPDX-License-Identifier: LGPL-2.1-or-later */
+/* test-mx.c: test of the block floating point (MX) encoding */
+/* Copyright (C) 2026 Eric Herman */
+/* https://github.com/ericherman/libefloat */
+
+#include <float.h>
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "efloat.h"
+
+#define Test_array_len 1000
+
+static efloat32 a[Test_array_len];
+static efloat32 out[Test_array_len];
+static uint8_t buf[efloat_mx_bytes(Test_array_len, 8)];
+
+void fill_values(void)
+{
+	uint32_t u;
+	size_t i;
+	int block_exp;
+
+	u = 17;
+	block_exp = 0;
+	for (i = 0; i < Test_array_len; ++i) {
+		u = (u * 1103515245UL) + 12345UL;
+		if ((i % efloat_mx_block_len) == 0) {
+			block_exp = (int)((u >> 16) % 80) - 40;
+		}
+		/* values within a block are of similar, but varied, size */
+		a[i] = (efloat32)ldexp((double)((int)(u >> 8) % 2000) - 1000,
+				       block_exp - (int)((u >> 4) % 6));
+	}
+	/* a block with a NaN, one of zeros, and one of tiny values */
+	a[40] = (efloat32)NAN;
+	for (i = 64; i < 96; ++i) {
+		a[i] = (i == 70) ? -0.0f : 0.0f;
+	}
+	for (i = 96; i < 128; ++i) {
+		a[i] = (efloat32)ldexp((double)i, -140);
+	}
+	a[130] = FLT_MAX;
+	a[131] = -FLT_MAX;
+}
+
+/* slow reference, using frexp and rint */
+double ref_mx(size_t block, size_t i, unsigned bits)
+{
+	double amax, q, qmax;
+	size_t j, end;
+	int x;
+
+	end = (block + efloat_mx_block_len < Test_array_len)
+	    ? block + efloat_mx_block_len : Test_array_len;
+	amax = 0;
+	for (j = block; j < end; ++j) {
+		if (isnan(a[j]) || isinf(a[j])) {
+			return NAN;
+		}
+		amax = (fabs(a[j]) > amax) ? fabs(a[j]) : amax;
+	}
+	if (amax < FLT_MIN) {
+		x = -127;
+	} else {
+		frexp(amax, &x);
+		x = x - 1;
+	}
+	qmax = ldexp(1.0, (int)bits - 1) - 1;
+	q = rint(ldexp(a[i], (int)bits - 2 - x));
+	q = (q > qmax) ? qmax : ((q < -qmax) ? -qmax : q);
+	return ldexp(q, x + 2 - (int)bits);
+}
+
+int check_bits(unsigned bits)
+{
+	efloat32 max_err;
+	double expect, err, expect_max;
+	size_t i, used, n;
+	int err_count;
+
+	err_count = 0;
+	used = efloat32_mx_encode(buf, sizeof(buf), a, Test_array_len, bits,
+				  &max_err);
+	if (used != efloat_mx_bytes(Test_array_len, bits)) {
+		fprintf(stderr, "bits %u used %lu\n", bits,
+			(unsigned long)used);
+		return 1;
+	}
+	n = efloat32_mx_decode(out, Test_array_len, buf, used, bits);
+	if (n != Test_array_len) {
+		return 1;
+	}
+	expect_max = 0;
+	for (i = 0; i < Test_array_len; ++i) {
+		expect = ref_mx(i - (i % efloat_mx_block_len), i, bits);
+		if (isnan(expect)) {
+			err_count += !isnan(out[i]);
+			continue;
+		}
+		if ((double)out[i] != expect) {
+			++err_count;
+			fprintf(stderr, "bits %u [%lu] %g: %g != %g\n", bits,
+				(unsigned long)i, (double)a[i],
+				(double)out[i], expect);
+		}
+		err = fabs((double)out[i] - (double)a[i]);
+		expect_max = (err > expect_max) ? err : expect_max;
+	}
+	if (max_err != (efloat32)expect_max) {
+		++err_count;
+		fprintf(stderr, "bits %u max_err %g != %g\n", bits,
+			(double)max_err, expect_max);
+	}
+	return err_count;
+}
+
+int test_efloat64(void)
+{
+	efloat64 d[100], e[100];
+	uint8_t b[efloat_mx_bytes(100, 6)];
+	efloat64 max_err;
+	size_t i;
+	int err;
+
+	err = 0;
+	for (i = 0; i < 100; ++i) {
+		d[i] = ((double)i - 50.0) / 8.0;
+	}
+	d[99] = 1e300;		/* saturates to the largest scale */
+	err += (efloat64_mx_encode(b, sizeof(b), d, 100, 6, &max_err)
+		!= sizeof(b));
+	err += (efloat64_mx_decode(e, 100, b, sizeof(b), 6) != 100);
+	/* the first block spans -6.25 to -2.375, so has a quantum of 0.25 */
+	for (i = 0; i < 32; ++i) {
+		err += (fabs(e[i] - d[i]) > 0.125);
+	}
+	/* the last block's scale is pinned at 2^127, so 6.0 is lost */
+	err += (e[98] != 0.0);
+	err += (e[99] != ldexp(31.0, 127 + 2 - 6));
+	err += !(max_err > 1e299);
+
+	/* bad widths and short buffers are rejected */
+	err += (efloat64_mx_encode(b, sizeof(b), d, 100, 5, NULL) != 0);
+	err += (efloat64_mx_encode(b, sizeof(b) - 1, d, 100, 6, NULL) != 0);
+	err += (efloat64_mx_decode(e, 100, b, sizeof(b), 7) != 0);
+	if (err) {
+		fprintf(stderr, "efloat64: %d errors\n", err);
+	}
+	return err;
+}
+
+int main(void)
+{
+	int err;
+
+	err = 0;
+	fill_values();
+	err += check_bits(4);
+	err += check_bits(6);
+	err += check_bits(8);
+	err += test_efloat64();
+
+	if (err) {
+		fprintf(stderr, "%d errors\n", err);
+	}
+	return (err == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
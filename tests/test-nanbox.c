@@ -0,0 +1,160 @@
+/* SPDX-License-Identifier: LGPL-2.1-or-later */
+/* test-nanbox.c: test of tagged values carried in quiet NaN payloads */
+/* Copyright (C) 2026 Eric Herman */
+/* https://github.com/ericherman/libefloat */
+
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "efloat.h"
+#include "test-rng.h"
+
+#define Test_random_len 20000
+#define Test_array_len 200
+
+/* often a NaN of any sign and payload */
+uint64_t rand_bits64(void)
+{
+	uint64_t u;
+
+	u = rng();
+	if (u % 2) {
+		u |= 0x7FF0000000000001UL;
+	}
+	return u;
+}
+
+int test_box64(void)
+{
+	uint64_t payload;
+	unsigned tag;
+	double d;
+	size_t i;
+	int err;
+
+	err = 0;
+	for (i = 0; i < Test_random_len; ++i) {
+		tag = 1 + (unsigned)(rng() % 7);
+		payload = rng() >> 16;
+		d = efloat64_nanbox(tag, payload);
+		err += !isnan(d);
+		err += !efloat64_is_nanbox(d);
+		err += efloat64_nanbox_tag(d) != tag;
+		err += efloat64_nanbox_payload(d) != payload;
+		err += efloat64_to_uint64_bits(d)
+		    != efloat64_bits_nanbox(tag, payload);
+
+		/* nothing cleaned is a box, and only NaNs are changed */
+		d = uint64_bits_to_efloat64(rand_bits64());
+		if (isnan(d)) {
+			err += efloat64_is_nanbox(efloat64_nanbox_clean(d));
+			err += efloat64_to_uint64_bits(efloat64_nanbox_clean(d))
+			    != efloat64_canonical_nan_bits;
+		} else {
+			err += efloat64_is_nanbox(d);
+			err += efloat64_to_uint64_bits(efloat64_nanbox_clean(d))
+			    != efloat64_to_uint64_bits(d);
+		}
+	}
+	/* arithmetic NaNs are not boxes */
+	d = HUGE_VAL;
+	err += efloat64_is_nanbox(d - d);
+	err += efloat64_is_nanbox(nan(""));
+	err += efloat64_is_nanbox(-efloat64_nanbox(1, 1));
+	err += efloat64_nanbox_tag(1.0) != 0;
+	err += efloat64_nanbox_payload(nan("")) != 0;
+
+	err += efloat64_is_nanbox(efloat64_nanbox(0, 1));
+	err += efloat64_is_nanbox(efloat64_nanbox(8, 1));
+	err += !isnan(efloat64_nanbox(8, 1));
+	err += efloat64_is_nanbox(efloat64_nanbox(1, 0x0001000000000000UL));
+	err += efloat64_nanbox_payload(efloat64_nanbox(7, 0)) != 0;
+	if (err) {
+		fprintf(stderr, "box64: %d errors\n", err);
+	}
+	return err;
+}
+
+int test_box32(void)
+{
+	uint32_t payload, u;
+	unsigned tag;
+	float f;
+	size_t i;
+	int err;
+
+	err = 0;
+	for (i = 0; i < Test_random_len; ++i) {
+		tag = 1 + (unsigned)(rng() % 3);
+		payload = (uint32_t)(rng() >> 44);
+		f = efloat32_nanbox(tag, payload);
+		err += !isnan(f);
+		err += !efloat32_is_nanbox(f);
+		err += efloat32_nanbox_tag(f) != tag;
+		err += efloat32_nanbox_payload(f) != payload;
+
+		u = (uint32_t)(rand_bits64() >> 32);
+		if (i % 2) {
+			u |= 0x7F800001UL;
+		}
+		f = uint32_bits_to_efloat32(u);
+		if (isnan(f)) {
+			err += efloat32_is_nanbox(efloat32_nanbox_clean(f));
+		} else {
+			err += efloat32_to_uint32_bits(efloat32_nanbox_clean(f))
+			    != u;
+		}
+	}
+	f = (float)HUGE_VAL;
+	err += efloat32_is_nanbox(f - f);
+	err += efloat32_is_nanbox(efloat32_nanbox(4, 1));
+	err += efloat32_is_nanbox(efloat32_nanbox(1, 0x00100000UL));
+	if (err) {
+		fprintf(stderr, "box32: %d errors\n", err);
+	}
+	return err;
+}
+
+int test_arrays(void)
+{
+	static double d[Test_array_len], dc[Test_array_len];
+	static float f[Test_array_len], fc[Test_array_len];
+	size_t i;
+	int err;
+
+	err = 0;
+	for (i = 0; i < Test_array_len; ++i) {
+		d[i] = uint64_bits_to_efloat64(rand_bits64());
+		f[i] = uint32_bits_to_efloat32((uint32_t)(rand_bits64() >> 32));
+	}
+	efloat64_array_nanbox_clean(dc, d, Test_array_len);
+	efloat32_array_nanbox_clean(fc, f, Test_array_len);
+	for (i = 0; i < Test_array_len; ++i) {
+		err += efloat64_to_uint64_bits(dc[i])
+		    != efloat64_to_uint64_bits(efloat64_nanbox_clean(d[i]));
+		err += efloat32_to_uint32_bits(fc[i])
+		    != efloat32_to_uint32_bits(efloat32_nanbox_clean(f[i]));
+	}
+	if (err) {
+		fprintf(stderr, "arrays: %d errors\n", err);
+	}
+	return err;
+}
+
+int main(void)
+{
+	int err;
+
+	rng_seed(0xDA942042E4DD58B5UL);
+	err = 0;
+	err += test_box64();
+	err += test_box32();
+	err += test_arrays();
+
+	if (err) {
+		fprintf(stderr, "%d errors\n", err);
+	}
+	return (err == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
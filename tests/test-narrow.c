@@ -0,0 +1,296 @@
+/* SPDX-License-Identifier: LGPL-2.1-or-later */
+/* test-narrow.c: test of the exact representability functions */
+/* Copyright (C) 2026 Eric Herman */
+/* https://github.com/ericherman/libefloat */
+
+#include <float.h>
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "efloat.h"
+
+#define Test_array_len 4000
+
+/* a slow, independent reference using frexp and ldexp */
+int ref_fits_format(double d, int exp_bits, int signif_bits)
+{
+	int e, emin, emax, precision;
+	double m, scaled;
+
+	if (isinf(d) || d == 0.0) {
+		return 1;
+	}
+	if (isnan(d)) {
+		return -1;	/* the payload is checked separately */
+	}
+	emax = (1 << (exp_bits - 1)) - 1;
+	emin = 1 - emax;
+	m = frexp(fabs(d), &e);
+	--e;			/* now 1.0 <= (2 * m) < 2.0 */
+	if (e > emax) {
+		return 0;
+	}
+	precision = signif_bits;
+	if (e < emin) {
+		precision -= (emin - e);
+	}
+	if (precision < 0) {
+		return 0;
+	}
+	scaled = ldexp(2 * m, precision);
+	return scaled == floor(scaled);
+}
+
+int ref_fits_int(double d, int bits, int is_signed)
+{
+	double lo, hi;
+
+	if (isnan(d) || isinf(d)) {
+		return 0;
+	}
+	if (d == 0.0 && signbit(d)) {
+		return 0;
+	}
+	if (d != floor(d)) {
+		return 0;
+	}
+	lo = is_signed ? -ldexp(1.0, bits - 1) : 0.0;
+	hi = is_signed ? ldexp(1.0, bits - 1) : ldexp(1.0, bits);
+	return (d >= lo) && (d < hi);
+}
+
+double next_test_value(uint64_t *state, size_t i)
+{
+	uint64_t u;
+	double d;
+
+	*state = (*state * 6364136223846793005ULL) + 1442695040888963407ULL;
+	u = *state;
+	switch (i % 8) {
+	case 0:
+		/* small integers */
+		return (double)((int64_t)(u >> 40) % 70000) - 35000;
+	case 1:
+		/* large integers near the int32 limits */
+		d = (double)((u >> 30) % 4294967296ULL);
+		return d - 2147483648.0;
+	case 2:
+		/* short binary fractions over a wide exponent range */
+		d = (double)((u >> 48) & 0x7FF);
+		return ldexp(d, (int)((u >> 8) % 340) - 170);
+	case 3:
+		/* around the float32 and float16 subnormal boundaries */
+		d = (double)((u >> 56) | 1);
+		return ldexp(d, (int)((u >> 8) % 40) - ((i & 8) ? 160 : 35));
+	case 4:
+		/* rounded through float, so fits float32 */
+		return (double)(float)uint64_bits_to_efloat64(u);
+	case 5:
+		/* decimals, which rarely fit */
+		return (double)((u >> 40) % 100000) / 100.0;
+	case 6:
+		/* specials */
+		switch ((u >> 60) % 4) {
+		case 0:
+			return -0.0;
+		case 1:
+			return (u & 1) ? INFINITY : -INFINITY;
+		case 2:
+			u = (u & 0x0007FF0000000000ULL);
+			return uint64_bits_to_efloat64(0x7FF8000000000000ULL
+						       | u);
+		default:
+			return uint64_bits_to_efloat64(0x7FF0000000000001ULL);
+		}
+	default:
+		return uint64_bits_to_efloat64(u);
+	}
+}
+
+int check_efloat64_format(const efloat64 *a, size_t len, int exp_bits,
+			  int signif_bits)
+{
+	uint8_t out[Test_array_len];
+	size_t i, count, expect_count;
+	int expect, err;
+	uint64_t u, dropped;
+
+	err = 0;
+	expect_count = 0;
+	count = efloat64_fits_format(a, len, exp_bits, signif_bits, out);
+	for (i = 0; i < len; ++i) {
+		expect = ref_fits_format(a[i], exp_bits, signif_bits);
+		if (expect < 0) {
+			u = efloat64_to_uint64_bits(a[i]);
+			dropped = (((uint64_t)1) << (52 - signif_bits)) - 1;
+			expect = ((u & dropped) == 0);
+		}
+		expect_count += expect;
+		if (out[i] != expect) {
+			++err;
+			fprintf(stderr, "%g (0x%llx) fits (%d,%d)? %d != %d\n",
+				a[i], (unsigned long long)
+				efloat64_to_uint64_bits(a[i]), exp_bits,
+				signif_bits, (int)out[i], expect);
+		}
+	}
+	if (count != expect_count) {
+		++err;
+		fprintf(stderr, "(%d,%d) count %lu != %lu\n", exp_bits,
+			signif_bits, (unsigned long)count,
+			(unsigned long)expect_count);
+	}
+	return err;
+}
+
+int check_efloat64_int(const efloat64 *a, size_t len, int bits, int is_signed)
+{
+	uint8_t out[Test_array_len];
+	size_t i, count, expect_count;
+	int expect, err;
+
+	err = 0;
+	expect_count = 0;
+	if (is_signed) {
+		count = efloat64_fits_int(a, len, bits, out);
+	} else {
+		count = efloat64_fits_uint(a, len, bits, out);
+	}
+	for (i = 0; i < len; ++i) {
+		expect = ref_fits_int(a[i], bits, is_signed);
+		expect_count += expect;
+		if (out[i] != expect) {
+			++err;
+			fprintf(stderr, "%g fits %sint%d? %d != %d\n", a[i],
+				is_signed ? "" : "u", bits, (int)out[i],
+				expect);
+		}
+	}
+	if (count != expect_count) {
+		++err;
+		fprintf(stderr, "int%d count %lu != %lu\n", bits,
+			(unsigned long)count, (unsigned long)expect_count);
+	}
+	return err;
+}
+
+int test_efloat64_fits(void)
+{
+	efloat64 a[Test_array_len];
+	uint8_t out[Test_array_len];
+	uint64_t state;
+	size_t i, count;
+	int err;
+
+	state = 42;
+	for (i = 0; i < Test_array_len; ++i) {
+		a[i] = next_test_value(&state, i);
+	}
+
+	err = 0;
+	err += check_efloat64_format(a, Test_array_len, 8, 23);
+	err += check_efloat64_format(a, Test_array_len, 8, 7);
+	err += check_efloat64_format(a, Test_array_len, 5, 10);
+	err += check_efloat64_format(a, Test_array_len, 4, 3);
+	err += check_efloat64_format(a, Test_array_len, 11, 52);
+	err += check_efloat64_int(a, Test_array_len, 8, 1);
+	err += check_efloat64_int(a, Test_array_len, 16, 1);
+	err += check_efloat64_int(a, Test_array_len, 32, 1);
+	err += check_efloat64_int(a, Test_array_len, 64, 1);
+	err += check_efloat64_int(a, Test_array_len, 8, 0);
+	err += check_efloat64_int(a, Test_array_len, 32, 0);
+
+	/* the float32 convenience function agrees with a hardware cast */
+	count = efloat64_fits_efloat32(a, Test_array_len, out);
+	for (i = 0; i < Test_array_len; ++i) {
+		if (isnan(a[i])) {
+			continue;
+		}
+		if (out[i] != (((double)(float)a[i]) == a[i]
+			       && signbit((double)(float)a[i]) ==
+			       signbit(a[i]))) {
+			++err;
+			fprintf(stderr, "%g fits float32? %d\n", a[i],
+				(int)out[i]);
+		}
+	}
+	if (count == 0 || count == Test_array_len) {
+		++err;
+		fprintf(stderr, "fits float32 count: %lu?\n",
+			(unsigned long)count);
+	}
+	return err;
+}
+
+int test_narrowing(void)
+{
+	efloat64 a[100];
+	efloat32 b[100];
+	struct efloat_narrowing n, n2;
+	size_t i;
+	int err;
+
+	err = 0;
+	for (i = 0; i < 100; ++i) {
+		a[i] = (double)i - 50;
+		b[i] = (float)a[i];
+	}
+
+	efloat_narrowing_init(&n);
+	efloat64_narrowing_add(&n, a, 100);
+	err += (efloat_narrowing_best(&n) != ef_narrow_int8);
+
+	a[7] = 1000.0;
+	efloat_narrowing_init(&n);
+	efloat64_narrowing_add(&n, a, 100);
+	err += (efloat_narrowing_best(&n) != ef_narrow_int16);
+
+	a[8] = 0.5;
+	efloat_narrowing_init(&n);
+	efloat64_narrowing_add(&n, a, 50);
+	efloat_narrowing_init(&n2);
+	efloat64_narrowing_add(&n2, a + 50, 50);
+	efloat_narrowing_merge(&n, &n2);
+	err += (efloat_narrowing_best(&n) != ef_narrow_float16);
+
+	a[9] = ldexp(1.0, 100);
+	efloat_narrowing_init(&n);
+	efloat64_narrowing_add(&n, a, 100);
+	err += (efloat_narrowing_best(&n) != ef_narrow_bfloat16);
+
+	a[10] = 1.0 / 3.0;
+	efloat_narrowing_init(&n);
+	efloat64_narrowing_add(&n, a, 100);
+	err += (efloat_narrowing_best(&n) != ef_narrow_none);
+
+	a[10] = (double)(1.0f / 3.0f);
+	efloat_narrowing_init(&n);
+	efloat64_narrowing_add(&n, a, 100);
+	err += (efloat_narrowing_best(&n) != ef_narrow_float32);
+
+	b[3] = 100000.0f;
+	efloat_narrowing_init(&n);
+	efloat32_narrowing_add(&n, b, 100);
+	err += (efloat_narrowing_best(&n) != ef_narrow_int32);
+
+	if (err) {
+		fprintf(stderr, "narrowing_best: %d errors\n", err);
+	}
+	return err;
+}
+
+int main(void)
+{
+	int err;
+
+	err = 0;
+	err += test_efloat64_fits();
+	err += test_narrowing();
+
+	if (err) {
+		fprintf(stderr, "%d errors\n", err);
+	}
+	return (err == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,356 @@
+/* SPDX-License-Identifier: LGPL-2.1-or-later */
+/* test-posit.c: test of the posit conversions */
+/* Copyright (C) 2026 Eric Herman */
+/* https://github.com/ericherman/libefloat */
+
+#include <float.h>
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "efloat.h"
+
+#define Test_random_len 100000
+
+static efloat32 f32[1 << 16];
+static efloat64 f64[1 << 16];
+static uint16_t p16[1 << 16];
+
+uint32_t posit_mask(unsigned nbits)
+{
+	return (nbits == 32) ? 0xFFFFFFFFUL : ((((uint32_t)1) << nbits) - 1);
+}
+
+/* slow reference, reading one bit at a time */
+double ref_posit(uint32_t p, unsigned nbits, unsigned es)
+{
+	uint32_t sign, first;
+	double frac, w, v;
+	int i, run, k, e, neg;
+	unsigned b;
+
+	sign = ((uint32_t)1) << (nbits - 1);
+	p &= posit_mask(nbits);
+	if (p == 0) {
+		return 0.0;
+	} else if (p == sign) {
+		return NAN;
+	}
+	neg = (p & sign) ? 1 : 0;
+	if (neg) {
+		p = (0 - p) & posit_mask(nbits);
+	}
+	i = (int)nbits - 2;
+	first = (p >> i) & 1;
+	run = 0;
+	while (i >= 0 && ((p >> i) & 1) == first) {
+		++run;
+		--i;
+	}
+	k = first ? (run - 1) : -run;
+	--i;
+	e = 0;
+	for (b = 0; b < es; ++b) {
+		e <<= 1;
+		if (i >= 0) {
+			e |= (int)((p >> i) & 1);
+			--i;
+		}
+	}
+	frac = 1.0;
+	w = 0.5;
+	for (; i >= 0; --i) {
+		if ((p >> i) & 1) {
+			frac += w;
+		}
+		w /= 2;
+	}
+	v = ldexp(frac, (k * (1 << es)) + e);
+	return neg ? -v : v;
+}
+
+int same(double a, double b)
+{
+	return (isnan(a) && isnan(b)) || (a == b);
+}
+
+/* every pattern decodes as the reference, and re-encodes to itself */
+int test_exhaustive(void)
+{
+	uint32_t p, n;
+	unsigned nbits, es;
+	double expect;
+	int err;
+
+	err = 0;
+	for (nbits = 2; nbits <= 16; ++nbits) {
+		for (es = 0; es <= efloat_posit_es_max; ++es) {
+			n = ((uint32_t)1) << nbits;
+			for (p = 0; p < n; ++p) {
+				expect = ref_posit(p, nbits, es);
+				if (!same(posit_to_efloat64(p, nbits, es),
+					  expect)
+				    || !same(posit_to_efloat32(p, nbits, es),
+					     expect)) {
+					++err;
+					fprintf(stderr, "<%u,%u> 0x%lx: %g\n",
+						nbits, es, (unsigned long)p,
+						expect);
+				}
+				if (efloat64_to_posit(expect, nbits, es) != p
+				    || efloat32_to_posit((efloat32)expect,
+							 nbits, es) != p) {
+					++err;
+					fprintf(stderr, "<%u,%u> %g != 0x%lx\n",
+						nbits, es, expect,
+						(unsigned long)p);
+				}
+			}
+		}
+	}
+	return err;
+}
+
+int check_round(double d, uint32_t expect, unsigned nbits, unsigned es)
+{
+	uint32_t p, neg_expect;
+
+	neg_expect = (0 - expect) & posit_mask(nbits);
+	p = efloat64_to_posit(d, nbits, es);
+	if (p != expect || efloat64_to_posit(-d, nbits, es) != neg_expect) {
+		fprintf(stderr, "<%u,%u> %.17g: 0x%lx != 0x%lx\n", nbits, es,
+			d, (unsigned long)p, (unsigned long)expect);
+		return 1;
+	}
+	return 0;
+}
+
+/*
+ The bit string midpoint of neighbors p and p + 1 is the posit one bit
+ wider, (p << 1) | 1; it rounds to the even one, and anything off of
+ the midpoint to the nearer.
+*/
+int test_rounding(void)
+{
+	uint32_t p, maxpos;
+	unsigned nbits, es;
+	double mid, minpos;
+	int err;
+
+	err = 0;
+	for (nbits = 8; nbits <= 16; nbits += 8) {
+		for (es = 0; es <= efloat_posit_es_max; ++es) {
+			maxpos = posit_mask(nbits) >> 1;
+			for (p = 1; p < maxpos; ++p) {
+				mid = ref_posit((p << 1) | 1, nbits + 1, es);
+				err += check_round(mid, (p & 1) ? p + 1 : p,
+						   nbits, es);
+				err += check_round(nextafter(mid, INFINITY),
+						   p + 1, nbits, es);
+				err += check_round(nextafter(mid, 0), p,
+						   nbits, es);
+			}
+			/* posits saturate rather than overflow or underflow */
+			minpos = ref_posit(1, nbits, es);
+			err += check_round(minpos / 3, 1, nbits, es);
+			err += check_round(DBL_MIN, 1, nbits, es);
+			err += check_round(ldexp(1.0, -1074), 1, nbits, es);
+			err += check_round(ref_posit(maxpos, nbits, es) * 3,
+					   maxpos, nbits, es);
+			err += check_round(DBL_MAX, maxpos, nbits, es);
+			err += (efloat64_to_posit(INFINITY, nbits, es)
+				!= efloat_posit_nar(nbits));
+			err += (efloat64_to_posit(NAN, nbits, es)
+				!= efloat_posit_nar(nbits));
+			err += (efloat32_to_posit(-0.0f, nbits, es) != 0);
+			err += (efloat32_to_posit(FLT_MIN / 4, nbits, es) != 1);
+		}
+	}
+	return err;
+}
+
+int test_arrays(void)
+{
+	uint8_t p8[1000], q8[1000];
+	uint32_t i, p;
+	unsigned es;
+	int err;
+
+	err = 0;
+	for (es = 0; es <= efloat_posit_es_max; ++es) {
+		/* posit16, all of them */
+		for (i = 0; i < (1 << 16); ++i) {
+			p16[i] = (uint16_t)i;
+		}
+		err += (posit16_to_efloat32_array(f32, p16, 1 << 16, es)
+			!= (1 << 16));
+		err += (posit16_to_efloat64_array(f64, p16, 1 << 16, es)
+			!= (1 << 16));
+		for (i = 0; i < (1 << 16); ++i) {
+			err += !same(f32[i], ref_posit(i, 16, es));
+			err += !same(f64[i], ref_posit(i, 16, es));
+		}
+		err += (efloat32_array_to_posit16(p16, f32, 1 << 16, es)
+			!= (1 << 16));
+		for (i = 0; i < (1 << 16); ++i) {
+			err += (p16[i] != i);
+		}
+		err += (efloat64_array_to_posit16(p16, f64, 1 << 16, es)
+			!= (1 << 16));
+		for (i = 0; i < (1 << 16); ++i) {
+			err += (p16[i] != i);
+		}
+
+		/* the table matches */
+		err += (efloat64_posit_table(f64, 16, es) != f64);
+		for (i = 0; i < (1 << 16); ++i) {
+			err += !same(f64[i], ref_posit(i, 16, es));
+		}
+
+		/* posit8, long arrays by table and short ones directly */
+		p = 7;
+		for (i = 0; i < 1000; ++i) {
+			p = (p * 1103515245UL) + 12345UL;
+			p8[i] = (uint8_t)(p >> 16);
+		}
+		err += (posit8_to_efloat32_array(f32, p8, 1000, es) != 1000);
+		err += (posit8_to_efloat64_array(f64, p8, 100, es) != 100);
+		for (i = 0; i < 1000; ++i) {
+			err += !same(f32[i], ref_posit(p8[i], 8, es));
+			err += (i < 100)
+			    && !same(f64[i], ref_posit(p8[i], 8, es));
+		}
+		err += (efloat32_array_to_posit8(q8, f32, 1000, es) != 1000);
+		for (i = 0; i < 1000; ++i) {
+			err += (q8[i] != p8[i]);
+		}
+		err += (efloat64_array_to_posit8(q8, f64, 100, es) != 100);
+		for (i = 0; i < 100; ++i) {
+			err += (q8[i] != p8[i]);
+		}
+	}
+	if (err) {
+		fprintf(stderr, "arrays: %d errors\n", err);
+	}
+	return err;
+}
+
+int test_posit32(void)
+{
+	uint32_t p32[256], q32[256];
+	uint32_t u;
+	double d;
+	size_t i, j;
+	int err;
+
+	err = 0;
+	u = 3;
+	for (i = 0; i < Test_random_len; i += 256) {
+		for (j = 0; j < 256; ++j) {
+			u = (u * 1103515245UL) + 12345UL;
+			p32[j] = (u << 16) ^ (u >> 16) ^ (uint32_t)(i + j);
+		}
+		posit32_to_efloat64_array(f64, p32, 256, 2);
+		posit32_to_efloat32_array(f32, p32, 256, 2);
+		for (j = 0; j < 256; ++j) {
+			d = ref_posit(p32[j], 32, 2);
+			/* exact as efloat64, rounded once as efloat32 */
+			err += !same(f64[j], d);
+			err += !same(f32[j], (efloat32)d);
+			err += !same(posit_to_efloat32(p32[j], 32, 2),
+				     (efloat32)d);
+		}
+		efloat64_array_to_posit32(q32, f64, 256, 2);
+		for (j = 0; j < 256; ++j) {
+			err += (q32[j] != p32[j]);
+		}
+		/* an efloat32 converts to the nearest posit32 */
+		efloat32_array_to_posit32(q32, f32, 256, 2);
+		for (j = 0; j < 256; ++j) {
+			err += (q32[j] != efloat64_to_posit(f32[j], 32, 2));
+		}
+	}
+	/* 1.0 + 2^-27 is exact as a posit32, but not as an efloat32 */
+	err += (efloat64_to_posit(1.0 + ldexp(1.0, -27), 32, 2)
+		!= 0x40000001UL);
+	err += (posit_to_efloat32(0x40000001UL, 32, 2) != 1.0f);
+	err += (posit_to_efloat32(0x40000010UL, 32, 2)
+		!= (efloat32)(1.0 + ldexp(1.0, -23)));
+	if (err) {
+		fprintf(stderr, "posit32: %d errors\n", err);
+	}
+	return err;
+}
+
+int test_fields(void)
+{
+	struct efloat32_fields fields, expect;
+	struct efloat64_fields fields64;
+	efloat32 vals[9];
+	enum efloat_class cls;
+	size_t i;
+	int err;
+
+	err = 0;
+	vals[0] = 1.5f;
+	vals[1] = -3.25f;
+	vals[2] = 0.0f;
+	vals[3] = FLT_MIN / 8;
+	vals[4] = 1e30f;
+	vals[5] = (efloat32)INFINITY;
+	vals[6] = (efloat32)NAN;
+	vals[7] = -1.0f / 3.0f;
+	vals[8] = 1024.0f;
+	for (i = 0; i < 9; ++i) {
+		efloat32_radix_2_to_fields(vals[i], &fields);
+		err += (efloat32_posit_from_fields(fields, 16, 1)
+			!= efloat32_to_posit(vals[i], 16, 1));
+		efloat64_radix_2_to_fields(vals[i], &fields64);
+		err += (efloat64_posit_from_fields(fields64, 32, 2)
+			!= efloat64_to_posit(vals[i], 32, 2));
+	}
+	cls = efloat32_posit_to_fields(0x4000, 16, 1, &fields);
+	efloat32_radix_2_to_fields(1.0f, &expect);
+	err += (cls != ef_normal) || (fields.sign != expect.sign)
+	    || (fields.exponent != expect.exponent)
+	    || (fields.significand != expect.significand);
+	err += (efloat32_posit_to_fields(0x8000, 16, 1, &fields) != ef_nan);
+	err += (efloat64_posit_to_fields(0, 16, 1, &fields64) != ef_zero);
+	if (err) {
+		fprintf(stderr, "fields: %d errors\n", err);
+	}
+	return err;
+}
+
+int test_invalid(void)
+{
+	int err;
+
+	err = 0;
+	err += (efloat32_to_posit(1.0f, 16, 3) != efloat_posit_nar(32));
+	err += (efloat64_to_posit(1.0, 33, 0) != efloat_posit_nar(32));
+	err += !isnan(posit_to_efloat64(0x4000, 1, 0));
+	err += (efloat32_posit_table(f32, 17, 0) != NULL);
+	err += (efloat64_array_to_posit32(NULL, NULL, 10, 3) != 0);
+	err += (posit8_to_efloat32_array(NULL, NULL, 10, 5) != 0);
+	return err;
+}
+
+int main(void)
+{
+	int err;
+
+	err = 0;
+	err += test_exhaustive();
+	err += test_rounding();
+	err += test_arrays();
+	err += test_posit32();
+	err += test_fields();
+	err += test_invalid();
+
+	if (err) {
+		fprintf(stderr, "%d errors\n", err);
+	}
+	return (err == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,250 @@
+/* SPDX-License-Identifier: LGPL-2.1-or-later */
+/* test-profile.c: test of the array profiling functions */
+/* Copyright (C) 2026 Eric Herman */
+/* https://github.com/ericherman/libefloat */
+
+#include <float.h>
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "efloat.h"
+
+#define Test_array_len 1000
+
+int check_u64(const char *name, uint64_t actual, uint64_t expect)
+{
+	if (actual == expect) {
+		return 0;
+	}
+	fprintf(stderr, "%s: %llu != %llu\n", name,
+		(unsigned long long)actual, (unsigned long long)expect);
+	return 1;
+}
+
+int check_efloat32_profile_equal(const struct efloat32_profile *a,
+				 const struct efloat32_profile *b)
+{
+	int err;
+	size_t i;
+
+	err = 0;
+	err += check_u64("count", a->count, b->count);
+	for (i = 0; i <= ef_normal; ++i) {
+		err += check_u64("class_count", a->class_count[i],
+				 b->class_count[i]);
+	}
+	err += check_u64("negative", a->negative, b->negative);
+	err += check_u64("exponent_min", (uint64_t)(a->exponent_min + 10000),
+			 (uint64_t)(b->exponent_min + 10000));
+	err += check_u64("exponent_max", (uint64_t)(a->exponent_max + 10000),
+			 (uint64_t)(b->exponent_max + 10000));
+	err += check_u64("min", efloat32_to_uint32_bits(a->min),
+			 efloat32_to_uint32_bits(b->min));
+	err += check_u64("max", efloat32_to_uint32_bits(a->max),
+			 efloat32_to_uint32_bits(b->max));
+	return err;
+}
+
+int test_efloat32_profile_known(void)
+{
+	efloat32 a[10];
+	struct efloat32_profile p;
+	int err;
+
+	a[0] = 1.5f;
+	a[1] = -0.0f;
+	a[2] = 0.0f;
+	a[3] = (efloat32)(0.0f / 0.0f);
+	a[4] = uint32_bits_to_efloat32(1);	/* smallest subnormal */
+	a[5] = (efloat32)INFINITY;
+	a[6] = -1024.0f;
+	a[7] = 3.0f;
+	a[8] = -FLT_MAX;
+	a[9] = (efloat32)(0.0f / 0.0f);
+
+	err = 0;
+	efloat32_profile_array(a, 10, &p);
+	err += check_u64("count", p.count, 10);
+	err += check_u64("nan", p.class_count[ef_nan], 2);
+	err += check_u64("inf", p.class_count[ef_inf], 1);
+	err += check_u64("zero", p.class_count[ef_zero], 2);
+	err += check_u64("subnorm", p.class_count[ef_subnorm], 1);
+	err += check_u64("normal", p.class_count[ef_normal], 4);
+	err += check_u64("exponent_min", (uint64_t)(p.exponent_min + 1000),
+			 (uint64_t)(efloat32_r2_exp_min + 1000));
+	err += check_u64("exponent_max", (uint64_t)p.exponent_max,
+			 efloat32_r2_exp_max);
+	err += check_u64("min", efloat32_to_uint32_bits(p.min),
+			 efloat32_to_uint32_bits(-FLT_MAX));
+	err += check_u64("max", efloat32_to_uint32_bits(p.max),
+			 efloat32_to_uint32_bits((efloat32)INFINITY));
+
+	/* no finite non-zero, only NaN */
+	efloat32_profile_array(a + 3, 1, &p);
+	err += check_u64("nan only", (p.exponent_min > p.exponent_max), 1);
+	err += check_u64("nan only", isnan(p.min) && isnan(p.max), 1);
+
+	return err;
+}
+
+int test_efloat32_profile_vs_fpclassify(void)
+{
+	efloat32 a[Test_array_len];
+	struct efloat32_profile whole, part, merged;
+	uint64_t expect[ef_normal + 1];
+	uint32_t u;
+	size_t i, j, cut;
+	int err, c;
+
+	err = 0;
+	for (i = 0; i <= ef_normal; ++i) {
+		expect[i] = 0;
+	}
+	u = 0x12345678;
+	for (i = 0; i < Test_array_len; ++i) {
+		u = (u * 1103515245UL) + 12345UL;
+		/* skew toward the interesting exponents */
+		if ((i % 7) == 0) {
+			u = u & (efloat32_r2_sign_mask | 0x00FF00FF);
+		} else if ((i % 11) == 0) {
+			u = u | efloat32_r2_rexp_mask;
+		}
+		a[i] = uint32_bits_to_efloat32(u);
+		c = fpclassify(a[i]);
+		if (c == FP_NAN) {
+			++expect[ef_nan];
+		} else if (c == FP_INFINITE) {
+			++expect[ef_inf];
+		} else if (c == FP_ZERO) {
+			++expect[ef_zero];
+		} else if (c == FP_SUBNORMAL) {
+			++expect[ef_subnorm];
+		} else {
+			++expect[ef_normal];
+		}
+	}
+
+	efloat32_profile_array(a, Test_array_len, &whole);
+	for (i = 0; i <= ef_normal; ++i) {
+		err += check_u64("class", whole.class_count[i], expect[i]);
+	}
+	for (i = 0; i < Test_array_len; ++i) {
+		if (!isnan(a[i])) {
+			err += (a[i] < whole.min) || (a[i] > whole.max);
+		}
+	}
+
+	for (j = 0; j < 5; ++j) {
+		cut = (j * Test_array_len) / 4;
+		if (cut > Test_array_len) {
+			cut = Test_array_len;
+		}
+		efloat32_profile_array(a, cut, &merged);
+		efloat32_profile_array(a + cut, Test_array_len - cut, &part);
+		efloat32_profile_merge(&merged, &part);
+		err += check_efloat32_profile_equal(&merged, &whole);
+	}
+
+	return err;
+}
+
+int check_efloat64_profile_equal(const struct efloat64_profile *a,
+				 const struct efloat64_profile *b)
+{
+	int err;
+	size_t i;
+
+	err = 0;
+	err += check_u64("count", a->count, b->count);
+	for (i = 0; i <= ef_normal; ++i) {
+		err += check_u64("class_count", a->class_count[i],
+				 b->class_count[i]);
+	}
+	err += check_u64("negative", a->negative, b->negative);
+	err += check_u64("exponent_min", (uint64_t)(a->exponent_min + 10000),
+			 (uint64_t)(b->exponent_min + 10000));
+	err += check_u64("exponent_max", (uint64_t)(a->exponent_max + 10000),
+			 (uint64_t)(b->exponent_max + 10000));
+	err += check_u64("min", efloat64_to_uint64_bits(a->min),
+			 efloat64_to_uint64_bits(b->min));
+	err += check_u64("max", efloat64_to_uint64_bits(a->max),
+			 efloat64_to_uint64_bits(b->max));
+	return err;
+}
+
+int test_efloat64_profile(void)
+{
+	efloat64 a[Test_array_len];
+	struct efloat64_profile whole, part, merged;
+	uint64_t expect[ef_normal + 1];
+	uint64_t u;
+	size_t i, j, cut;
+	int err, c;
+
+	err = 0;
+	for (i = 0; i <= ef_normal; ++i) {
+		expect[i] = 0;
+	}
+	u = 0x123456789ABCDEF0ULL;
+	for (i = 0; i < Test_array_len; ++i) {
+		u = (u * 6364136223846793005ULL) + 1442695040888963407ULL;
+		if ((i % 7) == 0) {
+			u = u & (efloat64_r2_sign_mask | 0x000FF0FF00FF00FFULL);
+		} else if ((i % 11) == 0) {
+			u = u | efloat64_r2_rexp_mask;
+		}
+		a[i] = uint64_bits_to_efloat64(u);
+		if (i == 3 || i == 4) {
+			a[i] = (i == 3) ? -0.0 : 0.0;
+		}
+		c = fpclassify(a[i]);
+		if (c == FP_NAN) {
+			++expect[ef_nan];
+		} else if (c == FP_INFINITE) {
+			++expect[ef_inf];
+		} else if (c == FP_ZERO) {
+			++expect[ef_zero];
+		} else if (c == FP_SUBNORMAL) {
+			++expect[ef_subnorm];
+		} else {
+			++expect[ef_normal];
+		}
+	}
+
+	efloat64_profile_array(a, Test_array_len, &whole);
+	for (i = 0; i <= ef_normal; ++i) {
+		err += check_u64("class", whole.class_count[i], expect[i]);
+	}
+	for (i = 0; i < Test_array_len; ++i) {
+		if (!isnan(a[i])) {
+			err += (a[i] < whole.min) || (a[i] > whole.max);
+		}
+	}
+
+	for (j = 0; j < 5; ++j) {
+		cut = (j * Test_array_len) / 4;
+		efloat64_profile_array(a, cut, &merged);
+		efloat64_profile_array(a + cut, Test_array_len - cut, &part);
+		efloat64_profile_merge(&merged, &part);
+		err += check_efloat64_profile_equal(&merged, &whole);
+	}
+
+	return err;
+}
+
+int main(void)
+{
+	int err;
+
+	err = 0;
+	err += test_efloat32_profile_known();
+	err += test_efloat32_profile_vs_fpclassify();
+	err += test_efloat64_profile();
+
+	if (err) {
+		fprintf(stderr, "%d errors\n", err);
+	}
+	return (err == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
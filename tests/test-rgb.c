@@ -0,0 +1,252 @@
+/* SPDX-License-Identifier: LGPL-2.1-or-later */
+/* test-rgb.c: test of the RGB9E5 and R11G11B10 packed color formats */
+/* Copyright (C) 2026 Eric Herman */
+/* https://github.com/ericherman/libefloat */
+
+#include <float.h>
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "efloat.h"
+
+#define Test_random_len 20000
+
+/* the reference decode of a 5 bit exponent unsigned float */
+double ref_small_float(uint32_t v, int signif_bits)
+{
+	uint32_t e, m;
+
+	e = v >> signif_bits;
+	m = v & ((1U << signif_bits) - 1);
+	if (e == 31) {
+		return m ? NAN : INFINITY;
+	} else if (e == 0) {
+		return ldexp((double)m, -14 - signif_bits);
+	}
+	return ldexp((double)((1U << signif_bits) | m),
+		     (int)e - 15 - signif_bits);
+}
+
+/* every code decodes as the table says, and re-encodes to itself */
+int test_small_float_exhaustive(void)
+{
+	efloat32 rgb[3];
+	uint32_t code, packed, again;
+	double expect;
+	int err, i, bits, shift;
+
+	err = 0;
+	for (code = 0; code < 2048; ++code) {
+		for (i = 0; i < 3; ++i) {
+			bits = (i == 2) ? 5 : 6;
+			shift = 11 * i;
+			if (i == 2 && code >= 1024) {
+				continue;
+			}
+			packed = code << shift;
+			efloat32_r11g11b10_decode(rgb, &packed, 1);
+			expect = ref_small_float(code, bits);
+			if (isnan(expect) ? !isnan(rgb[i])
+			    : ((double)rgb[i] != expect)) {
+				++err;
+				fprintf(stderr, "decode 0x%x (%d): %g != %g\n",
+					(unsigned)code, i, (double)rgb[i],
+					expect);
+			}
+			if (isnan(expect)) {
+				continue;
+			}
+			efloat32_r11g11b10_encode(&again, rgb, 1);
+			if (again != packed) {
+				++err;
+				fprintf(stderr, "encode %g: 0x%x != 0x%x\n",
+					(double)rgb[i], (unsigned)again,
+					(unsigned)packed);
+			}
+		}
+	}
+	return err;
+}
+
+/* the nearest code, ties to even, by searching the table */
+uint32_t ref_to_small_float(double d, int signif_bits)
+{
+	uint32_t code, best, max_finite;
+	double diff, best_diff, v;
+
+	if (isnan(d)) {
+		return (31U << signif_bits) | (1U << (signif_bits - 1));
+	}
+	if (!(d > 0)) {
+		return 0;
+	}
+	if (isinf(d)) {
+		return 31U << signif_bits;
+	}
+	max_finite = (31U << signif_bits) - 1;
+	if (d >= ref_small_float(max_finite, signif_bits)) {
+		return max_finite;
+	}
+	best = 0;
+	best_diff = d;
+	for (code = 1; code <= max_finite; ++code) {
+		v = ref_small_float(code, signif_bits);
+		diff = fabs(v - d);
+		if (diff < best_diff || (diff == best_diff && !(code & 1))) {
+			best = code;
+			best_diff = diff;
+		}
+	}
+	return best;
+}
+
+int test_small_float_rounding(void)
+{
+	efloat32 rgb[3 * 64];
+	uint32_t packed[64];
+	uint32_t u, expect;
+	size_t i, j;
+	int err, c;
+
+	err = 0;
+	u = 99;
+	for (i = 0; i < 2000; i += 64) {
+		for (j = 0; j < 3 * 64; ++j) {
+			u = (u * 1103515245UL) + 12345UL;
+			/* mostly within range, some beyond, some negative */
+			rgb[j] = (efloat32)ldexp((double)(u >> 8),
+						 (int)((u >> 3) % 46) - 50);
+			if ((u & 0x7) == 0) {
+				rgb[j] = -rgb[j];
+			}
+		}
+		/* ties, between 1.0 and the next code up */
+		rgb[0] = 1.0f + (1.0f / 128.0f);
+		rgb[1] = 1.0f + (3.0f / 128.0f);
+		rgb[2] = 1.0f + (1.0f / 64.0f);
+		rgb[3] = FLT_MAX;
+		rgb[4] = (efloat32)INFINITY;
+		rgb[5] = (efloat32)NAN;
+		efloat32_r11g11b10_encode(packed, rgb, 64);
+		for (j = 0; j < 3 * 64; ++j) {
+			c = (int)(j % 3);
+			expect = ref_to_small_float(rgb[j], (c == 2) ? 5 : 6);
+			u = (packed[j / 3] >> (11 * c)) & 0x7FF;
+			if (u != expect) {
+				++err;
+				fprintf(stderr, "%g: 0x%x != 0x%x\n",
+					(double)rgb[j], (unsigned)u,
+					(unsigned)expect);
+			}
+		}
+	}
+	return err;
+}
+
+/* the reference RGB9E5 encode, as written in the extension */
+uint32_t ref_rgb9e5(const efloat32 *rgb)
+{
+	double c[3], maxrgb, denom;
+	uint32_t m[3];
+	int i, e, shared, maxm;
+
+	maxrgb = 0;
+	for (i = 0; i < 3; ++i) {
+		c[i] = isnan(rgb[i]) ? 0 : rgb[i];
+		c[i] = (c[i] < 0) ? 0 : c[i];
+		c[i] = (c[i] > efloat_rgb9e5_max) ? efloat_rgb9e5_max : c[i];
+		maxrgb = (c[i] > maxrgb) ? c[i] : maxrgb;
+	}
+	if (maxrgb > 0) {
+		frexp(maxrgb, &e);
+		e = e - 1;
+	} else {
+		e = -16;
+	}
+	shared = ((e < -16) ? -16 : e) + 1 + 15;
+	maxm = (int)floor((maxrgb / ldexp(1.0, shared - 24)) + 0.5);
+	if (maxm == 512) {
+		++shared;
+	}
+	denom = ldexp(1.0, shared - 24);
+	for (i = 0; i < 3; ++i) {
+		m[i] = (uint32_t)floor((c[i] / denom) + 0.5);
+	}
+	return m[0] | (m[1] << 9) | (m[2] << 18) | (((uint32_t)shared) << 27);
+}
+
+int test_rgb9e5(void)
+{
+	efloat32 rgb[3 * 64], back[3 * 64];
+	uint32_t packed[64], again;
+	uint32_t u, e, m;
+	size_t i, j;
+	int err;
+
+	err = 0;
+	u = 5;
+	for (i = 0; i < Test_random_len; i += 64) {
+		for (j = 0; j < 3 * 64; ++j) {
+			u = (u * 1103515245UL) + 12345UL;
+			rgb[j] = (efloat32)ldexp((double)(u >> 8),
+						 (int)((u >> 3) % 50) - 50);
+			if ((u & 0xF) == 0) {
+				rgb[j] = -rgb[j];
+			}
+		}
+		rgb[0] = (efloat32)NAN;
+		rgb[1] = (efloat32)INFINITY;
+		rgb[3] = 0;
+		rgb[4] = 0;
+		rgb[5] = 0;
+		rgb[6] = efloat_rgb9e5_max;
+		/* rounds up to 512, bumping the exponent */
+		rgb[9] = 511.5f;
+		efloat32_rgb9e5_encode(packed, rgb, 64);
+		for (j = 0; j < 64; ++j) {
+			if (packed[j] != ref_rgb9e5(rgb + (3 * j))) {
+				++err;
+				fprintf(stderr, "(%g, %g, %g): 0x%x != 0x%x\n",
+					(double)rgb[3 * j],
+					(double)rgb[(3 * j) + 1],
+					(double)rgb[(3 * j) + 2],
+					(unsigned)packed[j],
+					(unsigned)ref_rgb9e5(rgb + (3 * j)));
+			}
+		}
+	}
+
+	/* every exponent and significand decodes exactly */
+	for (e = 0; e < 32; ++e) {
+		for (m = 0; m < 512; ++m) {
+			packed[0] = (e << 27) | m | ((511 - m) << 9)
+			    | (m << 18);
+			efloat32_rgb9e5_decode(back, packed, 1);
+			err += ((double)back[0] != ldexp(m, (int)e - 24));
+			err += ((double)back[1] != ldexp(511 - m, (int)e - 24));
+			/* and the values survive another round trip */
+			efloat32_rgb9e5_encode(&again, back, 1);
+			efloat32_rgb9e5_decode(rgb, &again, 1);
+			err += (rgb[0] != back[0]) || (rgb[1] != back[1])
+			    || (rgb[2] != back[2]);
+		}
+	}
+	return err;
+}
+
+int main(void)
+{
+	int err;
+
+	err = 0;
+	err += test_small_float_exhaustive();
+	err += test_small_float_rounding();
+	err += test_rgb9e5();
+
+	if (err) {
+		fprintf(stderr, "%d errors\n", err);
+	}
+	return (err == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
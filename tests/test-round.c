@@ -0,0 +1,679 @@
+/* SPDX-License-Identifier: LGPL-2.1-or-later */
+/* test-round.c: test of rounding wide significands against the hardware */
+/* Copyright (C) 2026 Eric Herman */
+/* https://github.com/ericherman/libefloat */
+
+#include <fenv.h>
+#include <float.h>
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "efloat.h"
+#include "test-rng.h"
+
+#define Test_random_len 200000
+#define Test_array_len 150
+
+static const enum efloat_round_mode modes[] = {
+	ef_round_nearest_even, ef_round_toward_zero, ef_round_up,
+	ef_round_down
+};
+
+static const int fe_modes[] = {
+	FE_TONEAREST, FE_TOWARDZERO, FE_UPWARD, FE_DOWNWARD
+};
+
+#define Modes_len (sizeof(modes) / sizeof(modes[0]))
+
+unsigned clz64(uint64_t u)
+{
+	unsigned n;
+
+	for (n = 0; n < 64 && !(u & 0x8000000000000000UL); ++n) {
+		u <<= 1;
+	}
+	return n;
+}
+
+unsigned fe_flags(void)
+{
+	unsigned flags;
+
+	flags = 0;
+	if (fetestexcept(FE_INEXACT)) {
+		flags |= efloat_flag_inexact;
+	}
+	if (fetestexcept(FE_UNDERFLOW)) {
+		flags |= efloat_flag_underflow;
+	}
+	if (fetestexcept(FE_OVERFLOW)) {
+		flags |= efloat_flag_overflow;
+	}
+	return flags;
+}
+
+/* a non-zero significand of up to 62 bits */
+uint64_t rand_sig(void)
+{
+	uint64_t sig;
+
+	do {
+		sig = rng() >> (2 + (rng() % 62));
+	} while (sig == 0);
+	return sig;
+}
+
+/* a random exponent near "center" */
+
+long rand_exp(long center, long spread)
+{
+	return center + (long)(rng() % (2 * spread + 1)) - spread;
+}
+
+#if LDBL_MANT_DIG >= 64
+/* the long double is exact, so the hardware narrowing is the reference */
+uint32_t hw32(int neg, long exponent, uint64_t sig, size_t mode,
+	      unsigned *flags)
+{
+	volatile long double w;
+	volatile float f;
+
+	w = ldexpl((long double)sig, (int)exponent);
+	if (neg) {
+		w = -w;
+	}
+	fesetround(fe_modes[mode]);
+	feclearexcept(FE_ALL_EXCEPT);
+	f = (float)w;
+	*flags = fe_flags();
+	fesetround(FE_TONEAREST);
+	return efloat32_to_uint32_bits(f);
+}
+
+uint64_t hw64(int neg, long exponent, uint64_t sig, size_t mode,
+	      unsigned *flags)
+{
+	volatile long double w;
+	volatile double d;
+
+	w = ldexpl((long double)sig, (int)exponent);
+	if (neg) {
+		w = -w;
+	}
+	fesetround(fe_modes[mode]);
+	feclearexcept(FE_ALL_EXCEPT);
+	d = (double)w;
+	*flags = fe_flags();
+	fesetround(FE_TONEAREST);
+	return efloat64_to_uint64_bits(d);
+}
+
+int check32(int neg, long exponent, uint64_t sig)
+{
+	uint32_t got, expect;
+	unsigned got_flags, expect_flags;
+	size_t m;
+	int err, sticky, shift;
+
+	err = 0;
+	/* a 1 bit far below the last bit kept is the same as a sticky */
+	shift = 0;
+	while ((sig << shift) < 0x4000000000000000UL) {
+		++shift;
+	}
+	for (m = 0; m < Modes_len; ++m) {
+		for (sticky = 0; sticky < 2; ++sticky) {
+			if (sticky) {
+				expect = hw32(neg, exponent - shift,
+					      (sig << shift) | 1, m,
+					      &expect_flags);
+			} else {
+				expect = hw32(neg, exponent, sig, m,
+					      &expect_flags);
+			}
+			got_flags = 0;
+			got = efloat32_to_uint32_bits(efloat32_from_wide
+						      (neg ? -1 : 1, exponent,
+						       sig, sticky, modes[m],
+						       &got_flags));
+			if (got != expect || got_flags != expect_flags) {
+				++err;
+				fprintf(stderr, "%c0x%016llx * 2^%ld%s mode %u:"
+					" 0x%08lx (%x) != 0x%08lx (%x)\n",
+					neg ? '-' : '+',
+					(unsigned long long)sig, exponent,
+					sticky ? " + sticky" : "",
+					(unsigned)m, (unsigned long)got,
+					got_flags, (unsigned long)expect,
+					expect_flags);
+			}
+		}
+	}
+	return err;
+}
+
+int check64(int neg, long exponent, uint64_t sig)
+{
+	uint64_t got, expect;
+	unsigned got_flags, expect_flags;
+	size_t m;
+	int err, sticky, shift;
+
+	err = 0;
+	/* a 1 bit far below the last bit kept is the same as a sticky */
+	shift = 0;
+	while ((sig << shift) < 0x4000000000000000UL) {
+		++shift;
+	}
+	for (m = 0; m < Modes_len; ++m) {
+		for (sticky = 0; sticky < 2; ++sticky) {
+			if (sticky) {
+				expect = hw64(neg, exponent - shift,
+					      (sig << shift) | 1, m,
+					      &expect_flags);
+			} else {
+				expect = hw64(neg, exponent, sig, m,
+					      &expect_flags);
+			}
+			got_flags = 0;
+			got = efloat64_to_uint64_bits(efloat64_from_wide
+						      (neg ? -1 : 1, exponent,
+						       sig, sticky, modes[m],
+						       &got_flags));
+			if (got != expect || got_flags != expect_flags) {
+				++err;
+				fprintf(stderr, "%c0x%016llx * 2^%ld%s mode %u:"
+					" 0x%016llx (%x) != 0x%016llx (%x)\n",
+					neg ? '-' : '+',
+					(unsigned long long)sig, exponent,
+					sticky ? " + sticky" : "",
+					(unsigned)m, (unsigned long long)got,
+					got_flags, (unsigned long long)expect,
+					expect_flags);
+			}
+		}
+	}
+	return err;
+}
+
+int test_hardware(void)
+{
+	/* exponents of the last bit: normal, subnormal, and overflowing */
+	static const long centers32[] = { -30, -150, -170, 100 };
+	static const long centers64[] = { -30, -1075, -1100, 990 };
+	uint64_t sig;
+	size_t i;
+	int err, neg;
+
+	err = 0;
+	for (i = 0; i < Test_random_len && err < 10; ++i) {
+		neg = (int)(rng() & 1);
+		sig = rand_sig();
+		err += check32(neg, rand_exp(centers32[i % 4], 40), sig);
+		err += check64(neg, rand_exp(centers64[i % 4], 40), sig);
+	}
+	/* just below the smallest normal, tininess is after rounding */
+	for (i = 0; i < 64; ++i) {
+		sig = (((uint64_t)1) << (25 + i % 8)) - 1 - (i / 8);
+		err += check32((int)(i & 1), -151 - (long)(i % 8), sig);
+		sig = (((uint64_t)1) << (54 + i % 8)) - 1 - (i / 8);
+		err += check64((int)(i & 1), -1076 - (long)(i % 8), sig);
+	}
+	return err;
+}
+/* integers, against the hardware conversion of the exact long double */
+int test_integers(void)
+{
+	int64_t src[Test_array_len];
+	efloat32 dst32[Test_array_len];
+	efloat64 dst64[Test_array_len];
+	uint8_t flags[Test_array_len];
+	uint64_t u, hi, lo, top;
+	unsigned got_flags, expect_flags, all, expect_all;
+	size_t i, m;
+	unsigned k;
+	int err, neg;
+
+	err = 0;
+	for (i = 0; i < Test_random_len && err < 10; ++i) {
+		m = i % Modes_len;
+		u = rng() >> (rng() % 64);
+
+		got_flags = 0;
+		err += efloat32_to_uint32_bits(uint64_to_efloat32_round
+					       (u, modes[m], &got_flags))
+		    != hw32(0, 0, u, m, &expect_flags);
+		err += got_flags != expect_flags;
+		got_flags = 0;
+		err += efloat64_to_uint64_bits(int64_to_efloat64_round
+					       (-(int64_t)(u >> 1), modes[m],
+						&got_flags))
+		    != hw64((u >> 1) != 0, 0, u >> 1, m, &expect_flags);
+		err += got_flags != expect_flags;
+
+		/* 128 bits: the low bits jammed into the top 64 bits */
+		hi = (rng() >> (1 + rng() % 63)) | 1;
+		lo = rng() >> (rng() % 64);
+		neg = (int)(rng() & 1);
+		k = clz64(hi);
+		top = (k == 0) ? hi : ((hi << k) | (lo >> (64 - k)));
+		top |= ((lo << k) != 0) ? 1 : 0;
+
+		got_flags = 0;
+		if (neg) {
+			/* the two's complement of the magnitude */
+			err += efloat32_to_uint32_bits(int128_to_efloat32_round
+						       ((int64_t)(~hi
+								  + (lo == 0)),
+							0 - lo, modes[m],
+							&got_flags))
+			    != hw32(1, 64 - (long)k, top, m, &expect_flags);
+		} else {
+			err += efloat32_to_uint32_bits(uint128_to_efloat32_round
+						       (hi, lo, modes[m],
+							&got_flags))
+			    != hw32(0, 64 - (long)k, top, m, &expect_flags);
+		}
+		err += got_flags != expect_flags;
+		got_flags = 0;
+		err += efloat64_to_uint64_bits(int128_to_efloat64_round
+					       ((int64_t)hi, lo, modes[m],
+						&got_flags))
+		    != hw64(0, 64 - (long)k, top, m, &expect_flags);
+		err += got_flags != expect_flags;
+	}
+	err += int64_to_efloat32_round(INT64_MIN, ef_round_toward_zero, NULL)
+	    != -9223372036854775808.0f;
+	err += int128_to_efloat64_round(INT64_MIN, 0, ef_round_up, NULL)
+	    != -170141183460469231731687303715884105728.0;
+	err += uint128_to_efloat32_round(UINT64_MAX, UINT64_MAX,
+					 ef_round_up, &got_flags)
+	    != (float)HUGE_VAL;
+
+	for (i = 0; i < Test_array_len; ++i) {
+		src[i] = (int64_t)(rng() >> (rng() % 64));
+		if (i & 1) {
+			src[i] = -src[i];
+		}
+	}
+	all = int64_to_efloat32_array_round(dst32, src, Test_array_len,
+					    ef_round_down, flags);
+	expect_all = 0;
+	for (i = 0; i < Test_array_len; ++i) {
+		got_flags = 0;
+		err += dst32[i] != int64_to_efloat32_round(src[i],
+							   ef_round_down,
+							   &got_flags);
+		err += flags[i] != got_flags;
+		expect_all |= got_flags;
+	}
+	err += all != expect_all;
+	all = uint64_to_efloat64_array_round(dst64, (uint64_t *)src,
+					     Test_array_len, ef_round_odd,
+					     NULL);
+	expect_all = 0;
+	for (i = 0; i < Test_array_len; ++i) {
+		err += dst64[i] != uint64_to_efloat64_round((uint64_t)src[i],
+							    ef_round_odd,
+							    &expect_all);
+	}
+	err += all != expect_all;
+	if (err) {
+		fprintf(stderr, "integers: %d errors\n", err);
+	}
+	return err;
+}
+#else
+int test_hardware(void)
+{
+	return 0;
+}
+
+int test_integers(void)
+{
+	return 0;
+}
+#endif
+
+/* a zero significand with a sticky is a non-zero amount too small */
+int test_zero(void)
+{
+	unsigned flags;
+	int err;
+
+	err = 0;
+	flags = 0;
+	err += efloat32_to_uint32_bits(efloat32_from_wide
+				       (1, 100, 0, 0, ef_round_up, &flags))
+	    != 0x00000000UL;
+	err += (flags != 0);
+	err += efloat64_to_uint64_bits(efloat64_from_wide
+				       (-1, 100, 0, 0, ef_round_up, &flags))
+	    != 0x8000000000000000UL;
+	err += (flags != 0);
+	err += efloat32_to_uint32_bits(efloat32_from_wide
+				       (1, 100, 0, 1, ef_round_up, &flags))
+	    != 0x00000001UL;
+	err += (flags != (efloat_flag_inexact | efloat_flag_underflow));
+	err += efloat64_to_uint64_bits(efloat64_from_wide
+				       (-1, 100, 0, 1, ef_round_nearest_even,
+					NULL)) != 0x8000000000000000UL;
+	err += efloat64_to_uint64_bits(efloat64_from_wide
+				       (-1, 100, 0, 1, ef_round_down, NULL))
+	    != 0x8000000000000001UL;
+	if (err) {
+		fprintf(stderr, "zero: %d errors\n", err);
+	}
+	return err;
+}
+
+/* round to odd is toward zero, with the last bit set if inexact */
+int test_odd(void)
+{
+	uint32_t odd32, rtz32;
+	uint64_t odd64, rtz64, sig;
+	unsigned f_odd, f_rtz;
+	long exponent;
+	size_t i;
+	int err;
+
+	err = 0;
+	for (i = 0; i < Test_random_len && err < 10; ++i) {
+		sig = rand_sig();
+		exponent = rand_exp(-150, 300);
+		f_odd = 0;
+		f_rtz = 0;
+		odd32 = efloat32_to_uint32_bits(efloat32_from_wide
+						(1, exponent, sig, 0,
+						 ef_round_odd, &f_odd));
+		rtz32 = efloat32_to_uint32_bits(efloat32_from_wide
+						(1, exponent, sig, 0,
+						 ef_round_toward_zero, &f_rtz));
+		if (f_rtz & efloat_flag_inexact) {
+			rtz32 |= 1;
+		}
+		err += (odd32 != rtz32) || (f_odd != f_rtz);
+
+		exponent = rand_exp(-1075, 2100);
+		f_odd = 0;
+		f_rtz = 0;
+		odd64 = efloat64_to_uint64_bits(efloat64_from_wide
+						(-1, exponent, sig, 1,
+						 ef_round_odd, &f_odd));
+		rtz64 = efloat64_to_uint64_bits(efloat64_from_wide
+						(-1, exponent, sig, 1,
+						 ef_round_toward_zero, &f_rtz));
+		rtz64 |= 1;
+		err += (odd64 != rtz64) || (f_odd != f_rtz);
+	}
+	if (err) {
+		fprintf(stderr, "round to odd: %d errors\n", err);
+	}
+	return err;
+}
+
+int test_nearest_away(void)
+{
+	int err;
+
+	err = 0;
+	/* halfway: ties to even goes down, ties away goes up */
+	err += efloat32_from_wide(1, 0, 0x1000001UL, 0,
+				  ef_round_nearest_even, NULL) != 16777216.0f;
+	err += efloat32_from_wide(1, 0, 0x1000001UL, 0,
+				  ef_round_nearest_away, NULL) != 16777218.0f;
+	err += efloat32_from_wide(-1, 0, 0x1000001UL, 0,
+				  ef_round_nearest_away, NULL) != -16777218.0f;
+	/* both go up from an odd last bit */
+	err += efloat32_from_wide(1, 0, 0x1000003UL, 0,
+				  ef_round_nearest_away, NULL) != 16777220.0f;
+	/* the smallest subnormal: half of it rounds away from zero */
+	err += efloat32_from_wide(1, -150, 1, 0,
+				  ef_round_nearest_away, NULL) != FLT_MIN
+	    / 8388608.0f;
+	err += efloat32_from_wide(1, -150, 1, 0,
+				  ef_round_nearest_even, NULL) != 0.0f;
+	err += efloat64_from_wide(1, 0, 0x20000000000001UL, 0,
+				  ef_round_nearest_away, NULL)
+	    != 9007199254740994.0;
+	err += efloat64_from_wide(1, 0, 0x20000000000001UL, 0,
+				  ef_round_nearest_even, NULL)
+	    != 9007199254740992.0;
+	/* with a sticky it is not a tie */
+	err += efloat64_from_wide(1, -1, 0x3FFFFFFFFFFFFFUL, 1,
+				  ef_round_nearest_even, NULL)
+	    != 9007199254740992.0;
+	if (err) {
+		fprintf(stderr, "nearest away: %d errors\n", err);
+	}
+	return err;
+}
+
+/* the 128 bit significands round as the 64 bit with a sticky */
+int test_wide_fields(void)
+{
+	struct efloat_wide_fields w;
+	unsigned f_wide, f_narrow;
+	uint64_t sig, lo;
+	size_t i, m;
+	int err;
+
+	err = 0;
+	for (i = 0; i < Test_random_len && err < 10; ++i) {
+		m = i % 6;
+		sig = rng() | 0x8000000000000000UL;
+		lo = (i & 1) ? rng() : 0;
+		w.sign = (int8_t)((rng() & 1) ? -1 : 1);
+		w.sticky = (uint8_t)((i & 2) ? 1 : 0);
+		w.exponent = (int32_t)rand_exp(-1100, 2200);
+		w.significand_hi = sig;
+		w.significand_lo = lo;
+		f_wide = 0;
+		f_narrow = 0;
+		err += efloat32_to_uint32_bits(efloat32_from_wide_fields
+					       (w, (enum efloat_round_mode)m,
+						&f_wide))
+		    != efloat32_to_uint32_bits(efloat32_from_wide
+					       (w.sign, w.exponent + 64L, sig,
+						(lo != 0) || w.sticky,
+						(enum efloat_round_mode)m,
+						&f_narrow));
+		err += (f_wide != f_narrow);
+
+		/* and a significand only in the high word is exact */
+		w.significand_lo = 0;
+		w.sticky = 0;
+		w.significand_hi = sig >> (rng() % 64);
+		f_wide = 0;
+		f_narrow = 0;
+		err += efloat64_to_uint64_bits(efloat64_from_wide_fields
+					       (w, (enum efloat_round_mode)m,
+						&f_wide))
+		    != efloat64_to_uint64_bits(efloat64_from_wide
+					       (w.sign, w.exponent + 64L,
+						w.significand_hi, 0,
+						(enum efloat_round_mode)m,
+						&f_narrow));
+		err += (f_wide != f_narrow);
+	}
+	if (err) {
+		fprintf(stderr, "wide fields: %d errors\n", err);
+	}
+	return err;
+}
+
+int test_array(void)
+{
+	struct efloat_wide_fields src[Test_array_len];
+	efloat32 dst32[Test_array_len];
+	efloat64 dst64[Test_array_len];
+	uint8_t flags[Test_array_len];
+	unsigned all, f, expect_all;
+	size_t i;
+	int err;
+
+	err = 0;
+	for (i = 0; i < Test_array_len; ++i) {
+		src[i].sign = (int8_t)((i & 1) ? -1 : 1);
+		src[i].sticky = (uint8_t)(i % 3 == 0);
+		src[i].exponent = (int32_t)rand_exp(-1000, 1100);
+		src[i].significand_hi = (i & 4) ? rand_sig() : 0;
+		src[i].significand_lo = rng();
+	}
+
+	all = efloat32_array_from_wide_fields(dst32, src, Test_array_len,
+					      ef_round_up, flags);
+	expect_all = 0;
+	for (i = 0; i < Test_array_len; ++i) {
+		f = 0;
+		err += efloat32_to_uint32_bits(dst32[i])
+		    != efloat32_to_uint32_bits(efloat32_from_wide_fields
+					       (src[i], ef_round_up, &f));
+		err += (flags[i] != f);
+		expect_all |= f;
+	}
+	err += (all != expect_all);
+
+	all = efloat64_array_from_wide_fields(dst64, src, Test_array_len,
+					      ef_round_nearest_even, NULL);
+	expect_all = 0;
+	for (i = 0; i < Test_array_len; ++i) {
+		err += efloat64_to_uint64_bits(dst64[i])
+		    != efloat64_to_uint64_bits(efloat64_from_wide_fields
+					       (src[i], ef_round_nearest_even,
+						&expect_all));
+	}
+	err += (all != expect_all);
+	if (err) {
+		fprintf(stderr, "array: %d errors\n", err);
+	}
+	return err;
+}
+
+/* a double: any bits, or near the subnormal or overflow of a float */
+uint64_t rand_double_bits(void)
+{
+	uint64_t r;
+
+	r = rng();
+	switch (r & 3) {
+	case 0:
+		return rng();
+	case 1:
+		/* exponents near that of FLT_MIN */
+		return (r & 0x800FFFFFFFFFFFFFUL)
+		    | ((uint64_t)(1023 - 150 + (long)((r >> 52) % 40))
+		       << 52);
+	case 2:
+		/* exponents near that of FLT_MAX */
+		return (r & 0x800FFFFFFFFFFFFFUL)
+		    | ((uint64_t)(1023 + 120 + (long)((r >> 52) % 16))
+		       << 52);
+	default:
+		/* few significand bits, often exact */
+		return (r & 0x8FFFFFFFE0000000UL) | 0x3000000000000000UL;
+	}
+}
+
+int test_narrow(void)
+{
+	volatile double d;
+	volatile float hw;
+	efloat64 src[Test_array_len];
+	efloat32 dst[Test_array_len];
+	uint8_t flags[Test_array_len];
+	uint32_t got, expect;
+	unsigned got_flags, expect_flags, all;
+	uint64_t bits;
+	size_t i, m;
+	int err;
+
+	err = 0;
+	for (i = 0; i < Test_random_len && err < 10; ++i) {
+		bits = rand_double_bits();
+		d = uint64_bits_to_efloat64(bits);
+		for (m = 0; m < Modes_len; ++m) {
+			fesetround(fe_modes[m]);
+			feclearexcept(FE_ALL_EXCEPT);
+			hw = (float)d;
+			expect_flags = fe_flags();
+			fesetround(FE_TONEAREST);
+			expect = efloat32_to_uint32_bits(hw);
+
+			got_flags = 0;
+			got = efloat32_to_uint32_bits(efloat64_to_efloat32_round
+						      (d, modes[m],
+						       &got_flags));
+			if (isnan(d)) {
+				/* the quiet NaN keeps the top of the payload */
+				err += (got != expect);
+			} else if (got != expect || got_flags != expect_flags) {
+				++err;
+				fprintf(stderr, "narrow 0x%016llx mode %u:"
+					" 0x%08lx (%x) != 0x%08lx (%x)\n",
+					(unsigned long long)bits, (unsigned)m,
+					(unsigned long)got, got_flags,
+					(unsigned long)expect, expect_flags);
+			}
+		}
+		if (!isnan(d)) {
+			/* round to odd: toward zero, then set the last bit */
+			got_flags = 0;
+			got = efloat32_to_uint32_bits(efloat64_to_efloat32_round
+						      (d, ef_round_odd,
+						       &got_flags));
+			expect_flags = 0;
+			expect = efloat32_to_uint32_bits
+			    (efloat64_to_efloat32_round(d, ef_round_toward_zero,
+							&expect_flags));
+			if (expect_flags & efloat_flag_inexact) {
+				expect |= 1;
+			}
+			err += (got != expect) || (got_flags != expect_flags);
+		}
+	}
+
+	for (i = 0; i < Test_array_len; ++i) {
+		src[i] = uint64_bits_to_efloat64(rand_double_bits());
+	}
+	all = efloat64_array_to_efloat32_round(dst, src, Test_array_len,
+					       ef_round_down, flags);
+	expect_flags = 0;
+	for (i = 0; i < Test_array_len; ++i) {
+		got_flags = 0;
+		got = efloat32_to_uint32_bits(efloat64_to_efloat32_round
+					      (src[i], ef_round_down,
+					       &got_flags));
+		err += (efloat32_to_uint32_bits(dst[i]) != got);
+		err += (flags[i] != got_flags);
+		expect_flags |= got_flags;
+	}
+	err += (all != expect_flags);
+	if (err) {
+		fprintf(stderr, "narrow: %d errors\n", err);
+	}
+	return err;
+}
+
+int main(void)
+{
+	int err;
+
+	rng_seed(0x9E3779B97F4A7C15UL);
+	err = 0;
+	err += test_hardware();
+	err += test_zero();
+	err += test_odd();
+	err += test_nearest_away();
+	err += test_wide_fields();
+	err += test_array();
+	err += test_narrow();
+	err += test_integers();
+
+	if (err) {
+		fprintf(stderr, "%d errors\n", err);
+	}
+	return (err == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
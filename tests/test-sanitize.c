@@ -0,0 +1,235 @@
+/* SPDX-License-Identifier: LGPL-2.1-or-later */
+/* test-sanitize.c: test of flushing, replacing and clamping arrays */
+/* Copyright (C) 2026 Eric Herman */
+/* https://github.com/ericherman/libefloat */
+
+#include <float.h>
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "efloat.h"
+#include "test-rng.h"
+
+#define Test_array_len 1000
+#define Test_rounds 64
+
+/* every class turns up often, and values near the clamp bounds */
+uint64_t rand_bits64(void)
+{
+	uint64_t u, sign;
+
+	u = rng();
+	sign = u & 0x8000000000000000UL;
+	switch (u % 8) {
+	case 0:
+		return sign;
+	case 1:
+		return sign | 0x7FF0000000000000UL;
+	case 2:
+		return u | 0x7FF0000000000001UL;
+	case 3:
+		return u & 0x800FFFFFFFFFFFFFUL;
+	case 4:
+		return sign | 0x4000000000000000UL | ((u >> 13) & 0xFFFFF);
+	default:
+		return u;
+	}
+}
+
+int classify_index(double d)
+{
+	switch (fpclassify(d)) {
+	case FP_NAN:
+		return ef_nan;
+	case FP_INFINITE:
+		return ef_inf;
+	case FP_ZERO:
+		return ef_zero;
+	case FP_SUBNORMAL:
+		return ef_subnorm;
+	default:
+		return ef_normal;
+	}
+}
+
+/* the same by value, one at a time, assuming the bounds are not zero */
+double ref_sanitize64(double d, const struct efloat64_sanitize *o)
+{
+	if ((o->flags & efloat_sanitize_flush)
+	    && fpclassify(d) == FP_SUBNORMAL) {
+		d = signbit(d) ? -0.0 : 0.0;
+	}
+	if ((o->flags & efloat_sanitize_inf) && isinf(d)) {
+		d = (d < 0) ? o->neg_inf : o->pos_inf;
+	}
+	if ((o->flags & efloat_sanitize_nan) && isnan(d)) {
+		d = o->nan_value;
+	}
+	if ((o->flags & efloat_sanitize_clamp) && !isnan(d)) {
+		d = (d < o->lo) ? o->lo : d;
+		d = (d > o->hi) ? o->hi : d;
+	}
+	return d;
+}
+
+int test_sanitize64(void)
+{
+	static double a[Test_array_len], orig[Test_array_len];
+	struct efloat64_sanitize o;
+	uint64_t counts[ef_normal + 1], expect[ef_normal + 1];
+	uint64_t x, y;
+	size_t i, j, len, changed, ref_changed;
+	int err;
+
+	err = 0;
+	for (j = 0; j < Test_rounds; ++j) {
+		efloat64_sanitize_init(&o);
+		o.flags = (unsigned)(j % 16);
+		if (j % 3) {
+			o.nan_value = -1.5;
+			o.pos_inf = 1e6;
+			o.neg_inf = -HUGE_VAL;
+		}
+		o.lo = (j % 2) ? -3.0 : 2.5;
+		o.hi = 3.0;
+		for (i = 0; i <= ef_normal; ++i) {
+			counts[i] = 1;
+			expect[i] = 1;
+		}
+		len = rng() % Test_array_len;
+		for (i = 0; i < len; ++i) {
+			a[i] = uint64_bits_to_efloat64(rand_bits64());
+			orig[i] = a[i];
+			++expect[classify_index(a[i])];
+		}
+		changed = efloat64_array_sanitize(a, len, &o, counts);
+		ref_changed = 0;
+		for (i = 0; i < len; ++i) {
+			x = efloat64_to_uint64_bits(a[i]);
+			y = efloat64_to_uint64_bits(ref_sanitize64
+						    (orig[i], &o));
+			err += x != y;
+			ref_changed += y != efloat64_to_uint64_bits(orig[i]);
+		}
+		err += changed != ref_changed;
+		for (i = 0; i <= ef_normal; ++i) {
+			err += counts[i] != expect[i];
+		}
+	}
+	if (err) {
+		fprintf(stderr, "sanitize64: %d errors\n", err);
+	}
+	return err;
+}
+
+int test_sanitize32(void)
+{
+	static float a[Test_array_len], orig[Test_array_len];
+	struct efloat32_sanitize o;
+	uint64_t counts[ef_normal + 1];
+	size_t i, j;
+	int err;
+	float f;
+
+	err = 0;
+	for (j = 0; j < Test_rounds; ++j) {
+		efloat32_sanitize_init(&o);
+		o.flags = efloat_sanitize_flush | efloat_sanitize_nan
+		    | efloat_sanitize_inf;
+		if (j % 2) {
+			o.flags |= efloat_sanitize_clamp;
+			o.lo = -1.0f;
+			o.hi = 1e30f;
+		}
+		for (i = 0; i <= ef_normal; ++i) {
+			counts[i] = 0;
+		}
+		for (i = 0; i < Test_array_len; ++i) {
+			a[i] = uint32_bits_to_efloat32((uint32_t)
+						       (rand_bits64() >> 32));
+			orig[i] = a[i];
+		}
+		efloat32_array_sanitize(a, Test_array_len, &o, counts);
+		for (i = 0; i < Test_array_len; ++i) {
+			f = orig[i];
+			err += fpclassify(a[i]) == FP_SUBNORMAL;
+			err += !isfinite(a[i]);
+			if (fpclassify(f) == FP_SUBNORMAL) {
+				err += a[i] != 0.0f || signbit(a[i])
+				    != signbit(f);
+			} else if (isnan(f)) {
+				err += a[i] != 0.0f;
+			} else if (isinf(f) && !(j % 2)) {
+				err += a[i] != ((f < 0) ? -FLT_MAX : FLT_MAX);
+			} else if (j % 2) {
+				f = (f < -1.0f) ? -1.0f : f;
+				f = (f > 1e30f) ? 1e30f : f;
+				err += a[i] != f;
+			} else {
+				err += a[i] != f;
+			}
+		}
+		err += counts[ef_nan] + counts[ef_inf] + counts[ef_zero]
+		    + counts[ef_subnorm] + counts[ef_normal] != Test_array_len;
+	}
+	if (err) {
+		fprintf(stderr, "sanitize32: %d errors\n", err);
+	}
+	return err;
+}
+
+int test_invalid(void)
+{
+	struct efloat64_sanitize o;
+	double a[2];
+	int err;
+
+	err = 0;
+	a[0] = -0.0;
+	a[1] = 5.0;
+	err += efloat64_array_sanitize(a, 2, NULL, NULL) != 0;
+
+	efloat64_sanitize_init(&o);
+	o.flags = efloat_sanitize_clamp;
+	o.lo = 1.0;
+	o.hi = -1.0;
+	err += efloat64_array_sanitize(a, 2, &o, NULL) != 0;
+	o.hi = nan("");
+	err += efloat64_array_sanitize(a, 2, &o, NULL) != 0;
+	err += a[1] != 5.0;
+
+	/* the clamp is in total order */
+	o.lo = 0.0;
+	o.hi = 4.0;
+	err += efloat64_array_sanitize(a, 2, &o, NULL) != 2;
+	err += a[0] != 0.0 || signbit(a[0]) || a[1] != 4.0;
+
+	/* with no flags, nothing changes */
+	efloat64_sanitize_init(&o);
+	a[0] = nan("");
+	a[1] = DBL_MIN / 4;
+	err += efloat64_array_sanitize(a, 2, &o, NULL) != 0;
+	err += a[1] != DBL_MIN / 4;
+	if (err) {
+		fprintf(stderr, "invalid: %d errors\n", err);
+	}
+	return err;
+}
+
+int main(void)
+{
+	int err;
+
+	rng_seed(0x6A09E667F3BCC909UL);
+	err = 0;
+	err += test_sanitize64();
+	err += test_sanitize32();
+	err += test_invalid();
+
+	if (err) {
+		fprintf(stderr, "%d errors\n", err);
+	}
+	return (err == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
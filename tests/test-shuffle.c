@@ -0,0 +1,181 @@
+/* SPDX-License-Identifier: LGPL-2.1-or-later */
+/* test-shuffle.c: test of the byte, bit and field plane shuffles */
+/* Copyright (C) 2026 Eric Herman */
+/* https://github.com/ericherman/libefloat */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "efloat.h"
+
+#define Test_array_len 1000
+
+static size_t test_lens[] = { 0, 1, 7, 8, 9, 63, 64, 65, 130, 1000 };
+
+#define Test_lens_len (sizeof(test_lens) / sizeof(test_lens[0]))
+
+void fill_efloat64(efloat64 *a, size_t len)
+{
+	uint64_t u;
+	size_t i;
+
+	u = 0x0123456789ABCDEFULL;
+	for (i = 0; i < len; ++i) {
+		u = (u * 6364136223846793005ULL) + 1442695040888963407ULL;
+		a[i] = uint64_bits_to_efloat64(u);
+	}
+}
+
+int test_efloat64_shuffles(void)
+{
+	efloat64 a[Test_array_len], b[Test_array_len];
+	uint8_t buf[Test_array_len * 8];
+	uint16_t rexp[Test_array_len];
+	uint64_t signif[Test_array_len];
+	uint8_t sign[efloat_bit_plane_len(Test_array_len)];
+	size_t i, k, len, plane_len;
+	uint64_t u;
+	unsigned bit, expect;
+	int err;
+
+	err = 0;
+	fill_efloat64(a, Test_array_len);
+	for (k = 0; k < Test_lens_len; ++k) {
+		len = test_lens[k];
+		plane_len = efloat_bit_plane_len(len);
+
+		efloat64_byte_shuffle(buf, a, len);
+		for (i = 0; i < len; ++i) {
+			u = efloat64_to_uint64_bits(a[i]);
+			for (bit = 0; bit < 8; ++bit) {
+				expect = (unsigned)((u >> (8 * bit)) & 0xFF);
+				err += (buf[(bit * len) + i] != expect);
+			}
+		}
+		memset(b, 0, sizeof(b));
+		efloat64_byte_unshuffle(b, buf, len);
+		err += memcmp(a, b, len * sizeof(efloat64)) ? 1 : 0;
+
+		memset(buf, 0xFF, sizeof(buf));
+		efloat64_bit_shuffle(buf, a, len);
+		for (i = 0; i < len; ++i) {
+			u = efloat64_to_uint64_bits(a[i]);
+			for (bit = 0; bit < 64; ++bit) {
+				expect = (unsigned)((u >> bit) & 1);
+				err += (((buf[(bit * plane_len) + (i / 8)]
+					  >> (i % 8)) & 1) != expect);
+			}
+		}
+		/* padding bits of the last byte of each plane are zero */
+		if (len % 8) {
+			for (bit = 0; bit < 64; ++bit) {
+				err += (buf[(bit * plane_len) + (len / 8)]
+					>> (len % 8)) != 0;
+			}
+		}
+		memset(b, 0, sizeof(b));
+		efloat64_bit_unshuffle(b, buf, len);
+		err += memcmp(a, b, len * sizeof(efloat64)) ? 1 : 0;
+
+		efloat64_field_split(sign, rexp, signif, a, len);
+		for (i = 0; i < len; ++i) {
+			u = efloat64_to_uint64_bits(a[i]);
+			err += (((sign[i / 8] >> (i % 8)) & 1) != (u >> 63));
+			err += (rexp[i] != ((u >> 52) & 0x7FF));
+			err += (signif[i] != (u & 0x000FFFFFFFFFFFFFULL));
+		}
+		memset(b, 0, sizeof(b));
+		efloat64_field_join(b, sign, rexp, signif, len);
+		err += memcmp(a, b, len * sizeof(efloat64)) ? 1 : 0;
+
+		if (err) {
+			fprintf(stderr, "efloat64 len %lu: %d errors\n",
+				(unsigned long)len, err);
+			return err;
+		}
+	}
+	return err;
+}
+
+int test_efloat32_shuffles(void)
+{
+	efloat32 a[Test_array_len], b[Test_array_len];
+	uint8_t buf[Test_array_len * 4];
+	uint8_t rexp[Test_array_len];
+	uint32_t signif[Test_array_len];
+	uint8_t sign[efloat_bit_plane_len(Test_array_len)];
+	size_t i, k, len, plane_len;
+	uint32_t u;
+	unsigned bit, expect;
+	int err;
+
+	err = 0;
+	u = 0x12345678;
+	for (i = 0; i < Test_array_len; ++i) {
+		u = (u * 1103515245UL) + 12345UL;
+		a[i] = uint32_bits_to_efloat32(u);
+	}
+	for (k = 0; k < Test_lens_len; ++k) {
+		len = test_lens[k];
+		plane_len = efloat_bit_plane_len(len);
+
+		efloat32_byte_shuffle(buf, a, len);
+		for (i = 0; i < len; ++i) {
+			u = efloat32_to_uint32_bits(a[i]);
+			for (bit = 0; bit < 4; ++bit) {
+				expect = (unsigned)((u >> (8 * bit)) & 0xFF);
+				err += (buf[(bit * len) + i] != expect);
+			}
+		}
+		memset(b, 0, sizeof(b));
+		efloat32_byte_unshuffle(b, buf, len);
+		err += memcmp(a, b, len * sizeof(efloat32)) ? 1 : 0;
+
+		efloat32_bit_shuffle(buf, a, len);
+		for (i = 0; i < len; ++i) {
+			u = efloat32_to_uint32_bits(a[i]);
+			for (bit = 0; bit < 32; ++bit) {
+				expect = (unsigned)((u >> bit) & 1);
+				err += (((buf[(bit * plane_len) + (i / 8)]
+					  >> (i % 8)) & 1) != expect);
+			}
+		}
+		memset(b, 0, sizeof(b));
+		efloat32_bit_unshuffle(b, buf, len);
+		err += memcmp(a, b, len * sizeof(efloat32)) ? 1 : 0;
+
+		efloat32_field_split(sign, rexp, signif, a, len);
+		for (i = 0; i < len; ++i) {
+			u = efloat32_to_uint32_bits(a[i]);
+			err += (((sign[i / 8] >> (i % 8)) & 1) != (u >> 31));
+			err += (rexp[i] != ((u >> 23) & 0xFF));
+			err += (signif[i] != (u & 0x007FFFFFUL));
+		}
+		memset(b, 0, sizeof(b));
+		efloat32_field_join(b, sign, rexp, signif, len);
+		err += memcmp(a, b, len * sizeof(efloat32)) ? 1 : 0;
+
+		if (err) {
+			fprintf(stderr, "efloat32 len %lu: %d errors\n",
+				(unsigned long)len, err);
+			return err;
+		}
+	}
+	return err;
+}
+
+int main(void)
+{
+	int err;
+
+	err = 0;
+	err += test_efloat64_shuffles();
+	err += test_efloat32_shuffles();
+
+	if (err) {
+		fprintf(stderr, "%d errors\n", err);
+	}
+	return (err == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,241 @@
+/* SPDX-License-Identifier: LGPL-2.1-or-later */
+/* test-soft.c: test of the software arithmetic against the hardware */
+/* Copyright (C) 2026 Eric Herman */
+/* https://github.com/ericherman/libefloat */
+
+#include <float.h>
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "efloat.h"
+#include "test-rng.h"
+
+#define Test_random_len 2000000
+#define Test_sqrt_stride 257
+
+static const uint32_t specials32[] = {
+	0x00000000UL, 0x80000000UL, 0x00000001UL, 0x80000001UL,
+	0x007FFFFFUL, 0x00800000UL, 0x00800001UL, 0x3F800000UL,
+	0xBF800000UL, 0x3F800001UL, 0x3FFFFFFFUL, 0x40000000UL,
+	0x7F7FFFFFUL, 0xFF7FFFFFUL, 0x7F000000UL, 0x7F800000UL,
+	0xFF800000UL, 0x7FC00000UL, 0xFFC00001UL, 0x7F800001UL,
+	0x33800000UL, 0x34000000UL, 0x4B800000UL, 0x0C800000UL
+};
+
+static const uint64_t specials64[] = {
+	0x0000000000000000UL, 0x8000000000000000UL, 0x0000000000000001UL,
+	0x8000000000000001UL, 0x000FFFFFFFFFFFFFUL, 0x0010000000000000UL,
+	0x0010000000000001UL, 0x3FF0000000000000UL, 0xBFF0000000000000UL,
+	0x3FF0000000000001UL, 0x3FFFFFFFFFFFFFFFUL, 0x4000000000000000UL,
+	0x7FEFFFFFFFFFFFFFUL, 0xFFEFFFFFFFFFFFFFUL, 0x7FE0000000000000UL,
+	0x7FF0000000000000UL, 0xFFF0000000000000UL, 0x7FF8000000000000UL,
+	0xFFF8000000000001UL, 0x7FF0000000000001UL, 0x3CA0000000000000UL,
+	0x3CB0000000000000UL, 0x4340000000000000UL, 0x0350000000000000UL
+};
+
+#define Specials32_len (sizeof(specials32) / sizeof(specials32[0]))
+#define Specials64_len (sizeof(specials64) / sizeof(specials64[0]))
+
+int same32(uint32_t got, uint32_t expect)
+{
+	if (((got & 0x7FFFFFFFUL) > 0x7F800000UL)
+	    && ((expect & 0x7FFFFFFFUL) > 0x7F800000UL)) {
+		return 1;
+	}
+	return got == expect;
+}
+
+int same64(uint64_t got, uint64_t expect)
+{
+	if (((got & 0x7FFFFFFFFFFFFFFFUL) > 0x7FF0000000000000UL)
+	    && ((expect & 0x7FFFFFFFFFFFFFFFUL) > 0x7FF0000000000000UL)) {
+		return 1;
+	}
+	return got == expect;
+}
+
+/* random operands: any bits, or near one another to force cancellation */
+uint32_t rand32(uint32_t near)
+{
+	uint64_t r;
+
+	r = rng();
+	switch (r & 3) {
+	case 0:
+		return (uint32_t)(r >> 32);
+	case 1:
+		return near ^ ((uint32_t)(r >> 40) & 0x00FFFFFFUL);
+	case 2:
+		return (near ^ 0x80000000UL) + (uint32_t)((r >> 60) & 3);
+	default:
+		return (uint32_t)(r >> 32) & 0x0FFFFFFFUL;
+	}
+}
+
+uint64_t rand64(uint64_t near)
+{
+	uint64_t r;
+
+	r = rng();
+	switch (r & 3) {
+	case 0:
+		return rng();
+	case 1:
+		return near ^ (rng() >> 11);
+	case 2:
+		return (near ^ 0x8000000000000000UL) + ((r >> 60) & 3);
+	default:
+		return rng() >> 4;
+	}
+}
+
+int check32(uint32_t a, uint32_t b, uint32_t c)
+{
+	volatile float x, y, z;
+	float r;
+	int err;
+
+	err = 0;
+	x = uint32_bits_to_efloat32(a);
+	y = uint32_bits_to_efloat32(b);
+	z = uint32_bits_to_efloat32(c);
+
+	r = x + y;
+	err += !same32(efloat32_soft_add(a, b), efloat32_to_uint32_bits(r));
+	r = x - y;
+	err += !same32(efloat32_soft_sub(a, b), efloat32_to_uint32_bits(r));
+	r = x * y;
+	err += !same32(efloat32_soft_mul(a, b), efloat32_to_uint32_bits(r));
+	r = x / y;
+	err += !same32(efloat32_soft_div(a, b), efloat32_to_uint32_bits(r));
+	r = fmaf(x, y, z);
+	err += !same32(efloat32_soft_fma(a, b, c), efloat32_to_uint32_bits(r));
+	if (err) {
+		fprintf(stderr, "0x%08lx 0x%08lx 0x%08lx: %d errors\n",
+			(unsigned long)a, (unsigned long)b, (unsigned long)c,
+			err);
+	}
+	return err;
+}
+
+int check64(uint64_t a, uint64_t b, uint64_t c)
+{
+	volatile double x, y, z;
+	double r;
+	int err;
+
+	err = 0;
+	x = uint64_bits_to_efloat64(a);
+	y = uint64_bits_to_efloat64(b);
+	z = uint64_bits_to_efloat64(c);
+
+	r = x + y;
+	err += !same64(efloat64_soft_add(a, b), efloat64_to_uint64_bits(r));
+	r = x - y;
+	err += !same64(efloat64_soft_sub(a, b), efloat64_to_uint64_bits(r));
+	r = x * y;
+	err += !same64(efloat64_soft_mul(a, b), efloat64_to_uint64_bits(r));
+	r = x / y;
+	err += !same64(efloat64_soft_div(a, b), efloat64_to_uint64_bits(r));
+	r = sqrt(x);
+	err += !same64(efloat64_soft_sqrt(a), efloat64_to_uint64_bits(r));
+	r = fma(x, y, z);
+	err += !same64(efloat64_soft_fma(a, b, c), efloat64_to_uint64_bits(r));
+	if (err) {
+		fprintf(stderr, "0x%016llx 0x%016llx 0x%016llx: %d errors\n",
+			(unsigned long long)a, (unsigned long long)b,
+			(unsigned long long)c, err);
+	}
+	return err;
+}
+
+int test_specials(void)
+{
+	size_t i, j, k;
+	int err;
+
+	err = 0;
+	for (i = 0; i < Specials32_len; ++i) {
+		for (j = 0; j < Specials32_len; ++j) {
+			for (k = 0; k < Specials32_len; ++k) {
+				err += check32(specials32[i], specials32[j],
+					       specials32[k]);
+			}
+		}
+	}
+	for (i = 0; i < Specials64_len; ++i) {
+		for (j = 0; j < Specials64_len; ++j) {
+			for (k = 0; k < Specials64_len; ++k) {
+				err += check64(specials64[i], specials64[j],
+					       specials64[k]);
+			}
+		}
+	}
+	return err;
+}
+
+int test_random(void)
+{
+	uint32_t a32, b32, c32;
+	uint64_t a64, b64, c64;
+	size_t i;
+	int err;
+
+	err = 0;
+	for (i = 0; i < Test_random_len && err < 10; ++i) {
+		a32 = (uint32_t)(rng() >> 32);
+		b32 = rand32(a32);
+		/* an addend near the product, to cancel */
+		c32 = rand32(efloat32_soft_mul(a32, b32));
+		err += check32(a32, b32, c32);
+
+		a64 = rng();
+		b64 = rand64(a64);
+		c64 = rand64(efloat64_soft_mul(a64, b64));
+		err += check64(a64, b64, c64);
+	}
+	return err;
+}
+
+int test_sqrt32(void)
+{
+	volatile float x;
+	float r;
+	uint64_t u;
+	uint32_t a;
+	int err;
+
+	err = 0;
+	for (u = 0; u <= 0xFFFFFFFFUL && err < 10; u += Test_sqrt_stride) {
+		a = (uint32_t)u;
+		x = uint32_bits_to_efloat32(a);
+		r = sqrtf(x);
+		if (!same32(efloat32_soft_sqrt(a),
+			    efloat32_to_uint32_bits(r))) {
+			++err;
+			fprintf(stderr, "sqrt 0x%08lx: 0x%08lx != 0x%08lx\n",
+				(unsigned long)a,
+				(unsigned long)efloat32_soft_sqrt(a),
+				(unsigned long)efloat32_to_uint32_bits(r));
+		}
+	}
+	return err;
+}
+
+int main(void)
+{
+	int err;
+
+	rng_seed(0x9E3779B97F4A7C15UL);
+	err = 0;
+	err += test_specials();
+	err += test_random();
+	err += test_sqrt32();
+
+	if (err) {
+		fprintf(stderr, "%d errors\n", err);
+	}
+	return (err == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
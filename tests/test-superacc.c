@@ -0,0 +1,401 @@
+/* SPDX-License-Identifier: LGPL-2.1-or-later */
+/* test-superacc.c: test of exact sums and dot products */
+/* Copyright (C) 2026 Eric Herman */
+/* https://github.com/ericherman/libefloat */
+
+#include <float.h>
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "efloat.h"
+#include "test-rng.h"
+
+#define Test_len 1000
+#define Test_rounds 200
+#define Test_partials 7
+
+static const enum efloat_round_mode modes[] = {
+	ef_round_nearest_even, ef_round_toward_zero, ef_round_up,
+	ef_round_down
+};
+
+#define Modes_len (sizeof(modes) / sizeof(modes[0]))
+
+/* a random finite double of any exponent */
+double rand_finite64(void)
+{
+	uint64_t u;
+
+	do {
+		u = rng();
+	} while ((u & 0x7FF0000000000000UL) == 0x7FF0000000000000UL);
+	return uint64_bits_to_efloat64(u);
+}
+
+/* sig * 2^exp with a random sign and a sig of "bits" bits */
+double rand_scaled(unsigned bits, int exp_min, int exp_span)
+{
+	double d;
+
+	d = (double)(rng() >> (64 - bits));
+	d = ldexp(d, exp_min + (int)(rng() % (unsigned)exp_span));
+	return (rng() & 1) ? -d : d;
+}
+
+#if LDBL_MANT_DIG >= 64
+/*
+ Round to nearest, then step toward the direction of the mode; the
+ compiler may move a conversion across a fesetround() call.
+*/
+float ref32(long double v, size_t mode)
+{
+	float f;
+
+	f = (float)v;
+	if ((long double)f < v && (modes[mode] == ef_round_up
+				    || (modes[mode] == ef_round_toward_zero
+					&& v < 0))) {
+		f = nextafterf(f, (float)HUGE_VAL);
+	} else if ((long double)f > v && (modes[mode] == ef_round_down
+					  || (modes[mode]
+					      == ef_round_toward_zero
+					      && v > 0))) {
+		f = nextafterf(f, (float)-HUGE_VAL);
+	}
+	return f;
+}
+
+double ref64(long double v, size_t mode)
+{
+	double d;
+
+	d = (double)v;
+	if ((long double)d < v && (modes[mode] == ef_round_up
+				    || (modes[mode] == ef_round_toward_zero
+					&& v < 0))) {
+		d = nextafter(d, HUGE_VAL);
+	} else if ((long double)d > v && (modes[mode] == ef_round_down
+					  || (modes[mode]
+					      == ef_round_toward_zero
+					      && v > 0))) {
+		d = nextafter(d, -HUGE_VAL);
+	}
+	return d;
+}
+
+/*
+ The values are chosen to have exact long double sums, so a cast of the
+ long double sum in each rounding mode is the correctly rounded sum.
+*/
+int test_sum32_modes(void)
+{
+	efloat32 src[Test_len];
+	struct efloat_superacc acc;
+	long double exact;
+	unsigned flags;
+	float expect, got;
+	size_t i, j, m;
+	int err;
+
+	err = 0;
+	for (j = 0; j < Test_rounds; ++j) {
+		exact = 0;
+		for (i = 0; i < Test_len; ++i) {
+			src[i] = (float)rand_scaled(24, -33, 20);
+			exact += src[i];
+		}
+		efloat_superacc_zero(&acc);
+		efloat32_superacc_add_array(&acc, src, Test_len);
+		for (m = 0; m < Modes_len; ++m) {
+			expect = ref32(exact, m);
+			flags = 0;
+			got = efloat32_superacc_round(&acc, modes[m], &flags);
+			if (efloat32_to_uint32_bits(got)
+			    != efloat32_to_uint32_bits(expect)
+			    || !(flags & efloat_flag_inexact)
+			    != ((long double)expect == exact)) {
+				++err;
+				fprintf(stderr, "sum32 mode %u: %g != %g\n",
+					(unsigned)m, got, expect);
+			}
+		}
+		if (efloat32_array_sum_exact(src, Test_len) != (float)exact) {
+			++err;
+		}
+	}
+	return err;
+}
+
+int test_dot32(void)
+{
+	efloat32 a[Test_len], b[Test_len];
+	long double exact;
+	size_t i, j;
+	int err;
+
+	err = 0;
+	for (j = 0; j < Test_rounds; ++j) {
+		exact = 0;
+		for (i = 0; i < Test_len; ++i) {
+			a[i] = (float)rand_scaled(12, -8, 9);
+			b[i] = (float)rand_scaled(12, -8, 9);
+			exact += (long double)a[i] * b[i];
+		}
+		if (efloat32_array_dot_exact(a, b, Test_len) != (float)exact) {
+			++err;
+		}
+	}
+	return err;
+}
+
+int test_sum64_modes(void)
+{
+	efloat64 src[Test_len];
+	struct efloat_superacc acc;
+	long double exact;
+	double expect, got;
+	size_t i, j, m;
+	int err;
+
+	err = 0;
+	for (j = 0; j < Test_rounds; ++j) {
+		exact = 0;
+		for (i = 0; i < Test_len; ++i) {
+			src[i] = rand_scaled(40, -44, 5);
+			exact += src[i];
+		}
+		efloat_superacc_zero(&acc);
+		for (i = 0; i < Test_len; ++i) {
+			efloat64_superacc_add(&acc, src[i]);
+		}
+		for (m = 0; m < Modes_len; ++m) {
+			expect = ref64(exact, m);
+			got = efloat64_superacc_round(&acc, modes[m], NULL);
+			if (efloat64_to_uint64_bits(got)
+			    != efloat64_to_uint64_bits(expect)) {
+				++err;
+				fprintf(stderr, "sum64 mode %u: %g != %g\n",
+					(unsigned)m, got, expect);
+			}
+		}
+	}
+	return err;
+}
+#else
+int test_sum32_modes(void)
+{
+	return 0;
+}
+
+int test_dot32(void)
+{
+	return 0;
+}
+
+int test_sum64_modes(void)
+{
+	return 0;
+}
+#endif
+
+/*
+ Terms of every exponent, each with its negation somewhere later, and
+ one more term, sum to that one term exactly; the dot products of
+ (x, y) and (x, -y) pairs likewise cancel.
+*/
+int test_cancel64(void)
+{
+	efloat64 a[2 * Test_len + 1], b[2 * Test_len + 1], t;
+	size_t i, j, k;
+	int err;
+
+	err = 0;
+	for (j = 0; j < Test_rounds / 10; ++j) {
+		for (i = 0; i < Test_len; ++i) {
+			a[2 * i] = rand_finite64();
+			a[2 * i + 1] = -a[2 * i];
+			b[2 * i] = rand_finite64();
+			b[2 * i + 1] = b[2 * i];
+		}
+		a[2 * Test_len] = rand_finite64();
+		b[2 * Test_len] = 1.0;
+		for (i = 2 * Test_len; i > 0; --i) {
+			k = rng() % (i + 1);
+			t = a[i];
+			a[i] = a[k];
+			a[k] = t;
+			t = b[i];
+			b[i] = b[k];
+			b[k] = t;
+		}
+		t = 0.0;
+		for (i = 0; i <= 2 * Test_len; ++i) {
+			if (b[i] == 1.0) {
+				t = a[i];
+			}
+		}
+		err += efloat64_array_dot_exact(a, b, 2 * Test_len + 1) != t;
+		for (i = 0; i <= 2 * Test_len; ++i) {
+			b[i] = (b[i] == 1.0) ? a[i] : 0.0;
+		}
+		err += efloat64_array_sum_exact(a, 2 * Test_len + 1)
+		    != efloat64_array_sum_exact(b, 2 * Test_len + 1);
+	}
+	if (err) {
+		fprintf(stderr, "cancel64: %d errors\n", err);
+	}
+	return err;
+}
+
+/*
+ The same terms, shuffled and split among partial accumulators merged in
+ another order, leave the same accumulator bits.
+*/
+int test_reproducible(void)
+{
+	efloat64 src[Test_len], t;
+	struct efloat_superacc whole, merged, partial[Test_partials];
+	size_t i, j, k, start, end;
+	int err;
+
+	err = 0;
+	for (i = 0; i < Test_len; ++i) {
+		src[i] = rand_finite64();
+	}
+	efloat_superacc_zero(&whole);
+	efloat64_superacc_add_array(&whole, src, Test_len);
+	for (j = 0; j < Test_rounds / 10; ++j) {
+		for (i = Test_len - 1; i > 0; --i) {
+			k = rng() % (i + 1);
+			t = src[i];
+			src[i] = src[k];
+			src[k] = t;
+		}
+		start = 0;
+		for (k = 0; k < Test_partials; ++k) {
+			end = (k == Test_partials - 1) ? Test_len
+			    : start + (rng() % (Test_len - start + 1));
+			efloat_superacc_zero(&partial[k]);
+			efloat64_superacc_add_array(&partial[k], src + start,
+						    end - start);
+			start = end;
+		}
+		efloat_superacc_zero(&merged);
+		for (k = Test_partials; k > 0; --k) {
+			efloat_superacc_merge(&merged, &partial[k - 1]);
+		}
+		if (memcmp(merged.word, whole.word, sizeof(whole.word))
+		    || merged.specials != whole.specials) {
+			++err;
+		}
+	}
+	if (err) {
+		fprintf(stderr, "reproducible: %d errors\n", err);
+	}
+	return err;
+}
+
+int test_specials(void)
+{
+	struct efloat_superacc acc;
+	efloat64 a[3], b[3];
+	unsigned flags;
+	int err;
+
+	err = 0;
+
+	a[0] = DBL_MAX;
+	a[1] = DBL_MAX;
+	a[2] = -DBL_MAX;
+	err += efloat64_array_sum_exact(a, 3) != DBL_MAX;
+	a[2] = DBL_MAX;
+	err += efloat64_array_sum_exact(a, 3) != HUGE_VAL;
+
+	a[0] = -0.0;
+	a[1] = -0.0;
+	err += efloat64_to_uint64_bits(efloat64_array_sum_exact(a, 2))
+	    != efloat64_to_uint64_bits(-0.0);
+	err += efloat64_to_uint64_bits(efloat64_array_sum_exact(a, 0))
+	    != efloat64_to_uint64_bits(0.0);
+	a[0] = 1.0;
+	a[1] = -1.0;
+	err += efloat64_to_uint64_bits(efloat64_array_sum_exact(a, 2))
+	    != efloat64_to_uint64_bits(0.0);
+	efloat_superacc_zero(&acc);
+	efloat64_superacc_add_array(&acc, a, 2);
+	err += efloat64_to_uint64_bits(efloat64_superacc_round
+				       (&acc, ef_round_down, NULL))
+	    != efloat64_to_uint64_bits(-0.0);
+
+	a[0] = HUGE_VAL;
+	a[1] = -HUGE_VAL;
+	efloat_superacc_zero(&acc);
+	efloat64_superacc_add_array(&acc, a, 2);
+	flags = 0;
+	err += !isnan(efloat64_superacc_round(&acc, ef_round_nearest_even,
+					      &flags));
+	err += flags != efloat_flag_invalid;
+	a[1] = 1.0;
+	err += efloat64_array_sum_exact(a, 2) != HUGE_VAL;
+	b[0] = 0.0;
+	b[1] = 1.0;
+	err += !isnan(efloat64_array_dot_exact(a, b, 2));
+
+	/* the product of the smallest subnormals is kept exactly */
+	a[0] = DBL_MIN * DBL_EPSILON;
+	b[0] = a[0];
+	a[1] = 1.0;
+	b[1] = -1.0;
+	a[2] = 1.0;
+	b[2] = 1.0;
+	efloat_superacc_zero(&acc);
+	efloat64_superacc_add_products(&acc, a, b, 3);
+	flags = 0;
+	err += efloat64_superacc_round(&acc, ef_round_up, &flags)
+	    != DBL_MIN * DBL_EPSILON;
+	err += flags != (efloat_flag_inexact | efloat_flag_underflow);
+	err += efloat32_superacc_round(&acc, ef_round_down, NULL) != 0.0f;
+	err += efloat64_array_dot_exact(a, b, 3) != 0.0;
+
+	/* a term far below the last bit still rounds up */
+	a[0] = DBL_MIN * DBL_EPSILON;
+	a[1] = 1.0;
+	efloat_superacc_zero(&acc);
+	efloat64_superacc_add_array(&acc, a, 2);
+	err += efloat64_superacc_round(&acc, ef_round_up, NULL)
+	    != 1.0 + DBL_EPSILON;
+	err += efloat64_superacc_round(&acc, ef_round_down, NULL) != 1.0;
+	err += efloat32_superacc_round(&acc, ef_round_up, NULL)
+	    != 1.0f + FLT_EPSILON;
+	a[1] = -1.0;
+	efloat64_superacc_add_array(&acc, a, 2);
+	err += efloat64_superacc_round(&acc, ef_round_up, NULL)
+	    != 2 * DBL_MIN * DBL_EPSILON;
+
+	if (err) {
+		fprintf(stderr, "specials: %d errors\n", err);
+	}
+	return err;
+}
+
+int main(void)
+{
+	int err;
+
+	rng_seed(0x9E3779B97F4A7C15UL);
+	err = 0;
+	err += test_sum32_modes();
+	err += test_dot32();
+	err += test_sum64_modes();
+	err += test_cancel64();
+	err += test_reproducible();
+	err += test_specials();
+
+	if (err) {
+		fprintf(stderr, "%d errors\n", err);
+	}
+	return (err == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,269 @@
+/* SPDX-License-Identifier: LGPL-2.1-or-later */
+/* test-trim.c: test of the precision trimming functions */
+/* Copyright (C) 2026 Eric Herman */
+/* https://github.com/ericherman/libefloat */
+
+#include <float.h>
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "efloat.h"
+
+#define Test_array_len 2000
+
+static efloat64 a[Test_array_len];
+static efloat64 t[Test_array_len];
+
+void fill_values(void)
+{
+	uint64_t u;
+	size_t i;
+
+	u = 3;
+	for (i = 0; i < Test_array_len; ++i) {
+		u = (u * 6364136223846793005ULL)
+		    + 1442695040888963407ULL;
+		switch (i % 5) {
+		case 0:
+			/* near 1.0 */
+			a[i] = 1.0 + ldexp((double)(u >> 12), -52);
+			break;
+		case 1:
+			/* subnormals */
+			a[i] = uint64_bits_to_efloat64(u >> 13);
+			break;
+		default:
+			a[i] = uint64_bits_to_efloat64(u);
+			break;
+		}
+	}
+	a[0] = DBL_MAX;
+	a[1] = -DBL_MAX;
+	a[2] = INFINITY;
+	a[3] = NAN;
+	a[4] = -0.0;
+	a[5] = 1.5;
+}
+
+/* slow reference, using the quantum of the kept bits */
+double ref_trim(double x, int keep, int truncate)
+{
+	int e;
+	double q, r;
+
+	if (isnan(x) || isinf(x) || x == 0.0) {
+		return x;
+	}
+	e = ilogb(x);
+	if (e < DBL_MIN_EXP - 1) {
+		e = DBL_MIN_EXP - 1;
+	}
+	q = ldexp(1.0, e - keep);
+	r = truncate ? trunc(x / q) * q : rint(x / q) * q;
+	if (isinf(r)) {
+		r = trunc(x / q) * q;
+	}
+	return r;
+}
+
+int check_bits(int keep, enum efloat_trim_mode mode)
+{
+	efloat64 max_abs, max_rel, err, expect_abs, expect;
+	size_t i;
+	int truncate, err_count;
+
+	err_count = 0;
+	truncate = (mode == ef_trim_truncate);
+	max_abs = efloat64_trim_bits(t, a, Test_array_len, keep, mode,
+				     &max_rel);
+	expect_abs = 0;
+	for (i = 0; i < Test_array_len; ++i) {
+		expect = ref_trim(a[i], keep, truncate);
+		if (efloat64_to_uint64_bits(t[i])
+		    != efloat64_to_uint64_bits(expect)) {
+			++err_count;
+			fprintf(stderr, "keep %d trunc %d: %g -> %g\n", keep,
+				truncate, a[i], t[i]);
+		}
+		err = fabs(t[i] - a[i]);
+		if (err > expect_abs) {
+			expect_abs = err;
+		}
+		if (fabs(a[i]) >= DBL_MIN && err > ldexp(fabs(a[i]), -keep)) {
+			++err_count;
+		}
+	}
+	if (max_abs != expect_abs) {
+		++err_count;
+		fprintf(stderr, "max_abs %g != %g\n", max_abs, expect_abs);
+	}
+	/* subnormals have fewer bits, so a larger max_rel */
+	if (keep < 52 && max_rel < ldexp(1.0, -(keep + 1))) {
+		++err_count;
+		fprintf(stderr, "keep %d max_rel %g\n", keep, max_rel);
+	}
+	return err_count;
+}
+
+int test_trim_bits(void)
+{
+	int keep, err;
+
+	err = 0;
+	for (keep = 0; keep <= 52; keep += 4) {
+		err += check_bits(keep, ef_trim_nearest_even);
+		err += check_bits(keep, ef_trim_truncate);
+	}
+	return err;
+}
+
+int check_tolerance(double tol, enum efloat_trim_tolerance kind,
+		    enum efloat_trim_mode mode)
+{
+	efloat64 max_abs, max_rel, err, bound;
+	size_t i, zeros;
+	int err_count;
+
+	err_count = 0;
+	zeros = 0;
+	max_abs = efloat64_trim_tolerance(t, a, Test_array_len, tol, kind,
+					  mode, &max_rel);
+	for (i = 0; i < Test_array_len; ++i) {
+		if (isnan(a[i]) || isinf(a[i])) {
+			err_count += (efloat64_to_uint64_bits(t[i])
+				      != efloat64_to_uint64_bits(a[i]));
+			continue;
+		}
+		err = fabs(t[i] - a[i]);
+		bound = (kind == ef_trim_relative) ? tol * fabs(a[i]) : tol;
+		if (err > bound) {
+			++err_count;
+			fprintf(stderr, "%g -> %g, tol %g kind %d\n", a[i],
+				t[i], tol, (int)kind);
+		}
+		zeros += ((efloat64_to_uint64_bits(t[i]) & 0xFF) == 0);
+	}
+	if (tol >= 1e-3 && zeros < 500) {
+		++err_count;
+		fprintf(stderr, "tol %g zeros %lu\n", tol,
+			(unsigned long)zeros);
+	}
+	if (tol == 0.0 && max_abs != 0.0) {
+		++err_count;
+	}
+	if (kind == ef_trim_relative && max_rel > tol) {
+		++err_count;
+	}
+	return err_count;
+}
+
+int test_trim_tolerance(void)
+{
+	double tols[] = { 0.0, 1e-300, 1e-12, 1e-3, 0.5, 1e10 };
+	efloat64 b[2], max_abs, max_rel;
+	size_t i;
+	int err;
+
+	err = 0;
+	for (i = 0; i < sizeof(tols) / sizeof(tols[0]); ++i) {
+		err += check_tolerance(tols[i], ef_trim_absolute,
+				       ef_trim_nearest_even);
+		err += check_tolerance(tols[i], ef_trim_absolute,
+				       ef_trim_truncate);
+		err += check_tolerance(tols[i], ef_trim_relative,
+				       ef_trim_nearest_even);
+		err += check_tolerance(tols[i], ef_trim_relative,
+				       ef_trim_truncate);
+	}
+
+	/* near the top, rounding up would be infinity */
+	b[0] = DBL_MAX;
+	b[1] = -DBL_MAX;
+	max_abs = efloat64_trim_tolerance(b, b, 2, ldexp(1.0, 978),
+					  ef_trim_absolute,
+					  ef_trim_nearest_even, NULL);
+	err += isinf(b[0]) || isinf(b[1]) || max_abs > ldexp(1.0, 978);
+	b[0] = DBL_MAX;
+	max_abs = efloat64_trim_tolerance(b, b, 1, ldexp(1.0, -20),
+					  ef_trim_relative,
+					  ef_trim_nearest_even, &max_rel);
+	err += isinf(b[0]) || max_rel > ldexp(1.0, -20);
+
+	/* a negative or NaN tolerance is rejected */
+	err += (efloat64_trim_tolerance(t, a, 10, -1.0, ef_trim_absolute,
+					ef_trim_truncate, NULL) != -1);
+	err += (efloat64_trim_tolerance(t, a, 10, NAN, ef_trim_relative,
+					ef_trim_truncate, NULL) != -1);
+	return err;
+}
+
+int test_efloat32_trim(void)
+{
+	efloat32 f[Test_array_len], g[Test_array_len];
+	efloat32 max_abs, max_rel;
+	size_t i;
+	int err_count;
+
+	err_count = 0;
+	for (i = 0; i < Test_array_len; ++i) {
+		f[i] = (efloat32)a[i];
+	}
+	f[0] = FLT_MAX;
+	max_abs = efloat32_trim_bits(g, f, Test_array_len, 7,
+				     ef_trim_nearest_even, &max_rel);
+	for (i = 0; i < Test_array_len; ++i) {
+		if (isinf(g[i]) != isinf(f[i])) {
+			++err_count;
+		}
+		if (!isnan(f[i]) && !isinf(f[i])
+		    && (efloat32_to_uint32_bits(g[i]) & 0xFFFF)) {
+			++err_count;
+		}
+		/* FLT_MAX would round up to infinity, so is truncated */
+		if (i > 0 && fabs(f[i]) >= FLT_MIN
+		    && (efloat32)ref_trim(f[i], 7, 0) != g[i]) {
+			++err_count;
+			fprintf(stderr, "%g -> %g\n", (double)f[i],
+				(double)g[i]);
+		}
+	}
+	if (g[0] != ldexp(255.0, 120) || !(max_abs > 0)) {
+		++err_count;
+	}
+
+	/* rounding FLT_MAX up would be infinity, truncating must still
+	   stay within the tolerance */
+	f[0] = FLT_MAX;
+	max_abs = efloat32_trim_tolerance(g, f, 1, ldexpf(1.0f, 110),
+					  ef_trim_absolute,
+					  ef_trim_nearest_even, NULL);
+	if (isinf(g[0]) || max_abs > ldexpf(1.0f, 110)) {
+		++err_count;
+		fprintf(stderr, "FLT_MAX -> %g\n", (double)g[0]);
+	}
+
+	/* in place, with a relative tolerance */
+	max_abs = efloat32_trim_tolerance(f, f, Test_array_len, 0.01f,
+					  ef_trim_relative, ef_trim_truncate,
+					  &max_rel);
+	err_count += (max_rel > 0.01f);
+	return err_count;
+}
+
+int main(void)
+{
+	int err;
+
+	err = 0;
+	fill_values();
+	err += test_trim_bits();
+	err += test_trim_tolerance();
+	err += test_efloat32_trim();
+
+	if (err) {
+		fprintf(stderr, "%d errors\n", err);
+	}
+	return (err == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,236 @@
+/* SPDX-License-Identifier: LGPL-2.1-or-later */
+/* test-xor.c: test of the XOR float series compression */
+/* Copyright (C) 2026 Eric Herman */
+/* https://github.com/ericherman/libefloat */
+
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "efloat.h"
+
+#define Test_array_len 2000
+#define Test_buf_len (16 + (Test_array_len * 9))
+
+void fill_series(efloat64 *a, size_t len, int kind)
+{
+	uint64_t state;
+	double walk;
+	size_t i;
+
+	state = 7;
+	walk = 100.0;
+	for (i = 0; i < len; ++i) {
+		state = (state * 6364136223846793005ULL)
+		    + 1442695040888963407ULL;
+		switch (kind) {
+		case 0:
+			/* a random walk of decimal prices */
+			walk += (double)((int)((state >> 40) % 21) - 10) / 100;
+			a[i] = walk;
+			break;
+		case 1:
+			/* long constant runs */
+			a[i] = (double)((i / 100) % 3) * 0.25;
+			break;
+		case 2:
+			/* a counter */
+			a[i] = (double)i;
+			break;
+		default:
+			/* anything at all, including NaN and infinities */
+			a[i] = uint64_bits_to_efloat64(state);
+			if ((i % 13) == 0) {
+				a[i] = (i & 1) ? INFINITY : -INFINITY;
+			} else if ((i % 17) == 0) {
+				a[i] = -0.0;
+			}
+			break;
+		}
+	}
+}
+
+int check_efloat64_round_trip(const efloat64 *a, size_t len,
+			      enum efloat_xor_variant variant, size_t *used)
+{
+	uint8_t buf[Test_buf_len];
+	efloat64 out[Test_array_len];
+	struct efloat_xor_encoder enc;
+	struct efloat_xor_decoder dec;
+	size_t i, n;
+	int err;
+
+	err = 0;
+	efloat64_xor_encoder_init(&enc, variant, buf, sizeof(buf));
+	n = efloat64_xor_append_array(&enc, a, len);
+	if (n != len) {
+		fprintf(stderr, "appended %lu of %lu\n", (unsigned long)n,
+			(unsigned long)len);
+		return 1;
+	}
+	*used = efloat_xor_encoder_finish(&enc);
+
+	if (!efloat64_xor_decoder_init(&dec, buf, *used)) {
+		return 1;
+	}
+	n = efloat64_xor_decode_array(&dec, out, Test_array_len);
+	if (n != len) {
+		fprintf(stderr, "decoded %lu of %lu\n", (unsigned long)n,
+			(unsigned long)len);
+		return 1;
+	}
+	for (i = 0; i < len; ++i) {
+		if (efloat64_to_uint64_bits(out[i])
+		    != efloat64_to_uint64_bits(a[i])) {
+			++err;
+			fprintf(stderr, "variant %d [%lu] %g != %g\n",
+				(int)variant, (unsigned long)i, out[i], a[i]);
+		}
+	}
+	return err;
+}
+
+int check_efloat32_round_trip(const efloat64 *a64, size_t len,
+			      enum efloat_xor_variant variant)
+{
+	uint8_t buf[Test_buf_len];
+	efloat32 a[Test_array_len];
+	efloat32 f;
+	struct efloat_xor_encoder enc;
+	struct efloat_xor_decoder dec;
+	size_t i, used;
+	int err;
+
+	err = 0;
+	for (i = 0; i < len; ++i) {
+		a[i] = (efloat32)a64[i];
+	}
+	efloat32_xor_encoder_init(&enc, variant, buf, sizeof(buf));
+	for (i = 0; i < len; ++i) {
+		err += efloat32_xor_append(&enc, a[i]);
+	}
+	used = efloat_xor_encoder_finish(&enc);
+
+	efloat32_xor_decoder_init(&dec, buf, used);
+	for (i = 0; efloat32_xor_decode(&dec, &f); ++i) {
+		if (efloat32_to_uint32_bits(f)
+		    != efloat32_to_uint32_bits(a[i])) {
+			++err;
+			fprintf(stderr, "variant %d [%lu] %g != %g\n",
+				(int)variant, (unsigned long)i, (double)f,
+				(double)a[i]);
+		}
+	}
+	if (i != len || dec.error) {
+		++err;
+		fprintf(stderr, "efloat32 decoded %lu of %lu\n",
+			(unsigned long)i, (unsigned long)len);
+	}
+	return err;
+}
+
+int test_round_trips(void)
+{
+	efloat64 a[Test_array_len];
+	size_t used;
+	int kind, err;
+
+	err = 0;
+	for (kind = 0; kind < 4; ++kind) {
+		fill_series(a, Test_array_len, kind);
+		err += check_efloat64_round_trip(a, Test_array_len,
+						 ef_xor_gorilla, &used);
+		err += check_efloat64_round_trip(a, Test_array_len,
+						 ef_xor_chimp, &used);
+		err += check_efloat32_round_trip(a, Test_array_len,
+						 ef_xor_gorilla);
+		err += check_efloat32_round_trip(a, Test_array_len,
+						 ef_xor_chimp);
+		/* a short tail, and one value */
+		err += check_efloat64_round_trip(a, 3, ef_xor_chimp, &used);
+		err += check_efloat64_round_trip(a, 1, ef_xor_gorilla, &used);
+	}
+
+	/* constant runs should compress to roughly a bit per value */
+	fill_series(a, Test_array_len, 1);
+	err += check_efloat64_round_trip(a, Test_array_len, ef_xor_gorilla,
+					 &used);
+	if (used > (Test_array_len / 4)) {
+		++err;
+		fprintf(stderr, "gorilla constant runs used %lu bytes\n",
+			(unsigned long)used);
+	}
+	err += check_efloat64_round_trip(a, Test_array_len, ef_xor_chimp,
+					 &used);
+	if (used > (Test_array_len / 3)) {
+		++err;
+		fprintf(stderr, "chimp constant runs used %lu bytes\n",
+			(unsigned long)used);
+	}
+	return err;
+}
+
+int test_full_buffer(void)
+{
+	uint8_t buf[64];
+	efloat64 a[Test_array_len];
+	efloat64 out[Test_array_len];
+	struct efloat_xor_encoder enc;
+	struct efloat_xor_decoder dec;
+	size_t i, n, m, used;
+	int err;
+
+	err = 0;
+	fill_series(a, Test_array_len, 3);
+	efloat64_xor_encoder_init(&enc, ef_xor_chimp, buf, sizeof(buf));
+	n = efloat64_xor_append_array(&enc, a, Test_array_len);
+	if (n == 0 || n >= Test_array_len) {
+		++err;
+		fprintf(stderr, "appended %lu to a small buffer\n",
+			(unsigned long)n);
+	}
+	/* a full stream stays full, and unchanged */
+	err += (efloat64_xor_append(&enc, a[n]) == 0);
+	used = efloat_xor_encoder_finish(&enc);
+	if (used > sizeof(buf)) {
+		++err;
+		fprintf(stderr, "used %lu > %lu\n", (unsigned long)used,
+			(unsigned long)sizeof(buf));
+	}
+
+	efloat64_xor_decoder_init(&dec, buf, used);
+	m = efloat64_xor_decode_array(&dec, out, Test_array_len);
+	err += (m != n);
+	for (i = 0; i < m && i < n; ++i) {
+		err += (efloat64_to_uint64_bits(out[i])
+			!= efloat64_to_uint64_bits(a[i]));
+	}
+
+	/* a truncated stream is an error, not garbage */
+	efloat64_xor_decoder_init(&dec, buf, used - 4);
+	m = efloat64_xor_decode_array(&dec, out, Test_array_len);
+	err += (m >= n) || (dec.error == 0);
+
+	/* the wrong width is rejected */
+	err += (efloat32_xor_decoder_init(&dec, buf, used) != NULL);
+
+	if (err) {
+		fprintf(stderr, "full buffer: %d errors\n", err);
+	}
+	return err;
+}
+
+int main(void)
+{
+	int err;
+
+	err = 0;
+	err += test_round_trips();
+	err += test_full_buffer();
+
+	if (err) {
+		fprintf(stderr, "%d errors\n", err);
+	}
+	return (err == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}